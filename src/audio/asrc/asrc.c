@@ -2,6 +2,7 @@
 //
 // Copyright(c) 2019-2022 Intel Corporation. All rights reserved.
 
+#include "asrc_config.h"
 #include "asrc_farrow.h"
 #include <sof/audio/module_adapter/module/generic.h>
 #include <sof/audio/buffer.h>
@@ -243,6 +244,45 @@ static int asrc_init(struct processing_module *mod)
 	return 0;
 }
 
+#if ASRC_GENERIC == 1
+static int asrc_initialize_buffers(struct asrc_farrow *src_obj)
+{
+	size_t buffer_size;
+
+	/* Set buffer_length to filter_length * 2 to compensate for
+	 * missing element wise wrap around while loading. All channels
+	 * share one ring buffer with interleaved frames.
+	 */
+	src_obj->buffer_length = src_obj->filter_length * 2;
+	src_obj->buffer_write_position = src_obj->filter_length;
+	buffer_size = src_obj->buffer_length * src_obj->num_channels;
+
+	if (src_obj->bit_depth == 32) {
+		src_obj->ring_buffer32 = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+						 buffer_size * sizeof(int32_t));
+		if (!src_obj->ring_buffer32)
+			return -ENOMEM;
+	} else {
+		src_obj->ring_buffer16 = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+						 buffer_size * sizeof(int16_t));
+		if (!src_obj->ring_buffer16)
+			return -ENOMEM;
+	}
+
+	return 0;
+}
+
+static void asrc_release_buffers(struct asrc_farrow *src_obj)
+{
+	if (!src_obj)
+		return;
+
+	rfree(src_obj->ring_buffer32);
+	src_obj->ring_buffer32 = NULL;
+	rfree(src_obj->ring_buffer16);
+	src_obj->ring_buffer16 = NULL;
+}
+#else
 static int asrc_initialize_buffers(struct asrc_farrow *src_obj)
 {
 	int32_t *buf_32;
@@ -312,6 +352,7 @@ static void asrc_release_buffers(struct asrc_farrow *src_obj)
 			}
 		}
 }
+#endif /* ASRC_GENERIC */
 
 static int asrc_free(struct processing_module *mod)
 {
@@ -801,6 +801,10 @@ enum asrc_error_code asrc_update_fs_ratio(struct comp_dev *dev,
 	return ASRC_EC_OK;
 }
 
+#if ASRC_HIFI3 == 1
+/* The generic versions use an interleaved ring buffer and are in
+ * asrc_farrow_generic.c.
+ */
 void asrc_write_to_ring_buffer16(struct asrc_farrow  *src_obj,
 				 int16_t **input_buffers, int index_input_frame)
 {
@@ -884,6 +888,7 @@ void asrc_write_to_ring_buffer32(struct asrc_farrow  *src_obj,
 		src_obj->ring_buffers32[ch][k] = input_buffers[ch][m];
 	}
 }
+#endif /* ASRC_HIFI3 */
 
 enum asrc_error_code asrc_process_push16(struct comp_dev *dev,
 					 struct asrc_farrow *src_obj,
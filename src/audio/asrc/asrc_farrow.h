@@ -141,15 +141,23 @@ struct asrc_farrow {
 	int num_channels;	/*!< Number of channels processed */
 				/*!< simultaneously */
 	int buffer_length;	/*!< Length of the ring buffer for each */
-				/*!< channel */
+				/*!< channel, in frames */
 	int buffer_write_position;	/*!< Position of the ring buffer */
 					/*!< to which will be written next */
 	int32_t **ring_buffers32;	/*!< Pointer to the pointers to the */
 					/*!< 32 bit ring buffers for each */
-					/*!< channel */
+					/*!< channel, used by the HiFi3 */
+					/*!< version */
 	int16_t **ring_buffers16;	/*!< Pointer to the pointers to the */
 					/*!< 16 bit ring buffers for each */
-					/*!< channel */
+					/*!< channel, used by the HiFi3 */
+					/*!< version */
+	int32_t *ring_buffer32;	/*!< 32 bit ring buffer with interleaved */
+				/*!< frames of all channels, used by */
+				/*!< the generic version */
+	int16_t *ring_buffer16;	/*!< 16 bit ring buffer with interleaved */
+				/*!< frames of all channels, used by */
+				/*!< the generic version */
 
 	/* + IO ring_buffer status */
 	enum asrc_buffer_mode io_buffer_mode; /*!< Mode in which IO buffers */
@@ -11,103 +11,275 @@
 
 LOG_MODULE_DECLARE(asrc, CONFIG_SOF_LOG_LEVEL);
 
+/*
+ * The generic version keeps the history of all channels in one
+ * interleaved ring buffer, ring_buffer16 or ring_buffer32, with
+ * buffer_length frames of num_channels samples. The filter is applied
+ * to ASRC_CH_BLOCK adjacent channels in a single pass over the impulse
+ * response, so each coefficient is loaded once for the block and the
+ * samples of the block are loaded from consecutive addresses.
+ */
+#define ASRC_CH_BLOCK	4
+
+void asrc_write_to_ring_buffer16(struct asrc_farrow *src_obj,
+				 int16_t **input_buffers, int index_input_frame)
+{
+	int16_t *upper_p;
+	int16_t *lower_p;
+	int nch = src_obj->num_channels;
+	int ch;
+	int m;
+
+	/* update the buffer_write_position */
+	(src_obj->buffer_write_position)++;
+
+	/* since it's a ring buffer we need a wrap around */
+	if (src_obj->buffer_write_position >= src_obj->buffer_length)
+		src_obj->buffer_write_position -= (src_obj->buffer_length >> 1);
+
+	/* handle input format */
+	if (src_obj->input_format == ASRC_IOF_INTERLEAVED)
+		m = nch * index_input_frame;
+	else
+		m = index_input_frame; /* For SRC_IOF_DEINTERLEAVED */
+
+	/*
+	 * Each input frame is written to the buffer twice, one with
+	 * an offset of half the buffer size. This way the filter
+	 * doesn't need a wrap around while loading #filter_length of
+	 * buffered frames.
+	 */
+	upper_p = &src_obj->ring_buffer16[src_obj->buffer_write_position * nch];
+	lower_p = upper_p - (src_obj->buffer_length >> 1) * nch;
+	for (ch = 0; ch < nch; ch++) {
+		upper_p[ch] = input_buffers[ch][m];
+		lower_p[ch] = input_buffers[ch][m];
+	}
+}
+
+void asrc_write_to_ring_buffer32(struct asrc_farrow *src_obj,
+				 int32_t **input_buffers, int index_input_frame)
+{
+	int32_t *upper_p;
+	int32_t *lower_p;
+	int nch = src_obj->num_channels;
+	int ch;
+	int m;
+
+	/* update the buffer_write_position */
+	(src_obj->buffer_write_position)++;
+
+	/* since it's a ring buffer we need a wrap around */
+	if (src_obj->buffer_write_position >= src_obj->buffer_length)
+		src_obj->buffer_write_position -= (src_obj->buffer_length >> 1);
+
+	/* handle input format */
+	if (src_obj->input_format == ASRC_IOF_INTERLEAVED)
+		m = nch * index_input_frame;
+	else
+		m = index_input_frame; /* For SRC_IOF_DEINTERLEAVED */
+
+	upper_p = &src_obj->ring_buffer32[src_obj->buffer_write_position * nch];
+	lower_p = upper_p - (src_obj->buffer_length >> 1) * nch;
+	for (ch = 0; ch < nch; ch++) {
+		upper_p[ch] = input_buffers[ch][m];
+		lower_p[ch] = input_buffers[ch][m];
+	}
+}
+
 void asrc_fir_filter16(struct asrc_farrow *src_obj, int16_t **output_buffers,
 		       int index_output_frame)
 {
-	int64_t prod;
+	int64_t prod0;
+	int64_t prod1;
+	int64_t prod2;
+	int64_t prod3;
 	int32_t prod32;
-	int16_t prod16;
-	int32_t *filter_p;
-	int16_t *buffer_p;
+	int32_t coef;
+	const int32_t *filter_p;
+	const int16_t *frame_p;
+	const int16_t *buffer_p;
+	int nch = src_obj->num_channels;
 	int ch;
 	int n;
 	int i;
 
 	if (src_obj->output_format == ASRC_IOF_INTERLEAVED)
-		i = src_obj->num_channels * index_output_frame;
+		i = nch * index_output_frame;
 	else
 		i = index_output_frame;
 
-	/* Iterate over each channel */
-	for (ch = 0; ch < src_obj->num_channels; ch++) {
+	/* Pointer to the newest buffered frame */
+	frame_p = &src_obj->ring_buffer16[src_obj->buffer_write_position * nch];
+
+	/* Iterate over blocks of ASRC_CH_BLOCK channels */
+	for (ch = 0; ch + ASRC_CH_BLOCK <= nch; ch += ASRC_CH_BLOCK) {
 		/* Pointer to the beginning of the impulse response */
 		filter_p = &src_obj->impulse_response[0];
+		buffer_p = frame_p + ch;
 
-		/* Pointer to the buffered input data */
-		buffer_p = &src_obj->ring_buffers16[ch]
-			[src_obj->buffer_write_position];
+		/* Initialise the accumulators */
+		prod0 = 0;
+		prod1 = 0;
+		prod2 = 0;
+		prod3 = 0;
 
-		/* Initialise the accumulator */
-		prod = 0;
-
-		/* Iterate over the filter bins.
+		/* Iterate over the filter bins, the older frames are
+		 * num_channels samples below the newer ones.
 		 * Data is Q1.15, coefficients are Q1.30. Prod will be Qx.45.
 		 */
-		for (n = 0; n < src_obj->filter_length; n++)
-			prod += (int64_t)(*buffer_p--) * (*filter_p++);
+		for (n = 0; n < src_obj->filter_length; n++) {
+			coef = *filter_p++;
+			prod0 += (int64_t)buffer_p[0] * coef;
+			prod1 += (int64_t)buffer_p[1] * coef;
+			prod2 += (int64_t)buffer_p[2] * coef;
+			prod3 += (int64_t)buffer_p[3] * coef;
+			buffer_p -= nch;
+		}
 
 		/* Shift left after accumulation, because interim
-		 * results might saturate during filtering prod = prod
-		 * << 1; will shift after last addition
+		 * results might saturate during filtering. Round to
+		 * 16 bit and store in (de-)interleaved format in the
+		 * output buffers.
 		 */
-		prod32 = sat_int32(Q_SHIFT(prod, 45, 31));
+		prod32 = sat_int32(Q_SHIFT(prod0, 45, 31));
+		output_buffers[ch][i] = sat_int16(Q_SHIFT_RND(prod32, 31, 15));
+		prod32 = sat_int32(Q_SHIFT(prod1, 45, 31));
+		output_buffers[ch + 1][i] = sat_int16(Q_SHIFT_RND(prod32, 31, 15));
+		prod32 = sat_int32(Q_SHIFT(prod2, 45, 31));
+		output_buffers[ch + 2][i] = sat_int16(Q_SHIFT_RND(prod32, 31, 15));
+		prod32 = sat_int32(Q_SHIFT(prod3, 45, 31));
+		output_buffers[ch + 3][i] = sat_int16(Q_SHIFT_RND(prod32, 31, 15));
+	}
 
-		/* Round 'prod' to 16 bit and store it in
-		 * (de-)interleaved format in the output buffers
-		 */
-		prod16 = sat_int16(Q_SHIFT_RND(prod32, 31, 15));
-		output_buffers[ch][i] = prod16;
+	/* Filter a remaining pair of channels */
+	if (ch + 2 <= nch) {
+		filter_p = &src_obj->impulse_response[0];
+		buffer_p = frame_p + ch;
+		prod0 = 0;
+		prod1 = 0;
+		for (n = 0; n < src_obj->filter_length; n++) {
+			coef = *filter_p++;
+			prod0 += (int64_t)buffer_p[0] * coef;
+			prod1 += (int64_t)buffer_p[1] * coef;
+			buffer_p -= nch;
+		}
+
+		prod32 = sat_int32(Q_SHIFT(prod0, 45, 31));
+		output_buffers[ch][i] = sat_int16(Q_SHIFT_RND(prod32, 31, 15));
+		prod32 = sat_int32(Q_SHIFT(prod1, 45, 31));
+		output_buffers[ch + 1][i] = sat_int16(Q_SHIFT_RND(prod32, 31, 15));
+		ch += 2;
+	}
+
+	/* Filter the last odd channel */
+	if (ch < nch) {
+		filter_p = &src_obj->impulse_response[0];
+		buffer_p = frame_p + ch;
+		prod0 = 0;
+		for (n = 0; n < src_obj->filter_length; n++) {
+			prod0 += (int64_t)(*buffer_p) * (*filter_p++);
+			buffer_p -= nch;
+		}
+
+		prod32 = sat_int32(Q_SHIFT(prod0, 45, 31));
+		output_buffers[ch][i] = sat_int16(Q_SHIFT_RND(prod32, 31, 15));
 	}
 }
 
 void asrc_fir_filter32(struct asrc_farrow *src_obj, int32_t **output_buffers,
 		       int index_output_frame)
 {
-	int64_t prod;
-	int32_t prod32;
+	int64_t prod0;
+	int64_t prod1;
+	int64_t prod2;
+	int64_t prod3;
+	int32_t coef;
 	const int32_t *filter_p;
-	int32_t *buffer_p;
+	const int32_t *frame_p;
+	const int32_t *buffer_p;
+	int nch = src_obj->num_channels;
 	int ch;
 	int n;
 	int i;
 
 	if (src_obj->output_format == ASRC_IOF_INTERLEAVED)
-		i = src_obj->num_channels * index_output_frame;
+		i = nch * index_output_frame;
 	else
 		i = index_output_frame;
 
-	/* Iterate over each channel */
-	for (ch = 0; ch < src_obj->num_channels; ch++) {
+	/* Pointer to the newest buffered frame */
+	frame_p = &src_obj->ring_buffer32[src_obj->buffer_write_position * nch];
+
+	/* Iterate over blocks of ASRC_CH_BLOCK channels */
+	for (ch = 0; ch + ASRC_CH_BLOCK <= nch; ch += ASRC_CH_BLOCK) {
 		/* Pointer to the beginning of the impulse response */
 		filter_p = &src_obj->impulse_response[0];
-
-		/* Pointer to the buffered input data */
-		buffer_p = &src_obj->ring_buffers32[ch]
-			[src_obj->buffer_write_position];
-
-		/* Initialise the accumulator */
-		prod = 0;
-
-		/* Iterate over the filter bins. Data is Q1.31, coefficients
-		 * are Q1.22. They are down scaled by 1 shift. In addition
-		 * there C is implementation specific right shift by 8. It
-		 * gives headroom to calculate up to 256 taps FIR. The use
-		 * of 24 bits of 32 bits is not a practical limitation for
-		 * quality. The product is Qx.54.
+		buffer_p = frame_p + ch;
+
+		/* Initialise the accumulators */
+		prod0 = 0;
+		prod1 = 0;
+		prod2 = 0;
+		prod3 = 0;
+
+		/* Iterate over the filter bins, the older frames are
+		 * num_channels samples below the newer ones. Data is
+		 * Q1.31, coefficients are Q1.22. They are down scaled
+		 * by 1 shift. In addition there C is implementation
+		 * specific right shift by 8. It gives headroom to
+		 * calculate up to 256 taps FIR. The use of 24 bits of
+		 * 32 bits is not a practical limitation for quality.
+		 * The product is Qx.54.
 		 */
-		for (n = 0; n < src_obj->filter_length; n++)
-			prod += (int64_t)(*buffer_p--) * (*filter_p++ >> 8);
+		for (n = 0; n < src_obj->filter_length; n++) {
+			coef = *filter_p++ >> 8;
+			prod0 += (int64_t)buffer_p[0] * coef;
+			prod1 += (int64_t)buffer_p[1] * coef;
+			prod2 += (int64_t)buffer_p[2] * coef;
+			prod3 += (int64_t)buffer_p[3] * coef;
+			buffer_p -= nch;
+		}
 
 		/* Shift left after accumulation, because interim
-		 * results might saturate during filtering prod = prod
-		 * << 1; will shift after last addition
+		 * results might saturate during filtering. Store in
+		 * (de-)interleaved format in the output buffers.
 		 */
-		prod32 = sat_int32(Q_SHIFT(prod, 53, 31));
+		output_buffers[ch][i] = sat_int32(Q_SHIFT(prod0, 53, 31));
+		output_buffers[ch + 1][i] = sat_int32(Q_SHIFT(prod1, 53, 31));
+		output_buffers[ch + 2][i] = sat_int32(Q_SHIFT(prod2, 53, 31));
+		output_buffers[ch + 3][i] = sat_int32(Q_SHIFT(prod3, 53, 31));
+	}
 
-		/* Store 'prod' in (de-)interleaved format in the output
-		 * buffers
-		 */
-		output_buffers[ch][i] = prod32;
+	/* Filter a remaining pair of channels */
+	if (ch + 2 <= nch) {
+		filter_p = &src_obj->impulse_response[0];
+		buffer_p = frame_p + ch;
+		prod0 = 0;
+		prod1 = 0;
+		for (n = 0; n < src_obj->filter_length; n++) {
+			coef = *filter_p++ >> 8;
+			prod0 += (int64_t)buffer_p[0] * coef;
+			prod1 += (int64_t)buffer_p[1] * coef;
+			buffer_p -= nch;
+		}
+
+		output_buffers[ch][i] = sat_int32(Q_SHIFT(prod0, 53, 31));
+		output_buffers[ch + 1][i] = sat_int32(Q_SHIFT(prod1, 53, 31));
+		ch += 2;
+	}
+
+	/* Filter the last odd channel */
+	if (ch < nch) {
+		filter_p = &src_obj->impulse_response[0];
+		buffer_p = frame_p + ch;
+		prod0 = 0;
+		for (n = 0; n < src_obj->filter_length; n++) {
+			prod0 += (int64_t)(*buffer_p) * (*filter_p++ >> 8);
+			buffer_p -= nch;
+		}
+
+		output_buffers[ch][i] = sat_int32(Q_SHIFT(prod0, 53, 31));
 	}
 }
 
@@ -12,7 +12,6 @@
 #include <rtos/alloc.h>
 #include <rtos/cache.h>
 #include <sof/lib/memory.h>
-#include <sof/lib/notifier.h>
 #include <sof/list.h>
 #include <rtos/spinlock.h>
 #include <ipc/topology.h>
@@ -72,6 +71,8 @@ struct comp_buffer *buffer_alloc(uint32_t size, uint32_t caps, uint32_t flags, u
 
 	list_init(&buffer->source_list);
 	list_init(&buffer->sink_list);
+	list_init(&buffer->hook_list);
+	k_spinlock_init(&buffer->hook_lock);
 
 	return buffer;
 }
@@ -178,12 +179,74 @@ bool buffer_params_match(struct comp_buffer *buffer,
 	return true;
 }
 
+/*
+ * Locking: hooks are added and removed by IPC, possibly on another core than
+ * the one updating the buffer, so the list is only used with the hook lock
+ * held. The produce and consume hooks are run with the lock held.
+ */
+void buffer_hook_add(struct comp_buffer *buffer, struct buffer_hook *hook)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&buffer->hook_lock);
+
+	hook->buffer = buffer;
+	list_item_append(&hook->list, &buffer->hook_list);
+	buffer->hook_types |= hook->types;
+
+	k_spin_unlock(&buffer->hook_lock, key);
+}
+
+void buffer_hook_remove(struct buffer_hook *hook)
+{
+	struct comp_buffer *buffer = hook->buffer;
+	struct list_item *hlist;
+	k_spinlock_key_t key;
+
+	/* already detached by buffer_free() */
+	if (!buffer)
+		return;
+
+	key = k_spin_lock(&buffer->hook_lock);
+
+	list_item_del(&hook->list);
+	hook->buffer = NULL;
+
+	buffer->hook_types = 0;
+	list_for_item(hlist, &buffer->hook_list)
+		buffer->hook_types |= container_of(hlist, struct buffer_hook, list)->types;
+
+	k_spin_unlock(&buffer->hook_lock, key);
+}
+
+static void buffer_hook_run(struct comp_buffer *buffer, uint32_t type, void *data)
+{
+	struct buffer_hook *hook;
+	struct list_item *hlist;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&buffer->hook_lock);
+
+	list_for_item(hlist, &buffer->hook_list) {
+		hook = container_of(hlist, struct buffer_hook, list);
+		if (hook->types & type)
+			hook->cb(hook->arg, type, data);
+	}
+
+	k_spin_unlock(&buffer->hook_lock, key);
+}
+
 /* free component in the pipeline */
 void buffer_free(struct comp_buffer *buffer)
 {
 	struct buffer_cb_free cb_data = {
 		.buffer = buffer,
 	};
+	struct buffer_hook *hook;
+	struct list_item hooks;
+	struct list_item *hlist;
+	struct list_item *tmp;
+	k_spinlock_key_t key;
 
 	CORE_CHECK_STRUCT(buffer);
 
@@ -192,11 +255,24 @@ void buffer_free(struct comp_buffer *buffer)
 
 	buf_dbg(buffer, "buffer_free()");
 
-	notifier_event(buffer, NOTIFIER_ID_BUFFER_FREE,
-		       NOTIFIER_TARGET_CORE_LOCAL, &cb_data, sizeof(cb_data));
+	/* Detach all hooks first, the free hooks may then remove themselves
+	 * without taking the lock again.
+	 */
+	list_init(&hooks);
+	key = k_spin_lock(&buffer->hook_lock);
+	list_for_item_safe(hlist, tmp, &buffer->hook_list) {
+		container_of(hlist, struct buffer_hook, list)->buffer = NULL;
+		list_item_del(hlist);
+		list_item_append(hlist, &hooks);
+	}
+	buffer->hook_types = 0;
+	k_spin_unlock(&buffer->hook_lock, key);
 
-	/* In case some listeners didn't unregister from buffer's callbacks */
-	notifier_unregister_all(NULL, buffer);
+	list_for_item_safe(hlist, tmp, &hooks) {
+		hook = container_of(hlist, struct buffer_hook, list);
+		if (hook->types & BUFF_CB_TYPE_FREE)
+			hook->cb(hook->arg, BUFF_CB_TYPE_FREE, &cb_data);
+	}
 
 	rfree(buffer->stream.addr);
 	rfree(buffer);
@@ -224,8 +300,8 @@ void comp_update_buffer_produce(struct comp_buffer *buffer, uint32_t bytes)
 
 	audio_stream_produce(&buffer->stream, bytes);
 
-	notifier_event(buffer, NOTIFIER_ID_BUFFER_PRODUCE,
-		       NOTIFIER_TARGET_CORE_LOCAL, &cb_data, sizeof(cb_data));
+	if (buffer->hook_types & BUFF_CB_TYPE_PRODUCE)
+		buffer_hook_run(buffer, BUFF_CB_TYPE_PRODUCE, &cb_data);
 
 #if CONFIG_SOF_LOG_DBG_BUFFER
 	buf_dbg(buffer, "comp_update_buffer_produce(), ((buffer->avail << 16) | buffer->free) = %08x, ((buffer->id << 16) | buffer->size) = %08x",
@@ -264,8 +340,8 @@ void comp_update_buffer_consume(struct comp_buffer *buffer, uint32_t bytes)
 
 	audio_stream_consume(&buffer->stream, bytes);
 
-	notifier_event(buffer, NOTIFIER_ID_BUFFER_CONSUME,
-		       NOTIFIER_TARGET_CORE_LOCAL, &cb_data, sizeof(cb_data));
+	if (buffer->hook_types & BUFF_CB_TYPE_CONSUME)
+		buffer_hook_run(buffer, BUFF_CB_TYPE_CONSUME, &cb_data);
 
 #if CONFIG_SOF_LOG_DBG_BUFFER
 	buf_dbg(buffer, "comp_update_buffer_consume(), (buffer->avail << 16) | buffer->free = %08x, (buffer->id << 16) | buffer->size = %08x, (buffer->r_ptr - buffer->addr) << 16 | (buffer->w_ptr - buffer->addr)) = %08x",
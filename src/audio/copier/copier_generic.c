@@ -16,6 +16,7 @@ LOG_MODULE_DECLARE(copier, CONFIG_SOF_LOG_LEVEL);
 #include <sof/audio/format.h>
 #include <sof/audio/pipeline.h>
 #include <sof/audio/component.h>
+#include <sof/audio/pcm_converter.h>
 #include <sof/common.h>
 #include <stddef.h>
 #include <errno.h>
@@ -24,12 +25,11 @@ LOG_MODULE_DECLARE(copier, CONFIG_SOF_LOG_LEVEL);
 int apply_attenuation(struct comp_dev *dev, struct copier_data *cd,
 		      struct comp_buffer *sink, int frame)
 {
-	int i;
 	int n;
 	int nmax;
 	int remaining_samples = frame * audio_stream_get_channels(&sink->stream);
 	uint32_t bytes = frame * audio_stream_frame_bytes(&sink->stream);
-	uint32_t *dst = audio_stream_rewind_wptr_by_bytes(&sink->stream, bytes);
+	int32_t *dst = (int32_t *)audio_stream_rewind_wptr_by_bytes(&sink->stream, bytes);
 
 	/* only support attenuation in format of 32bit */
 	switch (audio_stream_get_frm_fmt(&sink->stream)) {
@@ -41,10 +41,8 @@ int apply_attenuation(struct comp_dev *dev, struct copier_data *cd,
 		while (remaining_samples) {
 			nmax = audio_stream_samples_without_wrap_s32(&sink->stream, dst);
 			n = MIN(remaining_samples, nmax);
-			for (i = 0; i < n; i++) {
-				*dst >>= cd->attenuation;
-				dst++;
-			}
+			pcm_lin_attenuate_s32(dst, n, cd->attenuation);
+			dst += n;
 			remaining_samples -= n;
 			dst = audio_stream_wrap(&sink->stream, dst);
 		}
@@ -19,6 +19,7 @@
 #include <rtos/init.h>
 #include <sof/lib/memory.h>
 #include <sof/lib/uuid.h>
+#include <sof/math/iir_block.h>
 #include <sof/math/iir_df2t.h>
 #include <sof/list.h>
 #include <sof/platform.h>
@@ -54,6 +55,7 @@ static void crossover_reset_state(struct comp_data *cd)
 {
 	int i;
 
+	crossover_block_free(&cd->block);
 	for (i = 0; i < PLATFORM_MAX_CHANNELS; i++)
 		crossover_reset_state_ch(&cd->state[i]);
 }
@@ -230,6 +232,73 @@ int crossover_init_coef_ch(struct sof_eq_iir_biquad *coef,
 	return 0;
 }
 
+void crossover_block_free(struct crossover_block *block)
+{
+	int i;
+
+	for (i = 0; i < CROSSOVER_MAX_LR4; i++) {
+		iir_block_free_df2t(&block->lowpass[i]);
+		iir_block_free_df2t(&block->highpass[i]);
+	}
+
+	rfree(block->in);
+	block->in = NULL;
+	block->tmp = NULL;
+	for (i = 0; i < SOF_CROSSOVER_MAX_STREAMS; i++)
+		block->out[i] = NULL;
+}
+
+/**
+ * \brief Initializes the block filters of the crossover from the LR4
+ *	  filters of the first channels and allocates the frame buffers.
+ */
+int crossover_block_init(struct crossover_block *block, struct crossover_state state[],
+			 int channels, int32_t num_sinks)
+{
+	struct iir_state_df2t lr4[PLATFORM_MAX_CHANNELS];
+	int32_t num_lr4s = num_sinks == CROSSOVER_2WAY_NUM_SINKS ? 1 : 3;
+	int samples = channels * CROSSOVER_BLOCK_FRAMES;
+	int ch;
+	int i;
+	int ret;
+
+	if (channels > PLATFORM_MAX_CHANNELS)
+		return -EINVAL;
+
+	/* Input, outputs and the phase alignment buffer */
+	block->in = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			    (SOF_CROSSOVER_MAX_STREAMS + 2) * samples * sizeof(int32_t));
+	if (!block->in)
+		return -ENOMEM;
+
+	for (i = 0; i < SOF_CROSSOVER_MAX_STREAMS; i++)
+		block->out[i] = block->in + (i + 1) * samples;
+
+	block->tmp = block->out[SOF_CROSSOVER_MAX_STREAMS - 1] + samples;
+
+	for (i = 0; i < num_lr4s; i++) {
+		for (ch = 0; ch < channels; ch++)
+			lr4[ch] = state[ch].lowpass[i];
+
+		ret = iir_block_init_df2t(&block->lowpass[i], lr4, channels);
+		if (ret < 0)
+			goto err;
+
+		for (ch = 0; ch < channels; ch++)
+			lr4[ch] = state[ch].highpass[i];
+
+		ret = iir_block_init_df2t(&block->highpass[i], lr4, channels);
+		if (ret < 0)
+			goto err;
+	}
+
+	return 0;
+
+err:
+	crossover_block_free(block);
+	return ret;
+}
+
 /**
  * \brief Initializes the coefficients of the crossover filter
  *	  and assign them to the first nch channels.
@@ -287,8 +356,17 @@ static int crossover_setup(struct processing_module *mod, int nch)
 
 	/* Assign LR4 coefficients from config */
 	ret = crossover_init_coef(mod, nch);
+	if (ret < 0)
+		return ret;
 
-	return ret;
+	/* Process the channels as blocks of frames. The per channel
+	 * filters are used if the block filters can't be initialized.
+	 */
+	ret = crossover_block_init(&cd->block, cd->state, nch, cd->config->num_sinks);
+	if (ret < 0)
+		comp_warn(mod->dev, "crossover_setup(), block filters init fail %d", ret);
+
+	return 0;
 }
 
 /**
@@ -592,6 +670,8 @@ static int crossover_prepare(struct processing_module *mod,
 				 cd->config->num_sinks);
 			return -EINVAL;
 		}
+
+		cd->crossover_split_ch = crossover_find_split_ch_func(cd->config->num_sinks);
 	} else {
 		comp_info(dev, "crossover_prepare(), setting crossover to passthrough mode");
 
@@ -621,6 +701,7 @@ static int crossover_reset(struct processing_module *mod)
 
 	cd->crossover_process = NULL;
 	cd->crossover_split = NULL;
+	cd->crossover_split_ch = NULL;
 
 	return 0;
 }
@@ -56,10 +56,15 @@ typedef void (*crossover_process)(struct comp_data *cd,
 				  int32_t num_sinks,
 				  uint32_t frames);
 
+/* Splits one sample of a channel when the block filters are not available */
+typedef void (*crossover_split_ch)(int32_t in, int32_t out[],
+				   struct crossover_state *state);
+
 /* Crossover component private data */
 struct comp_data {
 	/**< filter state */
 	struct crossover_state state[PLATFORM_MAX_CHANNELS];
+	struct crossover_block block;		  /**< filters of all channels */
 #if CONFIG_IPC_MAJOR_4
 	uint32_t output_pin_index[SOF_CROSSOVER_MAX_STREAMS];
 	uint32_t num_output_pins;
@@ -69,6 +74,7 @@ struct comp_data {
 	enum sof_ipc_frame source_format;         /**< source frame format */
 	crossover_process crossover_process;      /**< processing function */
 	crossover_split crossover_split;          /**< split function */
+	crossover_split_ch crossover_split_ch;    /**< per channel split function */
 };
 
 struct crossover_proc_fnmap {
@@ -114,15 +120,18 @@ static inline crossover_process
 
 extern const crossover_split crossover_split_fnmap[];
 extern const size_t crossover_split_fncount;
+extern const crossover_split_ch crossover_split_ch_fnmap[];
 
-/*
- * \brief Runs input in through the LR4 filter and returns it's output.
+/**
+ * \brief Returns Crossover per channel split function.
  */
-static inline int32_t crossover_generic_process_lr4(int32_t in,
-						    struct iir_state_df2t *lr4)
+static inline crossover_split_ch crossover_find_split_ch_func(int32_t num_sinks)
 {
-	/* Cascade two biquads with same coefficients in series. */
-	return iir_df2t(lr4, in);
+	if (num_sinks < CROSSOVER_2WAY_NUM_SINKS ||
+	    num_sinks > CROSSOVER_4WAY_NUM_SINKS)
+		return NULL;
+
+	return crossover_split_ch_fnmap[num_sinks - CROSSOVER_2WAY_NUM_SINKS];
 }
 
 static inline void crossover_free_config(struct sof_crossover_config **config)
@@ -8,6 +8,8 @@
 #include <sof/audio/module_adapter/module/module_interface.h>
 #include <sof/audio/component.h>
 #include <sof/audio/format.h>
+#include <sof/common.h>
+#include <sof/math/iir_block.h>
 #include <sof/math/iir_df2t.h>
 #include <stdint.h>
 
@@ -16,75 +18,135 @@
 /*
  * \brief Splits x into two based on the coefficients set in the lp
  *        and hp filters. The output of the lp is in y1, the output of
- *        the hp is in y2.
+ *        the hp is in y2. The output y2 can be the same buffer as x.
  *
  * As a side effect, this function mutates the delay values of both
  * filters.
  */
-static inline void crossover_generic_lr4_split(struct iir_state_df2t *lp,
-					       struct iir_state_df2t *hp,
-					       int32_t x, int32_t *y1,
-					       int32_t *y2)
+static inline void crossover_generic_lr4_split(struct iir_block_df2t *lp,
+					       struct iir_block_df2t *hp,
+					       const int32_t *x, int32_t *y1,
+					       int32_t *y2, int frames)
 {
-	*y1 = crossover_generic_process_lr4(x, lp);
-	*y2 = crossover_generic_process_lr4(x, hp);
+	/* Each LR4 is a cascade of two biquads with same coefficients */
+	iir_block_df2t(lp, x, y1, frames);
+	iir_block_df2t(hp, x, y2, frames);
 }
 
 /*
  * \brief Splits input signal into two and merges it back to it's
- *        original form.
+ *        original form. The output y can be the same buffer as x.
  *
  * With 3-way crossovers, one output goes through only one LR4 filter,
  * whereas the other two go through two LR4 filters. This causes the signals
  * to be out of phase. We need to pass the signal through another set of LR4
  * filters to align back the phase.
  */
-static inline void crossover_generic_lr4_merge(struct iir_state_df2t *lp,
-					       struct iir_state_df2t *hp,
-					       int32_t x, int32_t *y)
+static inline void crossover_generic_lr4_merge(struct iir_block_df2t *lp,
+					       struct iir_block_df2t *hp,
+					       const int32_t *x, int32_t *y,
+					       int32_t *tmp, int frames)
+{
+	int samples = frames * lp->channels;
+	int i;
+
+	crossover_generic_lr4_split(lp, hp, x, tmp, y, frames);
+	for (i = 0; i < samples; i++)
+		y[i] = sat_int32(((int64_t)tmp[i]) + y[i]);
+}
+
+static void crossover_generic_split_2way(struct crossover_block *block,
+					 const int32_t *x, int32_t *out[],
+					 int frames)
+{
+	crossover_generic_lr4_split(&block->lowpass[0], &block->highpass[0],
+				    x, out[0], out[1], frames);
+}
+
+static void crossover_generic_split_3way(struct crossover_block *block,
+					 const int32_t *x, int32_t *out[],
+					 int frames)
+{
+	/* The intermediate z1 is in out[0] and z2 is in out[2] */
+	crossover_generic_lr4_split(&block->lowpass[0], &block->highpass[0],
+				    x, out[0], out[2], frames);
+	/* Realign the phase of z1 */
+	crossover_generic_lr4_merge(&block->lowpass[1], &block->highpass[1],
+				    out[0], out[0], block->tmp, frames);
+	crossover_generic_lr4_split(&block->lowpass[2], &block->highpass[2],
+				    out[2], out[1], out[2], frames);
+}
+
+static void crossover_generic_split_4way(struct crossover_block *block,
+					 const int32_t *x, int32_t *out[],
+					 int frames)
+{
+	/* The intermediate z1 is in out[1] and z2 is in out[3] */
+	crossover_generic_lr4_split(&block->lowpass[1], &block->highpass[1],
+				    x, out[1], out[3], frames);
+	crossover_generic_lr4_split(&block->lowpass[0], &block->highpass[0],
+				    out[1], out[0], out[1], frames);
+	crossover_generic_lr4_split(&block->lowpass[2], &block->highpass[2],
+				    out[3], out[2], out[3], frames);
+}
+
+/*
+ * \brief Per channel versions of the split functions for the case the
+ *        block filters could not be initialized. They process one sample
+ *        with the LR4 filters of the channel state.
+ */
+static inline void crossover_generic_lr4_split_ch(struct iir_state_df2t *lp,
+						  struct iir_state_df2t *hp,
+						  int32_t x, int32_t *y1,
+						  int32_t *y2)
+{
+	*y1 = iir_df2t(lp, x);
+	*y2 = iir_df2t(hp, x);
+}
+
+static inline void crossover_generic_lr4_merge_ch(struct iir_state_df2t *lp,
+						  struct iir_state_df2t *hp,
+						  int32_t x, int32_t *y)
 {
 	int32_t z1, z2;
 
-	z1 = crossover_generic_process_lr4(x, lp);
-	z2 = crossover_generic_process_lr4(x, hp);
+	z1 = iir_df2t(lp, x);
+	z2 = iir_df2t(hp, x);
 	*y = sat_int32(((int64_t)z1) + z2);
 }
 
-static void crossover_generic_split_2way(int32_t in,
-					 int32_t out[],
-					 struct crossover_state *state)
+static void crossover_generic_split_2way_ch(int32_t in, int32_t out[],
+					    struct crossover_state *state)
 {
-	crossover_generic_lr4_split(&state->lowpass[0], &state->highpass[0],
-				    in, &out[0], &out[1]);
+	crossover_generic_lr4_split_ch(&state->lowpass[0], &state->highpass[0],
+				       in, &out[0], &out[1]);
 }
 
-static void crossover_generic_split_3way(int32_t in,
-					 int32_t out[],
-					 struct crossover_state *state)
+static void crossover_generic_split_3way_ch(int32_t in, int32_t out[],
+					    struct crossover_state *state)
 {
 	int32_t z1, z2;
 
-	crossover_generic_lr4_split(&state->lowpass[0], &state->highpass[0],
-				    in, &z1, &z2);
+	crossover_generic_lr4_split_ch(&state->lowpass[0], &state->highpass[0],
+				       in, &z1, &z2);
 	/* Realign the phase of z1 */
-	crossover_generic_lr4_merge(&state->lowpass[1], &state->highpass[1],
-				    z1, &out[0]);
-	crossover_generic_lr4_split(&state->lowpass[2], &state->highpass[2],
-				    z2, &out[1], &out[2]);
+	crossover_generic_lr4_merge_ch(&state->lowpass[1], &state->highpass[1],
+				       z1, &out[0]);
+	crossover_generic_lr4_split_ch(&state->lowpass[2], &state->highpass[2],
+				       z2, &out[1], &out[2]);
 }
 
-static void crossover_generic_split_4way(int32_t in,
-					 int32_t out[],
-					 struct crossover_state *state)
+static void crossover_generic_split_4way_ch(int32_t in, int32_t out[],
+					    struct crossover_state *state)
 {
 	int32_t z1, z2;
 
-	crossover_generic_lr4_split(&state->lowpass[1], &state->highpass[1],
-				    in, &z1, &z2);
-	crossover_generic_lr4_split(&state->lowpass[0], &state->highpass[0],
-				    z1, &out[0], &out[1]);
-	crossover_generic_lr4_split(&state->lowpass[2], &state->highpass[2],
-				    z2, &out[2], &out[3]);
+	crossover_generic_lr4_split_ch(&state->lowpass[1], &state->highpass[1],
+				       in, &z1, &z2);
+	crossover_generic_lr4_split_ch(&state->lowpass[0], &state->highpass[0],
+				       z1, &out[0], &out[1]);
+	crossover_generic_lr4_split_ch(&state->lowpass[2], &state->highpass[2],
+				       z2, &out[2], &out[3]);
 }
 
 #if CONFIG_FORMAT_S16LE
@@ -143,11 +205,11 @@ static void crossover_s32_default_pass(struct comp_data *cd,
 #endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE */
 
 #if CONFIG_FORMAT_S16LE
-static void crossover_s16_default(struct comp_data *cd,
-				  struct input_stream_buffer *bsource,
-				  struct output_stream_buffer **bsinks,
-				  int32_t num_sinks,
-				  uint32_t frames)
+static void crossover_s16_default_ch(struct comp_data *cd,
+				     struct input_stream_buffer *bsource,
+				     struct output_stream_buffer **bsinks,
+				     int32_t num_sinks,
+				     uint32_t frames)
 {
 	struct crossover_state *state;
 	const struct audio_stream *source_stream = bsource->data;
@@ -163,14 +225,13 @@ static void crossover_s16_default(struct comp_data *cd,
 		state = &cd->state[ch];
 		for (i = 0; i < frames; i++) {
 			x = audio_stream_read_frag_s16(source_stream, idx);
-			cd->crossover_split(*x << 16, out, state);
+			cd->crossover_split_ch(*x << 16, out, state);
 
 			for (j = 0; j < num_sinks; j++) {
 				if (!bsinks[j])
 					continue;
 				sink_stream = bsinks[j]->data;
-				y = audio_stream_write_frag_s16(sink_stream,
-								idx);
+				y = audio_stream_write_frag_s16(sink_stream, idx);
 				*y = sat_int16(Q_SHIFT_RND(out[j], 31, 15));
 			}
 
@@ -178,14 +239,61 @@ static void crossover_s16_default(struct comp_data *cd,
 		}
 	}
 }
-#endif /* CONFIG_FORMAT_S16LE */
 
-#if CONFIG_FORMAT_S24LE
-static void crossover_s24_default(struct comp_data *cd,
+static void crossover_s16_default(struct comp_data *cd,
 				  struct input_stream_buffer *bsource,
 				  struct output_stream_buffer **bsinks,
 				  int32_t num_sinks,
 				  uint32_t frames)
+{
+	struct crossover_block *block = &cd->block;
+	const struct audio_stream *source_stream = bsource->data;
+	struct audio_stream *sink_stream;
+	int16_t *x, *y;
+	int i, j;
+	int n;
+	int samples;
+	int idx = 0;
+	int nch = audio_stream_get_channels(source_stream);
+
+	/* The block filters could not be initialized, process each channel */
+	if (!block->in) {
+		crossover_s16_default_ch(cd, bsource, bsinks, num_sinks, frames);
+		return;
+	}
+
+	while (frames) {
+		n = MIN(frames, CROSSOVER_BLOCK_FRAMES);
+		samples = n * nch;
+		for (i = 0; i < samples; i++) {
+			x = audio_stream_read_frag_s16(source_stream, idx + i);
+			block->in[i] = *x << 16;
+		}
+
+		cd->crossover_split(block, block->in, block->out, n);
+
+		for (j = 0; j < num_sinks; j++) {
+			if (!bsinks[j])
+				continue;
+			sink_stream = bsinks[j]->data;
+			for (i = 0; i < samples; i++) {
+				y = audio_stream_write_frag_s16(sink_stream, idx + i);
+				*y = sat_int16(Q_SHIFT_RND(block->out[j][i], 31, 15));
+			}
+		}
+
+		idx += samples;
+		frames -= n;
+	}
+}
+#endif /* CONFIG_FORMAT_S16LE */
+
+#if CONFIG_FORMAT_S24LE
+static void crossover_s24_default_ch(struct comp_data *cd,
+				     struct input_stream_buffer *bsource,
+				     struct output_stream_buffer **bsinks,
+				     int32_t num_sinks,
+				     uint32_t frames)
 {
 	struct crossover_state *state;
 	const struct audio_stream *source_stream = bsource->data;
@@ -201,14 +309,13 @@ static void crossover_s24_default(struct comp_data *cd,
 		state = &cd->state[ch];
 		for (i = 0; i < frames; i++) {
 			x = audio_stream_read_frag_s32(source_stream, idx);
-			cd->crossover_split(*x << 8, out, state);
+			cd->crossover_split_ch(*x << 8, out, state);
 
 			for (j = 0; j < num_sinks; j++) {
 				if (!bsinks[j])
 					continue;
 				sink_stream = bsinks[j]->data;
-				y = audio_stream_write_frag_s32(sink_stream,
-								idx);
+				y = audio_stream_write_frag_s32(sink_stream, idx);
 				*y = sat_int24(Q_SHIFT_RND(out[j], 31, 23));
 			}
 
@@ -216,14 +323,61 @@ static void crossover_s24_default(struct comp_data *cd,
 		}
 	}
 }
-#endif /* CONFIG_FORMAT_S24LE */
 
-#if CONFIG_FORMAT_S32LE
-static void crossover_s32_default(struct comp_data *cd,
+static void crossover_s24_default(struct comp_data *cd,
 				  struct input_stream_buffer *bsource,
 				  struct output_stream_buffer **bsinks,
 				  int32_t num_sinks,
 				  uint32_t frames)
+{
+	struct crossover_block *block = &cd->block;
+	const struct audio_stream *source_stream = bsource->data;
+	struct audio_stream *sink_stream;
+	int32_t *x, *y;
+	int i, j;
+	int n;
+	int samples;
+	int idx = 0;
+	int nch = audio_stream_get_channels(source_stream);
+
+	/* The block filters could not be initialized, process each channel */
+	if (!block->in) {
+		crossover_s24_default_ch(cd, bsource, bsinks, num_sinks, frames);
+		return;
+	}
+
+	while (frames) {
+		n = MIN(frames, CROSSOVER_BLOCK_FRAMES);
+		samples = n * nch;
+		for (i = 0; i < samples; i++) {
+			x = audio_stream_read_frag_s32(source_stream, idx + i);
+			block->in[i] = *x << 8;
+		}
+
+		cd->crossover_split(block, block->in, block->out, n);
+
+		for (j = 0; j < num_sinks; j++) {
+			if (!bsinks[j])
+				continue;
+			sink_stream = bsinks[j]->data;
+			for (i = 0; i < samples; i++) {
+				y = audio_stream_write_frag_s32(sink_stream, idx + i);
+				*y = sat_int24(Q_SHIFT_RND(block->out[j][i], 31, 23));
+			}
+		}
+
+		idx += samples;
+		frames -= n;
+	}
+}
+#endif /* CONFIG_FORMAT_S24LE */
+
+#if CONFIG_FORMAT_S32LE
+static void crossover_s32_default_ch(struct comp_data *cd,
+				     struct input_stream_buffer *bsource,
+				     struct output_stream_buffer **bsinks,
+				     int32_t num_sinks,
+				     uint32_t frames)
 {
 	struct crossover_state *state;
 	const struct audio_stream *source_stream = bsource->data;
@@ -239,14 +393,13 @@ static void crossover_s32_default(struct comp_data *cd,
 		state = &cd->state[ch];
 		for (i = 0; i < frames; i++) {
 			x = audio_stream_read_frag_s32(source_stream, idx);
-			cd->crossover_split(*x, out, state);
+			cd->crossover_split_ch(*x, out, state);
 
 			for (j = 0; j < num_sinks; j++) {
 				if (!bsinks[j])
 					continue;
 				sink_stream = bsinks[j]->data;
-				y = audio_stream_write_frag_s32(sink_stream,
-								idx);
+				y = audio_stream_write_frag_s32(sink_stream, idx);
 				*y = out[j];
 			}
 
@@ -254,6 +407,53 @@ static void crossover_s32_default(struct comp_data *cd,
 		}
 	}
 }
+
+static void crossover_s32_default(struct comp_data *cd,
+				  struct input_stream_buffer *bsource,
+				  struct output_stream_buffer **bsinks,
+				  int32_t num_sinks,
+				  uint32_t frames)
+{
+	struct crossover_block *block = &cd->block;
+	const struct audio_stream *source_stream = bsource->data;
+	struct audio_stream *sink_stream;
+	int32_t *x, *y;
+	int i, j;
+	int n;
+	int samples;
+	int idx = 0;
+	int nch = audio_stream_get_channels(source_stream);
+
+	/* The block filters could not be initialized, process each channel */
+	if (!block->in) {
+		crossover_s32_default_ch(cd, bsource, bsinks, num_sinks, frames);
+		return;
+	}
+
+	while (frames) {
+		n = MIN(frames, CROSSOVER_BLOCK_FRAMES);
+		samples = n * nch;
+		for (i = 0; i < samples; i++) {
+			x = audio_stream_read_frag_s32(source_stream, idx + i);
+			block->in[i] = *x;
+		}
+
+		cd->crossover_split(block, block->in, block->out, n);
+
+		for (j = 0; j < num_sinks; j++) {
+			if (!bsinks[j])
+				continue;
+			sink_stream = bsinks[j]->data;
+			for (i = 0; i < samples; i++) {
+				y = audio_stream_write_frag_s32(sink_stream, idx + i);
+				*y = block->out[j][i];
+			}
+		}
+
+		idx += samples;
+		frames -= n;
+	}
+}
 #endif /* CONFIG_FORMAT_S32LE */
 
 const struct crossover_proc_fnmap crossover_proc_fnmap[] = {
@@ -295,3 +495,9 @@ const crossover_split crossover_split_fnmap[] = {
 };
 
 const size_t crossover_split_fncount = ARRAY_SIZE(crossover_split_fnmap);
+
+const crossover_split_ch crossover_split_ch_fnmap[] = {
+	crossover_generic_split_2way_ch,
+	crossover_generic_split_3way_ch,
+	crossover_generic_split_4way_ch,
+};
@@ -66,6 +66,11 @@ void drc_reset_state(struct drc_state *state)
 	state->processed = 0;
 
 	state->max_attack_compression_diff_db = INT32_MIN;
+
+#if CONFIG_DRC_GAIN_TABLE
+	rfree(state->gain_table);
+	state->gain_table = NULL;
+#endif
 }
 
 int drc_init_pre_delay_buffers(struct drc_state *state,
@@ -121,6 +126,46 @@ int drc_set_pre_delay_time(struct drc_state *state,
 	return 0;
 }
 
+#if CONFIG_DRC_GAIN_TABLE
+/* Input level of table point i, Q1.31 */
+static int32_t drc_gain_table_x(int i)
+{
+	int octave = i >> DRC_GAIN_TABLE_STEPS_LOG2;
+	int step = i & (DRC_GAIN_TABLE_STEPS - 1);
+	int64_t x = (int64_t)(DRC_GAIN_TABLE_STEPS + step) <<
+		(31 - DRC_GAIN_TABLE_OCTAVES - DRC_GAIN_TABLE_STEPS_LOG2 + octave);
+
+	return sat_int32(x);
+}
+
+int drc_init_gain_table(struct drc_state *state, const struct sof_drc_params *p)
+{
+	const int32_t linear_threshold =
+		sat_int32(Q_SHIFT_LEFT((int64_t)p->linear_threshold, 30, 31));
+	struct drc_gain_table *t;
+	int i;
+
+	/* The curve is computed if it starts below the table */
+	if (linear_threshold <= drc_gain_table_x(0))
+		return 0;
+
+	if (!state->gain_table) {
+		state->gain_table = rballoc(0, SOF_MEM_CAPS_RAM, sizeof(*state->gain_table));
+		if (!state->gain_table)
+			return -ENOMEM;
+	}
+
+	t = state->gain_table;
+	t->linear_threshold = linear_threshold;
+	for (i = 0; i < DRC_GAIN_TABLE_SIZE; i++) {
+		t->gain[i] = drc_volume_gain(p, drc_gain_table_x(i));
+		t->release[i] = drc_release_rate(p, t->gain[i]);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_DRC_GAIN_TABLE */
+
 static int drc_setup(struct drc_comp_data *cd, uint16_t channels, uint32_t rate)
 {
 	uint32_t sample_bytes = get_sample_bytes(cd->source_format);
@@ -135,7 +180,12 @@ static int drc_setup(struct drc_comp_data *cd, uint16_t channels, uint32_t rate)
 		return ret;
 
 	/* Set pre-dely time */
-	return drc_set_pre_delay_time(&cd->state, cd->config->params.pre_delay_time, rate);
+	ret = drc_set_pre_delay_time(&cd->state, cd->config->params.pre_delay_time, rate);
+	if (ret < 0)
+		return ret;
+
+	/* Sample the compression curve */
+	return drc_init_gain_table(&cd->state, &cd->config->params);
 }
 
 /*
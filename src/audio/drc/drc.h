@@ -39,6 +39,24 @@ struct comp_dev;
 #define SOF_DRC_CTRL_INDEX_ENABLE_SWITCH 0
 #define SOF_DRC_NUM_ELEMS_ENABLE_SWITCH 1
 
+#if CONFIG_DRC_GAIN_TABLE
+/* The gain curve table has DRC_GAIN_TABLE_STEPS points per octave of input
+ * level for DRC_GAIN_TABLE_OCTAVES octaves below full scale, plus a point at
+ * full scale. DRC_GAIN_TABLE_STEPS needs to be a 2^N number.
+ */
+#define DRC_GAIN_TABLE_STEPS_LOG2 3
+#define DRC_GAIN_TABLE_STEPS (1 << DRC_GAIN_TABLE_STEPS_LOG2)
+#define DRC_GAIN_TABLE_OCTAVES 20
+#define DRC_GAIN_TABLE_SIZE (DRC_GAIN_TABLE_OCTAVES * DRC_GAIN_TABLE_STEPS + 1)
+
+/* Compression curve sampled from sof_drc_params */
+struct drc_gain_table {
+	int32_t linear_threshold;            /* Q1.31 */
+	int32_t gain[DRC_GAIN_TABLE_SIZE];    /* Q2.30 */
+	int32_t release[DRC_GAIN_TABLE_SIZE]; /* Q12.20 */
+};
+#endif
+
 /* Stores the state of DRC */
 struct drc_state {
 	/* The detector_average is the target gain obtained by looking at the
@@ -64,6 +82,11 @@ struct drc_state {
 	int32_t processed; /* switch */
 
 	int32_t max_attack_compression_diff_db; /* Q8.24 */
+
+#if CONFIG_DRC_GAIN_TABLE
+	/* Gain curve table, NULL when the curve is computed */
+	struct drc_gain_table *gain_table;
+#endif
 };
 
 typedef void (*drc_func)(struct processing_module *mod,
@@ -8,6 +8,7 @@
 #define __SOF_AUDIO_DRC_DRC_ALGORITHM_H__
 
 #include <stdint.h>
+#include <sof/audio/format.h>
 #include <sof/platform.h>
 
 #include "drc_user.h"
@@ -24,6 +25,58 @@ int drc_set_pre_delay_time(struct drc_state *state,
 			   int32_t pre_delay_time,
 			   int32_t rate);
 
+/* drc compression curve functions */
+int32_t drc_volume_gain(const struct sof_drc_params *p, int32_t x);
+int32_t drc_release_rate(const struct sof_drc_params *p, int32_t gain);
+
+#if CONFIG_DRC_GAIN_TABLE
+int drc_init_gain_table(struct drc_state *state, const struct sof_drc_params *p);
+
+/* Interpolate table y at input level x (Q1.31). The x needs to be positive,
+ * levels below the table return the first point.
+ */
+static inline int32_t drc_gain_table_interp(const int32_t *y, int32_t x)
+{
+	const int frac_bits = 30 - DRC_GAIN_TABLE_STEPS_LOG2;
+	int shift = __builtin_clz(x) - 1;
+	int32_t frac;
+	int idx;
+
+	if (shift >= DRC_GAIN_TABLE_OCTAVES)
+		return y[0];
+
+	/* The normalized x is in [1.0, 2.0) in Q2.30, the octave is given by
+	 * the shift and the point in octave by the highest fraction bits.
+	 */
+	x <<= shift;
+	idx = (DRC_GAIN_TABLE_OCTAVES - 1 - shift) * DRC_GAIN_TABLE_STEPS +
+		((x >> frac_bits) & (DRC_GAIN_TABLE_STEPS - 1));
+	frac = x & ((1 << frac_bits) - 1);
+	return y[idx] + (int32_t)(((int64_t)(y[idx + 1] - y[idx]) * frac) >> frac_bits);
+}
+
+/* Table version of drc_volume_gain() */
+static inline int32_t drc_gain_table_gain(const struct drc_gain_table *t, int32_t x)
+{
+	if (x < t->linear_threshold)
+		return Q_CONVERT_FLOAT(1.0f, 30);
+
+	return drc_gain_table_interp(t->gain, x);
+}
+
+/* Table version of drc_release_rate(), x is the input level of the gain */
+static inline int32_t drc_gain_table_release(const struct drc_gain_table *t, int32_t x)
+{
+	return drc_gain_table_interp(t->release, x);
+}
+#else
+static inline int drc_init_gain_table(struct drc_state *state,
+				      const struct sof_drc_params *p)
+{
+	return 0;
+}
+#endif
+
 /* drc process functions */
 void drc_update_detector_average(struct drc_state *state,
 				 const struct sof_drc_params *p,
@@ -42,7 +42,7 @@ static int32_t knee_curveK(const struct sof_drc_params *p, int32_t x)
 
 /* Full compression curve with constant ratio after knee. Returns the ratio of
  * output and input signal. */
-static int32_t volume_gain(const struct sof_drc_params *p, int32_t x)
+int32_t drc_volume_gain(const struct sof_drc_params *p, int32_t x)
 {
 	const int32_t knee_threshold =
 		sat_int32(Q_SHIFT_LEFT((int64_t)p->knee_threshold, 24, 31));
@@ -76,6 +76,16 @@ static int32_t volume_gain(const struct sof_drc_params *p, int32_t x)
 	return y;
 }
 
+/* Release rate for gain at or below -2 dB. Returns the rate in Q12.20. */
+int32_t drc_release_rate(const struct sof_drc_params *p, int32_t gain)
+{
+	int32_t db_per_frame;
+
+	db_per_frame = Q_MULTSR_32X32((int64_t)drc_lin2db_fixed(Q_SHIFT_RND(gain, 30, 26)),
+				      p->sat_release_frames_inv_neg, 21, 30, 24); /* Q8.24 */
+	return sofm_db2lin_fixed(db_per_frame) - ONE_Q20;
+}
+
 /* Update detector_average from the last input division. */
 void drc_update_detector_average(struct drc_state *state,
 				 const struct sof_drc_params *p,
@@ -91,8 +101,10 @@ void drc_update_detector_average(struct drc_state *state,
 	int32_t gain;
 	int32_t gain_diff;
 	int is_release;
-	int32_t db_per_frame;
 	int32_t sat_release_rate;
+#if CONFIG_DRC_GAIN_TABLE
+	const struct drc_gain_table *table = state->gain_table;
+#endif
 
 	/* Calculate the start index of the last input division */
 	if (state->pre_delay_write_index == 0) {
@@ -134,7 +146,12 @@ void drc_update_detector_average(struct drc_state *state,
 		 * derivative matched). The transition from the knee to the
 		 * ratio portion is smooth (1st derivative matched).
 		 */
-		gain = volume_gain(p, abs_input_array[i]); /* Q2.30 */
+#if CONFIG_DRC_GAIN_TABLE
+		if (table)
+			gain = drc_gain_table_gain(table, abs_input_array[i]);
+		else
+#endif
+			gain = drc_volume_gain(p, abs_input_array[i]); /* Q2.30 */
 		gain_diff = gain - detector_average; /* Q2.30 */
 		is_release = (gain_diff > 0);
 		if (is_release) {
@@ -144,14 +161,14 @@ void drc_update_detector_average(struct drc_state *state,
 						       p->sat_release_rate_at_neg_two_db,
 						       30, 30, 30);
 			} else {
-				db_per_frame =
-					Q_MULTSR_32X32((int64_t)drc_lin2db_fixed(Q_SHIFT_RND(gain,
-											     30,
-											     26)),
-						       p->sat_release_frames_inv_neg,
-						       21, 30, 24); /* Q8.24 */
-				sat_release_rate =
-					sofm_db2lin_fixed(db_per_frame) - ONE_Q20; /* Q12.20 */
+#if CONFIG_DRC_GAIN_TABLE
+				if (table)
+					sat_release_rate =
+						drc_gain_table_release(table, abs_input_array[i]);
+				else
+#endif
+					sat_release_rate =
+						drc_release_rate(p, gain); /* Q12.20 */
 				detector_average += Q_MULTSR_32X32((int64_t)gain_diff,
 								   sat_release_rate, 30, 20, 30);
 			}
@@ -51,7 +51,7 @@ static int32_t knee_curveK(const struct sof_drc_params *p, int32_t x)
 /* Full compression curve with constant ratio after knee. Returns the ratio of
  * output and input signal.
  */
-static int32_t volume_gain(const struct sof_drc_params *p, int32_t x)
+int32_t drc_volume_gain(const struct sof_drc_params *p, int32_t x)
 {
 	const ae_f32 knee_threshold = AE_SLAI32S(p->knee_threshold, 7); /* Q8.24 -> Q1.31 */
 	const ae_f32 linear_threshold = AE_SLAI32S(p->linear_threshold, 1); /* Q2.30 -> Q1.31 */
@@ -85,6 +85,17 @@ static int32_t volume_gain(const struct sof_drc_params *p, int32_t x)
 	return y;
 }
 
+/* Release rate for gain at or below -2 dB. Returns the rate in Q12.20. */
+int32_t drc_release_rate(const struct sof_drc_params *p, int32_t gain)
+{
+	ae_f32 db_per_frame; /* Q8.24 */
+
+	gain = AE_SRAI32R(gain, 4); /* Q2.30 -> Q6.26 */
+	db_per_frame = drc_mult_lshift(drc_lin2db_fixed(gain), p->sat_release_frames_inv_neg,
+				       drc_get_lshift(21, 30, 24));
+	return AE_SUB32(sofm_db2lin_fixed(db_per_frame), ONE_Q20);
+}
+
 /* Update detector_average from the last input division. */
 void drc_update_detector_average(struct drc_state *state,
 				 const struct sof_drc_params *p,
@@ -100,10 +111,12 @@ void drc_update_detector_average(struct drc_state *state,
 	int32_t sample;
 	ae_f32 gain;
 	ae_f32 gain_diff;
-	ae_f32 db_per_frame;
 	ae_f32 sat_release_rate;
 	ae_f32 tmp;
 	int is_release;
+#if CONFIG_DRC_GAIN_TABLE
+	const struct drc_gain_table *table = state->gain_table;
+#endif
 
 	/* Calculate the start index of the last input division */
 	if (state->pre_delay_write_index == 0)
@@ -147,7 +160,12 @@ void drc_update_detector_average(struct drc_state *state,
 		 * derivative matched). The transition from the knee to the
 		 * ratio portion is smooth (1st derivative matched).
 		 */
-		gain = volume_gain(p, abs_input_array[i]); /* Q2.30 */
+#if CONFIG_DRC_GAIN_TABLE
+		if (table)
+			gain = drc_gain_table_gain(table, abs_input_array[i]);
+		else
+#endif
+			gain = drc_volume_gain(p, abs_input_array[i]); /* Q2.30 */
 		gain_diff = AE_SUB32(gain, detector_average); /* Q2.30 */
 		is_release = ((int32_t)gain_diff > 0);
 		if (is_release) {
@@ -155,12 +173,13 @@ void drc_update_detector_average(struct drc_state *state,
 				tmp = drc_mult_lshift(gain_diff, p->sat_release_rate_at_neg_two_db,
 						      drc_get_lshift(30, 30, 30));
 			} else {
-				gain = AE_SRAI32R(gain, 4); /* Q2.30 -> Q6.26 */
-				db_per_frame = drc_mult_lshift(drc_lin2db_fixed(gain),
-							       p->sat_release_frames_inv_neg,
-							       drc_get_lshift(21, 30, 24));
-				sat_release_rate = AE_SUB32(sofm_db2lin_fixed(db_per_frame),
-							    ONE_Q20);
+#if CONFIG_DRC_GAIN_TABLE
+				if (table)
+					sat_release_rate =
+						drc_gain_table_release(table, abs_input_array[i]);
+				else
+#endif
+					sat_release_rate = drc_release_rate(p, gain);
 				tmp = drc_mult_lshift(gain_diff, sat_release_rate,
 						      drc_get_lshift(30, 20, 30));
 			}
@@ -74,6 +74,22 @@ static void eq_fir_free_delaylines(struct comp_data *cd)
 	cd->fir_delay_size = 0;
 	for (i = 0; i < PLATFORM_MAX_CHANNELS; i++)
 		fir[i].delay = NULL;
+
+#if CONFIG_MATH_FIR_FFT
+	for (i = 0; i < PLATFORM_MAX_CHANNELS; i++)
+		fir_fft_free(&cd->fft[i]);
+
+	cd->fft_mode = false;
+#endif
+}
+
+static bool eq_fir_active(struct comp_data *cd)
+{
+#if CONFIG_MATH_FIR_FFT
+	if (cd->fft_mode)
+		return true;
+#endif
+	return cd->fir_delay_size > 0;
 }
 
 static int eq_fir_init_coef(struct comp_dev *dev, struct sof_eq_fir_config *config,
@@ -165,6 +181,11 @@ static int eq_fir_init_coef(struct comp_dev *dev, struct sof_eq_fir_config *conf
 		s = fir_delay_size(eq);
 		if (s > 0) {
 			size_sum += s;
+#if CONFIG_MATH_FIR_FFT
+		} else if (!fir && eq->length > EQ_FIR_FFT_THRESHOLD &&
+			   fir_fft_length_valid(eq)) {
+			/* Long response, eq_fir_setup_fft() sets it up */
+#endif
 		} else {
 			comp_info(dev, "eq_fir_init_coef(), FIR length %d is invalid", eq->length);
 			return -EINVAL;
@@ -201,6 +222,74 @@ static void eq_fir_init_delay(struct fir_state_32x16 *fir,
 	}
 }
 
+#if CONFIG_MATH_FIR_FFT
+static struct sof_fir_coef_data *eq_fir_get_response(struct sof_eq_fir_config *config,
+						     int resp)
+{
+	int16_t *coef_data = ASSUME_ALIGNED(&config->data[config->channels_in_config], 4);
+	int j = 0;
+	int i;
+
+	for (i = 0; i < resp; i++)
+		j += SOF_FIR_COEF_NHEADER + coef_data[j];
+
+	return (struct sof_fir_coef_data *)&coef_data[j];
+}
+
+/* If any channel has a response longer than EQ_FIR_FFT_THRESHOLD all
+ * channels are run with partitioned FFT convolution. Returns 1 if this mode
+ * was set up, 0 if the direct form FIR should be used, or negative error
+ * code.
+ */
+static int eq_fir_setup_fft(struct comp_dev *dev, struct comp_data *cd, int nch)
+{
+	struct sof_eq_fir_config *config = cd->config;
+	int16_t *assign_response = ASSUME_ALIGNED(&config->data[0], 4);
+	int max_length = 0;
+	int resp = 0;
+	int ret;
+	int i;
+
+	/* Check the blob without touching the filters state */
+	ret = eq_fir_init_coef(dev, config, NULL, nch);
+	if (ret < 0)
+		return ret;
+
+	for (i = 0; i < nch; i++) {
+		if (i < config->channels_in_config)
+			resp = assign_response[i];
+
+		if (resp >= 0)
+			max_length = MAX(max_length, eq_fir_get_response(config, resp)->length);
+	}
+
+	if (max_length <= EQ_FIR_FFT_THRESHOLD)
+		return 0;
+
+	for (i = 0; i < nch; i++) {
+		if (i < config->channels_in_config)
+			resp = assign_response[i];
+
+		if (resp < 0) {
+			comp_info(dev, "eq_fir_setup_fft(), ch %d is set to bypass", i);
+			continue;
+		}
+
+		ret = fir_fft_init(&cd->fft[i], eq_fir_get_response(config, resp));
+		if (ret < 0) {
+			comp_err(dev, "eq_fir_setup_fft(), failed for ch %d", i);
+			eq_fir_free_delaylines(cd);
+			return ret;
+		}
+
+		comp_info(dev, "eq_fir_setup_fft(), ch %d is set to response = %d", i, resp);
+	}
+
+	cd->fft_mode = true;
+	return 1;
+}
+#endif
+
 static int eq_fir_setup(struct comp_dev *dev, struct comp_data *cd, int nch)
 {
 	int delay_size;
@@ -211,6 +300,12 @@ static int eq_fir_setup(struct comp_dev *dev, struct comp_data *cd, int nch)
 	/* Update number of channels */
 	cd->nch = nch;
 
+#if CONFIG_MATH_FIR_FFT
+	delay_size = eq_fir_setup_fft(dev, cd, nch);
+	if (delay_size)
+		return delay_size < 0 ? delay_size : 0;
+#endif
+
 	/* Set coefficients for each channel EQ from coefficient blob */
 	delay_size = eq_fir_init_coef(dev, cd->config, cd->fir, nch);
 	if (delay_size < 0)
@@ -367,7 +462,7 @@ static int eq_fir_process(struct processing_module *mod,
 		if (ret < 0) {
 			comp_err(mod->dev, "eq_fir_process(), failed FIR setup");
 			return ret;
-		} else if (cd->fir_delay_size) {
+		} else if (eq_fir_active(cd)) {
 			comp_dbg(mod->dev, "eq_fir_process(), active");
 			ret = set_fir_func(mod, audio_stream_get_frm_fmt(source));
 			if (ret < 0)
@@ -389,7 +484,14 @@ static int eq_fir_process(struct processing_module *mod,
 
 	frame_count &= ~0x1;
 	if (frame_count) {
-		cd->eq_fir_func(cd->fir, &input_buffers[0], &output_buffers[0], frame_count);
+#if CONFIG_MATH_FIR_FFT
+		if (cd->fft_mode)
+			cd->eq_fir_fft_func(cd->fft, &input_buffers[0], &output_buffers[0],
+					    frame_count);
+		else
+#endif
+			cd->eq_fir_func(cd->fir, &input_buffers[0], &output_buffers[0],
+					frame_count);
 		module_update_buffer_position(&input_buffers[0], &output_buffers[0], frame_count);
 	}
 
@@ -438,7 +540,7 @@ static int eq_fir_prepare(struct processing_module *mod,
 		ret = eq_fir_setup(dev, cd, channels);
 		if (ret < 0)
 			comp_err(dev, "eq_fir_prepare(): eq_fir_setup failed.");
-		else if (cd->fir_delay_size)
+		else if (eq_fir_active(cd))
 			ret = set_fir_func(mod, frame_fmt);
 		else
 			comp_dbg(dev, "eq_fir_prepare(): pass-through");
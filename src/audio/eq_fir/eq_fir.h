@@ -21,13 +21,20 @@
 #if FIR_HIFI3
 #include <sof/math/fir_hifi3.h>
 #endif
+#if CONFIG_MATH_FIR_FFT
+#include <sof/math/fir_fft.h>
+#endif
 #include <user/fir.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 /** \brief Macros to convert without division bytes count to samples count */
 #define EQ_FIR_BYTES_TO_S16_SAMPLES(b)	((b) >> 1)
 #define EQ_FIR_BYTES_TO_S32_SAMPLES(b)	((b) >> 2)
 
+/** \brief Responses longer than this are run with partitioned FFT convolution */
+#define EQ_FIR_FFT_THRESHOLD		SOF_FIR_MAX_LENGTH
+
 /* fir component private data */
 struct comp_data {
 	struct fir_state_32x16 fir[PLATFORM_MAX_CHANNELS]; /**< filters state */
@@ -40,6 +47,14 @@ struct comp_data {
 			    struct output_stream_buffer *bsink,
 			    int frames);
 	int nch;
+#if CONFIG_MATH_FIR_FFT
+	struct fir_fft_state fft[PLATFORM_MAX_CHANNELS]; /**< long filters state */
+	void (*eq_fir_fft_func)(struct fir_fft_state fft[],
+				struct input_stream_buffer *bsource,
+				struct output_stream_buffer *bsink,
+				int frames);
+	bool fft_mode;				/**< long filters are used */
+#endif
 };
 
 #if CONFIG_FORMAT_S16LE
@@ -48,6 +63,11 @@ void eq_fir_s16(struct fir_state_32x16 *fir, struct input_stream_buffer *bsource
 
 void eq_fir_2x_s16(struct fir_state_32x16 *fir, struct input_stream_buffer *bsource,
 		   struct output_stream_buffer *bsink, int frames);
+
+#if CONFIG_MATH_FIR_FFT
+void eq_fir_fft_s16(struct fir_fft_state fft[], struct input_stream_buffer *bsource,
+		    struct output_stream_buffer *bsink, int frames);
+#endif
 #endif /* CONFIG_FORMAT_S16LE */
 
 #if CONFIG_FORMAT_S24LE
@@ -56,6 +76,11 @@ void eq_fir_s24(struct fir_state_32x16 *fir, struct input_stream_buffer *bsource
 
 void eq_fir_2x_s24(struct fir_state_32x16 *fir, struct input_stream_buffer *bsource,
 		   struct output_stream_buffer *bsink, int frames);
+
+#if CONFIG_MATH_FIR_FFT
+void eq_fir_fft_s24(struct fir_fft_state fft[], struct input_stream_buffer *bsource,
+		    struct output_stream_buffer *bsink, int frames);
+#endif
 #endif /* CONFIG_FORMAT_S24LE */
 
 #if CONFIG_FORMAT_S32LE
@@ -64,6 +89,11 @@ void eq_fir_s32(struct fir_state_32x16 *fir, struct input_stream_buffer *bsource
 
 void eq_fir_2x_s32(struct fir_state_32x16 *fir, struct input_stream_buffer *bsource,
 		   struct output_stream_buffer *bsink, int frames);
+
+#if CONFIG_MATH_FIR_FFT
+void eq_fir_fft_s32(struct fir_fft_state fft[], struct input_stream_buffer *bsource,
+		    struct output_stream_buffer *bsink, int frames);
+#endif
 #endif /* CONFIG_FORMAT_S32LE */
 
 int set_fir_func(struct processing_module *mod, enum sof_ipc_frame fmt);
@@ -80,18 +110,27 @@ int eq_fir_params(struct processing_module *mod);
 static inline void set_s16_fir(struct comp_data *cd)
 {
 	cd->eq_fir_func = eq_fir_2x_s16;
+#if CONFIG_MATH_FIR_FFT
+	cd->eq_fir_fft_func = eq_fir_fft_s16;
+#endif
 }
 #endif /* CONFIG_FORMAT_S16LE */
 #if CONFIG_FORMAT_S24LE
 static inline void set_s24_fir(struct comp_data *cd)
 {
 	cd->eq_fir_func = eq_fir_2x_s24;
+#if CONFIG_MATH_FIR_FFT
+	cd->eq_fir_fft_func = eq_fir_fft_s24;
+#endif
 }
 #endif /* CONFIG_FORMAT_S24LE */
 #if CONFIG_FORMAT_S32LE
 static inline void set_s32_fir(struct comp_data *cd)
 {
 	cd->eq_fir_func = eq_fir_2x_s32;
+#if CONFIG_MATH_FIR_FFT
+	cd->eq_fir_fft_func = eq_fir_fft_s32;
+#endif
 }
 #endif /* CONFIG_FORMAT_S32LE */
 
@@ -101,18 +140,27 @@ static inline void set_s32_fir(struct comp_data *cd)
 static inline void set_s16_fir(struct comp_data *cd)
 {
 	cd->eq_fir_func = eq_fir_s16;
+#if CONFIG_MATH_FIR_FFT
+	cd->eq_fir_fft_func = eq_fir_fft_s16;
+#endif
 }
 #endif /* CONFIG_FORMAT_S16LE */
 #if CONFIG_FORMAT_S24LE
 static inline void set_s24_fir(struct comp_data *cd)
 {
 	cd->eq_fir_func = eq_fir_s24;
+#if CONFIG_MATH_FIR_FFT
+	cd->eq_fir_fft_func = eq_fir_fft_s24;
+#endif
 }
 #endif /* CONFIG_FORMAT_S24LE */
 #if CONFIG_FORMAT_S32LE
 static inline void set_s32_fir(struct comp_data *cd)
 {
 	cd->eq_fir_func = eq_fir_s32;
+#if CONFIG_MATH_FIR_FFT
+	cd->eq_fir_fft_func = eq_fir_fft_s32;
+#endif
 }
 #endif /* CONFIG_FORMAT_S32LE */
 #endif
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <sof/audio/module_adapter/module/generic.h>
+#include <sof/math/fir_fft.h>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "eq_fir.h"
+
+#if CONFIG_MATH_FIR_FFT
+
+LOG_MODULE_DECLARE(eq_fir, CONFIG_SOF_LOG_LEVEL);
+
+/* Process functions for responses that are longer than direct form FIR
+ * supports. The sample format conversions are the same as in
+ * eq_fir_generic.c.
+ */
+
+#if CONFIG_FORMAT_S16LE
+void eq_fir_fft_s16(struct fir_fft_state fft[], struct input_stream_buffer *bsource,
+		    struct output_stream_buffer *bsink, int frames)
+{
+	struct audio_stream *source = bsource->data;
+	struct audio_stream *sink = bsink->data;
+	struct fir_fft_state *filter;
+	int32_t z;
+	int16_t *x0, *y0;
+	int16_t *x = audio_stream_get_rptr(source);
+	int16_t *y = audio_stream_get_wptr(sink);
+	int nmax, n, i, j;
+	int nch = audio_stream_get_channels(source);
+	int remaining_samples = frames * nch;
+
+	while (remaining_samples) {
+		nmax = EQ_FIR_BYTES_TO_S16_SAMPLES(audio_stream_bytes_without_wrap(source, x));
+		n = MIN(remaining_samples, nmax);
+		nmax = EQ_FIR_BYTES_TO_S16_SAMPLES(audio_stream_bytes_without_wrap(sink, y));
+		n = MIN(n, nmax);
+		for (j = 0; j < nch; j++) {
+			x0 = x + j;
+			y0 = y + j;
+			filter = &fft[j];
+			for (i = 0; i < n; i += nch) {
+				z = fir_fft_32x16(filter, *x0 << 16);
+				*y0 = sat_int16(Q_SHIFT_RND(z, 31, 15));
+				x0 += nch;
+				y0 += nch;
+			}
+		}
+		remaining_samples -= n;
+		x = audio_stream_wrap(source, x + n);
+		y = audio_stream_wrap(sink, y + n);
+	}
+}
+#endif /* CONFIG_FORMAT_S16LE */
+
+#if CONFIG_FORMAT_S24LE
+void eq_fir_fft_s24(struct fir_fft_state fft[], struct input_stream_buffer *bsource,
+		    struct output_stream_buffer *bsink, int frames)
+{
+	struct audio_stream *source = bsource->data;
+	struct audio_stream *sink = bsink->data;
+	struct fir_fft_state *filter;
+	int32_t z;
+	int32_t *x0, *y0;
+	int32_t *x = audio_stream_get_rptr(source);
+	int32_t *y = audio_stream_get_wptr(sink);
+	int nmax, n, i, j;
+	int nch = audio_stream_get_channels(source);
+	int remaining_samples = frames * nch;
+
+	while (remaining_samples) {
+		nmax = EQ_FIR_BYTES_TO_S32_SAMPLES(audio_stream_bytes_without_wrap(source, x));
+		n = MIN(remaining_samples, nmax);
+		nmax = EQ_FIR_BYTES_TO_S32_SAMPLES(audio_stream_bytes_without_wrap(sink, y));
+		n = MIN(n, nmax);
+		for (j = 0; j < nch; j++) {
+			x0 = x + j;
+			y0 = y + j;
+			filter = &fft[j];
+			for (i = 0; i < n; i += nch) {
+				z = fir_fft_32x16(filter, *x0 << 8);
+				*y0 = sat_int24(Q_SHIFT_RND(z, 31, 23));
+				x0 += nch;
+				y0 += nch;
+			}
+		}
+		remaining_samples -= n;
+		x = audio_stream_wrap(source, x + n);
+		y = audio_stream_wrap(sink, y + n);
+	}
+}
+#endif /* CONFIG_FORMAT_S24LE */
+
+#if CONFIG_FORMAT_S32LE
+void eq_fir_fft_s32(struct fir_fft_state fft[], struct input_stream_buffer *bsource,
+		    struct output_stream_buffer *bsink, int frames)
+{
+	struct audio_stream *source = bsource->data;
+	struct audio_stream *sink = bsink->data;
+	struct fir_fft_state *filter;
+	int32_t *x0, *y0;
+	int32_t *x = audio_stream_get_rptr(source);
+	int32_t *y = audio_stream_get_wptr(sink);
+	int nmax, n, i, j;
+	int nch = audio_stream_get_channels(source);
+	int remaining_samples = frames * nch;
+
+	while (remaining_samples) {
+		nmax = EQ_FIR_BYTES_TO_S32_SAMPLES(audio_stream_bytes_without_wrap(source, x));
+		n = MIN(remaining_samples, nmax);
+		nmax = EQ_FIR_BYTES_TO_S32_SAMPLES(audio_stream_bytes_without_wrap(sink, y));
+		n = MIN(n, nmax);
+		for (j = 0; j < nch; j++) {
+			x0 = x + j;
+			y0 = y + j;
+			filter = &fft[j];
+			for (i = 0; i < n; i += nch) {
+				*y0 = fir_fft_32x16(filter, *x0);
+				x0 += nch;
+				y0 += nch;
+			}
+		}
+		remaining_samples -= n;
+		x = audio_stream_wrap(source, x + n);
+		y = audio_stream_wrap(sink, y + n);
+	}
+}
+#endif /* CONFIG_FORMAT_S32LE */
+
+#endif /* CONFIG_MATH_FIR_FFT */
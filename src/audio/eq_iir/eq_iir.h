@@ -14,6 +14,7 @@
 #include <sof/audio/module_adapter/module/generic.h>
 #include <sof/math/iir_df2t.h>
 #include <sof/math/iir_df1.h>
+#include <sof/math/iir_block.h>
 
 /** \brief Macros to convert without division bytes count to samples count */
 #define EQ_IIR_BYTES_TO_S16_SAMPLES(b)	((b) >> 1)
@@ -36,6 +37,8 @@ struct eq_iir_func_map {
 /* IIR component private data */
 struct comp_data {
 	struct iir_state_df1 iir[PLATFORM_MAX_CHANNELS]; /**< filters state */
+	struct iir_block_df1 block;		/**< all channels filters as block */
+	int32_t block_buf[PLATFORM_MAX_CHANNELS * IIR_BLOCK_FRAMES]; /**< block format conversion */
 	struct comp_data_blob_handler *model_handler;
 	struct sof_eq_iir_config *config;
 	int32_t *iir_delay;			/**< pointer to allocated RAM */
@@ -23,6 +23,7 @@
 #include <sof/lib/uuid.h>
 #include <sof/list.h>
 #include <sof/math/iir_df1.h>
+#include <sof/math/iir_block.h>
 #include <sof/platform.h>
 #include <rtos/string.h>
 #include <sof/ut.h>
@@ -39,6 +40,29 @@
 LOG_MODULE_DECLARE(eq_iir, CONFIG_SOF_LOG_LEVEL);
 
 #if CONFIG_FORMAT_S16LE
+/* Run the block filter for samples of all channels in chunks of conversion buffer */
+static void eq_iir_block_s16(struct comp_data *cd, const int16_t *x, int16_t *y, int samples)
+{
+	const int chunk = cd->block.channels * IIR_BLOCK_FRAMES;
+	int32_t *buf = cd->block_buf;
+	int m;
+	int i;
+
+	while (samples) {
+		m = MIN(samples, chunk);
+		for (i = 0; i < m; i++)
+			buf[i] = (int32_t)x[i] << 16;
+
+		iir_block_df1(&cd->block, buf, buf, m / cd->block.channels);
+		for (i = 0; i < m; i++)
+			y[i] = sat_int16(Q_SHIFT_RND(buf[i], 31, 15));
+
+		x += m;
+		y += m;
+		samples -= m;
+	}
+}
+
 void eq_iir_s16_default(struct processing_module *mod, struct input_stream_buffer *bsource,
 			struct output_stream_buffer *bsink, uint32_t frames)
 {
@@ -68,14 +92,18 @@ void eq_iir_s16_default(struct processing_module *mod, struct input_stream_buffe
 		n2 = audio_stream_bytes_without_wrap(sink, y) >> 1;
 		n = MIN(n1, n2);
 		n = MIN(n, nmax);
-		for (i = 0; i < nch; i++) {
-			x0 = x + i;
-			y0 = y + i;
-			filter = &cd->iir[i];
-			for (j = 0; j < n; j += nch) {
-				*y0 = iir_df1_s16(filter, *x0);
-				x0 += nch;
-				y0 += nch;
+		if (cd->block.biquads) {
+			eq_iir_block_s16(cd, x, y, n);
+		} else {
+			for (i = 0; i < nch; i++) {
+				x0 = x + i;
+				y0 = y + i;
+				filter = &cd->iir[i];
+				for (j = 0; j < n; j += nch) {
+					*y0 = iir_df1_s16(filter, *x0);
+					x0 += nch;
+					y0 += nch;
+				}
 			}
 		}
 		processed += n;
@@ -86,6 +114,27 @@ void eq_iir_s16_default(struct processing_module *mod, struct input_stream_buffe
 #endif /* CONFIG_FORMAT_S16LE */
 
 #if CONFIG_FORMAT_S24LE
+static void eq_iir_block_s24(struct comp_data *cd, const int32_t *x, int32_t *y, int samples)
+{
+	const int chunk = cd->block.channels * IIR_BLOCK_FRAMES;
+	int32_t *buf = cd->block_buf;
+	int m;
+	int i;
+
+	while (samples) {
+		m = MIN(samples, chunk);
+		for (i = 0; i < m; i++)
+			buf[i] = x[i] << 8;
+
+		iir_block_df1(&cd->block, buf, buf, m / cd->block.channels);
+		for (i = 0; i < m; i++)
+			y[i] = sat_int24(Q_SHIFT_RND(buf[i], 31, 23));
+
+		x += m;
+		y += m;
+		samples -= m;
+	}
+}
 
 void eq_iir_s24_default(struct processing_module *mod, struct input_stream_buffer *bsource,
 			struct output_stream_buffer *bsink, uint32_t frames)
@@ -116,14 +165,18 @@ void eq_iir_s24_default(struct processing_module *mod, struct input_stream_buffe
 		n2 = audio_stream_bytes_without_wrap(sink, y) >> 2;
 		n = MIN(n1, n2);
 		n = MIN(n, nmax);
-		for (i = 0; i < nch; i++) {
-			x0 = x + i;
-			y0 = y + i;
-			filter = &cd->iir[i];
-			for (j = 0; j < n; j += nch) {
-				*y0 = iir_df1_s24(filter, *x0);
-				x0 += nch;
-				y0 += nch;
+		if (cd->block.biquads) {
+			eq_iir_block_s24(cd, x, y, n);
+		} else {
+			for (i = 0; i < nch; i++) {
+				x0 = x + i;
+				y0 = y + i;
+				filter = &cd->iir[i];
+				for (j = 0; j < n; j += nch) {
+					*y0 = iir_df1_s24(filter, *x0);
+					x0 += nch;
+					y0 += nch;
+				}
 			}
 		}
 		processed += n;
@@ -164,14 +217,18 @@ void eq_iir_s32_default(struct processing_module *mod, struct input_stream_buffe
 		n2 = audio_stream_bytes_without_wrap(sink, y) >> 2;
 		n = MIN(n1, n2);
 		n = MIN(n, nmax);
-		for (i = 0; i < nch; i++) {
-			x0 = x + i;
-			y0 = y + i;
-			filter = &cd->iir[i];
-			for (j = 0; j < n; j += nch) {
-				*y0 = iir_df1(filter, *x0);
-				x0 += nch;
-				y0 += nch;
+		if (cd->block.biquads) {
+			iir_block_df1(&cd->block, x, y, n / nch);
+		} else {
+			for (i = 0; i < nch; i++) {
+				x0 = x + i;
+				y0 = y + i;
+				filter = &cd->iir[i];
+				for (j = 0; j < n; j += nch) {
+					*y0 = iir_df1(filter, *x0);
+					x0 += nch;
+					y0 += nch;
+				}
 			}
 		}
 		processed += n;
@@ -294,6 +351,7 @@ void eq_iir_free_delaylines(struct comp_data *cd)
 	/* Free the common buffer for all EQs and point then
 	 * each IIR channel delay line to NULL.
 	 */
+	iir_block_free_df1(&cd->block);
 	rfree(cd->iir_delay);
 	cd->iir_delay = NULL;
 	cd->iir_delay_size = 0;
@@ -314,6 +372,7 @@ int eq_iir_setup(struct processing_module *mod, int nch)
 {
 	struct comp_data *cd = module_get_private_data(mod);
 	int delay_size;
+	int ret;
 
 	/* Free existing IIR channels data if it was allocated */
 	eq_iir_free_delaylines(cd);
@@ -341,6 +400,14 @@ int eq_iir_setup(struct processing_module *mod, int nch)
 
 	/* Assign delay line to each channel EQ */
 	eq_iir_init_delay(cd->iir, cd->iir_delay, nch);
+
+	/* Process all channels with the block filter. The per channel
+	 * filters are used if the responses don't fit in a block.
+	 */
+	ret = iir_block_init_df1(&cd->block, cd->iir, nch);
+	if (ret < 0)
+		comp_warn(mod->dev, "eq_iir_setup(), block filter init fail %d", ret);
+
 	return 0;
 }
 
@@ -23,6 +23,7 @@
 #include <sof/lib/uuid.h>
 #include <sof/list.h>
 #include <sof/math/iir_df1.h>
+#include <sof/math/iir_block.h>
 #include <sof/platform.h>
 #include <rtos/string.h>
 #include <sof/ut.h>
@@ -39,6 +40,27 @@
 LOG_MODULE_DECLARE(eq_iir, CONFIG_SOF_LOG_LEVEL);
 
 #if CONFIG_FORMAT_S32LE && CONFIG_FORMAT_S16LE
+/* Run the block filter for samples of all channels in chunks of conversion buffer */
+static void eq_iir_block_s32_s16(struct comp_data *cd, const int32_t *x, int16_t *y,
+				 int samples)
+{
+	const int chunk = cd->block.channels * IIR_BLOCK_FRAMES;
+	int32_t *buf = cd->block_buf;
+	int m;
+	int i;
+
+	while (samples) {
+		m = MIN(samples, chunk);
+		iir_block_df1(&cd->block, x, buf, m / cd->block.channels);
+		for (i = 0; i < m; i++)
+			y[i] = sat_int16(Q_SHIFT_RND(buf[i], 31, 15));
+
+		x += m;
+		y += m;
+		samples -= m;
+	}
+}
+
 static void eq_iir_s32_16_default(struct processing_module *mod,
 				  struct input_stream_buffer *bsource,
 				  struct output_stream_buffer *bsink, uint32_t frames)
@@ -69,14 +91,18 @@ static void eq_iir_s32_16_default(struct processing_module *mod,
 		n2 = audio_stream_bytes_without_wrap(sink, y) >> 1; /* divide 2 */
 		n = MIN(n1, n2);
 		n = MIN(n, nmax);
-		for (i = 0; i < nch; i++) {
-			x0 = x + i;
-			y0 = y + i;
-			filter = &cd->iir[i];
-			for (j = 0; j < n; j += nch) {
-				*y0 = iir_df1_s32_s16(filter, *x0);
-				x0 += nch;
-				y0 += nch;
+		if (cd->block.biquads) {
+			eq_iir_block_s32_s16(cd, x, y, n);
+		} else {
+			for (i = 0; i < nch; i++) {
+				x0 = x + i;
+				y0 = y + i;
+				filter = &cd->iir[i];
+				for (j = 0; j < n; j += nch) {
+					*y0 = iir_df1_s32_s16(filter, *x0);
+					x0 += nch;
+					y0 += nch;
+				}
 			}
 		}
 		processed += n;
@@ -87,6 +113,26 @@ static void eq_iir_s32_16_default(struct processing_module *mod,
 #endif /* CONFIG_FORMAT_S32LE && CONFIG_FORMAT_S16LE */
 
 #if CONFIG_FORMAT_S32LE && CONFIG_FORMAT_S24LE
+static void eq_iir_block_s32_s24(struct comp_data *cd, const int32_t *x, int32_t *y,
+				 int samples)
+{
+	const int chunk = cd->block.channels * IIR_BLOCK_FRAMES;
+	int m;
+	int i;
+
+	/* The output is converted in place */
+	while (samples) {
+		m = MIN(samples, chunk);
+		iir_block_df1(&cd->block, x, y, m / cd->block.channels);
+		for (i = 0; i < m; i++)
+			y[i] = sat_int24(Q_SHIFT_RND(y[i], 31, 23));
+
+		x += m;
+		y += m;
+		samples -= m;
+	}
+}
+
 static void eq_iir_s32_24_default(struct processing_module *mod,
 				  struct input_stream_buffer *bsource,
 				  struct output_stream_buffer *bsink, uint32_t frames)
@@ -117,14 +163,18 @@ static void eq_iir_s32_24_default(struct processing_module *mod,
 		n2 = audio_stream_bytes_without_wrap(sink, y) >> 2;
 		n = MIN(n1, n2);
 		n = MIN(n, nmax);
-		for (i = 0; i < nch; i++) {
-			x0 = x + i;
-			y0 = y + i;
-			filter = &cd->iir[i];
-			for (j = 0; j < n; j += nch) {
-				*y0 = iir_df1_s32_s24(filter, *x0);
-				x0 += nch;
-				y0 += nch;
+		if (cd->block.biquads) {
+			eq_iir_block_s32_s24(cd, x, y, n);
+		} else {
+			for (i = 0; i < nch; i++) {
+				x0 = x + i;
+				y0 = y + i;
+				filter = &cd->iir[i];
+				for (j = 0; j < n; j += nch) {
+					*y0 = iir_df1_s32_s24(filter, *x0);
+					x0 += nch;
+					y0 += nch;
+				}
 			}
 		}
 		processed += n;
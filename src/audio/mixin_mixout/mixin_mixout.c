@@ -62,6 +62,11 @@ DECLARE_TR_CTX(mixout_tr, SOF_UUID(mixout_uuid), LOG_LEVEL_INFO);
  *
  * Such implementation has less buffer reads/writes than simple implementation
  * using intermediate buffer between mixin and mixout.
+ *
+ * With CONFIG_COMP_MIXOUT_SINGLE_PASS the mixins that have a single sink and
+ * run on the same core as their mixout do nothing in mixin_process(). The
+ * mixout reads the source data of all such mixins in mixout_process() and
+ * mixes them in one pass, so the mixout sink buffer is written only once.
  */
 
 struct mixin_sink_config {
@@ -111,6 +116,9 @@ struct mixout_data {
 	 */
 	struct cir_buf_ptr acquired_buf;
 	uint32_t acquired_buf_free_frames;
+
+	/* single pass processing function for the mixins mixed in mixout_process() */
+	mix_n_func mix_n;
 };
 
 /* NULL is also a valid mixin argument: in such case the function returns first unused entry */
@@ -126,6 +134,29 @@ static struct pending_frames *get_mixin_pending_frames(struct mixout_data *mixou
 	return NULL;
 }
 
+/* Returns true if mixout reads the source data of the mixin and mixes it in
+ * mixout_process() instead of the mixin mixing it in mixin_process().
+ */
+static bool mixout_mixes_source(const struct processing_module *mixin_mod,
+				const struct comp_dev *mixout)
+{
+	return IS_ENABLED(CONFIG_COMP_MIXOUT_SINGLE_PASS) && mixin_mod->num_of_sinks == 1 &&
+	       mixin_mod->dev->ipc_config.core == mixout->ipc_config.core;
+}
+
+/* Returns the gain of the mixin sink that is connected to mixout with buffer */
+static uint16_t mixin_sink_gain(struct processing_module *mixin_mod,
+				const struct comp_buffer *buffer)
+{
+	struct mixin_data *mixin_data = module_get_private_data(mixin_mod);
+	uint32_t sink_index = IPC4_SRC_QUEUE_ID(buf_get_id(buffer));
+
+	if (sink_index >= MIXIN_MAX_SINKS)
+		return IPC4_MIXIN_UNITY_GAIN;
+
+	return mixin_data->sink_config[sink_index].gain;
+}
+
 static int mixin_init(struct processing_module *mod)
 {
 	struct module_data *mod_data = &mod->priv;
@@ -312,6 +343,10 @@ static int mixin_process(struct processing_module *mod,
 			continue;
 		}
 
+		/* the only mixout mixes the source data in mixout_process() */
+		if (mixout_mixes_source(mod, mixout))
+			return 0;
+
 		mixout_mod = comp_get_drvdata(mixout);
 		active_mixouts[i] = mixout_mod;
 		mixout_sink = mixout_mod->sinks[0];
@@ -455,15 +490,59 @@ static int mixin_process(struct processing_module *mod,
 	return 0;
 }
 
-/* mixout just commits its sink buffer with data already mixed by mixins */
+/* Mixes source data of the mixins that are not mixed in mixin_process() into mixout
+ * sink buffer in one pass and releases the mixed source data.
+ */
+static void mixout_mix_sources(struct processing_module *mod,
+			       struct sof_source **mix_sources, const uint16_t *gains,
+			       int mix_sources_count, uint32_t frames)
+{
+	struct mixout_data *md = module_get_private_data(mod);
+	struct sof_sink *sink = mod->sinks[0];
+	struct cir_buf_ptr source_ptr[MIXOUT_MAX_SOURCES];
+	uint32_t channel_count = sink_get_channels(sink);
+	size_t bytes = frames * sink_get_frame_bytes(sink);
+	size_t buf_size;
+	int i;
+
+	/* the buffer is not yet acquired if no mixin mixed data into it */
+	if (!md->acquired_buf.ptr) {
+		size_t free_bytes = sink_get_free_size(sink);
+
+		sink_get_buffer(sink, free_bytes, &md->acquired_buf.ptr,
+				&md->acquired_buf.buf_start, &buf_size);
+		md->acquired_buf.buf_end = (uint8_t *)md->acquired_buf.buf_start + buf_size;
+		md->acquired_buf_free_frames = free_bytes / sink_get_frame_bytes(sink);
+	}
+
+	for (i = 0; i < mix_sources_count; i++) {
+		source_get_data(mix_sources[i], bytes, (const void **)&source_ptr[i].ptr,
+				(const void **)&source_ptr[i].buf_start, &buf_size);
+		source_ptr[i].buf_end = (uint8_t *)source_ptr[i].buf_start + buf_size;
+	}
+
+	md->mix_n(&md->acquired_buf, md->mixed_frames * channel_count,
+		  source_ptr, gains, mix_sources_count, frames * channel_count);
+
+	for (i = 0; i < mix_sources_count; i++)
+		source_release_data(mix_sources[i], bytes);
+}
+
+/* mixout commits its sink buffer with data already mixed by mixins. The data of
+ * mixins that are not mixed in mixin_process() is mixed here first.
+ */
 static int mixout_process(struct processing_module *mod,
 			  struct sof_source **sources, int num_of_sources,
 			  struct sof_sink **sinks, int num_of_sinks)
 {
 	struct comp_dev *dev = mod->dev;
 	struct mixout_data *md;
+	struct sof_source *mix_sources[MIXOUT_MAX_SOURCES];
+	uint16_t gains[MIXOUT_MAX_SOURCES];
+	int mix_sources_count = 0;
 	uint32_t frames_to_produce = INT32_MAX;
 	uint32_t bytes_to_produce;
+	uint32_t free_frames;
 	struct pending_frames *pending_frames;
 	int i;
 
@@ -478,6 +557,7 @@ static int mixout_process(struct processing_module *mod,
 	for (i = 0; i < num_of_sources; i++) {
 		const struct audio_stream *source_stream;
 		struct comp_buffer *unused_in_between_buf;
+		struct processing_module *mixin_mod;
 		struct comp_dev *mixin;
 
 		/* WORKAROUND: since mixin is always connected to mixout, we can safely assume
@@ -495,11 +575,42 @@ static int mixout_process(struct processing_module *mod,
 		if (!pending_frames)
 			continue;
 
+		mixin_mod = comp_get_drvdata(mixin);
+		if (mixout_mixes_source(mixin_mod, dev)) {
+			uint32_t avail_frames;
+
+			/* like in mixin_process() a source without data does not
+			 * block mixing, it is mixed as silence
+			 */
+			if (mixin->state != COMP_STATE_ACTIVE)
+				continue;
+
+			avail_frames = source_get_data_frames_available(mixin_mod->sources[0]);
+			if (avail_frames) {
+				frames_to_produce = MIN(frames_to_produce, avail_frames);
+				gains[mix_sources_count] =
+					mixin_sink_gain(mixin_mod, unused_in_between_buf);
+				mix_sources[mix_sources_count++] = mixin_mod->sources[0];
+			}
+
+			continue;
+		}
+
 		if (mixin->state == COMP_STATE_ACTIVE || pending_frames->frames)
 			frames_to_produce = MIN(frames_to_produce, pending_frames->frames);
 	}
 
+	if (mix_sources_count) {
+		free_frames = md->acquired_buf.ptr ? md->acquired_buf_free_frames :
+			sink_get_free_frames(sinks[0]);
+		frames_to_produce = MIN(frames_to_produce, free_frames);
+	}
+
 	if (frames_to_produce > 0 && frames_to_produce < INT32_MAX) {
+		if (mix_sources_count)
+			mixout_mix_sources(mod, mix_sources, gains, mix_sources_count,
+					   frames_to_produce);
+
 		for (i = 0; i < num_of_sources; i++) {
 			const struct audio_stream *source_stream;
 			struct comp_buffer *unused_in_between_buf;
@@ -520,8 +631,9 @@ static int mixout_process(struct processing_module *mod,
 				pending_frames->frames = 0;
 		}
 
-		assert(md->mixed_frames >= frames_to_produce);
-		md->mixed_frames -= frames_to_produce;
+		/* the frames mixed in mixout_process() are not counted in mixed_frames */
+		assert(mix_sources_count || md->mixed_frames >= frames_to_produce);
+		md->mixed_frames -= MIN(md->mixed_frames, frames_to_produce);
 
 		bytes_to_produce = frames_to_produce * sink_get_frame_bytes(sinks[0]);
 	} else {
@@ -753,6 +865,14 @@ static int mixout_prepare(struct processing_module *mod,
 	md = module_get_private_data(mod);
 	md->mixed_frames = 0;
 
+	if (IS_ENABLED(CONFIG_COMP_MIXOUT_SINGLE_PASS)) {
+		md->mix_n = mixout_get_processing_function(sink_get_valid_fmt(sinks[0]));
+		if (!md->mix_n) {
+			comp_err(dev, "have not found the suitable processing function");
+			return -EINVAL;
+		}
+	}
+
 	for (i = 0; i < MIXOUT_MAX_SOURCES; i++)
 		md->pending_frames[i].frames = 0;
 
@@ -28,6 +28,7 @@
 #include <sof/audio/buffer.h>
 #include <sof/audio/component.h>
 #include <sof/audio/format.h>
+#include <sof/math/numbers.h>
 #include <sof/platform.h>
 #include <stddef.h>
 
@@ -117,12 +118,29 @@ typedef void (*mix_func)(struct cir_buf_ptr *sink, int32_t start_sample,
 			 const struct cir_buf_ptr *source,
 			 int32_t sample_count, uint16_t gain);
 
+/* Number of samples accumulated at a time in single pass mixing */
+#define MIX_N_BLOCK_SAMPLES 64
+
+/**
+ * \brief mixout single pass processing function interface
+ *
+ * Mixes sample_count samples of all sources into sink. The first mixed_samples
+ * samples of sink already contain data that is mixed with the sources, the rest
+ * of sink is overwritten. Each source is scaled by its gain from gains, as
+ * described in struct ipc4_mixer_mode_sink_config, unless the gain is unity.
+ * The samples are summed with a wide accumulator and saturated once.
+ */
+typedef void (*mix_n_func)(struct cir_buf_ptr *sink, int32_t mixed_samples,
+			   const struct cir_buf_ptr *sources, const uint16_t *gains,
+			   int32_t source_count, int32_t sample_count);
+
 /**
  * @brief mixin processing functions map.
  */
 struct mix_func_map {
 	uint16_t frame_fmt;	/* frame format */
 	mix_func func;		/* mixin processing function */
+	mix_n_func mix_n;	/* mixout single pass processing function */
 };
 
 extern const struct mix_func_map mix_func_map[];
@@ -144,4 +162,52 @@ static inline mix_func mixin_get_processing_function(int fmt)
 	return NULL;
 }
 
+/**
+ * \brief Retrievies mixout single pass processing function.
+ * \param[in] fmt  stream PCM frame format
+ */
+static inline mix_n_func mixout_get_processing_function(int fmt)
+{
+	int i;
+
+	for (i = 0; i < mix_count; i++) {
+		if (fmt == mix_func_map[i].frame_fmt)
+			return mix_func_map[i].mix_n;
+	}
+
+	return NULL;
+}
+
+/**
+ * \brief Wraps sink and source pointers of single pass mixing.
+ * \param[in] sink  sink buffer
+ * \param[in,out] dst  pointer to sink data
+ * \param[in] sources  source buffers
+ * \param[in,out] src  pointers to source data
+ * \param[in] source_count  number of sources
+ * \param[in] sample_bytes  size of one sample in bytes
+ * \param[in] samples  maximum number of samples to process
+ * \return number of samples that can be processed without wrapping any buffer
+ */
+static inline int32_t mix_n_wrap(const struct cir_buf_ptr *sink, void **dst,
+				 const struct cir_buf_ptr *sources, void **src,
+				 int32_t source_count, int32_t sample_bytes, int32_t samples)
+{
+	int32_t n = samples;
+	int32_t nmax;
+	int i;
+
+	*dst = cir_buf_wrap(*dst, sink->buf_start, sink->buf_end);
+	nmax = ((uint8_t *)sink->buf_end - (uint8_t *)*dst) / sample_bytes;
+	n = MIN(n, nmax);
+
+	for (i = 0; i < source_count; i++) {
+		src[i] = cir_buf_wrap(src[i], sources[i].buf_start, sources[i].buf_end);
+		nmax = ((uint8_t *)sources[i].buf_end - (uint8_t *)src[i]) / sample_bytes;
+		n = MIN(n, nmax);
+	}
+
+	return n;
+}
+
 #endif	/* __SOF_IPC4_MIXIN_MIXOUT_H__ */
@@ -54,6 +54,53 @@ static void mix_s16(struct cir_buf_ptr *sink, int32_t start_sample, int32_t mixe
 		src += n;
 	}
 }
+
+/* The single pass mixing converts blocks of samples. The samples already in the
+ * sink buffer initialize the accumulator and every source is added in a loop
+ * over the block that the compiler can vectorize. The sum is saturated once.
+ */
+static void mix_n_s16(struct cir_buf_ptr *sink, int32_t mixed_samples,
+		      const struct cir_buf_ptr *sources, const uint16_t *gains,
+		      int32_t source_count, int32_t sample_count)
+{
+	void *src[IPC4_MIXOUT_MODULE_MAX_INPUT_QUEUES];
+	void *dst = sink->ptr;
+	int32_t acc[MIX_N_BLOCK_SAMPLES];
+	int32_t left_samples, n, m, i, j;
+	const int16_t *in;
+	int16_t *out;
+
+	for (j = 0; j < source_count; j++)
+		src[j] = sources[j].ptr;
+
+	for (left_samples = sample_count; left_samples > 0; left_samples -= n) {
+		n = mix_n_wrap(sink, &dst, sources, src, source_count, sizeof(int16_t),
+			       MIN(left_samples, MIX_N_BLOCK_SAMPLES));
+		out = dst;
+		m = MAX(MIN(n, mixed_samples), 0);
+		mixed_samples -= n;
+		for (i = 0; i < m; i++)
+			acc[i] = out[i];
+		for (; i < n; i++)
+			acc[i] = 0;
+
+		for (j = 0; j < source_count; j++) {
+			in = src[j];
+			if (gains[j] == IPC4_MIXIN_UNITY_GAIN) {
+				for (i = 0; i < n; i++)
+					acc[i] += in[i];
+			} else {
+				for (i = 0; i < n; i++)
+					acc[i] += (in[i] * gains[j]) >> IPC4_MIXIN_GAIN_SHIFT;
+			}
+			src[j] = (int16_t *)src[j] + n;
+		}
+
+		for (i = 0; i < n; i++)
+			out[i] = sat_int16(acc[i]);
+		dst = out + n;
+	}
+}
 #endif	/* CONFIG_FORMAT_S16LE */
 
 #if CONFIG_FORMAT_S24LE
@@ -99,6 +146,51 @@ static void mix_s24(struct cir_buf_ptr *sink, int32_t start_sample, int32_t mixe
 	}
 }
 
+static void mix_n_s24(struct cir_buf_ptr *sink, int32_t mixed_samples,
+		      const struct cir_buf_ptr *sources, const uint16_t *gains,
+		      int32_t source_count, int32_t sample_count)
+{
+	void *src[IPC4_MIXOUT_MODULE_MAX_INPUT_QUEUES];
+	void *dst = sink->ptr;
+	int32_t acc[MIX_N_BLOCK_SAMPLES];
+	int32_t left_samples, n, m, i, j;
+	const int32_t *in;
+	int32_t *out;
+
+	for (j = 0; j < source_count; j++)
+		src[j] = sources[j].ptr;
+
+	for (left_samples = sample_count; left_samples > 0; left_samples -= n) {
+		n = mix_n_wrap(sink, &dst, sources, src, source_count, sizeof(int32_t),
+			       MIN(left_samples, MIX_N_BLOCK_SAMPLES));
+		out = dst;
+		m = MAX(MIN(n, mixed_samples), 0);
+		mixed_samples -= n;
+		for (i = 0; i < m; i++)
+			acc[i] = sign_extend_s24(out[i]);
+		for (; i < n; i++)
+			acc[i] = 0;
+
+		/* Sum of up to 9 sign extended s24 samples fits to int32_t */
+		for (j = 0; j < source_count; j++) {
+			in = src[j];
+			if (gains[j] == IPC4_MIXIN_UNITY_GAIN) {
+				for (i = 0; i < n; i++)
+					acc[i] += sign_extend_s24(in[i]);
+			} else {
+				for (i = 0; i < n; i++)
+					acc[i] += ((int64_t)sign_extend_s24(in[i]) * gains[j]) >>
+						  IPC4_MIXIN_GAIN_SHIFT;
+			}
+			src[j] = (int32_t *)src[j] + n;
+		}
+
+		for (i = 0; i < n; i++)
+			out[i] = sat_int24(acc[i]);
+		dst = out + n;
+	}
+}
+
 #endif	/* CONFIG_FORMAT_S24LE */
 
 #if CONFIG_FORMAT_S32LE
@@ -143,17 +235,61 @@ static void mix_s32(struct cir_buf_ptr *sink, int32_t start_sample, int32_t mixe
 	}
 }
 
+static void mix_n_s32(struct cir_buf_ptr *sink, int32_t mixed_samples,
+		      const struct cir_buf_ptr *sources, const uint16_t *gains,
+		      int32_t source_count, int32_t sample_count)
+{
+	void *src[IPC4_MIXOUT_MODULE_MAX_INPUT_QUEUES];
+	void *dst = sink->ptr;
+	int64_t acc[MIX_N_BLOCK_SAMPLES];
+	int32_t left_samples, n, m, i, j;
+	const int32_t *in;
+	int32_t *out;
+
+	for (j = 0; j < source_count; j++)
+		src[j] = sources[j].ptr;
+
+	for (left_samples = sample_count; left_samples > 0; left_samples -= n) {
+		n = mix_n_wrap(sink, &dst, sources, src, source_count, sizeof(int32_t),
+			       MIN(left_samples, MIX_N_BLOCK_SAMPLES));
+		out = dst;
+		m = MAX(MIN(n, mixed_samples), 0);
+		mixed_samples -= n;
+		for (i = 0; i < m; i++)
+			acc[i] = out[i];
+		for (; i < n; i++)
+			acc[i] = 0;
+
+		for (j = 0; j < source_count; j++) {
+			in = src[j];
+			if (gains[j] == IPC4_MIXIN_UNITY_GAIN) {
+				for (i = 0; i < n; i++)
+					acc[i] += in[i];
+			} else {
+				for (i = 0; i < n; i++)
+					acc[i] += ((int64_t)in[i] * gains[j]) >>
+						  IPC4_MIXIN_GAIN_SHIFT;
+			}
+			src[j] = (int32_t *)src[j] + n;
+		}
+
+		for (i = 0; i < n; i++)
+			out[i] = sat_int32(acc[i]);
+		dst = out + n;
+	}
+}
+
 #endif	/* CONFIG_FORMAT_S32LE */
 
 const struct mix_func_map mix_func_map[] = {
 #if CONFIG_FORMAT_S16LE
-	{ SOF_IPC_FRAME_S16_LE, mix_s16 },
+	{ SOF_IPC_FRAME_S16_LE, mix_s16, mix_n_s16 },
 #endif
 #if CONFIG_FORMAT_S24LE
-	{ SOF_IPC_FRAME_S24_4LE, mix_s24 },
+	{ SOF_IPC_FRAME_S24_4LE, mix_s24, mix_n_s24 },
 #endif
 #if CONFIG_FORMAT_S32LE
-	{ SOF_IPC_FRAME_S32_LE, mix_s32 }
+	{ SOF_IPC_FRAME_S32_LE, mix_s32, mix_n_s32 }
 #endif
 };
 
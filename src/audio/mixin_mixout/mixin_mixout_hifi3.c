@@ -97,6 +97,84 @@ static void mix_s16(struct cir_buf_ptr *sink, int32_t start_sample, int32_t mixe
 		}
 	}
 }
+
+/* The single pass mixing accumulates blocks of samples. The samples already in
+ * the sink buffer initialize the accumulator, the sources are added without
+ * saturation and the sum is saturated once when it is stored to sink.
+ */
+static void mix_n_s16(struct cir_buf_ptr *sink, int32_t mixed_samples,
+		      const struct cir_buf_ptr *sources, const uint16_t *gains,
+		      int32_t source_count, int32_t sample_count)
+{
+	void *src[IPC4_MIXOUT_MODULE_MAX_INPUT_QUEUES];
+	void *dst = sink->ptr;
+	int32_t acc[MIX_N_BLOCK_SAMPLES] __aligned(8);
+	ae_int32x2 *acc_p;
+	ae_int32x2 acc_h, acc_l;
+	ae_int16x4 sample;
+	ae_int16x4 *in;
+	ae_int16x4 *out;
+	ae_valign inu;
+	ae_valign outu = AE_ZALIGN64();
+	int left_samples, n, m, i, j;
+
+	for (j = 0; j < source_count; j++)
+		src[j] = sources[j].ptr;
+
+	for (left_samples = sample_count; left_samples > 0; left_samples -= n) {
+		n = mix_n_wrap(sink, &dst, sources, src, source_count, sizeof(int16_t),
+			       AE_MIN_32_signed(left_samples, MIX_N_BLOCK_SAMPLES));
+		m = MAX(MIN(n, mixed_samples), 0);
+		mixed_samples -= n;
+		for (i = 0; i < m; i++)
+			acc[i] = ((int16_t *)dst)[i];
+		for (; i < n; i++)
+			acc[i] = 0;
+
+		for (j = 0; j < source_count; j++) {
+			/* attenuated sources are rare, they are scaled one by one */
+			if (gains[j] != IPC4_MIXIN_UNITY_GAIN) {
+				for (i = 0; i < n; i++)
+					acc[i] += (((int16_t *)src[j])[i] * gains[j]) >>
+						  IPC4_MIXIN_GAIN_SHIFT;
+				src[j] = (int16_t *)src[j] + n;
+				continue;
+			}
+
+			in = src[j];
+			inu = AE_LA64_PP(in);
+			acc_p = (ae_int32x2 *)acc;
+			/* process 4 samples per loop */
+			for (i = 0; i < n >> 2; i++) {
+				AE_LA16X4_IP(sample, inu, in);
+				acc_h = AE_ADD32(acc_p[0], AE_SEXT32X2D16_32(sample));
+				acc_l = AE_ADD32(acc_p[1], AE_SEXT32X2D16_10(sample));
+				AE_S32X2_IP(acc_h, acc_p, sizeof(ae_int32x2));
+				AE_S32X2_IP(acc_l, acc_p, sizeof(ae_int32x2));
+			}
+
+			/* add the left samples one by one to avoid memory access overrun */
+			for (i = n & ~3; i < n; i++)
+				acc[i] += ((int16_t *)src[j])[i];
+
+			src[j] = (int16_t *)src[j] + n;
+		}
+
+		out = dst;
+		acc_p = (ae_int32x2 *)acc;
+		for (i = 0; i < n >> 2; i++) {
+			AE_L32X2_IP(acc_h, acc_p, sizeof(ae_int32x2));
+			AE_L32X2_IP(acc_l, acc_p, sizeof(ae_int32x2));
+			AE_SA16X4_IP(AE_SAT16X4(acc_h, acc_l), outu, out);
+		}
+		AE_SA64POS_FP(outu, out);
+
+		for (i = n & ~3; i < n; i++)
+			((int16_t *)dst)[i] = sat_int16(acc[i]);
+
+		dst = (int16_t *)dst + n;
+	}
+}
 #endif	/* CONFIG_FORMAT_S16LE */
 
 #if CONFIG_FORMAT_S24LE
@@ -180,6 +258,79 @@ static void mix_s24(struct cir_buf_ptr *sink, int32_t start_sample, int32_t mixe
 	}
 }
 
+static void mix_n_s24(struct cir_buf_ptr *sink, int32_t mixed_samples,
+		      const struct cir_buf_ptr *sources, const uint16_t *gains,
+		      int32_t source_count, int32_t sample_count)
+{
+	void *src[IPC4_MIXOUT_MODULE_MAX_INPUT_QUEUES];
+	void *dst = sink->ptr;
+	int32_t acc[MIX_N_BLOCK_SAMPLES] __aligned(8);
+	ae_int32x2 *acc_p;
+	ae_int32x2 acc_s;
+	ae_int32x2 sample;
+	ae_int32x2 *in;
+	ae_int32x2 *out;
+	ae_valign inu;
+	ae_valign outu = AE_ZALIGN64();
+	int left_samples, n, m, i, j;
+
+	for (j = 0; j < source_count; j++)
+		src[j] = sources[j].ptr;
+
+	for (left_samples = sample_count; left_samples > 0; left_samples -= n) {
+		n = mix_n_wrap(sink, &dst, sources, src, source_count, sizeof(int32_t),
+			       AE_MIN_32_signed(left_samples, MIX_N_BLOCK_SAMPLES));
+		m = MAX(MIN(n, mixed_samples), 0);
+		mixed_samples -= n;
+		for (i = 0; i < m; i++)
+			acc[i] = sign_extend_s24(((int32_t *)dst)[i]);
+		for (; i < n; i++)
+			acc[i] = 0;
+
+		/* Sum of up to 9 sign extended s24 samples fits to 32 bits */
+		for (j = 0; j < source_count; j++) {
+			if (gains[j] != IPC4_MIXIN_UNITY_GAIN) {
+				in = src[j];
+				for (i = 0; i < n; i++)
+					acc[i] += ((int64_t)sign_extend_s24(((int32_t *)in)[i]) *
+						   gains[j]) >> IPC4_MIXIN_GAIN_SHIFT;
+				src[j] = (int32_t *)src[j] + n;
+				continue;
+			}
+
+			in = src[j];
+			inu = AE_LA64_PP(in);
+			acc_p = (ae_int32x2 *)acc;
+			/* process 2 samples per loop */
+			for (i = 0; i < n >> 1; i++) {
+				AE_LA32X2_IP(sample, inu, in);
+				sample = AE_SRAI32(AE_SLAI32(sample, 8), 8);
+				acc_s = AE_ADD32(acc_p[0], sample);
+				AE_S32X2_IP(acc_s, acc_p, sizeof(ae_int32x2));
+			}
+
+			/* add the left sample to avoid memory access overrun */
+			if (n & 1)
+				acc[n - 1] += sign_extend_s24(((int32_t *)src[j])[n - 1]);
+
+			src[j] = (int32_t *)src[j] + n;
+		}
+
+		out = dst;
+		acc_p = (ae_int32x2 *)acc;
+		for (i = 0; i < n >> 1; i++) {
+			AE_L32X2_IP(acc_s, acc_p, sizeof(ae_int32x2));
+			AE_SA32X2_IP(AE_SRAI32(AE_SLAI32S(acc_s, 8), 8), outu, out);
+		}
+		AE_SA64POS_FP(outu, out);
+
+		if (n & 1)
+			((int32_t *)dst)[n - 1] = sat_int24(acc[n - 1]);
+
+		dst = (int32_t *)dst + n;
+	}
+}
+
 #endif	/* CONFIG_FORMAT_S24LE */
 
 #if CONFIG_FORMAT_S32LE
@@ -264,17 +415,97 @@ static void mix_s32(struct cir_buf_ptr *sink, int32_t start_sample, int32_t mixe
 	}
 }
 
+static void mix_n_s32(struct cir_buf_ptr *sink, int32_t mixed_samples,
+		      const struct cir_buf_ptr *sources, const uint16_t *gains,
+		      int32_t source_count, int32_t sample_count)
+{
+	void *src[IPC4_MIXOUT_MODULE_MAX_INPUT_QUEUES];
+	void *dst = sink->ptr;
+	int64_t acc[MIX_N_BLOCK_SAMPLES];
+	ae_int64 *acc_p;
+	ae_int64 acc_h, acc_l;
+	ae_int32x2 sample;
+	ae_int32x2 *in;
+	ae_int32x2 *out;
+	ae_int32x2 one = AE_MOVDA32(1);
+	ae_valign inu;
+	ae_valign outu = AE_ZALIGN64();
+	int left_samples, n, m, i, j;
+
+	for (j = 0; j < source_count; j++)
+		src[j] = sources[j].ptr;
+
+	for (left_samples = sample_count; left_samples > 0; left_samples -= n) {
+		n = mix_n_wrap(sink, &dst, sources, src, source_count, sizeof(int32_t),
+			       AE_MIN_32_signed(left_samples, MIX_N_BLOCK_SAMPLES));
+		m = MAX(MIN(n, mixed_samples), 0);
+		mixed_samples -= n;
+		for (i = 0; i < m; i++)
+			acc[i] = ((int32_t *)dst)[i];
+		for (; i < n; i++)
+			acc[i] = 0;
+
+		for (j = 0; j < source_count; j++) {
+			if (gains[j] != IPC4_MIXIN_UNITY_GAIN) {
+				for (i = 0; i < n; i++)
+					acc[i] += ((int64_t)((int32_t *)src[j])[i] * gains[j]) >>
+						  IPC4_MIXIN_GAIN_SHIFT;
+				src[j] = (int32_t *)src[j] + n;
+				continue;
+			}
+
+			in = src[j];
+			inu = AE_LA64_PP(in);
+			acc_p = (ae_int64 *)acc;
+			/* process 2 samples per loop, the 32x32 bit MAC with one
+			 * sign extends the sample to the 64 bit accumulator
+			 */
+			for (i = 0; i < n >> 1; i++) {
+				AE_LA32X2_IP(sample, inu, in);
+				acc_h = acc_p[0];
+				acc_l = acc_p[1];
+				AE_MULA32_HH(acc_h, sample, one);
+				AE_MULA32_LL(acc_l, sample, one);
+				AE_S64_IP(acc_h, acc_p, sizeof(ae_int64));
+				AE_S64_IP(acc_l, acc_p, sizeof(ae_int64));
+			}
+
+			/* add the left sample to avoid memory access overrun */
+			if (n & 1)
+				acc[n - 1] += ((int32_t *)src[j])[n - 1];
+
+			src[j] = (int32_t *)src[j] + n;
+		}
+
+		/* saturating shift to Q1.63 and exact rounding to Q1.31 */
+		out = dst;
+		acc_p = (ae_int64 *)acc;
+		for (i = 0; i < n >> 1; i++) {
+			AE_L64_IP(acc_h, acc_p, sizeof(ae_int64));
+			AE_L64_IP(acc_l, acc_p, sizeof(ae_int64));
+			sample = AE_ROUND32X2F64SSYM(AE_SLAI64S(acc_h, 32), AE_SLAI64S(acc_l, 32));
+			AE_SA32X2_IP(sample, outu, out);
+		}
+		AE_SA64POS_FP(outu, out);
+
+		if (n & 1)
+			((int32_t *)dst)[n - 1] = sat_int32(acc[n - 1]);
+
+		dst = (int32_t *)dst + n;
+	}
+}
+
 #endif	/* CONFIG_FORMAT_S32LE */
 
 const struct mix_func_map mix_func_map[] = {
 #if CONFIG_FORMAT_S16LE
-	{ SOF_IPC_FRAME_S16_LE, mix_s16 },
+	{ SOF_IPC_FRAME_S16_LE, mix_s16, mix_n_s16 },
 #endif
 #if CONFIG_FORMAT_S24LE
-	{ SOF_IPC_FRAME_S24_4LE, mix_s24 },
+	{ SOF_IPC_FRAME_S24_4LE, mix_s24, mix_n_s24 },
 #endif
 #if CONFIG_FORMAT_S32LE
-	{ SOF_IPC_FRAME_S32_LE, mix_s32 }
+	{ SOF_IPC_FRAME_S32_LE, mix_s32, mix_n_s32 }
 #endif
 };
 
@@ -111,11 +111,11 @@ struct comp_dev *module_adapter_new(const struct comp_driver *drv,
 		goto err;
 	}
 
-#if CONFIG_ZEPHYR_DP_SCHEDULER
+#if CONFIG_DP_SCHEDULER
 	/* create a task for DP processing */
 	if (config->proc_domain == COMP_PROCESSING_DOMAIN_DP)
 		pipeline_comp_dp_task_init(dev);
-#endif /* CONFIG_ZEPHYR_DP_SCHEDULER */
+#endif /* CONFIG_DP_SCHEDULER */
 
 	module_adapter_reset_data(dst);
 
@@ -130,7 +130,7 @@ err:
 }
 EXPORT_SYMBOL(module_adapter_new);
 
-#if CONFIG_ZEPHYR_DP_SCHEDULER
+#if CONFIG_DP_SCHEDULER
 static int module_adapter_dp_queue_prepare(struct comp_dev *dev)
 {
 	int dp_mode = dev->is_shared ? DP_QUEUE_MODE_SHARED : DP_QUEUE_MODE_LOCAL;
@@ -276,7 +276,7 @@ static inline int module_adapter_dp_queue_prepare(struct comp_dev *dev)
 {
 	return -EINVAL;
 }
-#endif /* CONFIG_ZEPHYR_DP_SCHEDULER */
+#endif /* CONFIG_DP_SCHEDULER */
 
 /*
  * \brief Prepare the module
@@ -1019,7 +1019,7 @@ out:
 	return ret;
 }
 
-#if CONFIG_ZEPHYR_DP_SCHEDULER
+#if CONFIG_DP_SCHEDULER
 static int module_adapter_copy_dp_queues(struct comp_dev *dev)
 {
 	/*
@@ -1092,7 +1092,7 @@ static inline int module_adapter_copy_dp_queues(struct comp_dev *dev)
 {
 	return -ENOTSUP;
 }
-#endif /* CONFIG_ZEPHYR_DP_SCHEDULER */
+#endif /* CONFIG_DP_SCHEDULER */
 
 static int module_adapter_sink_source_copy(struct comp_dev *dev)
 {
@@ -1303,7 +1303,7 @@ int module_adapter_reset(struct comp_dev *dev)
 		mod->num_of_sources = 0;
 		mod->num_of_sinks = 0;
 	}
-#if CONFIG_ZEPHYR_DP_SCHEDULER
+#if CONFIG_DP_SCHEDULER
 	if (IS_PROCESSING_MODE_SINK_SOURCE(mod) &&
 	    mod->dev->ipc_config.proc_domain == COMP_PROCESSING_DOMAIN_DP) {
 		/* for DP processing - free DP Queues */
@@ -1324,7 +1324,7 @@ int module_adapter_reset(struct comp_dev *dev)
 			dp_queue_free(dp_queue);
 		}
 	}
-#endif /* CONFIG_ZEPHYR_DP_SCHEDULER */
+#endif /* CONFIG_DP_SCHEDULER */
 
 	mod->total_data_consumed = 0;
 	mod->total_data_produced = 0;
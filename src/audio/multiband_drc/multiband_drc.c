@@ -47,6 +47,11 @@ static void multiband_drc_reset_state(struct multiband_drc_state *state)
 {
 	int i;
 
+	/* Free the multi-channel block filters */
+	iir_block_free_df2t(&state->emphasis_block);
+	crossover_block_free(&state->crossover_block);
+	iir_block_free_df2t(&state->deemphasis_block);
+
 	/* Reset emphasis eq-iir state */
 	for (i = 0; i < PLATFORM_MAX_CHANNELS; i++)
 		multiband_drc_iir_reset_state_ch(&state->emphasis[i]);
@@ -169,6 +174,25 @@ static int multiband_drc_init_coef(struct processing_module *mod, int16_t nch, u
 		}
 	}
 
+	/* The EQs and crossover are run for all channels at once */
+	ret = iir_block_init_df2t(&state->emphasis_block, state->emphasis, nch);
+	if (ret < 0) {
+		comp_err(dev, "multiband_drc_init_coef(), could not init emphasis block filter");
+		goto err;
+	}
+
+	ret = crossover_block_init(&state->crossover_block, state->crossover, nch, num_bands);
+	if (ret < 0) {
+		comp_err(dev, "multiband_drc_init_coef(), could not init crossover block filters");
+		goto err;
+	}
+
+	ret = iir_block_init_df2t(&state->deemphasis_block, state->deemphasis, nch);
+	if (ret < 0) {
+		comp_err(dev, "multiband_drc_init_coef(), could not init deemphasis block filter");
+		goto err;
+	}
+
 	/* Allocate all DRC pre-delay buffers and set delay time with band number */
 	for (i = 0; i < num_bands; i++) {
 		comp_info(dev, "multiband_drc_init_coef(), initializing drc band %d", i);
@@ -186,6 +210,12 @@ static int multiband_drc_init_coef(struct processing_module *mod, int16_t nch, u
 			comp_err(dev, "multiband_drc_init_coef(), could not set pre delay time");
 			goto err;
 		}
+
+		ret = drc_init_gain_table(&state->drc[i], &cd->config->drc_coef[i]);
+		if (ret < 0) {
+			comp_err(dev, "multiband_drc_init_coef(), could not init gain table");
+			goto err;
+		}
 	}
 
 	return 0;
@@ -9,6 +9,7 @@
 
 #include <sof/audio/module_adapter/module/generic.h>
 #include <module/crossover/crossover_common.h>
+#include <sof/math/iir_block.h>
 #include <sof/math/iir_df2t.h>
 #include <sof/audio/component.h>
 #include <sof/audio/data_blob.h>
@@ -26,6 +27,9 @@ struct multiband_drc_state {
 	struct crossover_state crossover[PLATFORM_MAX_CHANNELS];
 	struct drc_state drc[SOF_MULTIBAND_DRC_MAX_BANDS];
 	struct iir_state_df2t deemphasis[PLATFORM_MAX_CHANNELS];
+	struct iir_block_df2t emphasis_block;
+	struct crossover_block crossover_block;
+	struct iir_block_df2t deemphasis_block;
 };
 
 typedef void (*multiband_drc_func)(const struct processing_module *mod,
@@ -6,7 +6,7 @@
 
 #include <stdint.h>
 #include <sof/audio/format.h>
-#include <sof/math/iir_df2t.h>
+#include <sof/math/iir_block.h>
 
 #include "multiband_drc.h"
 #include "../drc/drc_algorithm.h"
@@ -19,42 +19,6 @@ static void multiband_drc_default_pass(const struct processing_module *mod,
 	audio_stream_copy(source, 0, sink, 0, audio_stream_get_channels(source) * frames);
 }
 
-static void multiband_drc_process_emp_crossover(struct multiband_drc_state *state,
-						crossover_split split_func,
-						int32_t *buf_src,
-						int32_t *buf_sink,
-						int enable_emp,
-						int nch,
-						int nband)
-{
-	struct iir_state_df2t *emp_s;
-	struct crossover_state *crossover_s;
-	int32_t *buf_sink_band;
-	int ch, band;
-	int32_t emp_out;
-	int32_t crossover_out[nband];
-
-	for (ch = 0; ch < nch; ch++) {
-		emp_s = &state->emphasis[ch];
-		crossover_s = &state->crossover[ch];
-
-		if (enable_emp)
-			emp_out = iir_df2t(emp_s, *buf_src);
-		else
-			emp_out = *buf_src;
-
-		split_func(emp_out, crossover_out, crossover_s);
-		buf_sink_band = buf_sink;
-		for (band = 0; band < nband; band++) {
-			*buf_sink_band = crossover_out[band];
-			buf_sink_band += PLATFORM_MAX_CHANNELS;
-		}
-
-		buf_src++;
-		buf_sink++;
-	}
-}
-
 #if CONFIG_FORMAT_S16LE
 static void multiband_drc_s16_process_drc(struct drc_state *state,
 					  const struct sof_drc_params *p,
@@ -155,53 +119,67 @@ static void multiband_drc_s32_process_drc(struct drc_state *state,
 }
 #endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE */
 
-static void multiband_drc_process_deemp(struct multiband_drc_state *state,
+typedef void (*multiband_drc_band_func)(struct drc_state *state,
+					const struct sof_drc_params *p,
 					int32_t *buf_src,
 					int32_t *buf_sink,
-					int enable_deemp,
-					int nch,
-					int nband)
-{
-	struct iir_state_df2t *deemp_s;
-	int32_t *buf_src_band;
-	int ch, band;
-	int32_t mix_out;
-
-	for (ch = 0; ch < nch; ch++) {
-		deemp_s = &state->deemphasis[ch];
-
-		buf_src_band = buf_src;
-		mix_out = 0;
-		for (band = 0; band < nband; band++) {
-			mix_out = sat_int32((int64_t)mix_out + *buf_src_band);
-			buf_src_band += PLATFORM_MAX_CHANNELS;
-		}
+					int nch);
 
-		if (enable_deemp)
-			*buf_sink = iir_df2t(deemp_s, mix_out);
-		else
-			*buf_sink = mix_out;
-
-		buf_src++;
-		buf_sink++;
-	}
-}
-
- /* This graph illustrates the buffers declared in the following default functions, as the example
-  * of a 3-band Multiband DRC:
+ /* This graph illustrates the buffers of the crossover block used in the following default
+  * functions, as the example of a 3-band Multiband DRC:
   *
-  *            :buf_src[nch]                            :buf_drc_sink[nch*nband]
+  *            :in[nch*frames]                          :out[band][nch*frames]
   *            :                                        :
   *            :                           o-[]-> DRC0 -[]--o
-  *            :                           | :          :   |
-  *            :                 3-WAY     | :          :   |
+  *            :                           |            :   |
+  *            :                 3-WAY     |            :   |
   *    source -[]-> EQ EMP --> CROSSOVER --o-[]-> DRC1 -[]-(+)--> EQ DEEMP -[]-> sink
-  *                                        | :          :   |               :
-  *                                        | :          :   |               :
+  *                                        |            :   |               :
+  *                                        |            :   |               :
   *                                        o-[]-> DRC2 -[]--o               :
-  *                                          :                              :
-  *                                          :buf_drc_src[nch*nband]        :buf_sink[nch]
+  *                                                                         :
+  *                                                                         :out[0][nch*frames]
+  *
+  * The EQs and the crossover are run for all channels and frames at once. The DRC of
+  * each band is run frame by frame in place in the band buffer.
   */
+static inline void multiband_drc_process_block(struct multiband_drc_comp_data *cd,
+					       multiband_drc_band_func process_drc,
+					       int nch, int frames)
+{
+	struct multiband_drc_state *state = &cd->state;
+	struct crossover_block *block = &state->crossover_block;
+	int enable_emp_deemp = cd->config->enable_emp_deemp;
+	int nband = cd->config->num_bands;
+	int samples = frames * nch;
+	int32_t *buf;
+	int band;
+	int i;
+
+	if (enable_emp_deemp)
+		iir_block_df2t(&state->emphasis_block, block->in, block->in, frames);
+
+	cd->crossover_split(block, block->in, block->out, frames);
+
+	for (band = 0; band < nband; band++) {
+		buf = block->out[band];
+		for (i = 0; i < frames; i++) {
+			process_drc(&state->drc[band], &cd->config->drc_coef[band], buf, buf, nch);
+			buf += nch;
+		}
+	}
+
+	/* Mix the bands to the first band buffer */
+	for (band = 1; band < nband; band++) {
+		for (i = 0; i < samples; i++)
+			block->out[0][i] = sat_int32((int64_t)block->out[0][i] +
+						     block->out[band][i]);
+	}
+
+	if (enable_emp_deemp)
+		iir_block_df2t(&state->deemphasis_block, block->out[0], block->out[0], frames);
+}
+
 #if CONFIG_FORMAT_S16LE
 static void multiband_drc_s16_default(const struct processing_module *mod,
 				      const struct audio_stream *source,
@@ -209,23 +187,16 @@ static void multiband_drc_s16_default(const struct processing_module *mod,
 				      uint32_t frames)
 {
 	struct multiband_drc_comp_data *cd = module_get_private_data(mod);
-	struct multiband_drc_state *state = &cd->state;
-	int32_t buf_src[PLATFORM_MAX_CHANNELS];
-	int32_t buf_sink[PLATFORM_MAX_CHANNELS];
-	int32_t buf_drc_src[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
-	int32_t buf_drc_sink[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
-	int32_t *band_buf_drc_src;
-	int32_t *band_buf_drc_sink;
+	struct crossover_block *block = &cd->state.crossover_block;
 	int16_t *x = audio_stream_get_rptr(source);
 	int16_t *y = audio_stream_get_wptr(sink);
-	int band;
 	int nbuf;
 	int npcm;
-	int ch;
+	int n;
 	int i;
+	int j;
 	int nch = audio_stream_get_channels(source);
-	int nband = cd->config->num_bands;
-	int enable_emp_deemp = cd->config->enable_emp_deemp;
+	int chunk = nch * CROSSOVER_BLOCK_FRAMES;
 	int samples = frames * nch;
 
 	while (samples) {
@@ -233,34 +204,19 @@ static void multiband_drc_s16_default(const struct processing_module *mod,
 		npcm = MIN(samples, nbuf);
 		nbuf = audio_stream_samples_without_wrap_s16(sink, y);
 		npcm = MIN(npcm, nbuf);
-		for (i = 0; i < npcm; i += nch) {
-			for (ch = 0; ch < nch; ch++) {
-				buf_src[ch] = *x << 16;
-				x++;
-			}
-
-			multiband_drc_process_emp_crossover(state, cd->crossover_split,
-							    buf_src, buf_drc_src,
-							    enable_emp_deemp, nch, nband);
-
-			band_buf_drc_src = buf_drc_src;
-			band_buf_drc_sink = buf_drc_sink;
-			for (band = 0; band < nband; ++band) {
-				multiband_drc_s16_process_drc(&state->drc[band],
-							      &cd->config->drc_coef[band],
-							      band_buf_drc_src, band_buf_drc_sink,
-							      nch);
-				band_buf_drc_src += PLATFORM_MAX_CHANNELS;
-				band_buf_drc_sink += PLATFORM_MAX_CHANNELS;
-			}
-
-			multiband_drc_process_deemp(state, buf_drc_sink, buf_sink,
-						    enable_emp_deemp, nch, nband);
-
-			for (ch = 0; ch < nch; ch++) {
-				*y = sat_int16(Q_SHIFT_RND(buf_sink[ch], 31, 15));
-				y++;
-			}
+		for (i = 0; i < npcm; i += n) {
+			n = MIN(npcm - i, chunk);
+			for (j = 0; j < n; j++)
+				block->in[j] = x[j] << 16;
+
+			multiband_drc_process_block(cd, multiband_drc_s16_process_drc,
+						    nch, n / nch);
+
+			for (j = 0; j < n; j++)
+				y[j] = sat_int16(Q_SHIFT_RND(block->out[0][j], 31, 15));
+
+			x += n;
+			y += n;
 		}
 		samples -= npcm;
 		x = audio_stream_wrap(source, x);
@@ -276,23 +232,16 @@ static void multiband_drc_s24_default(const struct processing_module *mod,
 				      uint32_t frames)
 {
 	struct multiband_drc_comp_data *cd = module_get_private_data(mod);
-	struct multiband_drc_state *state = &cd->state;
-	int32_t buf_src[PLATFORM_MAX_CHANNELS];
-	int32_t buf_sink[PLATFORM_MAX_CHANNELS];
-	int32_t buf_drc_src[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
-	int32_t buf_drc_sink[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
-	int32_t *band_buf_drc_src;
-	int32_t *band_buf_drc_sink;
+	struct crossover_block *block = &cd->state.crossover_block;
 	int32_t *x = audio_stream_get_rptr(source);
 	int32_t *y = audio_stream_get_wptr(sink);
-	int band;
 	int nbuf;
 	int npcm;
-	int ch;
+	int n;
 	int i;
+	int j;
 	int nch = audio_stream_get_channels(source);
-	int nband = cd->config->num_bands;
-	int enable_emp_deemp = cd->config->enable_emp_deemp;
+	int chunk = nch * CROSSOVER_BLOCK_FRAMES;
 	int samples = frames * nch;
 
 	while (samples) {
@@ -300,34 +249,19 @@ static void multiband_drc_s24_default(const struct processing_module *mod,
 		npcm = MIN(samples, nbuf);
 		nbuf = audio_stream_samples_without_wrap_s24(sink, y);
 		npcm = MIN(npcm, nbuf);
-		for (i = 0; i < npcm; i += nch) {
-			for (ch = 0; ch < nch; ch++) {
-				buf_src[ch] = *x << 8;
-				x++;
-			}
-
-			multiband_drc_process_emp_crossover(state, cd->crossover_split,
-							    buf_src, buf_drc_src,
-							    enable_emp_deemp, nch, nband);
-
-			band_buf_drc_src = buf_drc_src;
-			band_buf_drc_sink = buf_drc_sink;
-			for (band = 0; band < nband; ++band) {
-				multiband_drc_s32_process_drc(&state->drc[band],
-							      &cd->config->drc_coef[band],
-							      band_buf_drc_src, band_buf_drc_sink,
-							      nch);
-				band_buf_drc_src += PLATFORM_MAX_CHANNELS;
-				band_buf_drc_sink += PLATFORM_MAX_CHANNELS;
-			}
-
-			multiband_drc_process_deemp(state, buf_drc_sink, buf_sink,
-						    enable_emp_deemp, nch, nband);
-
-			for (ch = 0; ch < nch; ch++) {
-				*y = sat_int24(Q_SHIFT_RND(buf_sink[ch], 31, 23));
-				y++;
-			}
+		for (i = 0; i < npcm; i += n) {
+			n = MIN(npcm - i, chunk);
+			for (j = 0; j < n; j++)
+				block->in[j] = x[j] << 8;
+
+			multiband_drc_process_block(cd, multiband_drc_s32_process_drc,
+						    nch, n / nch);
+
+			for (j = 0; j < n; j++)
+				y[j] = sat_int24(Q_SHIFT_RND(block->out[0][j], 31, 23));
+
+			x += n;
+			y += n;
 		}
 		samples -= npcm;
 		x = audio_stream_wrap(source, x);
@@ -343,23 +277,16 @@ static void multiband_drc_s32_default(const struct processing_module *mod,
 				      uint32_t frames)
 {
 	struct multiband_drc_comp_data *cd = module_get_private_data(mod);
-	struct multiband_drc_state *state = &cd->state;
-	int32_t buf_src[PLATFORM_MAX_CHANNELS];
-	int32_t buf_sink[PLATFORM_MAX_CHANNELS];
-	int32_t buf_drc_src[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
-	int32_t buf_drc_sink[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
-	int32_t *band_buf_drc_src;
-	int32_t *band_buf_drc_sink;
+	struct crossover_block *block = &cd->state.crossover_block;
 	int32_t *x = audio_stream_get_rptr(source);
 	int32_t *y = audio_stream_get_wptr(sink);
-	int band;
 	int nbuf;
 	int npcm;
-	int ch;
+	int n;
 	int i;
+	int j;
 	int nch = audio_stream_get_channels(source);
-	int nband = cd->config->num_bands;
-	int enable_emp_deemp = cd->config->enable_emp_deemp;
+	int chunk = nch * CROSSOVER_BLOCK_FRAMES;
 	int samples = frames * nch;
 
 	while (samples) {
@@ -367,34 +294,19 @@ static void multiband_drc_s32_default(const struct processing_module *mod,
 		npcm = MIN(samples, nbuf);
 		nbuf = audio_stream_samples_without_wrap_s32(sink, y);
 		npcm = MIN(npcm, nbuf);
-		for (i = 0; i < npcm; i += nch) {
-			for (ch = 0; ch < nch; ch++) {
-				buf_src[ch] = *x;
-				x++;
-			}
-
-			multiband_drc_process_emp_crossover(state, cd->crossover_split,
-							    buf_src, buf_drc_src,
-							    enable_emp_deemp, nch, nband);
-
-			band_buf_drc_src = buf_drc_src;
-			band_buf_drc_sink = buf_drc_sink;
-			for (band = 0; band < nband; ++band) {
-				multiband_drc_s32_process_drc(&state->drc[band],
-							      &cd->config->drc_coef[band],
-							      band_buf_drc_src, band_buf_drc_sink,
-							      nch);
-				band_buf_drc_src += PLATFORM_MAX_CHANNELS;
-				band_buf_drc_sink += PLATFORM_MAX_CHANNELS;
-			}
-
-			multiband_drc_process_deemp(state, buf_drc_sink, buf_sink,
-						    enable_emp_deemp, nch, nband);
-
-			for (ch = 0; ch < nch; ch++) {
-				*y = buf_sink[ch];
-				y++;
-			}
+		for (i = 0; i < npcm; i += n) {
+			n = MIN(npcm - i, chunk);
+			for (j = 0; j < n; j++)
+				block->in[j] = x[j];
+
+			multiband_drc_process_block(cd, multiband_drc_s32_process_drc,
+						    nch, n / nch);
+
+			for (j = 0; j < n; j++)
+				y[j] = block->out[0][j];
+
+			x += n;
+			y += n;
 		}
 		samples -= npcm;
 		x = audio_stream_wrap(source, x);
@@ -0,0 +1,383 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+/**
+ * \file audio/pcm_converter/pcm_converter_lin.c
+ * \brief PCM conversion kernels for linear memory regions
+ *
+ * The kernels are fed with the largest spans that don't wrap in the source
+ * and sink buffers by pcm_convert_as_linear() and pcm_convert_linear_spans().
+ * The host SIMD part converts the start of the span and the scalar loop
+ * converts the remaining samples.
+ *
+ * The kernels keep the channel order. The channel map that the copier sets
+ * in buffer->chmap for multi gateway DAIs is applied by the DAI that copies
+ * the channels one by one between the DMA buffer and the copier buffer, see
+ * dai_dma_multi_endpoint_cb(). Those copies are strided rather than linear,
+ * so the remap is not fused into these kernels.
+ */
+
+#include <sof/audio/format.h>
+#include <sof/audio/pcm_converter.h>
+#include <sof/common.h>
+#include <rtos/bit.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pcm_converter_lin_simd.h"
+
+void pcm_lin_s16_to_s24(const void *psrc, void *pdst, uint32_t samples)
+{
+	const int16_t *src = psrc;
+	int32_t *dst = pdst;
+	uint32_t i = 0;
+
+#if PCM_CONVERTER_LIN_SIMD
+	i = pcm_simd_s16_to_s32(src, dst, samples, 8);
+#endif
+	for (; i < samples; i++)
+		dst[i] = src[i] << 8;
+}
+
+void pcm_lin_s24_to_s16(const void *psrc, void *pdst, uint32_t samples)
+{
+	const int32_t *src = psrc;
+	int16_t *dst = pdst;
+	uint32_t i = 0;
+
+#if PCM_CONVERTER_LIN_SIMD
+	i = pcm_simd_s32_to_s16(src, dst, samples, 1);
+#endif
+	for (; i < samples; i++)
+		dst[i] = sat_int16(Q_SHIFT_RND(sign_extend_s24(src[i]), 23, 15));
+}
+
+void pcm_lin_s16_to_s32(const void *psrc, void *pdst, uint32_t samples)
+{
+	const int16_t *src = psrc;
+	int32_t *dst = pdst;
+	uint32_t i = 0;
+
+#if PCM_CONVERTER_LIN_SIMD
+	i = pcm_simd_s16_to_s32(src, dst, samples, 0);
+#endif
+	for (; i < samples; i++)
+		dst[i] = src[i] << 16;
+}
+
+void pcm_lin_s32_to_s16(const void *psrc, void *pdst, uint32_t samples)
+{
+	const int32_t *src = psrc;
+	int16_t *dst = pdst;
+	uint32_t i = 0;
+
+#if PCM_CONVERTER_LIN_SIMD
+	i = pcm_simd_s32_to_s16(src, dst, samples, 0);
+#endif
+	for (; i < samples; i++)
+		dst[i] = sat_int16(Q_SHIFT_RND(src[i], 31, 15));
+}
+
+void pcm_lin_s24_to_s32(const void *psrc, void *pdst, uint32_t samples)
+{
+	const int32_t *src = psrc;
+	int32_t *dst = pdst;
+	uint32_t i = 0;
+
+#if PCM_CONVERTER_LIN_SIMD
+	i = pcm_simd_s32_shl(src, dst, samples, 8);
+#endif
+	for (; i < samples; i++)
+		dst[i] = src[i] << 8;
+}
+
+void pcm_lin_s32_to_s24(const void *psrc, void *pdst, uint32_t samples)
+{
+	const int32_t *src = psrc;
+	int32_t *dst = pdst;
+	uint32_t i = 0;
+
+#if PCM_CONVERTER_LIN_SIMD
+	i = pcm_simd_s32_to_s24(src, dst, samples, 0);
+#endif
+	for (; i < samples; i++)
+		dst[i] = sat_int24(Q_SHIFT_RND(src[i], 31, 23));
+}
+
+void pcm_lin_s32_to_s24_be(const void *psrc, void *pdst, uint32_t samples)
+{
+	const int32_t *src = psrc;
+	int32_t *dst = pdst;
+	uint32_t i = 0;
+
+#if PCM_CONVERTER_LIN_SIMD
+	i = pcm_simd_s32_to_s24(src, dst, samples, 1);
+#endif
+	for (; i < samples; i++)
+		dst[i] = sat_int24(Q_SHIFT_RND(src[i], 31, 23)) << 8;
+}
+
+void pcm_lin_s16_c16_to_s16_c32(const void *psrc, void *pdst, uint32_t samples)
+{
+	const int16_t *src = psrc;
+	int32_t *dst = pdst;
+	uint32_t i = 0;
+
+#if PCM_CONVERTER_LIN_SIMD
+	i = pcm_simd_s16_to_s32(src, dst, samples, 16);
+#endif
+	for (; i < samples; i++)
+		dst[i] = src[i];
+}
+
+void pcm_lin_s16_c32_to_s16_c16(const void *psrc, void *pdst, uint32_t samples)
+{
+	const int32_t *src = psrc;
+	int16_t *dst = pdst;
+	uint32_t i = 0;
+
+#if PCM_CONVERTER_LIN_SIMD
+	i = pcm_simd_s16_c32_to_s16_c16(src, dst, samples);
+#endif
+	for (; i < samples; i++)
+		dst[i] = src[i] & 0xffff;
+}
+
+void pcm_lin_s16_c32_to_s32_c32(const void *psrc, void *pdst, uint32_t samples)
+{
+	const int32_t *src = psrc;
+	int32_t *dst = pdst;
+	uint32_t i = 0;
+
+#if PCM_CONVERTER_LIN_SIMD
+	i = pcm_simd_s32_shl(src, dst, samples, 16);
+#endif
+	for (; i < samples; i++)
+		dst[i] = src[i] << 16;
+}
+
+void pcm_lin_s32_c32_to_s16_c32(const void *psrc, void *pdst, uint32_t samples)
+{
+	const int32_t *src = psrc;
+	int32_t *dst = pdst;
+	uint32_t i = 0;
+
+#if PCM_CONVERTER_LIN_SIMD
+	i = pcm_simd_s32_to_s16_c32(src, dst, samples, 0);
+#endif
+	for (; i < samples; i++)
+		dst[i] = sat_int16(Q_SHIFT_RND(src[i], 31, 15));
+}
+
+void pcm_lin_s24_c32_to_s16_c32(const void *psrc, void *pdst, uint32_t samples)
+{
+	const int32_t *src = psrc;
+	int32_t *dst = pdst;
+	uint32_t i = 0;
+
+#if PCM_CONVERTER_LIN_SIMD
+	i = pcm_simd_s32_to_s16_c32(src, dst, samples, 1);
+#endif
+	for (; i < samples; i++)
+		dst[i] = sat_int16(Q_SHIFT_RND(sign_extend_s24(src[i] & 0xffffff), 23, 15));
+}
+
+void pcm_lin_attenuate_s32(int32_t *buf, uint32_t samples, uint32_t shift)
+{
+	uint32_t i = 0;
+
+#if PCM_CONVERTER_LIN_SIMD
+	i = pcm_simd_s32_sra(buf, samples, shift);
+#endif
+	for (; i < samples; i++)
+		buf[i] >>= shift;
+}
+
+#if CONFIG_PCM_CONVERTER_FORMAT_FLOAT
+/*
+ * IEEE 754 binary32 float format:
+ *
+ *   S|EEEEEEEE|MMMMMMMMMMMMMMMMMMMMMMM|
+ *  31|30    23|22                    0|
+ *
+ * S - sign bit
+ * E - exponent number, base 2
+ * M - mantissa, unsigned Q1.22 value where integer portion is always set
+ */
+
+/**
+ * shift d value left (for positive a) or right (for negative a)
+ * and take care about overflows
+ */
+static inline int32_t _pcm_shift(int32_t d, int32_t a)
+{
+	int64_t dd = d;
+
+	if (a > 32)
+		a = 32;
+	else if (a < -32)
+		a = -32;
+
+	dd = a >= 0 ? dd << a : dd >> -a;
+	if (dd > INT32_MAX)
+		dd = INT32_MAX;
+
+	return (int32_t)dd;
+}
+
+/**
+ * Calculate absolute value of s32 number without using code branching.
+ * XOR number with sign bit (stretched in 32 bits) (+1 for negative numbers)
+ */
+#define PCM_ABS32(x) (((x) ^ ((int32_t)(x) >> 31)) + ((uint32_t)(x) >> 31))
+
+/**
+ * \brief convert float number to fixed point
+ *
+ * Do not relay on compiler built-in float<=>int conversion in generic
+ * implementation, because "floating types float, double, and long double whose
+ * radix is not specified by the C standard but is usually two"
+ * ~https://gcc.gnu.org/onlinedocs/gcc/Decimal-Float.html
+ *
+ * \param src integer number to convert, it is int32_t to omit software float
+ *            operations library inclusion by compiler, when in whole topology
+ *            only external component needs float input.
+ * \param pow additional exponent component,
+ *            number of fractional bits in fixed point value.
+ *            Use '0' for normal conversion to integers
+ * \return (int32_t)src * 2**pow
+ */
+static int32_t _pcm_convert_f_to_i(int32_t src, int32_t pow)
+{
+	int32_t exponent, mantissa, dst;
+
+	exponent = (src >> 23);
+	exponent = (exponent & 0xFF) + pow - 127; /* exponential */
+	mantissa = BIT(23) | (MASK(22, 0) & src); /* mantisa + 1.0 [Q9.22] */
+	/* calculate power */
+	dst = _pcm_shift(mantissa, exponent - 23);
+	/* add 0.5 to round correctly but assert it doesn't lead to overflow */
+	if (exponent - 22 < 9 || (src & BIT(31)) == BIT(31))
+		dst += _pcm_shift(mantissa, exponent - 22) & 1;
+	/* copy sign to dst */
+	dst = (dst ^ (src >> 31)) + (int)((unsigned int)src >> 31);
+
+	return dst;
+}
+
+/**
+ * \brief convert fixed number to float
+ *
+ * Do not relay on compiler built-in float<=>int conversion in generic
+ * implementation, because "floating types float, double, and long double whose
+ * radix is not specified by the C standard but is usually two"
+ * ~https://gcc.gnu.org/onlinedocs/gcc/Decimal-Float.html
+ *
+ * \param src integer number to convert
+ * \param pow additional exponent component
+ *            number of fractional bits in fixed point value.
+ *            Use '0' for normal conversion to float
+ * \return (float)(src * 2**pow), return type is int32_t to omit software float
+ *          operations library inclusion by compiler, when in whole topology
+ *          only external component needs float input
+ */
+static int32_t _pcm_convert_i_to_f(int32_t src, int32_t pow)
+{
+	int sign, mantissa, exponent, dst, abs_clz;
+
+	if (src == 0)
+		return 0;
+
+	sign = src & BIT(31);
+	abs_clz = clz(PCM_ABS32(src));
+	exponent = (127 + 31 - abs_clz - pow) & 0xFF;
+	mantissa = PCM_ABS32(src);
+	mantissa = _pcm_shift(mantissa, 23 - 31 + abs_clz) & MASK(22, 0);
+	dst = sign | (exponent << 23) | mantissa;
+
+	return dst;
+}
+
+void pcm_lin_s16_to_f(const void *psrc, void *pdst, uint32_t samples)
+{
+	const int16_t *src = psrc;
+	int32_t *dst = pdst; /* float */
+	uint32_t i = 0;
+
+#if PCM_CONVERTER_LIN_SIMD
+	i = pcm_simd_s16_to_f(src, dst, samples);
+#endif
+	/* s16 is in format Q1.15 so during */
+	/* conversion subtract 15 from exponent */
+	for (; i < samples; i++)
+		dst[i] = _pcm_convert_i_to_f(src[i], 15);
+}
+
+void pcm_lin_f_to_s16(const void *psrc, void *pdst, uint32_t samples)
+{
+	const int32_t *src = psrc; /* float */
+	int16_t *dst = pdst;
+	uint32_t i;
+
+	/* s16 is in format Q1.15 so during */
+	/* conversion add 15 from exponent */
+	for (i = 0; i < samples; i++)
+		dst[i] = sat_int16(_pcm_convert_f_to_i(src[i], 15));
+}
+
+void pcm_lin_s24_to_f(const void *psrc, void *pdst, uint32_t samples)
+{
+	const int32_t *src = psrc;
+	int32_t *dst = pdst; /* float */
+	uint32_t i = 0;
+
+#if PCM_CONVERTER_LIN_SIMD
+	i = pcm_simd_s32_to_f(src, dst, samples, 23);
+#endif
+	/* s24 is in format Q1.23 so during */
+	/* conversion subtract 23 to exponent */
+	for (; i < samples; i++)
+		dst[i] = _pcm_convert_i_to_f(sign_extend_s24(src[i]), 23);
+}
+
+void pcm_lin_f_to_s24(const void *psrc, void *pdst, uint32_t samples)
+{
+	const int32_t *src = psrc; /* float */
+	int32_t *dst = pdst;
+	uint32_t i;
+
+	/* s24 is in format Q1.23 so during */
+	/* conversion add 23 to exponent */
+	for (i = 0; i < samples; i++)
+		dst[i] = sat_int24(_pcm_convert_f_to_i(src[i], 23));
+}
+
+/* The conversions with s32 and to fixed point round differently from the
+ * SIMD float instructions so they are scalar only.
+ */
+void pcm_lin_s32_to_f(const void *psrc, void *pdst, uint32_t samples)
+{
+	const int32_t *src = psrc;
+	int32_t *dst = pdst; /* float */
+	uint32_t i;
+
+	/* s32 is in format Q1.31 so during */
+	/* conversion subtract 31 to exponent */
+	for (i = 0; i < samples; i++)
+		dst[i] = _pcm_convert_i_to_f(src[i], 31);
+}
+
+void pcm_lin_f_to_s32(const void *psrc, void *pdst, uint32_t samples)
+{
+	const int32_t *src = psrc; /* float */
+	int32_t *dst = pdst;
+	uint32_t i;
+
+	/* s32 is in format Q1.31 so during */
+	/* conversion add 31 to exponent */
+	for (i = 0; i < samples; i++)
+		dst[i] = _pcm_convert_f_to_i(src[i], 31);
+}
+#endif /* CONFIG_PCM_CONVERTER_FORMAT_FLOAT */
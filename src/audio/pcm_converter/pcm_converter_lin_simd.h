@@ -0,0 +1,372 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2023 Intel Corporation. All rights reserved.
+ */
+
+/**
+ * \file audio/pcm_converter/pcm_converter_lin_simd.h
+ * \brief Host SIMD parts of the linear PCM conversion kernels
+ *
+ * Every function converts the largest multiple of the vector length from the
+ * start of the linear region and returns the number of converted samples.
+ * The caller converts the remaining samples with the scalar code. The
+ * results are bit exact with the scalar code.
+ */
+
+#ifndef __SOF_AUDIO_PCM_CONVERTER_LIN_SIMD_H__
+#define __SOF_AUDIO_PCM_CONVERTER_LIN_SIMD_H__
+
+#include <sof/audio/format.h>
+#include <stdint.h>
+
+/* Define PCM_CONVERTER_LIN_FORCEARCH 0 in build command line to use only the
+ * scalar code.
+ */
+#if defined PCM_CONVERTER_LIN_FORCEARCH && PCM_CONVERTER_LIN_FORCEARCH == 0
+#define PCM_CONVERTER_LIN_SSE2	0
+#define PCM_CONVERTER_LIN_NEON	0
+#elif defined __SSE2__ && defined __x86_64__
+#define PCM_CONVERTER_LIN_SSE2	1
+#define PCM_CONVERTER_LIN_NEON	0
+#elif defined __ARM_NEON
+#define PCM_CONVERTER_LIN_SSE2	0
+#define PCM_CONVERTER_LIN_NEON	1
+#else
+#define PCM_CONVERTER_LIN_SSE2	0
+#define PCM_CONVERTER_LIN_NEON	0
+#endif
+
+#define PCM_CONVERTER_LIN_SIMD	(PCM_CONVERTER_LIN_SSE2 || PCM_CONVERTER_LIN_NEON)
+
+#if PCM_CONVERTER_LIN_SSE2
+
+#include <emmintrin.h>
+
+/* Rounding shift right by shift + 1 as Q_SHIFT_RND() */
+#define PCM_SIMD_SHIFT_RND(x, shift) \
+	_mm_srai_epi32(_mm_add_epi32(_mm_srai_epi32(x, shift), _mm_set1_epi32(1)), 1)
+
+static inline __m128i pcm_simd_load(const int32_t *src)
+{
+	return _mm_loadu_si128((const __m128i *)src);
+}
+
+static inline void pcm_simd_store(int32_t *dst, __m128i v)
+{
+	_mm_storeu_si128((__m128i *)dst, v);
+}
+
+static inline uint32_t pcm_simd_s16_to_s32(const int16_t *src, int32_t *dst,
+					   uint32_t samples, int shift)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i v;
+	uint32_t i;
+
+	/* The 16 bit sample is placed to the high half and shifted back */
+	for (i = 0; i + 8 <= samples; i += 8) {
+		v = _mm_loadu_si128((const __m128i *)&src[i]);
+		pcm_simd_store(&dst[i], _mm_srai_epi32(_mm_unpacklo_epi16(zero, v), shift));
+		pcm_simd_store(&dst[i + 4], _mm_srai_epi32(_mm_unpackhi_epi16(zero, v), shift));
+	}
+
+	return i;
+}
+
+static inline uint32_t pcm_simd_s32_to_s16(const int32_t *src, int16_t *dst,
+					   uint32_t samples, int s24)
+{
+	__m128i a, b;
+	uint32_t i;
+
+	/* Round to 16 bits and saturate with the signed pack */
+	for (i = 0; i + 8 <= samples; i += 8) {
+		a = pcm_simd_load(&src[i]);
+		b = pcm_simd_load(&src[i + 4]);
+		if (s24) {
+			a = _mm_srai_epi32(_mm_slli_epi32(a, 8), 8);
+			b = _mm_srai_epi32(_mm_slli_epi32(b, 8), 8);
+			a = PCM_SIMD_SHIFT_RND(a, 7);
+			b = PCM_SIMD_SHIFT_RND(b, 7);
+		} else {
+			a = PCM_SIMD_SHIFT_RND(a, 15);
+			b = PCM_SIMD_SHIFT_RND(b, 15);
+		}
+		_mm_storeu_si128((__m128i *)&dst[i], _mm_packs_epi32(a, b));
+	}
+
+	return i;
+}
+
+static inline uint32_t pcm_simd_s32_to_s16_c32(const int32_t *src, int32_t *dst,
+					       uint32_t samples, int s24)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i a, b, p;
+	uint32_t i;
+
+	for (i = 0; i + 8 <= samples; i += 8) {
+		a = pcm_simd_load(&src[i]);
+		b = pcm_simd_load(&src[i + 4]);
+		if (s24) {
+			a = _mm_srai_epi32(_mm_slli_epi32(a, 8), 8);
+			b = _mm_srai_epi32(_mm_slli_epi32(b, 8), 8);
+			a = PCM_SIMD_SHIFT_RND(a, 7);
+			b = PCM_SIMD_SHIFT_RND(b, 7);
+		} else {
+			a = PCM_SIMD_SHIFT_RND(a, 15);
+			b = PCM_SIMD_SHIFT_RND(b, 15);
+		}
+		p = _mm_packs_epi32(a, b);
+		pcm_simd_store(&dst[i], _mm_srai_epi32(_mm_unpacklo_epi16(zero, p), 16));
+		pcm_simd_store(&dst[i + 4], _mm_srai_epi32(_mm_unpackhi_epi16(zero, p), 16));
+	}
+
+	return i;
+}
+
+static inline uint32_t pcm_simd_s16_c32_to_s16_c16(const int32_t *src, int16_t *dst,
+						   uint32_t samples)
+{
+	__m128i a, b;
+	uint32_t i;
+
+	/* Sign extend the low 16 bits so the pack doesn't saturate */
+	for (i = 0; i + 8 <= samples; i += 8) {
+		a = _mm_srai_epi32(_mm_slli_epi32(pcm_simd_load(&src[i]), 16), 16);
+		b = _mm_srai_epi32(_mm_slli_epi32(pcm_simd_load(&src[i + 4]), 16), 16);
+		_mm_storeu_si128((__m128i *)&dst[i], _mm_packs_epi32(a, b));
+	}
+
+	return i;
+}
+
+static inline uint32_t pcm_simd_s32_shl(const int32_t *src, int32_t *dst,
+					uint32_t samples, int shift)
+{
+	uint32_t i;
+
+	for (i = 0; i + 4 <= samples; i += 4)
+		pcm_simd_store(&dst[i], _mm_slli_epi32(pcm_simd_load(&src[i]), shift));
+
+	return i;
+}
+
+static inline uint32_t pcm_simd_s32_to_s24(const int32_t *src, int32_t *dst,
+					   uint32_t samples, int msb)
+{
+	const __m128i max = _mm_set1_epi32(INT24_MAXVALUE);
+	__m128i v, over;
+	uint32_t i;
+
+	/* Only the positive full scale can exceed 24 bits after rounding */
+	for (i = 0; i + 4 <= samples; i += 4) {
+		v = PCM_SIMD_SHIFT_RND(pcm_simd_load(&src[i]), 7);
+		over = _mm_cmpgt_epi32(v, max);
+		v = _mm_or_si128(_mm_andnot_si128(over, v), _mm_and_si128(over, max));
+		if (msb)
+			v = _mm_slli_epi32(v, 8);
+
+		pcm_simd_store(&dst[i], v);
+	}
+
+	return i;
+}
+
+static inline uint32_t pcm_simd_s32_sra(int32_t *buf, uint32_t samples, uint32_t shift)
+{
+	const __m128i count = _mm_cvtsi32_si128(shift);
+	uint32_t i;
+
+	for (i = 0; i + 4 <= samples; i += 4)
+		pcm_simd_store(&buf[i], _mm_sra_epi32(pcm_simd_load(&buf[i]), count));
+
+	return i;
+}
+
+#if CONFIG_PCM_CONVERTER_FORMAT_FLOAT
+static inline uint32_t pcm_simd_s32_to_f(const int32_t *src, int32_t *dst,
+					 uint32_t samples, int bits)
+{
+	const __m128 scale = _mm_set1_ps(1.0f / (float)(1 << bits));
+	__m128i v;
+	uint32_t i;
+
+	/* Exact for up to 24 bit data since it fits to the float mantissa */
+	for (i = 0; i + 4 <= samples; i += 4) {
+		v = pcm_simd_load(&src[i]);
+		if (bits == 23)
+			v = _mm_srai_epi32(_mm_slli_epi32(v, 8), 8);
+
+		_mm_storeu_ps((float *)&dst[i], _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+	}
+
+	return i;
+}
+
+static inline uint32_t pcm_simd_s16_to_f(const int16_t *src, int32_t *dst, uint32_t samples)
+{
+	const __m128 scale = _mm_set1_ps(1.0f / (1 << 15));
+	const __m128i zero = _mm_setzero_si128();
+	__m128i v;
+	uint32_t i;
+
+	for (i = 0; i + 8 <= samples; i += 8) {
+		v = _mm_loadu_si128((const __m128i *)&src[i]);
+		_mm_storeu_ps((float *)&dst[i],
+			      _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(zero, v),
+									16)), scale));
+		_mm_storeu_ps((float *)&dst[i + 4],
+			      _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(zero, v),
+									16)), scale));
+	}
+
+	return i;
+}
+#endif /* CONFIG_PCM_CONVERTER_FORMAT_FLOAT */
+
+#elif PCM_CONVERTER_LIN_NEON
+
+#include <arm_neon.h>
+
+static inline uint32_t pcm_simd_s16_to_s32(const int16_t *src, int32_t *dst,
+					   uint32_t samples, int shift)
+{
+	int16x8_t v;
+	uint32_t i;
+
+	for (i = 0; i + 8 <= samples; i += 8) {
+		v = vld1q_s16(&src[i]);
+		vst1q_s32(&dst[i], vshlq_s32(vshll_n_s16(vget_low_s16(v), 8),
+					     vdupq_n_s32(8 - shift)));
+		vst1q_s32(&dst[i + 4], vshlq_s32(vshll_n_s16(vget_high_s16(v), 8),
+						 vdupq_n_s32(8 - shift)));
+	}
+
+	return i;
+}
+
+static inline int16x4_t pcm_simd_round_s16(int32x4_t v, int s24)
+{
+	/* Rounding and saturating narrow is the same as Q_SHIFT_RND() and sat_int16() */
+	if (s24)
+		return vqrshrn_n_s32(vshrq_n_s32(vshlq_n_s32(v, 8), 8), 8);
+
+	return vqrshrn_n_s32(v, 16);
+}
+
+static inline uint32_t pcm_simd_s32_to_s16(const int32_t *src, int16_t *dst,
+					   uint32_t samples, int s24)
+{
+	uint32_t i;
+
+	for (i = 0; i + 8 <= samples; i += 8)
+		vst1q_s16(&dst[i], vcombine_s16(pcm_simd_round_s16(vld1q_s32(&src[i]), s24),
+						pcm_simd_round_s16(vld1q_s32(&src[i + 4]), s24)));
+
+	return i;
+}
+
+static inline uint32_t pcm_simd_s32_to_s16_c32(const int32_t *src, int32_t *dst,
+					       uint32_t samples, int s24)
+{
+	uint32_t i;
+
+	for (i = 0; i + 4 <= samples; i += 4)
+		vst1q_s32(&dst[i], vmovl_s16(pcm_simd_round_s16(vld1q_s32(&src[i]), s24)));
+
+	return i;
+}
+
+static inline uint32_t pcm_simd_s16_c32_to_s16_c16(const int32_t *src, int16_t *dst,
+						   uint32_t samples)
+{
+	uint32_t i;
+
+	for (i = 0; i + 4 <= samples; i += 4)
+		vst1_s16(&dst[i], vmovn_s32(vld1q_s32(&src[i])));
+
+	return i;
+}
+
+static inline uint32_t pcm_simd_s32_shl(const int32_t *src, int32_t *dst,
+					uint32_t samples, int shift)
+{
+	const int32x4_t count = vdupq_n_s32(shift);
+	uint32_t i;
+
+	for (i = 0; i + 4 <= samples; i += 4)
+		vst1q_s32(&dst[i], vshlq_s32(vld1q_s32(&src[i]), count));
+
+	return i;
+}
+
+static inline uint32_t pcm_simd_s32_to_s24(const int32_t *src, int32_t *dst,
+					   uint32_t samples, int msb)
+{
+	const int32x4_t max = vdupq_n_s32(INT24_MAXVALUE);
+	int32x4_t v;
+	uint32_t i;
+
+	for (i = 0; i + 4 <= samples; i += 4) {
+		v = vminq_s32(vrshrq_n_s32(vld1q_s32(&src[i]), 8), max);
+		if (msb)
+			v = vshlq_n_s32(v, 8);
+
+		vst1q_s32(&dst[i], v);
+	}
+
+	return i;
+}
+
+static inline uint32_t pcm_simd_s32_sra(int32_t *buf, uint32_t samples, uint32_t shift)
+{
+	const int32x4_t count = vdupq_n_s32(-(int32_t)shift);
+	uint32_t i;
+
+	for (i = 0; i + 4 <= samples; i += 4)
+		vst1q_s32(&buf[i], vshlq_s32(vld1q_s32(&buf[i]), count));
+
+	return i;
+}
+
+#if CONFIG_PCM_CONVERTER_FORMAT_FLOAT
+static inline uint32_t pcm_simd_s32_to_f(const int32_t *src, int32_t *dst,
+					 uint32_t samples, int bits)
+{
+	const float32x4_t scale = vdupq_n_f32(1.0f / (float)(1 << bits));
+	int32x4_t v;
+	uint32_t i;
+
+	for (i = 0; i + 4 <= samples; i += 4) {
+		v = vld1q_s32(&src[i]);
+		if (bits == 23)
+			v = vshrq_n_s32(vshlq_n_s32(v, 8), 8);
+
+		vst1q_f32((float *)&dst[i], vmulq_f32(vcvtq_f32_s32(v), scale));
+	}
+
+	return i;
+}
+
+static inline uint32_t pcm_simd_s16_to_f(const int16_t *src, int32_t *dst, uint32_t samples)
+{
+	const float32x4_t scale = vdupq_n_f32(1.0f / (1 << 15));
+	int16x8_t v;
+	uint32_t i;
+
+	for (i = 0; i + 8 <= samples; i += 8) {
+		v = vld1q_s16(&src[i]);
+		vst1q_f32((float *)&dst[i],
+			  vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), scale));
+		vst1q_f32((float *)&dst[i + 4],
+			  vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), scale));
+	}
+
+	return i;
+}
+#endif /* CONFIG_PCM_CONVERTER_FORMAT_FLOAT */
+
+#endif /* PCM_CONVERTER_LIN_NEON */
+
+#endif /* __SOF_AUDIO_PCM_CONVERTER_LIN_SIMD_H__ */
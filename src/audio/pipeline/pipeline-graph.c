@@ -193,6 +193,10 @@ int pipeline_connect(struct comp_dev *comp, struct comp_buffer *buffer,
 
 	irq_local_enable(flags);
 
+	/* the graph changed, rebuilt on the next prepare */
+	if (comp->pipeline)
+		pipeline_copy_schedule_free(comp->pipeline);
+
 	return 0;
 }
 
@@ -213,6 +217,9 @@ void pipeline_disconnect(struct comp_dev *comp, struct comp_buffer *buffer, int
 	buffer_set_comp(buffer, NULL, dir);
 
 	irq_local_enable(flags);
+
+	if (comp->pipeline)
+		pipeline_copy_schedule_free(comp->pipeline);
 }
 
 /* pipelines must be inactive */
@@ -233,6 +240,8 @@ int pipeline_free(struct pipeline *p)
 		rfree(p->pipe_task);
 	}
 
+	pipeline_copy_schedule_free(p);
+
 	ipc_msg_free(p->msg);
 
 	pipeline_posn_offset_put(p->posn_offset);
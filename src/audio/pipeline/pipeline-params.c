@@ -300,6 +300,7 @@ int pipeline_prepare(struct pipeline *p, struct comp_dev *dev)
 		.buff_func = buffer_reset_pos,
 		.skip_incomplete = true,
 	};
+	int err;
 	int ret;
 
 	pipe_dbg(p, "pipe prepare");
@@ -313,6 +314,12 @@ int pipeline_prepare(struct pipeline *p, struct comp_dev *dev)
 		return ret;
 	}
 
+	err = pipeline_copy_schedule_build(p);
+	if (err < 0) {
+		pipe_err(p, "pipeline_prepare(): copy schedule failed %d", err);
+		return err;
+	}
+
 	p->status = COMP_STATE_PREPARE;
 
 	return ret;
@@ -33,7 +33,7 @@ LOG_MODULE_DECLARE(pipe, CONFIG_SOF_LOG_LEVEL);
 DECLARE_SOF_UUID("pipe-task", pipe_task_uuid, 0xf11818eb, 0xe92e, 0x4082,
 		 0x82,  0xa3, 0xdc, 0x54, 0xc6, 0x04, 0xeb, 0xb3);
 
-#if CONFIG_ZEPHYR_DP_SCHEDULER
+#if CONFIG_DP_SCHEDULER
 
 /* ee755917-96b9-4130-b49e-37b9d0501993 */
 DECLARE_SOF_UUID("dp-task", dp_task_uuid, 0xee755917, 0x96b9, 0x4130,
@@ -48,9 +48,14 @@ DECLARE_SOF_UUID("dp-task", dp_task_uuid, 0xee755917, 0x96b9, 0x4130,
 /**
  * \brief a priority of the DP threads in the system.
  */
-#define ZEPHYR_DP_THREAD_PRIORITY (CONFIG_NUM_PREEMPT_PRIORITIES - 2)
+#if CONFIG_ZEPHYR_DP_SCHEDULER
+#define DP_THREAD_PRIORITY (CONFIG_NUM_PREEMPT_PRIORITIES - 2)
+#else
+/* host DP threads use the default priority of the process */
+#define DP_THREAD_PRIORITY 0
+#endif
 
-#endif /* CONFIG_ZEPHYR_DP_SCHEDULER */
+#endif /* CONFIG_DP_SCHEDULER */
 
 static void pipeline_schedule_cancel(struct pipeline *p)
 {
@@ -376,7 +381,7 @@ int pipeline_comp_ll_task_init(struct pipeline *p)
 	return 0;
 }
 
-#if CONFIG_ZEPHYR_DP_SCHEDULER
+#if CONFIG_DP_SCHEDULER
 static enum task_state dp_task_run(void *data)
 {
 	struct processing_module *mod = data;
@@ -404,14 +409,14 @@ int pipeline_comp_dp_task_init(struct comp_dev *comp)
 					     mod,
 					     comp->ipc_config.core,
 					     TASK_DP_STACK_SIZE,
-					     ZEPHYR_DP_THREAD_PRIORITY);
+					     DP_THREAD_PRIORITY);
 		if (ret < 0)
 			return ret;
 	}
 
 	return 0;
 }
-#endif /* CONFIG_ZEPHYR_DP_SCHEDULER */
+#endif /* CONFIG_DP_SCHEDULER */
 
 void pipeline_comp_trigger_sched_comp(struct pipeline *p,
 				      struct comp_dev *comp,
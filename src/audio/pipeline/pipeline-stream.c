@@ -9,6 +9,8 @@
 #include <sof/audio/component_ext.h>
 #include <sof/audio/pipeline.h>
 #include <sof/lib/dai.h>
+#include <rtos/alloc.h>
+#include <rtos/interrupt.h>
 #include <rtos/wait.h>
 #include <sof/list.h>
 #include <rtos/spinlock.h>
@@ -123,10 +125,187 @@ static int pipeline_comp_copy(struct comp_dev *current,
 	return err;
 }
 
+/* pipeline_copy() starts from the sink for playback and from the source for
+ * capture
+ */
+static struct comp_dev *pipeline_copy_start(struct pipeline *p, uint32_t *dir)
+{
+	if (p->source_comp->direction == SOF_IPC_STREAM_PLAYBACK) {
+		*dir = PPL_DIR_UPSTREAM;
+		return p->sink_comp;
+	}
+
+	*dir = PPL_DIR_DOWNSTREAM;
+	return p->source_comp;
+}
+
+/* flat copy schedule build context */
+struct pipeline_copy_build {
+	struct comp_dev *start;
+	struct pipeline_step *steps;	/* NULL while counting the steps */
+	uint32_t count;
+};
+
+static int pipeline_comp_copy_step(struct comp_dev *current,
+				   struct comp_buffer *calling_buf,
+				   struct pipeline_walk_context *ctx, int dir)
+{
+	struct pipeline_copy_build *build = ctx->comp_data;
+	uint32_t first = build->count;
+	uint32_t index = first;
+	int err;
+
+	/* same walk as pipeline_comp_copy(), activity is checked on copy */
+	if (!comp_is_single_pipeline(current, build->start))
+		return 0;
+
+	/* downstream copies before the components below, upstream after */
+	if (dir == PPL_DIR_DOWNSTREAM)
+		build->count++;
+
+	err = pipeline_for_each_comp(current, ctx, dir);
+	if (err < 0)
+		return err;
+
+	if (dir == PPL_DIR_UPSTREAM)
+		index = build->count++;
+
+	if (build->steps) {
+		build->steps[index].cd = current;
+		build->steps[index].subtree = dir == PPL_DIR_DOWNSTREAM ?
+					      build->count - 1 : first;
+	}
+
+	return 0;
+}
+
+int pipeline_copy_schedule_build(struct pipeline *p)
+{
+	struct pipeline_copy_build build;
+	struct pipeline_walk_context walk_ctx = {
+		.comp_func = pipeline_comp_copy_step,
+		.comp_data = &build,
+		.skip_incomplete = true,
+	};
+	struct pipeline_step *steps;
+	struct comp_dev *start;
+	uint32_t flags;
+	uint32_t dir;
+	int ret;
+
+	pipeline_copy_schedule_free(p);
+
+	/* incomplete pipelines are never copied */
+	if (!p->source_comp || !p->sink_comp)
+		return 0;
+
+	start = pipeline_copy_start(p, &dir);
+	build.start = start;
+	build.steps = NULL;
+	build.count = 0;
+
+	/* count the steps first, then walk again to fill them in */
+	ret = walk_ctx.comp_func(start, NULL, &walk_ctx, dir);
+	if (ret < 0)
+		return ret;
+
+	steps = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			sizeof(*steps) * build.count);
+	if (!steps) {
+		pipe_err(p, "pipeline_copy_schedule_build(): out of memory, %u steps",
+			 build.count);
+		return -ENOMEM;
+	}
+
+	build.steps = steps;
+	build.count = 0;
+	ret = walk_ctx.comp_func(start, NULL, &walk_ctx, dir);
+	if (ret < 0) {
+		rfree(steps);
+		return ret;
+	}
+
+	pipe_dbg(p, "pipeline_copy_schedule_build(), %u steps", build.count);
+
+	irq_local_disable(flags);
+	p->copy_steps = steps;
+	p->copy_step_count = build.count;
+	irq_local_enable(flags);
+
+	return 0;
+}
+
+void pipeline_copy_schedule_free(struct pipeline *p)
+{
+	struct pipeline_step *steps;
+	uint32_t flags;
+
+	/* the pipeline task on this core never sees a half updated schedule */
+	irq_local_disable(flags);
+	steps = p->copy_steps;
+	p->copy_steps = NULL;
+	p->copy_step_count = 0;
+	irq_local_enable(flags);
+
+	rfree(steps);
+}
+
+/* Run the flat copy schedule. It copies the same components in the same
+ * order as the pipeline_comp_copy() walk. An inactive component skips the
+ * steps below it and an error or PPL_STATUS_PATH_STOP ends the copy.
+ */
+static int pipeline_copy_steps(struct pipeline_step *steps, int count, uint32_t dir)
+{
+	struct pipeline_step *step;
+	int err = 0;
+	int i;
+
+	if (dir == PPL_DIR_DOWNSTREAM) {
+		for (i = 0; i < count; i++) {
+			step = &steps[i];
+			if (!comp_is_active(step->cd)) {
+				i = step->subtree;
+				continue;
+			}
+
+			err = comp_copy(step->cd);
+			if (err < 0 || err == PPL_STATUS_PATH_STOP)
+				return err;
+		}
+
+		return 0;
+	}
+
+	/* upstream components follow the steps below them, so mark the
+	 * steps to run from the sink end first
+	 */
+	for (i = count - 1; i >= 0; i--) {
+		step = &steps[i];
+		step->run = comp_is_active(step->cd);
+		if (!step->run)
+			while (i > step->subtree)
+				steps[--i].run = false;
+	}
+
+	for (i = 0; i < count; i++) {
+		step = &steps[i];
+		if (!step->run)
+			continue;
+
+		err = comp_copy(step->cd);
+		if (err < 0 || err == PPL_STATUS_PATH_STOP)
+			return err;
+	}
+
+	return err;
+}
+
 /* Copy data across all pipeline components.
  * For capture pipelines it always starts from source component
  * and continues downstream and for playback pipelines it first
  * copies sink component itself and then goes upstream.
+ * Prepared pipelines run the flat copy schedule, otherwise the
+ * graph is walked.
  */
 int pipeline_copy(struct pipeline *p)
 {
@@ -140,18 +319,17 @@ int pipeline_copy(struct pipeline *p)
 	uint32_t dir;
 	int ret;
 
-	if (p->source_comp->direction == SOF_IPC_STREAM_PLAYBACK) {
-		dir = PPL_DIR_UPSTREAM;
-		start = p->sink_comp;
+	start = pipeline_copy_start(p, &dir);
+
+	if (p->copy_steps) {
+		ret = pipeline_copy_steps(p->copy_steps, p->copy_step_count, dir);
 	} else {
-		dir = PPL_DIR_DOWNSTREAM;
-		start = p->source_comp;
-	}
+		data.start = start;
+		data.p = p;
 
-	data.start = start;
-	data.p = p;
+		ret = walk_ctx.comp_func(start, NULL, &walk_ctx, dir);
+	}
 
-	ret = walk_ctx.comp_func(start, NULL, &walk_ctx, dir);
 	if (ret < 0)
 		pipe_err(p, "pipeline_copy(): ret = %d, start->comp.id = %u, dir = %u",
 			 ret, dev_comp_id(start), dir);
@@ -111,6 +111,7 @@ int src_buffer_lengths(struct comp_dev *dev, struct comp_data *cd,
 	}
 
 	a->fir_s1 = nch * src_fir_delay_length(stage1);
+	a->fir_m1 = nch * src_fir_mirror_length(stage1);
 	a->out_s1 = nch * src_out_delay_length(stage1);
 
 	/* Computing of number of blocks to process is done in
@@ -123,10 +124,12 @@ int src_buffer_lengths(struct comp_dev *dev, struct comp_data *cd,
 
 	if (stage2->filter_length == 1) {
 		a->fir_s2 = 0;
+		a->fir_m2 = 0;
 		a->out_s2 = 0;
 		a->sbuf_length = 0;
 	} else {
 		a->fir_s2 = nch * src_fir_delay_length(stage2);
+		a->fir_m2 = nch * src_fir_mirror_length(stage2);
 		a->out_s2 = nch * src_out_delay_length(stage2);
 
 		/* Stage 1 is repeated max. amount that just exceeds one
@@ -144,7 +147,8 @@ int src_buffer_lengths(struct comp_dev *dev, struct comp_data *cd,
 		a->sbuf_length = nch * (n + (n >> 3));
 	}
 
-	a->src_multich = a->fir_s1 + a->fir_s2 + a->out_s1 + a->out_s2;
+	a->src_multich = a->fir_s1 + a->fir_s2 + a->fir_m1 + a->fir_m2 +
+		a->out_s1 + a->out_s2;
 	a->total = a->sbuf_length + a->src_multich;
 
 	return 0;
@@ -173,10 +177,11 @@ int init_stages(struct src_stage *stage1, struct src_stage *stage2,
 
 	/* Delay line sizes */
 	src->state1.fir_delay_size = p->fir_s1;
+	src->state1.fir_mirror_size = p->fir_m1;
 	src->state1.out_delay_size = p->out_s1;
 	src->state1.fir_delay = delay_lines_start;
-	src->state1.out_delay =
-		src->state1.fir_delay + src->state1.fir_delay_size;
+	src->state1.out_delay = src->state1.fir_delay +
+		src->state1.fir_delay_size + src->state1.fir_mirror_size;
 	/* Initialize to last ensures that circular wrap cannot happen
 	 * mid-frame. The size is multiple of channels count.
 	 */
@@ -184,11 +189,12 @@ int init_stages(struct src_stage *stage1, struct src_stage *stage2,
 	src->state1.out_rp = src->state1.out_delay;
 	if (n > 1) {
 		src->state2.fir_delay_size = p->fir_s2;
+		src->state2.fir_mirror_size = p->fir_m2;
 		src->state2.out_delay_size = p->out_s2;
 		src->state2.fir_delay =
 			src->state1.out_delay + src->state1.out_delay_size;
-		src->state2.out_delay =
-			src->state2.fir_delay + src->state2.fir_delay_size;
+		src->state2.out_delay = src->state2.fir_delay +
+			src->state2.fir_delay_size + src->state2.fir_mirror_size;
 		/* Initialize to last ensures that circular wrap cannot happen
 		 * mid-frame. The size is multiple of channels count.
 		 */
@@ -196,6 +202,7 @@ int init_stages(struct src_stage *stage1, struct src_stage *stage2,
 		src->state2.out_rp = src->state2.out_delay;
 	} else {
 		src->state2.fir_delay_size = 0;
+		src->state2.fir_mirror_size = 0;
 		src->state2.out_delay_size = 0;
 		src->state2.fir_delay = NULL;
 		src->state2.out_delay = NULL;
@@ -16,9 +16,13 @@
 #include <sof/audio/component.h>
 #include <sof/audio/module_adapter/module/generic.h>
 
+#include "src_config.h"
+
 struct src_param {
 	int fir_s1;
 	int fir_s2;
+	int fir_m1;
+	int fir_m2;
 	int out_s1;
 	int out_s2;
 	int sbuf_length;
@@ -48,6 +52,7 @@ struct src_stage {
 
 struct src_state {
 	int fir_delay_size;	/* samples */
+	int fir_mirror_size;	/* samples */
 	int out_delay_size;	/* samples */
 	int32_t *fir_delay;
 	int32_t *out_delay;
@@ -107,6 +112,7 @@ static inline void src_dec_wrap_s16(int16_t **ptr, int16_t *addr, size_t size)
 static inline void src_state_reset(struct src_state *state)
 {
 	state->fir_delay_size = 0;
+	state->fir_mirror_size = 0;
 	state->out_delay_size = 0;
 }
 
@@ -193,6 +199,20 @@ static inline int src_fir_delay_length(struct src_stage *s)
 		+ s->blk_in;
 }
 
+/* Calculates the length of the FIR delay line start that is mirrored
+ * after its end. The generic FIR core reads up to subfilter_length - 1
+ * frames past the end without a circular wrap. The HiFi versions use
+ * the circular addressing of the DSP instead.
+ */
+static inline int src_fir_mirror_length(struct src_stage *s)
+{
+#if SRC_GENERIC
+	return s->subfilter_length - 1;
+#else
+	return 0;
+#endif
+}
+
 /* Calculates the FIR output delay line length */
 static inline int src_out_delay_length(struct src_stage *s)
 {
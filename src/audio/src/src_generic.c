@@ -20,195 +20,115 @@
 
 #if SRC_SHORT /* 16 bit coefficients version */
 
-static inline void fir_filter_generic(int32_t *rp, const void *cp, int32_t *wp0,
-				      int32_t *fir_start, int32_t *fir_end,
-				      const int taps_x_nch,
-				      const int shift, const int nch)
-{
-	int64_t y0;
-	int64_t y1;
-	int32_t *data;
-	const int16_t *coef;
-	int i;
-	int j;
-	int n1;
-	int n2;
-	int frames;
-	const int qshift = 15 + shift; /* Q2.46 -> Q2.31 */
-	const int32_t rnd = 1 << (qshift - 1); /* Half LSB */
-	int32_t *d = rp;
-	int32_t *wp = wp0;
+/* The FIR is calculated as Q1.15 x Q1.31 -> Q2.46. The output shift
+ * includes the shift by 15 for Qx.46 to Qx.31.
+ */
+typedef int16_t src_coef_t;
+#define SRC_COEF(c)		(c)
+#define SRC_COEF_QSHIFT		15
 
-	/* Check for 2ch FIR case */
-	if (nch == 2) {
-		/* Decrement data pointer to next channel start. Note that
-		 * initialization code ensures that circular wrap does not
-		 * happen mid-frame.
-		 */
-		data = d - 1;
+#else /* 32bit coefficients version */
 
-		/* Initialize to half LSB for rounding, prepare for FIR core */
-		y0 = rnd;
-		y1 = rnd;
-		coef = (const int16_t *)cp;
-		frames = fir_end - data; /* Frames until wrap */
-		n1 = ((taps_x_nch < frames) ? taps_x_nch : frames) >> 1;
-		n2 = (taps_x_nch >> 1) - n1;
-
-		/* The FIR is calculated as Q1.15 x Q1.31 -> Q2.46. The
-		 * output shift includes the shift by 15 for Qx.46 to
-		 * Qx.31.
-		 */
-		for (i = 0; i < n1; i++, coef++, data += 2) {
-			y0 += (int64_t)(*coef) * data[0];
-			y1 += (int64_t)(*coef) * data[1];
-		}
+/* The FIR is calculated as Q1.23 x Q1.31 -> Q2.54. The output shift
+ * includes the shift by 23 for Qx.54 to Qx.31.
+ */
+typedef int32_t src_coef_t;
+#define SRC_COEF(c)		((c) >> 8)
+#define SRC_COEF_QSHIFT		23
 
-		/* No need to check for circular wrap. Pointer data is moved to
-		 * fir_start to be used by next loop if n2 is greater than zero.
-		 */
-		data = fir_start;
-		for (i = 0; i < n2; i++, coef++, data += 2) {
-			y0 += (int64_t)(*coef) * data[0];
-			y1 += (int64_t)(*coef) * data[1];
-		}
+#endif /* 32bit coefficients version */
 
-		*wp = sat_int32(y1 >> qshift);
-		*(wp + 1) = sat_int32(y0 >> qshift);
-		return;
-	}
+/* Copy the samples written to the start of the delay line also to the
+ * mirror after its end.
+ */
+static inline void src_fir_mirror(struct src_state *fir, int32_t *x, int n)
+{
+	int32_t *mirror = x + fir->fir_delay_size;
+	int m = fir->fir_mirror_size - (x - fir->fir_delay);
+	int i;
 
-	for (j = 0; j < nch; j++) {
-		/* Decrement data pointer to next channel start. Note that
-		 * initialization code ensures that circular wrap does not
-		 * happen mid-frame.
-		 */
-		data = d--;
+	if (n > m)
+		n = m;
 
-		/* Initialize to half LSB for rounding, prepare for FIR core */
-		y0 = rnd;
-		coef = (const int16_t *)cp;
-		frames = fir_end - data + nch - j - 1; /* Frames until wrap */
-		n1 = (taps_x_nch < frames) ? taps_x_nch : frames;
-		n2 = taps_x_nch - n1;
-
-		/* The FIR is calculated as Q1.15 x Q1.31 -> Q2.46. The
-		 * output shift includes the shift by 15 for Qx.46 to
-		 * Qx.31.
-		 */
-		for (i = 0; i < n1; i += nch, coef++, data += nch)
-			y0 += (int64_t)(*coef) * (*data);
-
-		/* No need to check for circular wrap. Pointer data is moved to fir_start
-		 * plus actual channel to be used by next loop if n2 is greater than zero.
-		 */
-		data = fir_start + nch - j - 1;
-		for (i = 0; i < n2; i += nch, coef++, data += nch)
-			y0 += (int64_t)(*coef) * (*data);
-
-		*wp = sat_int32(y0 >> qshift);
-		wp++;
-	}
+	for (i = 0; i < n; i++)
+		mirror[i] = x[i];
 }
 
-#else /* 32bit coefficients version */
-
-static inline void fir_filter_generic(int32_t *rp, const void *cp, int32_t *wp0,
-				      int32_t *fir_start, int32_t *fir_end,
-				      const int taps_x_nch, const int shift,
+/* The delay line is written backwards, so in memory a frame has the
+ * channels in reverse order and the older frames follow it. Pointer rp
+ * is to channel 0 of the newest frame of the sub-filter. The mirror
+ * after the delay line end ensures there is no circular wrap while
+ * reading the taps. The channels are filtered in blocks of four, then
+ * a pair and the last odd channel, so one coefficient load is shared
+ * by the block and the block samples are adjacent in memory.
+ */
+static inline void fir_filter_generic(int32_t *rp, const void *cp, int32_t *wp,
+				      const int taps, const int shift,
 				      const int nch)
 {
 	int64_t y0;
 	int64_t y1;
-	int32_t scaled_coef;
+	int64_t y2;
+	int64_t y3;
+	int32_t c;
 	int32_t *data;
-	const int32_t *coef;
+	const src_coef_t *coef;
 	int i;
 	int j;
-	int frames;
-	int n1;
-	int n2;
-
-	const int qshift = 23 + shift; /* Qx.54 -> Qx.31 */
+	const int qshift = SRC_COEF_QSHIFT + shift; /* Qx.46 or Qx.54 -> Qx.31 */
 	const int32_t rnd = 1 << (qshift - 1); /* Half LSB */
-	int32_t *d = rp;
-	int32_t *wp = wp0;
-
-	/* Check for 2ch FIR case */
-	if (nch == 2) {
-		/* Decrement data pointer to next channel start. Note that
-		 * initialization code ensures that circular wrap does not
-		 * happen mid-frame.
-		 */
-		data = d - 1;
+	int32_t *frame = rp - nch + 1; /* Channel nch - 1 of newest frame */
 
+	/* Index j is the offset in frame, it is channel nch - 1 - j */
+	for (j = 0; j + 4 <= nch; j += 4) {
 		/* Initialize to half LSB for rounding, prepare for FIR core */
 		y0 = rnd;
 		y1 = rnd;
-		coef = (const int32_t *)cp;
-		frames = fir_end - data; /* Frames until wrap */
-		n1 = ((taps_x_nch < frames) ? taps_x_nch : frames) >> 1;
-		n2 = (taps_x_nch >> 1) - n1;
-
-		/* The FIR is calculated as Q1.23 x Q1.31 -> Q2.54. The
-		 * output shift includes the shift by 23 for Qx.54 to
-		 * Qx.31.
-		 */
-		for (i = 0; i < n1; i++, coef++, data += 2) {
-			scaled_coef = *coef >> 8;
-			y0 += (int64_t)scaled_coef * data[0];
-			y1 += (int64_t)scaled_coef * data[1];
+		y2 = rnd;
+		y3 = rnd;
+		coef = (const src_coef_t *)cp;
+		data = frame + j;
+		for (i = 0; i < taps; i++, data += nch) {
+			c = SRC_COEF(coef[i]);
+			y0 += (int64_t)c * data[0];
+			y1 += (int64_t)c * data[1];
+			y2 += (int64_t)c * data[2];
+			y3 += (int64_t)c * data[3];
 		}
 
-		/* No need to check for circular wrap. Pointer data is moved to
-		 * fir_start to be used by next loop if n2 is greater than zero.
-		 */
-		data = fir_start;
-		for (i = 0; i < n2; i++, coef++, data += 2) {
-			scaled_coef = *coef >> 8;
-			y0 += (int64_t)scaled_coef * data[0];
-			y1 += (int64_t)scaled_coef * data[1];
-		}
-		*wp = sat_int32(y1 >> qshift);
-		*(wp + 1) = sat_int32(y0 >> qshift);
-		return;
+		wp[nch - 1 - j] = sat_int32(y0 >> qshift);
+		wp[nch - 2 - j] = sat_int32(y1 >> qshift);
+		wp[nch - 3 - j] = sat_int32(y2 >> qshift);
+		wp[nch - 4 - j] = sat_int32(y3 >> qshift);
 	}
 
-	for (j = 0; j < nch; j++) {
-		/* Decrement data pointer to next channel start. Note that
-		 * initialization code ensures that circular wrap does not
-		 * happen mid-frame.
-		 */
-		data = d--;
+	if (j + 2 <= nch) {
+		y0 = rnd;
+		y1 = rnd;
+		coef = (const src_coef_t *)cp;
+		data = frame + j;
+		for (i = 0; i < taps; i++, data += nch) {
+			c = SRC_COEF(coef[i]);
+			y0 += (int64_t)c * data[0];
+			y1 += (int64_t)c * data[1];
+		}
 
-		/* Initialize to half LSB for rounding, prepare for FIR core */
+		wp[nch - 1 - j] = sat_int32(y0 >> qshift);
+		wp[nch - 2 - j] = sat_int32(y1 >> qshift);
+		j += 2;
+	}
+
+	if (j < nch) {
 		y0 = rnd;
-		coef = (const int32_t *)cp;
-		frames = fir_end - data + nch - j - 1; /* Frames until wrap */
-		n1 = (taps_x_nch < frames) ? taps_x_nch : frames;
-		n2 = taps_x_nch - n1;
-
-		/* The FIR is calculated as Q1.23 x Q1.31 -> Q2.54. The
-		 * output shift includes the shift by 23 for Qx.54 to
-		 * Qx.31.
-		 */
-		for (i = 0; i < n1; i += nch, coef++, data += nch)
-			y0 += (int64_t)(*coef >> 8) * (*data);
-
-		/* No need to check for circular wrap. Pointer data is moved to fir_start
-		 * plus actual channel to be used by next loop if n2 is greater than zero.
-		 */
-		data = fir_start + nch - j - 1;
-		for (i = 0; i < n2; i += nch, coef++, data += nch)
-			y0 += (int64_t)(*coef >> 8) * (*data);
-
-		*wp = sat_int32(y0 >> qshift);
-		wp++;
+		coef = (const src_coef_t *)cp;
+		data = frame + j;
+		for (i = 0; i < taps; i++, data += nch)
+			y0 += (int64_t)SRC_COEF(coef[i]) * data[0];
+
+		wp[0] = sat_int32(y0 >> qshift);
 	}
 }
 
-#endif /* 32bit coefficients version */
-
 #if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
 void src_polyphase_stage_cir(struct src_stage_prm *s)
 {
@@ -235,7 +155,6 @@ void src_polyphase_stage_cir(struct src_stage_prm *s)
 	const int rewind = nch * (cfg->blk_in + (cfg->num_of_subfilters - 1) * cfg->idm);
 	const int nch_x_idm = nch * cfg->idm;
 	const size_t fir_size = fir->fir_delay_size * sizeof(int32_t);
-	const int taps_x_nch = cfg->subfilter_length * nch;
 	int32_t *x_rptr = (int32_t *)s->x_rptr;
 	int32_t *y_wptr = (int32_t *)s->y_wptr;
 	int32_t *x_end_addr = (int32_t *)s->x_end_addr;
@@ -263,6 +182,7 @@ void src_polyphase_stage_cir(struct src_stage_prm *s)
 				fir->fir_wp--;
 				x_rptr++;
 			}
+			src_fir_mirror(fir, fir->fir_wp + 1, n_min);
 			/* Check for wrap */
 			src_dec_wrap(&fir->fir_wp, fir_delay, fir_size);
 			src_inc_wrap(&x_rptr, x_end_addr, s->x_size);
@@ -274,8 +194,8 @@ void src_polyphase_stage_cir(struct src_stage_prm *s)
 		src_inc_wrap(&rp, fir_end, fir_size);
 		wp = fir->out_rp;
 		for (i = 0; i < cfg->num_of_subfilters; i++) {
-			fir_filter_generic(rp, cp, wp, fir_delay, fir_end,
-					   taps_x_nch, cfg->shift, nch);
+			fir_filter_generic(rp, cp, wp, cfg->subfilter_length,
+					   cfg->shift, nch);
 			wp += nch_x_odm;
 			cp = (char *)cp + subfilter_size;
 			src_inc_wrap(&wp, out_delay_end, out_size);
@@ -333,7 +253,6 @@ void src_polyphase_stage_cir_s16(struct src_stage_prm *s)
 	const int rewind = nch * (cfg->blk_in + (cfg->num_of_subfilters - 1) * cfg->idm);
 	const int nch_x_idm = nch * cfg->idm;
 	const size_t fir_size = fir->fir_delay_size * sizeof(int32_t);
-	const int taps_x_nch = cfg->subfilter_length * nch;
 	int16_t *x_rptr = (int16_t *)s->x_rptr;
 	int16_t *y_wptr = (int16_t *)s->y_wptr;
 	int16_t *x_end_addr = (int16_t *)s->x_end_addr;
@@ -361,6 +280,7 @@ void src_polyphase_stage_cir_s16(struct src_stage_prm *s)
 				fir->fir_wp--;
 				x_rptr++;
 			}
+			src_fir_mirror(fir, fir->fir_wp + 1, n_min);
 			/* Check for wrap */
 			src_dec_wrap(&fir->fir_wp, fir_delay, fir_size);
 			src_inc_wrap_s16(&x_rptr, x_end_addr, s->x_size);
@@ -372,8 +292,8 @@ void src_polyphase_stage_cir_s16(struct src_stage_prm *s)
 		src_inc_wrap(&rp, fir_end, fir_size);
 		wp = fir->out_rp;
 		for (i = 0; i < cfg->num_of_subfilters; i++) {
-			fir_filter_generic(rp, cp, wp, fir_delay, fir_end,
-					   taps_x_nch, cfg->shift, nch);
+			fir_filter_generic(rp, cp, wp, cfg->subfilter_length,
+					   cfg->shift, nch);
 			wp += nch_x_odm;
 			cp = (char *)cp + subfilter_size;
 			src_inc_wrap(&wp, out_delay_end, out_size);
@@ -347,6 +347,60 @@ static inline void volume_ramp(struct processing_module *mod)
 	set_volume_process(cd, dev, true);
 }
 
+/**
+ * \brief Ramps volume for a block of frames processed with gain interpolation.
+ * \param[in,out] mod Volume processing module handle
+ * \param[in] frames Number of frames in the block.
+ *
+ * The gain is interpolated in every frame from the gain in end of previous
+ * block to the ramp gain in end of this block.
+ */
+static inline void volume_ramp_block(struct processing_module *mod, uint32_t frames)
+{
+	struct vol_data *cd = module_get_private_data(mod);
+	int i;
+
+	/* Ramp start, the zero crossing held gain is the current gain unless
+	 * it is still held from the previous ramp.
+	 */
+	if (!cd->vol_ramp_elapsed_frames && !cd->zc_hold) {
+		for (i = 0; i < cd->channels; i++)
+			cd->zc_gain[i] = cd->volume[i];
+
+		cd->zc_sum = 0;
+	}
+
+	if (cd->ramp_type == SOF_VOLUME_LINEAR_ZC)
+		cd->zc_hold = true;
+
+	for (i = 0; i < cd->channels; i++)
+		cd->ramp_gain[i] = cd->volume[i];
+
+	cd->vol_ramp_elapsed_frames += frames;
+	volume_ramp(mod);
+
+	/* Division rounds towards zero so the interpolated gain can't pass
+	 * the block end gain.
+	 */
+	for (i = 0; i < cd->channels; i++)
+		cd->ramp_step[i] = (cd->volume[i] - cd->ramp_gain[i]) / (int32_t)frames;
+}
+
+/**
+ * \brief Checks if the zero crossing held gain is still to reach the gain.
+ * \param[in] cd Volume component data
+ */
+static bool volume_zc_hold(struct vol_data *cd)
+{
+	int i;
+
+	for (i = 0; i < cd->channels; i++)
+		if (cd->zc_gain[i] != cd->volume[i])
+			return true;
+
+	return false;
+}
+
 /**
  * \brief Reset state except controls.
  */
@@ -363,6 +417,8 @@ void volume_reset_state(struct vol_data *cd)
 	cd->ramp_finished = true;
 	cd->vol_ramp_frames = 0;
 	cd->vol_ramp_elapsed_frames = 0;
+	cd->zc_sum = 0;
+	cd->zc_hold = false;
 	cd->sample_rate_inv = 0;
 	cd->copy_gain = true;
 	cd->is_passthrough = false;
@@ -545,9 +601,9 @@ void volume_set_chan_unmute(struct processing_module *mod, int chan)
 
  * \return Error code.
  */
-static int volume_process(struct processing_module *mod,
-			  struct input_stream_buffer *input_buffers, int num_input_buffers,
-			  struct output_stream_buffer *output_buffers, int num_output_buffers)
+UT_STATIC int volume_process(struct processing_module *mod,
+			     struct input_stream_buffer *input_buffers, int num_input_buffers,
+			     struct output_stream_buffer *output_buffers, int num_output_buffers)
 {
 	struct vol_data *cd = module_get_private_data(mod);
 	uint32_t avail_frames = input_buffers[0].size;
@@ -560,24 +616,38 @@ static int volume_process(struct processing_module *mod,
 #if CONFIG_COMP_PEAK_VOL
 		volume_update_current_vol_ipc4(cd);
 #endif
-		if (cd->ramp_finished || cd->vol_ramp_frames > avail_frames) {
+		if ((cd->ramp_finished && !cd->zc_hold) || cd->vol_ramp_frames > avail_frames) {
 			/* without ramping process all at once */
 			frames = avail_frames;
-		} else if (cd->ramp_type == SOF_VOLUME_LINEAR_ZC) {
-			/* with ZC ramping look for next ZC offset */
+		} else if (cd->ramp_type == SOF_VOLUME_LINEAR_ZC && !cd->ramp_vol) {
+			/* with ZC ramping look for next ZC offset, the gain
+			 * interpolation detects zero crossings while processing
+			 */
 			frames = cd->zc_get(input_buffers[0].data, cd->vol_ramp_frames, &prev_sum);
 		} else {
 			/* without ZC process max ramp chunk */
 			frames = cd->vol_ramp_frames;
 		}
 
-		if (!cd->ramp_finished) {
-			volume_ramp(mod);
-			cd->vol_ramp_elapsed_frames += frames;
-		}
+		if ((!cd->ramp_finished || cd->zc_hold) && cd->ramp_vol) {
+			/* copy and scale volume with interpolated gain, after
+			 * the ramp the held gain is kept until next zero crossing
+			 */
+			volume_ramp_block(mod, frames);
+			cd->ramp_vol(mod, &input_buffers[0], &output_buffers[0], frames,
+				     cd->ramp_type == SOF_VOLUME_LINEAR_ZC);
+			if (cd->ramp_finished && cd->zc_hold)
+				cd->zc_hold = volume_zc_hold(cd);
+		} else {
+			if (!cd->ramp_finished) {
+				volume_ramp(mod);
+				cd->vol_ramp_elapsed_frames += frames;
+			}
 
-		/* copy and scale volume */
-		cd->scale_vol(mod, &input_buffers[0], &output_buffers[0], frames, cd->attenuation);
+			/* copy and scale volume */
+			cd->scale_vol(mod, &input_buffers[0], &output_buffers[0], frames,
+				      cd->attenuation);
+		}
 
 		avail_frames -= frames;
 	}
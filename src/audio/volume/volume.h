@@ -131,6 +131,14 @@ struct sof_ipc_ctrl_value_chan;
 typedef void (*vol_scale_func)(struct processing_module *mod, struct input_stream_buffer *source,
 			struct output_stream_buffer *sink, uint32_t frames, uint32_t attenuation);
 
+/**
+ * \brief volume processing function interface with interpolated gain ramp.
+ * The gain changes in every frame from vol_data ramp_gain with ramp_step.
+ * With zc set the gain is updated only when the channels sum changes sign.
+ */
+typedef void (*vol_ramp_func)(struct processing_module *mod, struct input_stream_buffer *source,
+			      struct output_stream_buffer *sink, uint32_t frames, bool zc);
+
 /**
  * \brief volume interface for function getting nearest zero crossing frame
  */
@@ -157,6 +165,11 @@ struct vol_data {
 	int32_t mvolume[SOF_IPC_MAX_CHANNELS];	/**< mute volume */
 	int32_t rvolume[SOF_IPC_MAX_CHANNELS];	/**< ramp start volume */
 	int32_t ramp_coef[SOF_IPC_MAX_CHANNELS]; /**< parameter for slope */
+	int32_t ramp_gain[SOF_IPC_MAX_CHANNELS]; /**< gain in start of ramp block */
+	int32_t ramp_step[SOF_IPC_MAX_CHANNELS]; /**< gain increment per frame */
+	int32_t zc_gain[SOF_IPC_MAX_CHANNELS];	/**< gain held since last zero crossing */
+	int64_t zc_sum;				/**< channels sum of last ramp frame */
+	bool zc_hold;				/**< zc_gain not yet at the ramp end gain */
 	/**< store current volume 4 times for scale_vol function */
 	int32_t *vol;
 	uint32_t initial_ramp;			/**< ramp space in ms */
@@ -173,6 +186,7 @@ struct vol_data {
 	bool ramp_finished;			/**< control ramp launch */
 	vol_scale_func scale_vol;		/**< volume processing function */
 	vol_zc_func zc_get;			/**< function getting nearest zero crossing frame */
+	vol_ramp_func ramp_vol;			/**< volume processing function with ramp */
 	bool copy_gain;				/**< control copy gain or not */
 	uint32_t attenuation;			/**< peakmeter adjustment in range [0 - 31] */
 	bool is_passthrough;			/**< is passthrough or do gain multiplication */
@@ -184,6 +198,7 @@ struct comp_func_map {
 	uint16_t frame_fmt;	/**< frame format */
 	vol_scale_func func;	/**< volume processing function */
 	vol_scale_func passthrough_func;	/**< volume passthrough function */
+	vol_ramp_func ramp_func;	/**< ramp function, NULL for the stepped ramp */
 };
 
 /** \brief Map of formats with dedicated processing functions. */
@@ -225,6 +240,23 @@ static inline vol_scale_func vol_get_processing_function(struct comp_dev *dev,
 	return NULL;
 }
 
+/**
+ * \brief Retrievies volume processing function with gain ramp.
+ * \param[in] sinkb Sink buffer to match against
+ * \return Function or NULL if gain ramp is done in steps.
+ */
+static inline vol_ramp_func vol_get_ramp_function(struct comp_buffer *sinkb)
+{
+	int i;
+
+	for (i = 0; i < volume_func_count; i++) {
+		if (audio_stream_get_frm_fmt(&sinkb->stream) == volume_func_map[i].frame_fmt)
+			return volume_func_map[i].ramp_func;
+	}
+
+	return NULL;
+}
+
 #else
 /**
  * \brief Retrievies volume processing function.
@@ -264,6 +296,27 @@ static inline vol_scale_func vol_get_processing_function(struct comp_dev *dev,
 		}
 	}
 }
+
+/**
+ * \brief Retrievies volume processing function with gain ramp.
+ * \param[in,out] dev Volume base component device.
+ * \return Function or NULL if gain ramp is done in steps.
+ */
+static inline vol_ramp_func vol_get_ramp_function(struct comp_dev *dev)
+{
+	struct processing_module *mod = comp_get_drvdata(dev);
+
+	switch (mod->priv.cfg.base_cfg.audio_fmt.valid_bit_depth) {
+	case IPC4_DEPTH_16BIT:
+		return volume_func_map[0].ramp_func;
+	case IPC4_DEPTH_24BIT:
+		return volume_func_map[1].ramp_func;
+	case IPC4_DEPTH_32BIT:
+		return volume_func_map[2].ramp_func;
+	default:
+		return NULL;
+	}
+}
 #endif
 
 static inline void peak_vol_update(struct vol_data *cd)
@@ -278,6 +331,13 @@ static inline void peak_vol_update(struct vol_data *cd)
 void sys_comp_module_volume_interface_init(void);
 #endif
 
+/* non-static with UT_STATIC */
+#if defined UNIT_TEST || defined __ZEPHYR__ || CONFIG_LIBRARY_STATIC
+int volume_process(struct processing_module *mod,
+		   struct input_stream_buffer *input_buffers, int num_input_buffers,
+		   struct output_stream_buffer *output_buffers, int num_output_buffers);
+#endif
+
 /* source_or_sink, true means source, false means sink */
 void set_volume_process(struct vol_data *cd, struct comp_dev *dev, bool source_or_sink);
 
@@ -31,6 +31,39 @@ LOG_MODULE_DECLARE(volume_generic, CONFIG_SOF_LOG_LEVEL);
 
 #if (!CONFIG_COMP_PEAK_VOL)
 
+/**
+ * \brief Advances the interpolated gain by one frame.
+ * \param[in] cd Volume component private data.
+ * \param[in,out] gain Interpolated gains.
+ * \param[in] nch Number of channels.
+ */
+static inline void vol_ramp_gain(const struct vol_data *cd, int32_t *gain, int nch)
+{
+	int j;
+
+	for (j = 0; j < nch; j++)
+		gain[j] += cd->ramp_step[j];
+}
+
+/**
+ * \brief Updates the held gain if the frame channels sum changes sign.
+ * \param[in,out] cd Volume component private data.
+ * \param[in] gain Interpolated gains.
+ * \param[in] sum Frame channels sum.
+ * \param[in] nch Number of channels.
+ */
+static inline void vol_ramp_zc(struct vol_data *cd, const int32_t *gain, int64_t sum, int nch)
+{
+	int j;
+
+	if ((sum ^ cd->zc_sum) < 0) {
+		for (j = 0; j < nch; j++)
+			cd->zc_gain[j] = gain[j];
+	}
+
+	cd->zc_sum = sum;
+}
+
 #if CONFIG_FORMAT_S24LE
 /**
  * \brief Volume s24 to s24 multiply function
@@ -134,6 +167,63 @@ static void vol_passthrough_s24_to_s24(struct processing_module *mod,
 		y = audio_stream_wrap(sink, y + n);
 	}
 }
+/**
+ * \brief Volume processing from 24/32 bit to 24/32 bit with gain ramp.
+ * \param[in,out] mod Pointer to struct processing_module
+ * \param[in,out] bsource Input buffer.
+ * \param[in,out] bsink Destination buffer.
+ * \param[in] frames Number of frames to process.
+ * \param[in] zc Update gain only in zero crossings.
+ *
+ * Copy and scale volume from 24/32 bit source buffer to 24/32 bit
+ * destination buffer with the gain interpolated in every frame.
+ */
+static void vol_ramp_s24_to_s24(struct processing_module *mod, struct input_stream_buffer *bsource,
+				struct output_stream_buffer *bsink, uint32_t frames, bool zc)
+{
+	struct vol_data *cd = module_get_private_data(mod);
+	struct audio_stream *source = bsource->data;
+	struct audio_stream *sink = bsink->data;
+	int32_t gain[SOF_IPC_MAX_CHANNELS];
+	int32_t *vol = zc ? cd->zc_gain : gain;
+	int64_t sum;
+	int32_t *x;
+	int32_t *y;
+	int nmax, n, i, j;
+	const int nch = audio_stream_get_channels(source);
+	int remaining_samples = frames * nch;
+
+	x = audio_stream_wrap(source, (char *)audio_stream_get_rptr(source) + bsource->consumed);
+	y = audio_stream_wrap(sink, (char *)audio_stream_get_wptr(sink) + bsink->size);
+
+	bsource->consumed += VOL_S32_SAMPLES_TO_BYTES(remaining_samples);
+	bsink->size += VOL_S32_SAMPLES_TO_BYTES(remaining_samples);
+	for (j = 0; j < nch; j++)
+		gain[j] = cd->ramp_gain[j];
+
+	while (remaining_samples) {
+		nmax = audio_stream_samples_without_wrap_s24(source, x);
+		n = MIN(remaining_samples, nmax);
+		nmax = audio_stream_samples_without_wrap_s24(sink, y);
+		n = MIN(n, nmax);
+		for (i = 0; i < n; i += nch) {
+			vol_ramp_gain(cd, gain, nch);
+			if (zc) {
+				sum = 0;
+				for (j = 0; j < nch; j++)
+					sum += sign_extend_s24(x[i + j]);
+
+				vol_ramp_zc(cd, gain, sum, nch);
+			}
+
+			for (j = 0; j < nch; j++)
+				y[i + j] = vol_mult_s24_to_s24(x[i + j], vol[j]);
+		}
+		remaining_samples -= n;
+		x = audio_stream_wrap(source, x + n);
+		y = audio_stream_wrap(sink, y + n);
+	}
+}
 #endif /* CONFIG_FORMAT_S24LE */
 
 #if CONFIG_FORMAT_S32LE
@@ -228,6 +318,63 @@ static void vol_passthrough_s32_to_s32(struct processing_module *mod,
 		y = audio_stream_wrap(sink, y + n);
 	}
 }
+/**
+ * \brief Volume processing from 32 bit to 32 bit with gain ramp.
+ * \param[in,out] mod Pointer to struct processing_module
+ * \param[in,out] bsource Input buffer.
+ * \param[in,out] bsink Destination buffer.
+ * \param[in] frames Number of frames to process.
+ * \param[in] zc Update gain only in zero crossings.
+ *
+ * Copy and scale volume from 32 bit source buffer to 32 bit
+ * destination buffer with the gain interpolated in every frame.
+ */
+static void vol_ramp_s32_to_s32(struct processing_module *mod, struct input_stream_buffer *bsource,
+				struct output_stream_buffer *bsink, uint32_t frames, bool zc)
+{
+	struct vol_data *cd = module_get_private_data(mod);
+	struct audio_stream *source = bsource->data;
+	struct audio_stream *sink = bsink->data;
+	int32_t gain[SOF_IPC_MAX_CHANNELS];
+	int32_t *vol = zc ? cd->zc_gain : gain;
+	int64_t sum;
+	int32_t *x;
+	int32_t *y;
+	int nmax, n, i, j;
+	const int nch = audio_stream_get_channels(source);
+	int remaining_samples = frames * nch;
+
+	x = audio_stream_wrap(source, (char *)audio_stream_get_rptr(source) + bsource->consumed);
+	y = audio_stream_wrap(sink, (char *)audio_stream_get_wptr(sink) + bsink->size);
+	bsource->consumed += VOL_S32_SAMPLES_TO_BYTES(remaining_samples);
+	bsink->size += VOL_S32_SAMPLES_TO_BYTES(remaining_samples);
+	for (j = 0; j < nch; j++)
+		gain[j] = cd->ramp_gain[j];
+
+	while (remaining_samples) {
+		nmax = audio_stream_samples_without_wrap_s32(source, x);
+		n = MIN(remaining_samples, nmax);
+		nmax = audio_stream_samples_without_wrap_s32(sink, y);
+		n = MIN(n, nmax);
+		for (i = 0; i < n; i += nch) {
+			vol_ramp_gain(cd, gain, nch);
+			if (zc) {
+				sum = 0;
+				for (j = 0; j < nch; j++)
+					sum += x[i + j];
+
+				vol_ramp_zc(cd, gain, sum, nch);
+			}
+
+			for (j = 0; j < nch; j++)
+				y[i + j] = q_multsr_sat_32x32(x[i + j], vol[j],
+							      Q_SHIFT_BITS_64(31, VOL_QXY_Y, 31));
+		}
+		remaining_samples -= n;
+		x = audio_stream_wrap(source, x + n);
+		y = audio_stream_wrap(sink, y + n);
+	}
+}
 #endif /* CONFIG_FORMAT_S32LE */
 
 #if CONFIG_FORMAT_S16LE
@@ -319,17 +466,77 @@ static void vol_passthrough_s16_to_s16(struct processing_module *mod,
 		y = audio_stream_wrap(sink, y + n);
 	}
 }
+/**
+ * \brief Volume processing from 16 bit to 16 bit with gain ramp.
+ * \param[in,out] mod Pointer to struct processing_module
+ * \param[in,out] bsource Input buffer.
+ * \param[in,out] bsink Destination buffer.
+ * \param[in] frames Number of frames to process.
+ * \param[in] zc Update gain only in zero crossings.
+ *
+ * Copy and scale volume from 16 bit source buffer to 16 bit
+ * destination buffer with the gain interpolated in every frame.
+ */
+static void vol_ramp_s16_to_s16(struct processing_module *mod, struct input_stream_buffer *bsource,
+				struct output_stream_buffer *bsink, uint32_t frames, bool zc)
+{
+	struct vol_data *cd = module_get_private_data(mod);
+	struct audio_stream *source = bsource->data;
+	struct audio_stream *sink = bsink->data;
+	int32_t gain[SOF_IPC_MAX_CHANNELS];
+	int32_t *vol = zc ? cd->zc_gain : gain;
+	int64_t sum;
+	int16_t *x;
+	int16_t *y;
+	int nmax, n, i, j;
+	const int shift = Q_SHIFT_BITS_32(15, VOL_QXY_Y, 15);
+	const int nch = audio_stream_get_channels(source);
+	int remaining_samples = frames * nch;
+
+	x = audio_stream_wrap(source, (char *)audio_stream_get_rptr(source) + bsource->consumed);
+	y = audio_stream_wrap(sink, (char *)audio_stream_get_wptr(sink) + bsink->size);
+	bsource->consumed += VOL_S16_SAMPLES_TO_BYTES(remaining_samples);
+	bsink->size += VOL_S16_SAMPLES_TO_BYTES(remaining_samples);
+	for (j = 0; j < nch; j++)
+		gain[j] = cd->ramp_gain[j];
+
+	while (remaining_samples) {
+		nmax = audio_stream_samples_without_wrap_s16(source, x);
+		n = MIN(remaining_samples, nmax);
+		nmax = audio_stream_samples_without_wrap_s16(sink, y);
+		n = MIN(n, nmax);
+		for (i = 0; i < n; i += nch) {
+			vol_ramp_gain(cd, gain, nch);
+			if (zc) {
+				sum = 0;
+				for (j = 0; j < nch; j++)
+					sum += x[i + j];
+
+				vol_ramp_zc(cd, gain, sum, nch);
+			}
+
+			for (j = 0; j < nch; j++)
+				y[i + j] = q_multsr_sat_32x32_16(x[i + j], vol[j], shift);
+		}
+		remaining_samples -= n;
+		x = audio_stream_wrap(source, x + n);
+		y = audio_stream_wrap(sink, y + n);
+	}
+}
 #endif /* CONFIG_FORMAT_S16LE */
 
 const struct comp_func_map volume_func_map[] = {
 #if CONFIG_FORMAT_S16LE
-	{ SOF_IPC_FRAME_S16_LE, vol_s16_to_s16, vol_passthrough_s16_to_s16},
+	{ SOF_IPC_FRAME_S16_LE, vol_s16_to_s16, vol_passthrough_s16_to_s16,
+	  vol_ramp_s16_to_s16 },
 #endif
 #if CONFIG_FORMAT_S24LE
-	{ SOF_IPC_FRAME_S24_4LE, vol_s24_to_s24, vol_passthrough_s24_to_s24},
+	{ SOF_IPC_FRAME_S24_4LE, vol_s24_to_s24, vol_passthrough_s24_to_s24,
+	  vol_ramp_s24_to_s24 },
 #endif
 #if CONFIG_FORMAT_S32LE
-	{ SOF_IPC_FRAME_S32_LE, vol_s32_to_s32, vol_passthrough_s32_to_s32},
+	{ SOF_IPC_FRAME_S32_LE, vol_s32_to_s32, vol_passthrough_s32_to_s32,
+	  vol_ramp_s32_to_s32 },
 #endif
 };
 
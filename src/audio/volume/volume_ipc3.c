@@ -46,6 +46,7 @@ void set_volume_process(struct vol_data *cd, struct comp_dev *dev, bool source_o
 					  struct comp_buffer, source_list);
 
 	cd->scale_vol = vol_get_processing_function(dev, bufferb, cd);
+	cd->ramp_vol = vol_get_ramp_function(bufferb);
 }
 
 /**
@@ -37,6 +37,7 @@ LOG_MODULE_DECLARE(volume, CONFIG_SOF_LOG_LEVEL);
 void set_volume_process(struct vol_data *cd, struct comp_dev *dev, bool source_or_sink)
 {
 	cd->scale_vol = vol_get_processing_function(dev, cd);
+	cd->ramp_vol = vol_get_ramp_function(dev);
 }
 
 static int set_volume_ipc4(struct vol_data *cd, uint32_t const channel,
@@ -255,6 +256,7 @@ static int volume_set_volume(struct processing_module *mod, const uint8_t *data,
 	volume_set_ramp_channel_counter(cd, channels_count);
 
 	cd->scale_vol = vol_get_processing_function(dev, cd);
+	cd->ramp_vol = vol_get_ramp_function(dev);
 
 	volume_prepare_ramp(dev, cd);
 
@@ -8,6 +8,7 @@
 #ifndef __SOF_CROSSOVER_COMMON_H__
 #define __SOF_CROSSOVER_COMMON_H__
 
+#include <sof/math/iir_block.h>
 #include <sof/math/iir_df2t.h>
 #include <user/eq.h>
 
@@ -23,6 +24,8 @@
 #define CROSSOVER_MAX_LR4 3
 /* Maximum Number of sinks allowed in config */
 #define SOF_CROSSOVER_MAX_STREAMS 4
+/* Number of frames processed at a time by the split functions */
+#define CROSSOVER_BLOCK_FRAMES IIR_BLOCK_FRAMES
 
 /**
  * Stores the state of one channel of the Crossover filter
@@ -33,8 +36,21 @@ struct crossover_state {
 	struct iir_state_df2t highpass[CROSSOVER_MAX_LR4];
 };
 
-typedef void (*crossover_split)(int32_t in, int32_t out[],
-				struct crossover_state *state);
+/**
+ * Stores the LR4 filters of all channels as block IIR filters and the
+ * buffers for CROSSOVER_BLOCK_FRAMES interleaved frames.
+ */
+struct crossover_block {
+	struct iir_block_df2t lowpass[CROSSOVER_MAX_LR4];
+	struct iir_block_df2t highpass[CROSSOVER_MAX_LR4];
+	int32_t *in; /* Input frames */
+	int32_t *out[SOF_CROSSOVER_MAX_STREAMS]; /* Output frames of each band */
+	int32_t *tmp; /* Phase alignment of 3-way split */
+};
+
+/* Splits frames from x to the out buffers, x can be block->in */
+typedef void (*crossover_split)(struct crossover_block *block, const int32_t *x,
+				int32_t *out[], int frames);
 
 extern const crossover_split crossover_split_fnmap[];
 
@@ -43,6 +59,12 @@ int crossover_init_coef_ch(struct sof_eq_iir_biquad *coef,
 			   struct crossover_state *ch_state,
 			   int32_t num_sinks);
 
+/* Initialize the block filters from the channels states */
+int crossover_block_init(struct crossover_block *block, struct crossover_state state[],
+			 int channels, int32_t num_sinks);
+
+void crossover_block_free(struct crossover_block *block);
+
 /**
  * \brief Reset the state of an LR4 filter.
  */
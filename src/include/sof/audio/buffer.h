@@ -109,6 +109,7 @@ extern struct tr_ctx buffer_tr;
 /* buffer callback types */
 #define BUFF_CB_TYPE_PRODUCE	BIT(0)
 #define BUFF_CB_TYPE_CONSUME	BIT(1)
+#define BUFF_CB_TYPE_FREE	BIT(2)
 
 #define BUFFER_UPDATE_IF_UNSET	0
 #define BUFFER_UPDATE_FORCE	1
@@ -158,6 +159,11 @@ struct comp_buffer {
 
 	bool hw_params_configured; /**< indicates whether hw params were set */
 	bool walking;		/**< indicates if the buffer is being walked */
+
+	/* observers */
+	struct list_item hook_list;	/**< list of struct buffer_hook */
+	uint32_t hook_types;		/**< BUFF_CB_TYPE_* of all hooks */
+	struct k_spinlock hook_lock;	/**< protects hook_list and hook_types */
 };
 
 /* Only to be used for synchronous same-core notifications! */
@@ -171,6 +177,20 @@ struct buffer_cb_free {
 	struct comp_buffer *buffer;
 };
 
+/**
+ * Buffer observer, run synchronously on the core updating the buffer.
+ * The hook memory belongs to the observer, the buffer only links it.
+ * The callback data is struct buffer_cb_transact for produce and consume
+ * and struct buffer_cb_free for free.
+ */
+struct buffer_hook {
+	struct list_item list;		/**< list in comp_buffer hook_list */
+	struct comp_buffer *buffer;	/**< observed buffer, NULL if detached */
+	uint32_t types;			/**< BUFF_CB_TYPE_* to be called for */
+	void (*cb)(void *arg, uint32_t type, void *data);
+	void *arg;			/**< private data passed to cb */
+};
+
 #define buffer_comp_list(buffer, dir) \
 	((dir) == PPL_DIR_DOWNSTREAM ? &buffer->source_list : \
 	 &buffer->sink_list)
@@ -195,6 +215,10 @@ int buffer_set_size(struct comp_buffer *buffer, uint32_t size, uint32_t alignmen
 void buffer_free(struct comp_buffer *buffer);
 void buffer_zero(struct comp_buffer *buffer);
 
+/* observers, only a free hook callback may remove its own hook */
+void buffer_hook_add(struct comp_buffer *buffer, struct buffer_hook *hook);
+void buffer_hook_remove(struct buffer_hook *hook);
+
 /* called by a component after producing data into this buffer */
 void comp_update_buffer_produce(struct comp_buffer *buffer, uint32_t bytes);
 
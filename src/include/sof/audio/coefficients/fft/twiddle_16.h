@@ -1,6 +1,6 @@
 /* SPDX-License-Identifier: BSD-3-Clause
  *
- * Copyright(c) 2022 Intel Corporation. All rights reserved.
+ * Copyright(c) 2023 Intel Corporation. All rights reserved.
  *
  */
 
@@ -11,2062 +11,2059 @@
 
 #include <stdint.h>
 
-#define FFT_SIZE_MAX	1024
+#define FFT_SIZE_MAX	8192
 
-/* in Q1.15, generated from cos(i * 2 * pi / FFT_SIZE_MAX) */
-const int16_t twiddle_real_16[FFT_SIZE_MAX] = {
+/* in Q1.15, generated from cos(i * 2 * pi / FFT_SIZE_MAX) for the first quarter */
+const int16_t twiddle_cos_16[FFT_SIZE_MAX / 4 + 1] = {
+	32767,
+	32767,
+	32767,
+	32767,
+	32767,
+	32767,
+	32767,
 	32767,
 	32767,
-	32766,
-	32762,
-	32758,
-	32753,
-	32746,
-	32738,
-	32729,
-	32718,
-	32706,
-	32693,
-	32679,
-	32664,
-	32647,
-	32629,
-	32610,
-	32590,
-	32568,
-	32546,
-	32522,
-	32496,
-	32470,
-	32442,
-	32413,
-	32383,
-	32352,
-	32319,
-	32286,
-	32251,
-	32214,
-	32177,
-	32138,
-	32099,
-	32058,
-	32015,
-	31972,
-	31927,
-	31881,
-	31834,
-	31786,
-	31737,
-	31686,
-	31634,
-	31581,
-	31527,
-	31471,
-	31415,
-	31357,
-	31298,
-	31238,
-	31177,
-	31114,
-	31050,
-	30986,
-	30920,
-	30853,
-	30784,
-	30715,
-	30644,
-	30572,
-	30499,
-	30425,
-	30350,
-	30274,
-	30196,
-	30118,
-	30038,
-	29957,
-	29875,
-	29792,
-	29707,
-	29622,
-	29535,
-	29448,
-	29359,
-	29269,
-	29178,
-	29086,
-	28993,
-	28899,
-	28803,
-	28707,
-	28610,
-	28511,
-	28411,
-	28311,
-	28209,
-	28106,
-	28002,
-	27897,
-	27791,
-	27684,
-	27576,
-	27467,
-	27357,
-	27246,
-	27133,
-	27020,
-	26906,
-	26791,
-	26674,
-	26557,
-	26439,
-	26320,
-	26199,
-	26078,
-	25956,
-	25833,
-	25708,
-	25583,
-	25457,
-	25330,
-	25202,
-	25073,
-	24943,
-	24812,
-	24680,
-	24548,
-	24414,
-	24279,
-	24144,
-	24008,
-	23870,
-	23732,
-	23593,
-	23453,
-	23312,
-	23170,
-	23028,
-	22884,
-	22740,
-	22595,
-	22449,
-	22302,
-	22154,
-	22006,
-	21856,
-	21706,
-	21555,
-	21403,
-	21251,
-	21097,
-	20943,
-	20788,
-	20632,
-	20475,
-	20318,
-	20160,
-	20001,
-	19841,
-	19681,
-	19520,
-	19358,
-	19195,
-	19032,
-	18868,
-	18703,
-	18538,
-	18372,
-	18205,
-	18037,
-	17869,
-	17700,
-	17531,
-	17361,
-	17190,
-	17018,
-	16846,
-	16673,
-	16500,
-	16326,
-	16151,
-	15976,
-	15800,
-	15624,
-	15447,
-	15269,
-	15091,
-	14912,
-	14733,
-	14553,
-	14373,
-	14192,
-	14010,
-	13828,
-	13646,
-	13463,
-	13279,
-	13095,
-	12910,
-	12725,
-	12540,
-	12354,
-	12167,
-	11980,
-	11793,
-	11605,
-	11417,
-	11228,
-	11039,
-	10850,
-	10660,
-	10469,
-	10279,
-	10088,
-	9896,
-	9704,
-	9512,
-	9319,
-	9127,
-	8933,
-	8740,
-	8546,
-	8351,
-	8157,
-	7962,
-	7767,
-	7571,
-	7376,
-	7180,
-	6983,
-	6787,
-	6590,
-	6393,
-	6195,
-	5998,
-	5800,
-	5602,
-	5404,
-	5205,
-	5007,
-	4808,
-	4609,
-	4410,
-	4211,
-	4011,
-	3812,
-	3612,
-	3412,
-	3212,
-	3012,
-	2811,
-	2611,
-	2411,
-	2210,
-	2009,
-	1809,
-	1608,
-	1407,
-	1206,
-	1005,
-	804,
-	603,
-	402,
-	201,
-	0,
-	-201,
-	-402,
-	-603,
-	-804,
-	-1005,
-	-1206,
-	-1407,
-	-1608,
-	-1809,
-	-2009,
-	-2210,
-	-2411,
-	-2611,
-	-2811,
-	-3012,
-	-3212,
-	-3412,
-	-3612,
-	-3812,
-	-4011,
-	-4211,
-	-4410,
-	-4609,
-	-4808,
-	-5007,
-	-5205,
-	-5404,
-	-5602,
-	-5800,
-	-5998,
-	-6195,
-	-6393,
-	-6590,
-	-6787,
-	-6983,
-	-7180,
-	-7376,
-	-7571,
-	-7767,
-	-7962,
-	-8157,
-	-8351,
-	-8546,
-	-8740,
-	-8933,
-	-9127,
-	-9319,
-	-9512,
-	-9704,
-	-9896,
-	-10088,
-	-10279,
-	-10469,
-	-10660,
-	-10850,
-	-11039,
-	-11228,
-	-11417,
-	-11605,
-	-11793,
-	-11980,
-	-12167,
-	-12354,
-	-12540,
-	-12725,
-	-12910,
-	-13095,
-	-13279,
-	-13463,
-	-13646,
-	-13828,
-	-14010,
-	-14192,
-	-14373,
-	-14553,
-	-14733,
-	-14912,
-	-15091,
-	-15269,
-	-15447,
-	-15624,
-	-15800,
-	-15976,
-	-16151,
-	-16326,
-	-16500,
-	-16673,
-	-16846,
-	-17018,
-	-17190,
-	-17361,
-	-17531,
-	-17700,
-	-17869,
-	-18037,
-	-18205,
-	-18372,
-	-18538,
-	-18703,
-	-18868,
-	-19032,
-	-19195,
-	-19358,
-	-19520,
-	-19681,
-	-19841,
-	-20001,
-	-20160,
-	-20318,
-	-20475,
-	-20632,
-	-20788,
-	-20943,
-	-21097,
-	-21251,
-	-21403,
-	-21555,
-	-21706,
-	-21856,
-	-22006,
-	-22154,
-	-22302,
-	-22449,
-	-22595,
-	-22740,
-	-22884,
-	-23028,
-	-23170,
-	-23312,
-	-23453,
-	-23593,
-	-23732,
-	-23870,
-	-24008,
-	-24144,
-	-24279,
-	-24414,
-	-24548,
-	-24680,
-	-24812,
-	-24943,
-	-25073,
-	-25202,
-	-25330,
-	-25457,
-	-25583,
-	-25708,
-	-25833,
-	-25956,
-	-26078,
-	-26199,
-	-26320,
-	-26439,
-	-26557,
-	-26674,
-	-26791,
-	-26906,
-	-27020,
-	-27133,
-	-27246,
-	-27357,
-	-27467,
-	-27576,
-	-27684,
-	-27791,
-	-27897,
-	-28002,
-	-28106,
-	-28209,
-	-28311,
-	-28411,
-	-28511,
-	-28610,
-	-28707,
-	-28803,
-	-28899,
-	-28993,
-	-29086,
-	-29178,
-	-29269,
-	-29359,
-	-29448,
-	-29535,
-	-29622,
-	-29707,
-	-29792,
-	-29875,
-	-29957,
-	-30038,
-	-30118,
-	-30196,
-	-30274,
-	-30350,
-	-30425,
-	-30499,
-	-30572,
-	-30644,
-	-30715,
-	-30784,
-	-30853,
-	-30920,
-	-30986,
-	-31050,
-	-31114,
-	-31177,
-	-31238,
-	-31298,
-	-31357,
-	-31415,
-	-31471,
-	-31527,
-	-31581,
-	-31634,
-	-31686,
-	-31737,
-	-31786,
-	-31834,
-	-31881,
-	-31927,
-	-31972,
-	-32015,
-	-32058,
-	-32099,
-	-32138,
-	-32177,
-	-32214,
-	-32251,
-	-32286,
-	-32319,
-	-32352,
-	-32383,
-	-32413,
-	-32442,
-	-32470,
-	-32496,
-	-32522,
-	-32546,
-	-32568,
-	-32590,
-	-32610,
-	-32629,
-	-32647,
-	-32664,
-	-32679,
-	-32693,
-	-32706,
-	-32718,
-	-32729,
-	-32738,
-	-32746,
-	-32753,
-	-32758,
-	-32762,
-	-32766,
-	-32767,
-	-32767,
-	-32767,
-	-32766,
-	-32762,
-	-32758,
-	-32753,
-	-32746,
-	-32738,
-	-32729,
-	-32718,
-	-32706,
-	-32693,
-	-32679,
-	-32664,
-	-32647,
-	-32629,
-	-32610,
-	-32590,
-	-32568,
-	-32546,
-	-32522,
-	-32496,
-	-32470,
-	-32442,
-	-32413,
-	-32383,
-	-32352,
-	-32319,
-	-32286,
-	-32251,
-	-32214,
-	-32177,
-	-32138,
-	-32099,
-	-32058,
-	-32015,
-	-31972,
-	-31927,
-	-31881,
-	-31834,
-	-31786,
-	-31737,
-	-31686,
-	-31634,
-	-31581,
-	-31527,
-	-31471,
-	-31415,
-	-31357,
-	-31298,
-	-31238,
-	-31177,
-	-31114,
-	-31050,
-	-30986,
-	-30920,
-	-30853,
-	-30784,
-	-30715,
-	-30644,
-	-30572,
-	-30499,
-	-30425,
-	-30350,
-	-30274,
-	-30196,
-	-30118,
-	-30038,
-	-29957,
-	-29875,
-	-29792,
-	-29707,
-	-29622,
-	-29535,
-	-29448,
-	-29359,
-	-29269,
-	-29178,
-	-29086,
-	-28993,
-	-28899,
-	-28803,
-	-28707,
-	-28610,
-	-28511,
-	-28411,
-	-28311,
-	-28209,
-	-28106,
-	-28002,
-	-27897,
-	-27791,
-	-27684,
-	-27576,
-	-27467,
-	-27357,
-	-27246,
-	-27133,
-	-27020,
-	-26906,
-	-26791,
-	-26674,
-	-26557,
-	-26439,
-	-26320,
-	-26199,
-	-26078,
-	-25956,
-	-25833,
-	-25708,
-	-25583,
-	-25457,
-	-25330,
-	-25202,
-	-25073,
-	-24943,
-	-24812,
-	-24680,
-	-24548,
-	-24414,
-	-24279,
-	-24144,
-	-24008,
-	-23870,
-	-23732,
-	-23593,
-	-23453,
-	-23312,
-	-23170,
-	-23028,
-	-22884,
-	-22740,
-	-22595,
-	-22449,
-	-22302,
-	-22154,
-	-22006,
-	-21856,
-	-21706,
-	-21555,
-	-21403,
-	-21251,
-	-21097,
-	-20943,
-	-20788,
-	-20632,
-	-20475,
-	-20318,
-	-20160,
-	-20001,
-	-19841,
-	-19681,
-	-19520,
-	-19358,
-	-19195,
-	-19032,
-	-18868,
-	-18703,
-	-18538,
-	-18372,
-	-18205,
-	-18037,
-	-17869,
-	-17700,
-	-17531,
-	-17361,
-	-17190,
-	-17018,
-	-16846,
-	-16673,
-	-16500,
-	-16326,
-	-16151,
-	-15976,
-	-15800,
-	-15624,
-	-15447,
-	-15269,
-	-15091,
-	-14912,
-	-14733,
-	-14553,
-	-14373,
-	-14192,
-	-14010,
-	-13828,
-	-13646,
-	-13463,
-	-13279,
-	-13095,
-	-12910,
-	-12725,
-	-12540,
-	-12354,
-	-12167,
-	-11980,
-	-11793,
-	-11605,
-	-11417,
-	-11228,
-	-11039,
-	-10850,
-	-10660,
-	-10469,
-	-10279,
-	-10088,
-	-9896,
-	-9704,
-	-9512,
-	-9319,
-	-9127,
-	-8933,
-	-8740,
-	-8546,
-	-8351,
-	-8157,
-	-7962,
-	-7767,
-	-7571,
-	-7376,
-	-7180,
-	-6983,
-	-6787,
-	-6590,
-	-6393,
-	-6195,
-	-5998,
-	-5800,
-	-5602,
-	-5404,
-	-5205,
-	-5007,
-	-4808,
-	-4609,
-	-4410,
-	-4211,
-	-4011,
-	-3812,
-	-3612,
-	-3412,
-	-3212,
-	-3012,
-	-2811,
-	-2611,
-	-2411,
-	-2210,
-	-2009,
-	-1809,
-	-1608,
-	-1407,
-	-1206,
-	-1005,
-	-804,
-	-603,
-	-402,
-	-201,
-	0,
-	201,
-	402,
-	603,
-	804,
-	1005,
-	1206,
-	1407,
-	1608,
-	1809,
-	2009,
-	2210,
-	2411,
-	2611,
-	2811,
-	3012,
-	3212,
-	3412,
-	3612,
-	3812,
-	4011,
-	4211,
-	4410,
-	4609,
-	4808,
-	5007,
-	5205,
-	5404,
-	5602,
-	5800,
-	5998,
-	6195,
-	6393,
-	6590,
-	6787,
-	6983,
-	7180,
-	7376,
-	7571,
-	7767,
-	7962,
-	8157,
-	8351,
-	8546,
-	8740,
-	8933,
-	9127,
-	9319,
-	9512,
-	9704,
-	9896,
-	10088,
-	10279,
-	10469,
-	10660,
-	10850,
-	11039,
-	11228,
-	11417,
-	11605,
-	11793,
-	11980,
-	12167,
-	12354,
-	12540,
-	12725,
-	12910,
-	13095,
-	13279,
-	13463,
-	13646,
-	13828,
-	14010,
-	14192,
-	14373,
-	14553,
-	14733,
-	14912,
-	15091,
-	15269,
-	15447,
-	15624,
-	15800,
-	15976,
-	16151,
-	16326,
-	16500,
-	16673,
-	16846,
-	17018,
-	17190,
-	17361,
-	17531,
-	17700,
-	17869,
-	18037,
-	18205,
-	18372,
-	18538,
-	18703,
-	18868,
-	19032,
-	19195,
-	19358,
-	19520,
-	19681,
-	19841,
-	20001,
-	20160,
-	20318,
-	20475,
-	20632,
-	20788,
-	20943,
-	21097,
-	21251,
-	21403,
-	21555,
-	21706,
-	21856,
-	22006,
-	22154,
-	22302,
-	22449,
-	22595,
-	22740,
-	22884,
-	23028,
-	23170,
-	23312,
-	23453,
-	23593,
-	23732,
-	23870,
-	24008,
-	24144,
-	24279,
-	24414,
-	24548,
-	24680,
-	24812,
-	24943,
-	25073,
-	25202,
-	25330,
-	25457,
-	25583,
-	25708,
-	25833,
-	25956,
-	26078,
-	26199,
-	26320,
-	26439,
-	26557,
-	26674,
-	26791,
-	26906,
-	27020,
-	27133,
-	27246,
-	27357,
-	27467,
-	27576,
-	27684,
-	27791,
-	27897,
-	28002,
-	28106,
-	28209,
-	28311,
-	28411,
-	28511,
-	28610,
-	28707,
-	28803,
-	28899,
-	28993,
-	29086,
-	29178,
-	29269,
-	29359,
-	29448,
-	29535,
-	29622,
-	29707,
-	29792,
-	29875,
-	29957,
-	30038,
-	30118,
-	30196,
-	30274,
-	30350,
-	30425,
-	30499,
-	30572,
-	30644,
-	30715,
-	30784,
-	30853,
-	30920,
-	30986,
-	31050,
-	31114,
-	31177,
-	31238,
-	31298,
-	31357,
-	31415,
-	31471,
-	31527,
-	31581,
-	31634,
-	31686,
-	31737,
-	31786,
-	31834,
-	31881,
-	31927,
-	31972,
-	32015,
-	32058,
-	32099,
-	32138,
-	32177,
-	32214,
-	32251,
-	32286,
-	32319,
-	32352,
-	32383,
-	32413,
-	32442,
-	32470,
-	32496,
-	32522,
-	32546,
-	32568,
-	32590,
-	32610,
-	32629,
-	32647,
-	32664,
-	32679,
-	32693,
-	32706,
-	32718,
-	32729,
-	32738,
-	32746,
-	32753,
-	32758,
-	32762,
-	32766,
-	32767,
-};
-
-/* in Q1.15, generated from sin(i * 2 * pi / FFT_SIZE_MAX) */
-const int16_t twiddle_imag_16[FFT_SIZE_MAX] = {
-	0,
-	-201,
-	-402,
-	-603,
-	-804,
-	-1005,
-	-1206,
-	-1407,
-	-1608,
-	-1809,
-	-2009,
-	-2210,
-	-2411,
-	-2611,
-	-2811,
-	-3012,
-	-3212,
-	-3412,
-	-3612,
-	-3812,
-	-4011,
-	-4211,
-	-4410,
-	-4609,
-	-4808,
-	-5007,
-	-5205,
-	-5404,
-	-5602,
-	-5800,
-	-5998,
-	-6195,
-	-6393,
-	-6590,
-	-6787,
-	-6983,
-	-7180,
-	-7376,
-	-7571,
-	-7767,
-	-7962,
-	-8157,
-	-8351,
-	-8546,
-	-8740,
-	-8933,
-	-9127,
-	-9319,
-	-9512,
-	-9704,
-	-9896,
-	-10088,
-	-10279,
-	-10469,
-	-10660,
-	-10850,
-	-11039,
-	-11228,
-	-11417,
-	-11605,
-	-11793,
-	-11980,
-	-12167,
-	-12354,
-	-12540,
-	-12725,
-	-12910,
-	-13095,
-	-13279,
-	-13463,
-	-13646,
-	-13828,
-	-14010,
-	-14192,
-	-14373,
-	-14553,
-	-14733,
-	-14912,
-	-15091,
-	-15269,
-	-15447,
-	-15624,
-	-15800,
-	-15976,
-	-16151,
-	-16326,
-	-16500,
-	-16673,
-	-16846,
-	-17018,
-	-17190,
-	-17361,
-	-17531,
-	-17700,
-	-17869,
-	-18037,
-	-18205,
-	-18372,
-	-18538,
-	-18703,
-	-18868,
-	-19032,
-	-19195,
-	-19358,
-	-19520,
-	-19681,
-	-19841,
-	-20001,
-	-20160,
-	-20318,
-	-20475,
-	-20632,
-	-20788,
-	-20943,
-	-21097,
-	-21251,
-	-21403,
-	-21555,
-	-21706,
-	-21856,
-	-22006,
-	-22154,
-	-22302,
-	-22449,
-	-22595,
-	-22740,
-	-22884,
-	-23028,
-	-23170,
-	-23312,
-	-23453,
-	-23593,
-	-23732,
-	-23870,
-	-24008,
-	-24144,
-	-24279,
-	-24414,
-	-24548,
-	-24680,
-	-24812,
-	-24943,
-	-25073,
-	-25202,
-	-25330,
-	-25457,
-	-25583,
-	-25708,
-	-25833,
-	-25956,
-	-26078,
-	-26199,
-	-26320,
-	-26439,
-	-26557,
-	-26674,
-	-26791,
-	-26906,
-	-27020,
-	-27133,
-	-27246,
-	-27357,
-	-27467,
-	-27576,
-	-27684,
-	-27791,
-	-27897,
-	-28002,
-	-28106,
-	-28209,
-	-28311,
-	-28411,
-	-28511,
-	-28610,
-	-28707,
-	-28803,
-	-28899,
-	-28993,
-	-29086,
-	-29178,
-	-29269,
-	-29359,
-	-29448,
-	-29535,
-	-29622,
-	-29707,
-	-29792,
-	-29875,
-	-29957,
-	-30038,
-	-30118,
-	-30196,
-	-30274,
-	-30350,
-	-30425,
-	-30499,
-	-30572,
-	-30644,
-	-30715,
-	-30784,
-	-30853,
-	-30920,
-	-30986,
-	-31050,
-	-31114,
-	-31177,
-	-31238,
-	-31298,
-	-31357,
-	-31415,
-	-31471,
-	-31527,
-	-31581,
-	-31634,
-	-31686,
-	-31737,
-	-31786,
-	-31834,
-	-31881,
-	-31927,
-	-31972,
-	-32015,
-	-32058,
-	-32099,
-	-32138,
-	-32177,
-	-32214,
-	-32251,
-	-32286,
-	-32319,
-	-32352,
-	-32383,
-	-32413,
-	-32442,
-	-32470,
-	-32496,
-	-32522,
-	-32546,
-	-32568,
-	-32590,
-	-32610,
-	-32629,
-	-32647,
-	-32664,
-	-32679,
-	-32693,
-	-32706,
-	-32718,
-	-32729,
-	-32738,
-	-32746,
-	-32753,
-	-32758,
-	-32762,
-	-32766,
-	-32767,
-	-32767,
-	-32767,
-	-32766,
-	-32762,
-	-32758,
-	-32753,
-	-32746,
-	-32738,
-	-32729,
-	-32718,
-	-32706,
-	-32693,
-	-32679,
-	-32664,
-	-32647,
-	-32629,
-	-32610,
-	-32590,
-	-32568,
-	-32546,
-	-32522,
-	-32496,
-	-32470,
-	-32442,
-	-32413,
-	-32383,
-	-32352,
-	-32319,
-	-32286,
-	-32251,
-	-32214,
-	-32177,
-	-32138,
-	-32099,
-	-32058,
-	-32015,
-	-31972,
-	-31927,
-	-31881,
-	-31834,
-	-31786,
-	-31737,
-	-31686,
-	-31634,
-	-31581,
-	-31527,
-	-31471,
-	-31415,
-	-31357,
-	-31298,
-	-31238,
-	-31177,
-	-31114,
-	-31050,
-	-30986,
-	-30920,
-	-30853,
-	-30784,
-	-30715,
-	-30644,
-	-30572,
-	-30499,
-	-30425,
-	-30350,
-	-30274,
-	-30196,
-	-30118,
-	-30038,
-	-29957,
-	-29875,
-	-29792,
-	-29707,
-	-29622,
-	-29535,
-	-29448,
-	-29359,
-	-29269,
-	-29178,
-	-29086,
-	-28993,
-	-28899,
-	-28803,
-	-28707,
-	-28610,
-	-28511,
-	-28411,
-	-28311,
-	-28209,
-	-28106,
-	-28002,
-	-27897,
-	-27791,
-	-27684,
-	-27576,
-	-27467,
-	-27357,
-	-27246,
-	-27133,
-	-27020,
-	-26906,
-	-26791,
-	-26674,
-	-26557,
-	-26439,
-	-26320,
-	-26199,
-	-26078,
-	-25956,
-	-25833,
-	-25708,
-	-25583,
-	-25457,
-	-25330,
-	-25202,
-	-25073,
-	-24943,
-	-24812,
-	-24680,
-	-24548,
-	-24414,
-	-24279,
-	-24144,
-	-24008,
-	-23870,
-	-23732,
-	-23593,
-	-23453,
-	-23312,
-	-23170,
-	-23028,
-	-22884,
-	-22740,
-	-22595,
-	-22449,
-	-22302,
-	-22154,
-	-22006,
-	-21856,
-	-21706,
-	-21555,
-	-21403,
-	-21251,
-	-21097,
-	-20943,
-	-20788,
-	-20632,
-	-20475,
-	-20318,
-	-20160,
-	-20001,
-	-19841,
-	-19681,
-	-19520,
-	-19358,
-	-19195,
-	-19032,
-	-18868,
-	-18703,
-	-18538,
-	-18372,
-	-18205,
-	-18037,
-	-17869,
-	-17700,
-	-17531,
-	-17361,
-	-17190,
-	-17018,
-	-16846,
-	-16673,
-	-16500,
-	-16326,
-	-16151,
-	-15976,
-	-15800,
-	-15624,
-	-15447,
-	-15269,
-	-15091,
-	-14912,
-	-14733,
-	-14553,
-	-14373,
-	-14192,
-	-14010,
-	-13828,
-	-13646,
-	-13463,
-	-13279,
-	-13095,
-	-12910,
-	-12725,
-	-12540,
-	-12354,
-	-12167,
-	-11980,
-	-11793,
-	-11605,
-	-11417,
-	-11228,
-	-11039,
-	-10850,
-	-10660,
-	-10469,
-	-10279,
-	-10088,
-	-9896,
-	-9704,
-	-9512,
-	-9319,
-	-9127,
-	-8933,
-	-8740,
-	-8546,
-	-8351,
-	-8157,
-	-7962,
-	-7767,
-	-7571,
-	-7376,
-	-7180,
-	-6983,
-	-6787,
-	-6590,
-	-6393,
-	-6195,
-	-5998,
-	-5800,
-	-5602,
-	-5404,
-	-5205,
-	-5007,
-	-4808,
-	-4609,
-	-4410,
-	-4211,
-	-4011,
-	-3812,
-	-3612,
-	-3412,
-	-3212,
-	-3012,
-	-2811,
-	-2611,
-	-2411,
-	-2210,
-	-2009,
-	-1809,
-	-1608,
-	-1407,
-	-1206,
-	-1005,
-	-804,
-	-603,
-	-402,
-	-201,
-	0,
-	201,
-	402,
-	603,
-	804,
-	1005,
-	1206,
-	1407,
-	1608,
-	1809,
-	2009,
-	2210,
-	2411,
-	2611,
-	2811,
-	3012,
-	3212,
-	3412,
-	3612,
-	3812,
-	4011,
-	4211,
-	4410,
-	4609,
-	4808,
-	5007,
-	5205,
-	5404,
-	5602,
-	5800,
-	5998,
-	6195,
-	6393,
-	6590,
-	6787,
-	6983,
-	7180,
-	7376,
-	7571,
-	7767,
-	7962,
-	8157,
-	8351,
-	8546,
-	8740,
-	8933,
-	9127,
-	9319,
-	9512,
-	9704,
-	9896,
-	10088,
-	10279,
-	10469,
-	10660,
-	10850,
-	11039,
-	11228,
-	11417,
-	11605,
-	11793,
-	11980,
-	12167,
-	12354,
-	12540,
-	12725,
-	12910,
-	13095,
-	13279,
-	13463,
-	13646,
-	13828,
-	14010,
-	14192,
-	14373,
-	14553,
-	14733,
-	14912,
-	15091,
-	15269,
-	15447,
-	15624,
-	15800,
-	15976,
-	16151,
-	16326,
-	16500,
-	16673,
-	16846,
-	17018,
-	17190,
-	17361,
-	17531,
-	17700,
-	17869,
-	18037,
-	18205,
-	18372,
-	18538,
-	18703,
-	18868,
-	19032,
-	19195,
-	19358,
-	19520,
-	19681,
-	19841,
-	20001,
-	20160,
-	20318,
-	20475,
-	20632,
-	20788,
-	20943,
-	21097,
-	21251,
-	21403,
-	21555,
-	21706,
-	21856,
-	22006,
-	22154,
-	22302,
-	22449,
-	22595,
-	22740,
-	22884,
-	23028,
-	23170,
-	23312,
-	23453,
-	23593,
-	23732,
-	23870,
-	24008,
-	24144,
-	24279,
-	24414,
-	24548,
-	24680,
-	24812,
-	24943,
-	25073,
-	25202,
-	25330,
-	25457,
-	25583,
-	25708,
-	25833,
-	25956,
-	26078,
-	26199,
-	26320,
-	26439,
-	26557,
-	26674,
-	26791,
-	26906,
-	27020,
-	27133,
-	27246,
-	27357,
-	27467,
-	27576,
-	27684,
-	27791,
-	27897,
-	28002,
-	28106,
-	28209,
-	28311,
-	28411,
-	28511,
-	28610,
-	28707,
-	28803,
-	28899,
-	28993,
-	29086,
-	29178,
-	29269,
-	29359,
-	29448,
-	29535,
-	29622,
-	29707,
-	29792,
-	29875,
-	29957,
-	30038,
-	30118,
-	30196,
-	30274,
-	30350,
-	30425,
-	30499,
-	30572,
-	30644,
-	30715,
-	30784,
-	30853,
-	30920,
-	30986,
-	31050,
-	31114,
-	31177,
-	31238,
-	31298,
-	31357,
-	31415,
-	31471,
-	31527,
-	31581,
-	31634,
-	31686,
-	31737,
-	31786,
-	31834,
-	31881,
-	31927,
-	31972,
-	32015,
-	32058,
-	32099,
-	32138,
-	32177,
-	32214,
-	32251,
-	32286,
-	32319,
-	32352,
-	32383,
-	32413,
-	32442,
-	32470,
-	32496,
-	32522,
-	32546,
-	32568,
-	32590,
-	32610,
-	32629,
-	32647,
-	32664,
-	32679,
-	32693,
-	32706,
-	32718,
-	32729,
-	32738,
-	32746,
-	32753,
-	32758,
-	32762,
-	32766,
 	32767,
 	32767,
 	32767,
+	32767,
+	32766,
+	32766,
+	32766,
 	32766,
+	32765,
+	32765,
+	32765,
+	32764,
+	32764,
+	32763,
+	32763,
 	32762,
+	32762,
+	32761,
+	32761,
+	32760,
+	32760,
+	32759,
+	32759,
+	32758,
 	32758,
+	32757,
+	32756,
+	32756,
+	32755,
+	32754,
 	32753,
+	32753,
+	32752,
+	32751,
+	32750,
+	32749,
+	32748,
+	32748,
+	32747,
 	32746,
+	32745,
+	32744,
+	32743,
+	32742,
+	32741,
+	32740,
+	32739,
 	32738,
+	32737,
+	32736,
+	32734,
+	32733,
+	32732,
+	32731,
+	32730,
 	32729,
+	32727,
+	32726,
+	32725,
+	32723,
+	32722,
+	32721,
+	32719,
 	32718,
+	32717,
+	32715,
+	32714,
+	32712,
+	32711,
+	32709,
+	32708,
 	32706,
+	32705,
+	32703,
+	32702,
+	32700,
+	32698,
+	32697,
+	32695,
 	32693,
+	32692,
+	32690,
+	32688,
+	32686,
+	32685,
+	32683,
+	32681,
 	32679,
+	32677,
+	32675,
+	32674,
+	32672,
+	32670,
+	32668,
+	32666,
 	32664,
+	32662,
+	32660,
+	32658,
+	32656,
+	32654,
+	32651,
+	32649,
 	32647,
+	32645,
+	32643,
+	32641,
+	32638,
+	32636,
+	32634,
+	32632,
 	32629,
+	32627,
+	32625,
+	32622,
+	32620,
+	32618,
+	32615,
+	32613,
 	32610,
+	32608,
+	32605,
+	32603,
+	32600,
+	32598,
+	32595,
+	32592,
 	32590,
+	32587,
+	32585,
+	32582,
+	32579,
+	32577,
+	32574,
+	32571,
 	32568,
+	32566,
+	32563,
+	32560,
+	32557,
+	32554,
+	32551,
+	32548,
 	32546,
+	32543,
+	32540,
+	32537,
+	32534,
+	32531,
+	32528,
+	32525,
 	32522,
+	32518,
+	32515,
+	32512,
+	32509,
+	32506,
+	32503,
+	32500,
 	32496,
+	32493,
+	32490,
+	32487,
+	32483,
+	32480,
+	32477,
+	32473,
 	32470,
+	32467,
+	32463,
+	32460,
+	32456,
+	32453,
+	32449,
+	32446,
 	32442,
+	32439,
+	32435,
+	32432,
+	32428,
+	32424,
+	32421,
+	32417,
 	32413,
+	32410,
+	32406,
+	32402,
+	32398,
+	32395,
+	32391,
+	32387,
 	32383,
+	32379,
+	32376,
+	32372,
+	32368,
+	32364,
+	32360,
+	32356,
 	32352,
+	32348,
+	32344,
+	32340,
+	32336,
+	32332,
+	32328,
+	32323,
 	32319,
+	32315,
+	32311,
+	32307,
+	32303,
+	32298,
+	32294,
+	32290,
 	32286,
+	32281,
+	32277,
+	32273,
+	32268,
+	32264,
+	32259,
+	32255,
 	32251,
+	32246,
+	32242,
+	32237,
+	32233,
+	32228,
+	32224,
+	32219,
 	32214,
+	32210,
+	32205,
+	32201,
+	32196,
+	32191,
+	32186,
+	32182,
 	32177,
+	32172,
+	32167,
+	32163,
+	32158,
+	32153,
+	32148,
+	32143,
 	32138,
+	32133,
+	32129,
+	32124,
+	32119,
+	32114,
+	32109,
+	32104,
 	32099,
+	32093,
+	32088,
+	32083,
+	32078,
+	32073,
+	32068,
+	32063,
 	32058,
+	32052,
+	32047,
+	32042,
+	32037,
+	32031,
+	32026,
+	32021,
 	32015,
+	32010,
+	32005,
+	31999,
+	31994,
+	31988,
+	31983,
+	31977,
 	31972,
+	31966,
+	31961,
+	31955,
+	31950,
+	31944,
+	31938,
+	31933,
 	31927,
+	31921,
+	31916,
+	31910,
+	31904,
+	31899,
+	31893,
+	31887,
 	31881,
+	31875,
+	31870,
+	31864,
+	31858,
+	31852,
+	31846,
+	31840,
 	31834,
+	31828,
+	31822,
+	31816,
+	31810,
+	31804,
+	31798,
+	31792,
 	31786,
+	31780,
+	31774,
+	31768,
+	31761,
+	31755,
+	31749,
+	31743,
 	31737,
+	31730,
+	31724,
+	31718,
+	31711,
+	31705,
+	31699,
+	31692,
 	31686,
+	31679,
+	31673,
+	31667,
+	31660,
+	31654,
+	31647,
+	31641,
 	31634,
+	31627,
+	31621,
+	31614,
+	31608,
+	31601,
+	31594,
+	31588,
 	31581,
+	31574,
+	31568,
+	31561,
+	31554,
+	31547,
+	31540,
+	31534,
 	31527,
+	31520,
+	31513,
+	31506,
+	31499,
+	31492,
+	31485,
+	31478,
 	31471,
+	31464,
+	31457,
+	31450,
+	31443,
+	31436,
+	31429,
+	31422,
 	31415,
+	31408,
+	31400,
+	31393,
+	31386,
+	31379,
+	31372,
+	31364,
 	31357,
+	31350,
+	31342,
+	31335,
+	31328,
+	31320,
+	31313,
+	31305,
 	31298,
+	31291,
+	31283,
+	31276,
+	31268,
+	31261,
+	31253,
+	31246,
 	31238,
+	31230,
+	31223,
+	31215,
+	31207,
+	31200,
+	31192,
+	31184,
 	31177,
+	31169,
+	31161,
+	31153,
+	31146,
+	31138,
+	31130,
+	31122,
 	31114,
+	31106,
+	31098,
+	31090,
+	31082,
+	31074,
+	31067,
+	31059,
 	31050,
+	31042,
+	31034,
+	31026,
+	31018,
+	31010,
+	31002,
+	30994,
 	30986,
+	30977,
+	30969,
+	30961,
+	30953,
+	30945,
+	30936,
+	30928,
 	30920,
+	30911,
+	30903,
+	30895,
+	30886,
+	30878,
+	30869,
+	30861,
 	30853,
+	30844,
+	30836,
+	30827,
+	30819,
+	30810,
+	30801,
+	30793,
 	30784,
+	30776,
+	30767,
+	30758,
+	30750,
+	30741,
+	30732,
+	30723,
 	30715,
+	30706,
+	30697,
+	30688,
+	30680,
+	30671,
+	30662,
+	30653,
 	30644,
+	30635,
+	30626,
+	30617,
+	30608,
+	30599,
+	30590,
+	30581,
 	30572,
+	30563,
+	30554,
+	30545,
+	30536,
+	30527,
+	30518,
+	30509,
 	30499,
+	30490,
+	30481,
+	30472,
+	30462,
+	30453,
+	30444,
+	30435,
 	30425,
+	30416,
+	30407,
+	30397,
+	30388,
+	30378,
+	30369,
+	30360,
 	30350,
+	30341,
+	30331,
+	30322,
+	30312,
+	30302,
+	30293,
+	30283,
 	30274,
+	30264,
+	30254,
+	30245,
+	30235,
+	30225,
+	30216,
+	30206,
 	30196,
+	30186,
+	30177,
+	30167,
+	30157,
+	30147,
+	30137,
+	30127,
 	30118,
+	30108,
+	30098,
+	30088,
+	30078,
+	30068,
+	30058,
+	30048,
 	30038,
+	30028,
+	30018,
+	30008,
+	29997,
+	29987,
+	29977,
+	29967,
 	29957,
+	29947,
+	29936,
+	29926,
+	29916,
+	29906,
+	29895,
+	29885,
 	29875,
+	29864,
+	29854,
+	29844,
+	29833,
+	29823,
+	29813,
+	29802,
 	29792,
+	29781,
+	29771,
+	29760,
+	29750,
+	29739,
+	29729,
+	29718,
 	29707,
+	29697,
+	29686,
+	29675,
+	29665,
+	29654,
+	29643,
+	29633,
 	29622,
+	29611,
+	29600,
+	29590,
+	29579,
+	29568,
+	29557,
+	29546,
 	29535,
+	29525,
+	29514,
+	29503,
+	29492,
+	29481,
+	29470,
+	29459,
 	29448,
+	29437,
+	29426,
+	29415,
+	29404,
+	29392,
+	29381,
+	29370,
 	29359,
+	29348,
+	29337,
+	29325,
+	29314,
+	29303,
+	29292,
+	29280,
 	29269,
+	29258,
+	29247,
+	29235,
+	29224,
+	29212,
+	29201,
+	29190,
 	29178,
+	29167,
+	29155,
+	29144,
+	29132,
+	29121,
+	29109,
+	29098,
 	29086,
+	29075,
+	29063,
+	29051,
+	29040,
+	29028,
+	29016,
+	29005,
 	28993,
+	28981,
+	28970,
+	28958,
+	28946,
+	28934,
+	28922,
+	28911,
 	28899,
+	28887,
+	28875,
+	28863,
+	28851,
+	28839,
+	28827,
+	28815,
 	28803,
+	28791,
+	28779,
+	28767,
+	28755,
+	28743,
+	28731,
+	28719,
 	28707,
+	28695,
+	28683,
+	28671,
+	28658,
+	28646,
+	28634,
+	28622,
 	28610,
+	28597,
+	28585,
+	28573,
+	28560,
+	28548,
+	28536,
+	28523,
 	28511,
+	28499,
+	28486,
+	28474,
+	28461,
+	28449,
+	28436,
+	28424,
 	28411,
+	28399,
+	28386,
+	28374,
+	28361,
+	28349,
+	28336,
+	28323,
 	28311,
+	28298,
+	28285,
+	28273,
+	28260,
+	28247,
+	28234,
+	28222,
 	28209,
+	28196,
+	28183,
+	28170,
+	28158,
+	28145,
+	28132,
+	28119,
 	28106,
+	28093,
+	28080,
+	28067,
+	28054,
+	28041,
+	28028,
+	28015,
 	28002,
+	27989,
+	27976,
+	27963,
+	27950,
+	27937,
+	27924,
+	27910,
 	27897,
+	27884,
+	27871,
+	27858,
+	27844,
+	27831,
+	27818,
+	27805,
 	27791,
+	27778,
+	27765,
+	27751,
+	27738,
+	27724,
+	27711,
+	27698,
 	27684,
+	27671,
+	27657,
+	27644,
+	27630,
+	27617,
+	27603,
+	27590,
 	27576,
+	27562,
+	27549,
+	27535,
+	27522,
+	27508,
+	27494,
+	27481,
 	27467,
+	27453,
+	27440,
+	27426,
+	27412,
+	27398,
+	27384,
+	27371,
 	27357,
+	27343,
+	27329,
+	27315,
+	27301,
+	27287,
+	27273,
+	27260,
 	27246,
+	27232,
+	27218,
+	27204,
+	27190,
+	27176,
+	27162,
+	27147,
 	27133,
+	27119,
+	27105,
+	27091,
+	27077,
+	27063,
+	27049,
+	27034,
 	27020,
+	27006,
+	26992,
+	26977,
+	26963,
+	26949,
+	26935,
+	26920,
 	26906,
+	26892,
+	26877,
+	26863,
+	26848,
+	26834,
+	26820,
+	26805,
 	26791,
+	26776,
+	26762,
+	26747,
+	26733,
+	26718,
+	26704,
+	26689,
 	26674,
+	26660,
+	26645,
+	26630,
+	26616,
+	26601,
+	26586,
+	26572,
 	26557,
+	26542,
+	26528,
+	26513,
+	26498,
+	26483,
+	26468,
+	26454,
 	26439,
+	26424,
+	26409,
+	26394,
+	26379,
+	26364,
+	26349,
+	26334,
 	26320,
+	26305,
+	26290,
+	26275,
+	26259,
+	26244,
+	26229,
+	26214,
 	26199,
+	26184,
+	26169,
+	26154,
+	26139,
+	26124,
+	26108,
+	26093,
 	26078,
+	26063,
+	26048,
+	26032,
+	26017,
+	26002,
+	25986,
+	25971,
 	25956,
+	25940,
+	25925,
+	25910,
+	25894,
+	25879,
+	25863,
+	25848,
 	25833,
+	25817,
+	25802,
+	25786,
+	25771,
+	25755,
+	25739,
+	25724,
 	25708,
+	25693,
+	25677,
+	25662,
+	25646,
+	25630,
+	25615,
+	25599,
 	25583,
+	25567,
+	25552,
+	25536,
+	25520,
+	25504,
+	25489,
+	25473,
 	25457,
+	25441,
+	25425,
+	25410,
+	25394,
+	25378,
+	25362,
+	25346,
 	25330,
+	25314,
+	25298,
+	25282,
+	25266,
+	25250,
+	25234,
+	25218,
 	25202,
+	25186,
+	25170,
+	25154,
+	25138,
+	25121,
+	25105,
+	25089,
 	25073,
+	25057,
+	25041,
+	25024,
+	25008,
+	24992,
+	24976,
+	24959,
 	24943,
+	24927,
+	24910,
+	24894,
+	24878,
+	24861,
+	24845,
+	24829,
 	24812,
+	24796,
+	24779,
+	24763,
+	24746,
+	24730,
+	24713,
+	24697,
 	24680,
+	24664,
+	24647,
+	24631,
+	24614,
+	24598,
+	24581,
+	24564,
 	24548,
+	24531,
+	24514,
+	24498,
+	24481,
+	24464,
+	24448,
+	24431,
 	24414,
+	24397,
+	24380,
+	24364,
+	24347,
+	24330,
+	24313,
+	24296,
 	24279,
+	24263,
+	24246,
+	24229,
+	24212,
+	24195,
+	24178,
+	24161,
 	24144,
+	24127,
+	24110,
+	24093,
+	24076,
+	24059,
+	24042,
+	24025,
 	24008,
+	23991,
+	23973,
+	23956,
+	23939,
+	23922,
+	23905,
+	23888,
 	23870,
+	23853,
+	23836,
+	23819,
+	23801,
+	23784,
+	23767,
+	23749,
 	23732,
+	23715,
+	23697,
+	23680,
+	23663,
+	23645,
+	23628,
+	23610,
 	23593,
+	23576,
+	23558,
+	23541,
+	23523,
+	23506,
+	23488,
+	23471,
 	23453,
+	23436,
+	23418,
+	23400,
+	23383,
+	23365,
+	23348,
+	23330,
 	23312,
+	23295,
+	23277,
+	23259,
+	23241,
+	23224,
+	23206,
+	23188,
 	23170,
+	23153,
+	23135,
+	23117,
+	23099,
+	23081,
+	23064,
+	23046,
 	23028,
+	23010,
+	22992,
+	22974,
+	22956,
+	22938,
+	22920,
+	22902,
 	22884,
+	22866,
+	22848,
+	22830,
+	22812,
+	22794,
+	22776,
+	22758,
 	22740,
+	22722,
+	22704,
+	22686,
+	22668,
+	22649,
+	22631,
+	22613,
 	22595,
+	22577,
+	22558,
+	22540,
+	22522,
+	22504,
+	22485,
+	22467,
 	22449,
+	22431,
+	22412,
+	22394,
+	22375,
+	22357,
+	22339,
+	22320,
 	22302,
+	22284,
+	22265,
+	22247,
+	22228,
+	22210,
+	22191,
+	22173,
 	22154,
+	22136,
+	22117,
+	22099,
+	22080,
+	22061,
+	22043,
+	22024,
 	22006,
+	21987,
+	21968,
+	21950,
+	21931,
+	21912,
+	21894,
+	21875,
 	21856,
+	21838,
+	21819,
+	21800,
+	21781,
+	21762,
+	21744,
+	21725,
 	21706,
+	21687,
+	21668,
+	21649,
+	21631,
+	21612,
+	21593,
+	21574,
 	21555,
+	21536,
+	21517,
+	21498,
+	21479,
+	21460,
+	21441,
+	21422,
 	21403,
+	21384,
+	21365,
+	21346,
+	21327,
+	21308,
+	21289,
+	21270,
 	21251,
+	21231,
+	21212,
+	21193,
+	21174,
+	21155,
+	21136,
+	21116,
 	21097,
+	21078,
+	21059,
+	21039,
+	21020,
+	21001,
+	20981,
+	20962,
 	20943,
+	20923,
+	20904,
+	20885,
+	20865,
+	20846,
+	20827,
+	20807,
 	20788,
+	20768,
+	20749,
+	20729,
+	20710,
+	20691,
+	20671,
+	20652,
 	20632,
+	20612,
+	20593,
+	20573,
+	20554,
+	20534,
+	20515,
+	20495,
 	20475,
+	20456,
+	20436,
+	20416,
+	20397,
+	20377,
+	20357,
+	20338,
 	20318,
+	20298,
+	20279,
+	20259,
+	20239,
+	20219,
+	20200,
+	20180,
 	20160,
+	20140,
+	20120,
+	20100,
+	20081,
+	20061,
+	20041,
+	20021,
 	20001,
+	19981,
+	19961,
+	19941,
+	19921,
+	19901,
+	19881,
+	19861,
 	19841,
+	19821,
+	19801,
+	19781,
+	19761,
+	19741,
+	19721,
+	19701,
 	19681,
+	19661,
+	19641,
+	19621,
+	19601,
+	19580,
+	19560,
+	19540,
 	19520,
+	19500,
+	19479,
+	19459,
+	19439,
+	19419,
+	19399,
+	19378,
 	19358,
+	19338,
+	19317,
+	19297,
+	19277,
+	19256,
+	19236,
+	19216,
 	19195,
+	19175,
+	19155,
+	19134,
+	19114,
+	19093,
+	19073,
+	19053,
 	19032,
+	19012,
+	18991,
+	18971,
+	18950,
+	18930,
+	18909,
+	18889,
 	18868,
+	18848,
+	18827,
+	18806,
+	18786,
+	18765,
+	18745,
+	18724,
 	18703,
+	18683,
+	18662,
+	18641,
+	18621,
+	18600,
+	18579,
+	18559,
 	18538,
+	18517,
+	18496,
+	18476,
+	18455,
+	18434,
+	18413,
+	18393,
 	18372,
+	18351,
+	18330,
+	18309,
+	18288,
+	18268,
+	18247,
+	18226,
 	18205,
+	18184,
+	18163,
+	18142,
+	18121,
+	18100,
+	18079,
+	18058,
 	18037,
+	18016,
+	17995,
+	17974,
+	17953,
+	17932,
+	17911,
+	17890,
 	17869,
+	17848,
+	17827,
+	17806,
+	17785,
+	17764,
+	17743,
+	17721,
 	17700,
+	17679,
+	17658,
+	17637,
+	17616,
+	17594,
+	17573,
+	17552,
 	17531,
+	17510,
+	17488,
+	17467,
+	17446,
+	17425,
+	17403,
+	17382,
 	17361,
+	17339,
+	17318,
+	17297,
+	17275,
+	17254,
+	17233,
+	17211,
 	17190,
+	17168,
+	17147,
+	17126,
+	17104,
+	17083,
+	17061,
+	17040,
 	17018,
+	16997,
+	16975,
+	16954,
+	16932,
+	16911,
+	16889,
+	16868,
 	16846,
+	16825,
+	16803,
+	16781,
+	16760,
+	16738,
+	16717,
+	16695,
 	16673,
+	16652,
+	16630,
+	16608,
+	16587,
+	16565,
+	16543,
+	16522,
 	16500,
+	16478,
+	16456,
+	16435,
+	16413,
+	16391,
+	16369,
+	16348,
 	16326,
+	16304,
+	16282,
+	16261,
+	16239,
+	16217,
+	16195,
+	16173,
 	16151,
+	16129,
+	16108,
+	16086,
+	16064,
+	16042,
+	16020,
+	15998,
 	15976,
+	15954,
+	15932,
+	15910,
+	15888,
+	15866,
+	15844,
+	15822,
 	15800,
+	15778,
+	15756,
+	15734,
+	15712,
+	15690,
+	15668,
+	15646,
 	15624,
+	15602,
+	15580,
+	15557,
+	15535,
+	15513,
+	15491,
+	15469,
 	15447,
+	15425,
+	15402,
+	15380,
+	15358,
+	15336,
+	15314,
+	15291,
 	15269,
+	15247,
+	15225,
+	15202,
+	15180,
+	15158,
+	15136,
+	15113,
 	15091,
+	15069,
+	15046,
+	15024,
+	15002,
+	14979,
+	14957,
+	14935,
 	14912,
+	14890,
+	14867,
+	14845,
+	14823,
+	14800,
+	14778,
+	14755,
 	14733,
+	14710,
+	14688,
+	14665,
+	14643,
+	14621,
+	14598,
+	14576,
 	14553,
+	14530,
+	14508,
+	14485,
+	14463,
+	14440,
+	14418,
+	14395,
 	14373,
+	14350,
+	14327,
+	14305,
+	14282,
+	14260,
+	14237,
+	14214,
 	14192,
+	14169,
+	14146,
+	14124,
+	14101,
+	14078,
+	14056,
+	14033,
 	14010,
+	13987,
+	13965,
+	13942,
+	13919,
+	13896,
+	13874,
+	13851,
 	13828,
+	13805,
+	13783,
+	13760,
+	13737,
+	13714,
+	13691,
+	13668,
 	13646,
+	13623,
+	13600,
+	13577,
+	13554,
+	13531,
+	13508,
+	13485,
 	13463,
+	13440,
+	13417,
+	13394,
+	13371,
+	13348,
+	13325,
+	13302,
 	13279,
+	13256,
+	13233,
+	13210,
+	13187,
+	13164,
+	13141,
+	13118,
 	13095,
+	13072,
+	13049,
+	13026,
+	13003,
+	12980,
+	12957,
+	12933,
 	12910,
+	12887,
+	12864,
+	12841,
+	12818,
+	12795,
+	12772,
+	12748,
 	12725,
+	12702,
+	12679,
+	12656,
+	12633,
+	12609,
+	12586,
+	12563,
 	12540,
+	12517,
+	12493,
+	12470,
+	12447,
+	12424,
+	12400,
+	12377,
 	12354,
+	12330,
+	12307,
+	12284,
+	12261,
+	12237,
+	12214,
+	12191,
 	12167,
+	12144,
+	12121,
+	12097,
+	12074,
+	12051,
+	12027,
+	12004,
 	11980,
+	11957,
+	11934,
+	11910,
+	11887,
+	11863,
+	11840,
+	11816,
 	11793,
+	11770,
+	11746,
+	11723,
+	11699,
+	11676,
+	11652,
+	11629,
 	11605,
+	11582,
+	11558,
+	11535,
+	11511,
+	11488,
+	11464,
+	11441,
 	11417,
+	11393,
+	11370,
+	11346,
+	11323,
+	11299,
+	11276,
+	11252,
 	11228,
+	11205,
+	11181,
+	11157,
+	11134,
+	11110,
+	11087,
+	11063,
 	11039,
+	11016,
+	10992,
+	10968,
+	10945,
+	10921,
+	10897,
+	10873,
 	10850,
+	10826,
+	10802,
+	10779,
+	10755,
+	10731,
+	10707,
+	10684,
 	10660,
+	10636,
+	10612,
+	10588,
+	10565,
+	10541,
+	10517,
+	10493,
 	10469,
+	10446,
+	10422,
+	10398,
+	10374,
+	10350,
+	10326,
+	10303,
 	10279,
+	10255,
+	10231,
+	10207,
+	10183,
+	10159,
+	10135,
+	10112,
 	10088,
+	10064,
+	10040,
+	10016,
+	9992,
+	9968,
+	9944,
+	9920,
 	9896,
+	9872,
+	9848,
+	9824,
+	9800,
+	9776,
+	9752,
+	9728,
 	9704,
+	9680,
+	9656,
+	9632,
+	9608,
+	9584,
+	9560,
+	9536,
 	9512,
+	9488,
+	9464,
+	9440,
+	9416,
+	9392,
+	9368,
+	9344,
 	9319,
+	9295,
+	9271,
+	9247,
+	9223,
+	9199,
+	9175,
+	9151,
 	9127,
+	9102,
+	9078,
+	9054,
+	9030,
+	9006,
+	8982,
+	8957,
 	8933,
+	8909,
+	8885,
+	8861,
+	8836,
+	8812,
+	8788,
+	8764,
 	8740,
+	8715,
+	8691,
+	8667,
+	8643,
+	8618,
+	8594,
+	8570,
 	8546,
+	8521,
+	8497,
+	8473,
+	8449,
+	8424,
+	8400,
+	8376,
 	8351,
+	8327,
+	8303,
+	8279,
+	8254,
+	8230,
+	8206,
+	8181,
 	8157,
+	8133,
+	8108,
+	8084,
+	8059,
+	8035,
+	8011,
+	7986,
 	7962,
+	7938,
+	7913,
+	7889,
+	7864,
+	7840,
+	7816,
+	7791,
 	7767,
+	7742,
+	7718,
+	7694,
+	7669,
+	7645,
+	7620,
+	7596,
 	7571,
+	7547,
+	7522,
+	7498,
+	7473,
+	7449,
+	7425,
+	7400,
 	7376,
+	7351,
+	7327,
+	7302,
+	7278,
+	7253,
+	7229,
+	7204,
 	7180,
+	7155,
+	7130,
+	7106,
+	7081,
+	7057,
+	7032,
+	7008,
 	6983,
+	6959,
+	6934,
+	6910,
+	6885,
+	6860,
+	6836,
+	6811,
 	6787,
+	6762,
+	6737,
+	6713,
+	6688,
+	6664,
+	6639,
+	6614,
 	6590,
+	6565,
+	6541,
+	6516,
+	6491,
+	6467,
+	6442,
+	6417,
 	6393,
+	6368,
+	6343,
+	6319,
+	6294,
+	6269,
+	6245,
+	6220,
 	6195,
+	6171,
+	6146,
+	6121,
+	6097,
+	6072,
+	6047,
+	6023,
 	5998,
+	5973,
+	5948,
+	5924,
+	5899,
+	5874,
+	5850,
+	5825,
 	5800,
+	5775,
+	5751,
+	5726,
+	5701,
+	5676,
+	5652,
+	5627,
 	5602,
+	5577,
+	5553,
+	5528,
+	5503,
+	5478,
+	5453,
+	5429,
 	5404,
+	5379,
+	5354,
+	5329,
+	5305,
+	5280,
+	5255,
+	5230,
 	5205,
+	5181,
+	5156,
+	5131,
+	5106,
+	5081,
+	5057,
+	5032,
 	5007,
+	4982,
+	4957,
+	4932,
+	4907,
+	4883,
+	4858,
+	4833,
 	4808,
+	4783,
+	4758,
+	4733,
+	4709,
+	4684,
+	4659,
+	4634,
 	4609,
+	4584,
+	4559,
+	4534,
+	4510,
+	4485,
+	4460,
+	4435,
 	4410,
+	4385,
+	4360,
+	4335,
+	4310,
+	4285,
+	4260,
+	4236,
 	4211,
+	4186,
+	4161,
+	4136,
+	4111,
+	4086,
+	4061,
+	4036,
 	4011,
+	3986,
+	3961,
+	3936,
+	3911,
+	3886,
+	3861,
+	3836,
 	3812,
+	3787,
+	3762,
+	3737,
+	3712,
+	3687,
+	3662,
+	3637,
 	3612,
+	3587,
+	3562,
+	3537,
+	3512,
+	3487,
+	3462,
+	3437,
 	3412,
+	3387,
+	3362,
+	3337,
+	3312,
+	3287,
+	3262,
+	3237,
 	3212,
+	3187,
+	3162,
+	3137,
+	3112,
+	3087,
+	3062,
+	3037,
 	3012,
+	2987,
+	2962,
+	2937,
+	2912,
+	2887,
+	2861,
+	2836,
 	2811,
+	2786,
+	2761,
+	2736,
+	2711,
+	2686,
+	2661,
+	2636,
 	2611,
+	2586,
+	2561,
+	2536,
+	2511,
+	2486,
+	2461,
+	2436,
 	2411,
+	2385,
+	2360,
+	2335,
+	2310,
+	2285,
+	2260,
+	2235,
 	2210,
+	2185,
+	2160,
+	2135,
+	2110,
+	2085,
+	2060,
+	2034,
 	2009,
+	1984,
+	1959,
+	1934,
+	1909,
+	1884,
+	1859,
+	1834,
 	1809,
+	1784,
+	1758,
+	1733,
+	1708,
+	1683,
+	1658,
+	1633,
 	1608,
+	1583,
+	1558,
+	1533,
+	1507,
+	1482,
+	1457,
+	1432,
 	1407,
+	1382,
+	1357,
+	1332,
+	1307,
+	1281,
+	1256,
+	1231,
 	1206,
+	1181,
+	1156,
+	1131,
+	1106,
+	1081,
+	1055,
+	1030,
 	1005,
+	980,
+	955,
+	930,
+	905,
+	880,
+	854,
+	829,
 	804,
+	779,
+	754,
+	729,
+	704,
+	679,
+	653,
+	628,
 	603,
+	578,
+	553,
+	528,
+	503,
+	478,
+	452,
+	427,
 	402,
+	377,
+	352,
+	327,
+	302,
+	276,
+	251,
+	226,
 	201,
+	176,
+	151,
+	126,
+	101,
+	75,
+	50,
+	25,
+	0,
 };
 
 #endif
@@ -160,4 +160,56 @@ int pcm_convert_as_linear(const struct audio_stream *source, uint32_t ioffset,
 			  struct audio_stream *sink, uint32_t ooffset,
 			  uint32_t samples, pcm_converter_lin_func converter);
 
+/**
+ * \brief Convert data from circular buffer in maximal linear spans without
+ *	  checking the available and free samples of the buffers
+ * \param source buffer with samples to process, read pointer is not modified
+ * \param ioffset offset to first sample in source stream
+ * \param in_bytes size of one source sample in bytes
+ * \param sink output buffer, write pointer is not modified
+ * \param ooffset offset to first sample in sink stream
+ * \param out_bytes size of one sink sample in bytes
+ * \param samples number of samples to convert
+ * \param converter core conversion function working on linear memory regions
+ * \return number of processed samples
+ */
+int pcm_convert_linear_spans(const struct audio_stream *source, uint32_t ioffset,
+			     uint32_t in_bytes, struct audio_stream *sink,
+			     uint32_t ooffset, uint32_t out_bytes, uint32_t samples,
+			     pcm_converter_lin_func converter);
+
+/*
+ * Conversion kernels for linear memory regions. The kernels use host SIMD
+ * instructions when available and give the same result as the scalar code.
+ */
+void pcm_lin_s16_to_s24(const void *psrc, void *pdst, uint32_t samples);
+void pcm_lin_s24_to_s16(const void *psrc, void *pdst, uint32_t samples);
+void pcm_lin_s16_to_s32(const void *psrc, void *pdst, uint32_t samples);
+void pcm_lin_s32_to_s16(const void *psrc, void *pdst, uint32_t samples);
+void pcm_lin_s24_to_s32(const void *psrc, void *pdst, uint32_t samples);
+void pcm_lin_s32_to_s24(const void *psrc, void *pdst, uint32_t samples);
+void pcm_lin_s32_to_s24_be(const void *psrc, void *pdst, uint32_t samples);
+void pcm_lin_s16_c16_to_s16_c32(const void *psrc, void *pdst, uint32_t samples);
+void pcm_lin_s16_c32_to_s16_c16(const void *psrc, void *pdst, uint32_t samples);
+void pcm_lin_s16_c32_to_s32_c32(const void *psrc, void *pdst, uint32_t samples);
+void pcm_lin_s32_c32_to_s16_c32(const void *psrc, void *pdst, uint32_t samples);
+void pcm_lin_s24_c32_to_s16_c32(const void *psrc, void *pdst, uint32_t samples);
+
+#if CONFIG_PCM_CONVERTER_FORMAT_FLOAT
+void pcm_lin_s16_to_f(const void *psrc, void *pdst, uint32_t samples);
+void pcm_lin_f_to_s16(const void *psrc, void *pdst, uint32_t samples);
+void pcm_lin_s24_to_f(const void *psrc, void *pdst, uint32_t samples);
+void pcm_lin_f_to_s24(const void *psrc, void *pdst, uint32_t samples);
+void pcm_lin_s32_to_f(const void *psrc, void *pdst, uint32_t samples);
+void pcm_lin_f_to_s32(const void *psrc, void *pdst, uint32_t samples);
+#endif /* CONFIG_PCM_CONVERTER_FORMAT_FLOAT */
+
+/**
+ * \brief Attenuate 32 bit samples in linear memory region in place
+ * \param buf samples to process
+ * \param samples number of samples to process
+ * \param shift attenuation as number of bits to shift right
+ */
+void pcm_lin_attenuate_s32(int32_t *buf, uint32_t samples, uint32_t shift);
+
 #endif /* __SOF_AUDIO_PCM_CONVERTER_H__ */
@@ -49,6 +49,18 @@ struct ipc_msg;
 #define PPL_DIR_DOWNSTREAM	0
 #define PPL_DIR_UPSTREAM	1
 
+/*
+ * Step of the flat copy schedule, see pipeline_copy_schedule_build().
+ * Downstream steps are in walk order and subtree is the last step below
+ * cd. Upstream steps are in copy order and subtree is the first step
+ * below cd.
+ */
+struct pipeline_step {
+	struct comp_dev *cd;	/* component to copy */
+	uint32_t subtree;	/* other end of the steps below cd */
+	bool run;		/* upstream: no inactive component above */
+};
+
 /*
  * Audio pipeline.
  */
@@ -75,6 +87,10 @@ struct pipeline {
 	struct pipeline *sched_next;	/* pipeline scheduled after this */
 	struct pipeline *sched_prev;	/* pipeline scheduled before this */
 
+	/* flat copy schedule, NULL until prepared or after a graph change */
+	struct pipeline_step *copy_steps;
+	uint32_t copy_step_count;
+
 	/* component that drives scheduling in this pipe */
 	struct comp_dev *sched_comp;
 	/* source component for this pipe */
@@ -292,6 +308,22 @@ int pipeline_trigger_run(struct pipeline *p, struct comp_dev *host, int cmd);
  */
 int pipeline_copy(struct pipeline *p);
 
+/**
+ * \brief Flatten the pipeline_copy() walk into an array of steps.
+ *
+ * Components from other pipelines and incomplete components are left
+ * out of the schedule. Component activity is checked on each copy.
+ * \param[in] p pipeline.
+ * \return 0 on success.
+ */
+int pipeline_copy_schedule_build(struct pipeline *p);
+
+/**
+ * \brief Drop the flat copy schedule, pipeline_copy() walks the graph.
+ * \param[in] p pipeline.
+ */
+void pipeline_copy_schedule_free(struct pipeline *p);
+
 /**
  * \brief Get time pipeline timestamps from host to dai.
  * \param[in] p pipeline.
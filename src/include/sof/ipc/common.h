@@ -23,6 +23,7 @@
 #include <stdint.h>
 
 struct dma_sg_elem_array;
+struct ipc_comp_dev;
 struct ipc_msg;
 
 /* validates internal non tail structures within IPC command structure */
@@ -50,6 +51,10 @@ extern struct tr_ctx ipc_tr;
 #define IPC_TASK_SECONDARY_CORE	BIT(2)
 #define IPC_TASK_POWERDOWN      BIT(3)
 
+/* buckets of the comp_list ID and pipeline ID indexes */
+#define IPC_COMP_HASH_BITS	6
+#define IPC_COMP_HASH_SIZE	BIT(IPC_COMP_HASH_BITS)
+
 struct ipc {
 	struct k_spinlock lock;	/* locking mechanism */
 	void *comp_data;
@@ -63,6 +68,9 @@ struct ipc {
 	unsigned int core;		/* core, processing the IPC */
 
 	struct list_item comp_list;	/* list of component devices */
+	/* comp_list index, see ipc_comp_list_add() */
+	struct ipc_comp_dev *comp_hash[IPC_COMP_HASH_SIZE];	/* by ID */
+	struct ipc_comp_dev *ppl_hash[IPC_COMP_HASH_SIZE];	/* by pipeline ID */
 
 	/* processing task */
 	struct task ipc_task;
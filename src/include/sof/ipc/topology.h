@@ -94,6 +94,11 @@ struct ipc_comp_dev {
 
 	/* lists */
 	struct list_item list;		/* list in components */
+
+	/* comp_list index chains, in comp_list order */
+	struct ipc_comp_dev *hash_next;	/* same ID bucket */
+	struct ipc_comp_dev *ppl_next;	/* same pipeline ID bucket */
+	uint32_t ppl_id;		/* pipeline ID when added */
 };
 
 /**
@@ -177,6 +182,41 @@ int ipc_comp_disconnect(struct ipc *ipc, ipc_pipe_comp_connect *connect);
  */
 struct ipc_comp_dev *ipc_get_comp_dev(struct ipc *ipc, uint16_t type, uint32_t id);
 
+/**
+ * \brief Add a component, buffer or pipeline to the IPC component list.
+ *
+ * Appends to ipc->comp_list and to the ID and pipeline ID indexes. The
+ * ID, type and component type data must be set.
+ * @param ipc The global IPC context.
+ * @param icd The IPC component device.
+ */
+void ipc_comp_list_add(struct ipc *ipc, struct ipc_comp_dev *icd);
+
+/**
+ * \brief Remove a component, buffer or pipeline from the IPC component list.
+ * @param ipc The global IPC context.
+ * @param icd The IPC component device.
+ */
+void ipc_comp_list_del(struct ipc *ipc, struct ipc_comp_dev *icd);
+
+/**
+ * \brief Get the first component, buffer or pipeline of a pipeline.
+ *
+ * Together with ipc_ppl_comp_next() this visits the devices of a pipeline
+ * in ipc->comp_list order without walking the whole list.
+ * @param ipc The global IPC context.
+ * @param ppl_id The pipeline ID.
+ * @return IPC component device or NULL.
+ */
+struct ipc_comp_dev *ipc_ppl_comp_first(struct ipc *ipc, uint32_t ppl_id);
+
+/**
+ * \brief Get the next component, buffer or pipeline of the same pipeline.
+ * @param icd The current IPC component device.
+ * @return IPC component device or NULL.
+ */
+struct ipc_comp_dev *ipc_ppl_comp_next(struct ipc_comp_dev *icd);
+
 /**
  * \brief Get component device from pipeline ID and type.
  * @param ipc The global IPC context.
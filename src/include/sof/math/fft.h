@@ -25,7 +25,7 @@
 
 #endif
 
-#define FFT_SIZE_MAX	1024
+#define FFT_SIZE_MAX	8192
 
 struct icomplex32 {
 	int32_t real;
@@ -51,10 +51,24 @@ struct fft_plan {
 	struct icomplex16 *outb16;	/* pointer to output integer complex buffer */
 };
 
+/* Real FFT is computed with a half size complex FFT and a post-processing step */
+struct fft_real_plan {
+	uint32_t size;	/* fft size */
+	struct fft_plan *plan;	/* pointer to half size complex fft plan */
+	struct icomplex32 *buf;	/* pointer to half size complex fft input and output */
+	int32_t *real;	/* pointer to real data buffer, size samples */
+	struct icomplex32 *spectrum;	/* pointer to spectrum buffer, size / 2 + 1 bins */
+};
+
 /* interfaces of the library */
 struct fft_plan *fft_plan_new(void *inb, void *outb, uint32_t size, int bits);
 void fft_execute_16(struct fft_plan *plan, bool ifft);
 void fft_execute_32(struct fft_plan *plan, bool ifft);
 void fft_plan_free(struct fft_plan *plan16);
 
+struct fft_real_plan *fft_plan_new_real(int32_t *real, struct icomplex32 *spectrum,
+					uint32_t size);
+void fft_execute_real_32(struct fft_real_plan *plan, bool ifft);
+void fft_plan_free_real(struct fft_real_plan *plan);
+
 #endif /* __SOF_FFT_H__ */
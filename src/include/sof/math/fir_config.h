@@ -21,20 +21,30 @@
 #endif
 #endif
 
-/* Define SOFM_FIR_FORCEARCH 0/2/3 in build command line or temporarily in
- * this file to override the default auto detection.
+/* Define SOFM_FIR_FORCEARCH 0/1/2/3 in build command line or temporarily in
+ * this file to override the default auto detection. Value 1 is the generic
+ * C version with the tap loops built on SSE4.1 or NEON intrinsics
+ * (FIR_SIMD), it shares the state and API with the generic version.
  */
 #ifdef SOFM_FIR_FORCEARCH
 #  if SOFM_FIR_FORCEARCH == 3
 #    define FIR_GENERIC	0
+#    define FIR_SIMD	0
 #    define FIR_HIFIEP	0
 #    define FIR_HIFI3	1
 #  elif SOFM_FIR_FORCEARCH == 2
 #    define FIR_GENERIC	0
+#    define FIR_SIMD	0
 #    define FIR_HIFIEP	1
 #    define FIR_HIFI3	0
+#  elif SOFM_FIR_FORCEARCH == 1
+#    define FIR_GENERIC	1
+#    define FIR_SIMD	1
+#    define FIR_HIFIEP	0
+#    define FIR_HIFI3	0
 #  elif SOFM_FIR_FORCEARCH == 0
 #    define FIR_GENERIC	1
+#    define FIR_SIMD	0
 #    define FIR_HIFIEP	0
 #    define FIR_HIFI3	0
 #  else
@@ -44,6 +54,7 @@
 #  if defined __XCC__
 #    include <xtensa/config/core-isa.h>
 #    define FIR_GENERIC	0
+#    define FIR_SIMD	0
 #    if XCHAL_HAVE_HIFI2EP == 1
 #      define FIR_HIFIEP	1
 #      define FIR_HIFI3	0
@@ -56,6 +67,11 @@
 #  else
 #    define FIR_GENERIC	1
 #    define FIR_HIFI3	0
+#    if (defined __SSE4_1__ && defined __x86_64__) || defined __ARM_NEON
+#      define FIR_SIMD	1
+#    else
+#      define FIR_SIMD	0
+#    endif
 #  endif /* __XCC__ */
 #endif /* SOFM_FIR_FORCEARCH */
 
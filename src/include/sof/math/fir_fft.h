@@ -0,0 +1,56 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2023 Intel Corporation. All rights reserved.
+ */
+
+#ifndef __SOF_MATH_FIR_FFT_H__
+#define __SOF_MATH_FIR_FFT_H__
+
+#include <sof/math/fft.h>
+#include <user/fir.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Uniformly partitioned overlap-save convolution for long FIR filters. The
+ * first partition of the response is run in direct form, so there is no
+ * added latency. The rest of the partitions are run in frequency domain
+ * once per block with the spectra of the previous input blocks.
+ */
+
+#define FIR_FFT_LEN		7	/* FFT length in exponent of 2 */
+#define FIR_FFT_SIZE		(1 << FIR_FFT_LEN)
+#define FIR_FFT_BLOCK		(FIR_FFT_SIZE / 2) /* Partition length in samples */
+#define FIR_FFT_BINS		(FIR_FFT_BLOCK + 1) /* Bins of real signal spectrum */
+
+/* Max length for individual filter. Note that the FIR equalizer limits the
+ * initial configuration blob to SOF_EQ_FIR_MAX_SIZE bytes, that allows a
+ * response of at most 2024 taps with two channels in config.
+ */
+#define FIR_FFT_MAX_LENGTH	4096
+
+struct fir_fft_state {
+	struct fft_real_plan *plan;
+	int32_t *fft_real; /* Real FFT data, FIR_FFT_SIZE */
+	struct icomplex32 *fft_spectrum; /* FFT spectrum, FIR_FFT_BINS */
+	struct icomplex32 *coef_spectra; /* Spectra of partitions 1..N */
+	struct icomplex32 *input_spectra; /* Frequency domain delay line */
+	int32_t *window; /* Previous and current input block */
+	int32_t *tail; /* Output of partitions 1..N for current block */
+	int16_t *coef; /* Pointer to FIR coefficients */
+	int head_taps; /* Number of taps run in direct form */
+	int partitions; /* Number of partitions run in frequency domain */
+	int newest; /* Delay line index of the newest input spectrum */
+	int pos; /* Sample index in current block */
+	int out_shift; /* Amount of right shifts at output */
+};
+
+bool fir_fft_length_valid(struct sof_fir_coef_data *config);
+
+int fir_fft_init(struct fir_fft_state *fft, struct sof_fir_coef_data *config);
+
+void fir_fft_free(struct fir_fft_state *fft);
+
+int32_t fir_fft_32x16(struct fir_fft_state *fft, int32_t x);
+
+#endif /* __SOF_MATH_FIR_FFT_H__ */
@@ -22,6 +22,10 @@
 struct comp_buffer;
 struct sof_eq_fir_coef_data;
 
+/* With FIR_SIMD the delay line is mirrored, every sample is stored at
+ * rwi and rwi + length. The newest sample is at rwi and the older ones
+ * follow it, so the taps are read without a circular wrap.
+ */
 struct fir_state_32x16 {
 	int rwi; /* Circular read and write index */
 	int taps; /* Number of FIR taps */
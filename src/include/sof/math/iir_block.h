@@ -0,0 +1,130 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2023 Intel Corporation. All rights reserved.
+ */
+
+#ifndef __SOF_MATH_IIR_BLOCK_H__
+#define __SOF_MATH_IIR_BLOCK_H__
+
+#include <sof/audio/format.h>
+#include <sof/math/iir_df1.h>
+#include <sof/math/iir_df2t.h>
+#include <stdint.h>
+
+/*
+ * Multi-channel block IIR. The biquad cascades of all channels of a stream
+ * are run for a block of interleaved frames in one call. The coefficients
+ * and delay lines are stored as structure of arrays, i.e. value k of biquad
+ * b for channel ch is in index (b * num_values + k) * stride + ch. The
+ * stride is the channels count rounded up to even so that adjacent channels
+ * are processed in SIMD lanes.
+ *
+ * The block filters are initialized from the per channel filters. The
+ * channels in bypass and the shorter series cascades are padded with
+ * pass-through biquads. The parallel cascades need to be the same for all
+ * channels that are not in bypass.
+ */
+
+/* Define SOFM_IIR_BLOCK_FORCEARCH 0/1/3 in build command line or temporarily
+ * in this file to override the default auto detection. Value 1 is the host
+ * SIMD version with SSE4.2 or NEON intrinsics. Value 3 is the HiFi3 version,
+ * it is not selected automatically until it has been checked bit exact with
+ * iir_df1_hifi3 and iir_df2t_hifi3, so the Xtensa builds use the generic C
+ * version.
+ */
+#ifdef SOFM_IIR_BLOCK_FORCEARCH
+#  if SOFM_IIR_BLOCK_FORCEARCH == 3
+#    define IIR_BLOCK_GENERIC	0
+#    define IIR_BLOCK_SIMD	0
+#    define IIR_BLOCK_HIFI3	1
+#  elif SOFM_IIR_BLOCK_FORCEARCH == 1
+#    define IIR_BLOCK_GENERIC	0
+#    define IIR_BLOCK_SIMD	1
+#    define IIR_BLOCK_HIFI3	0
+#  elif SOFM_IIR_BLOCK_FORCEARCH == 0
+#    define IIR_BLOCK_GENERIC	1
+#    define IIR_BLOCK_SIMD	0
+#    define IIR_BLOCK_HIFI3	0
+#  else
+#    error "Unsupported SOFM_IIR_BLOCK_FORCEARCH value."
+#  endif
+#else
+#  if defined __XCC__
+#    define IIR_BLOCK_GENERIC	1
+#    define IIR_BLOCK_SIMD	0
+#    define IIR_BLOCK_HIFI3	0
+#  else
+#    define IIR_BLOCK_HIFI3	0
+#    if (defined __SSE4_2__ && defined __x86_64__) || defined __ARM_NEON
+#      define IIR_BLOCK_GENERIC	0
+#      define IIR_BLOCK_SIMD	1
+#    else
+#      define IIR_BLOCK_GENERIC	1
+#      define IIR_BLOCK_SIMD	0
+#    endif
+#  endif /* __XCC__ */
+#endif /* SOFM_IIR_BLOCK_FORCEARCH */
+
+/* Frames per run of parallel biquad cascades */
+#define IIR_BLOCK_FRAMES	16
+
+struct iir_block_df1 {
+	int channels; /* Number of interleaved channels */
+	int stride; /* Channels rounded up to even */
+	int biquads; /* Number of biquads per channel, zero for bypass */
+	int biquads_in_series; /* Number of biquads in series */
+	int32_t *coef; /* Coefficients, SOF_EQ_IIR_NBIQUAD per biquad */
+	int32_t *delay; /* Delay lines, IIR_DF1_NUM_STATE per biquad */
+	int32_t *branch; /* Output of a parallel cascade */
+	int64_t *sum; /* Sum of parallel cascades */
+};
+
+struct iir_block_df2t {
+	int channels; /* Number of interleaved channels */
+	int stride; /* Channels rounded up to even */
+	int biquads; /* Number of biquads per channel, zero for bypass */
+	int biquads_in_series; /* Number of biquads in series */
+	int32_t *coef; /* Coefficients, SOF_EQ_IIR_NBIQUAD per biquad */
+	int64_t *delay; /* Delay lines, IIR_DF2T_NUM_DELAYS per biquad */
+	int32_t *branch; /* Output of a parallel cascade */
+	int32_t *sum; /* Sum of parallel cascades */
+};
+
+int iir_block_init_df1(struct iir_block_df1 *iir, const struct iir_state_df1 filters[],
+		       int channels);
+
+void iir_block_free_df1(struct iir_block_df1 *iir);
+
+/**
+ * \brief Run the DF1 filters for interleaved Q1.31 frames. The output can
+ *	  be the same buffer as input.
+ * \param[in,out] iir - block filter initialized with iir_block_init_df1().
+ * \param[in] x - input frames.
+ * \param[out] y - output frames.
+ * \param[in] frames - number of frames to process.
+ */
+void iir_block_df1(struct iir_block_df1 *iir, const int32_t *x, int32_t *y, int frames);
+
+int iir_block_init_df2t(struct iir_block_df2t *iir, const struct iir_state_df2t filters[],
+			int channels);
+
+void iir_block_free_df2t(struct iir_block_df2t *iir);
+
+/**
+ * \brief Run the DF2T filters for interleaved Q1.31 frames. The output can
+ *	  be the same buffer as input.
+ * \param[in,out] iir - block filter initialized with iir_block_init_df2t().
+ * \param[in] x - input frames.
+ * \param[out] y - output frames.
+ * \param[in] frames - number of frames to process.
+ */
+void iir_block_df2t(struct iir_block_df2t *iir, const int32_t *x, int32_t *y, int frames);
+
+/* Run one biquad of all channels, these are the architecture specific parts */
+void iir_block_biquad_df1(struct iir_block_df1 *iir, int biquad, const int32_t *x,
+			  int32_t *y, int frames);
+
+void iir_block_biquad_df2t(struct iir_block_df2t *iir, int biquad, const int32_t *x,
+			   int32_t *y, int frames);
+
+#endif /* __SOF_MATH_IIR_BLOCK_H__ */
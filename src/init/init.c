@@ -185,11 +185,11 @@ int secondary_core_init(struct sof *sof)
 	if (dma_domain)
 		scheduler_init_ll(dma_domain);
 
-#if CONFIG_ZEPHYR_DP_SCHEDULER
+#if CONFIG_DP_SCHEDULER
 	err = scheduler_dp_init();
 	if (err < 0)
 		return err;
-#endif /* CONFIG_ZEPHYR_DP_SCHEDULER */
+#endif /* CONFIG_DP_SCHEDULER */
 
 	/* initialize IDC mechanism */
 	trace_point(TRACE_BOOT_PLATFORM_IDC);
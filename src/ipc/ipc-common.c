@@ -78,20 +78,83 @@ int ipc_process_on_core(uint32_t core, bool blocking)
 	return 1;
 }
 
+/* Fibonacci hash, IPC4 IDs carry the instance in the upper half */
+static inline uint32_t ipc_comp_hash(uint32_t id)
+{
+	return (id * 0x9e3779b1) >> (32 - IPC_COMP_HASH_BITS);
+}
+
+static struct ipc_comp_dev **ipc_comp_chain_link(struct ipc_comp_dev *icd, bool ppl)
+{
+	return ppl ? &icd->ppl_next : &icd->hash_next;
+}
+
+/* append to a bucket chain, so each chain keeps the comp_list order */
+static void ipc_comp_chain_add(struct ipc_comp_dev **link, struct ipc_comp_dev *icd, bool ppl)
+{
+	while (*link)
+		link = ipc_comp_chain_link(*link, ppl);
+
+	*ipc_comp_chain_link(icd, ppl) = NULL;
+	*link = icd;
+}
+
+static void ipc_comp_chain_del(struct ipc_comp_dev **link, struct ipc_comp_dev *icd, bool ppl)
+{
+	while (*link && *link != icd)
+		link = ipc_comp_chain_link(*link, ppl);
+
+	if (*link)
+		*link = *ipc_comp_chain_link(icd, ppl);
+}
+
+void ipc_comp_list_add(struct ipc *ipc, struct ipc_comp_dev *icd)
+{
+	icd->ppl_id = ipc_comp_pipe_id(icd);
+
+	list_item_append(&icd->list, &ipc->comp_list);
+	ipc_comp_chain_add(&ipc->comp_hash[ipc_comp_hash(icd->id)], icd, false);
+	ipc_comp_chain_add(&ipc->ppl_hash[ipc_comp_hash(icd->ppl_id)], icd, true);
+}
+
+/* the component type data may already be freed, only the index keys are used */
+void ipc_comp_list_del(struct ipc *ipc, struct ipc_comp_dev *icd)
+{
+	list_item_del(&icd->list);
+	ipc_comp_chain_del(&ipc->comp_hash[ipc_comp_hash(icd->id)], icd, false);
+	ipc_comp_chain_del(&ipc->ppl_hash[ipc_comp_hash(icd->ppl_id)], icd, true);
+}
+
+static struct ipc_comp_dev *ipc_ppl_comp_match(struct ipc_comp_dev *icd, uint32_t ppl_id)
+{
+	while (icd && icd->ppl_id != ppl_id)
+		icd = icd->ppl_next;
+
+	return icd;
+}
+
+struct ipc_comp_dev *ipc_ppl_comp_first(struct ipc *ipc, uint32_t ppl_id)
+{
+	return ipc_ppl_comp_match(ipc->ppl_hash[ipc_comp_hash(ppl_id)], ppl_id);
+}
+
+struct ipc_comp_dev *ipc_ppl_comp_next(struct ipc_comp_dev *icd)
+{
+	return ipc_ppl_comp_match(icd->ppl_next, icd->ppl_id);
+}
+
 /*
  * Components, buffers and pipelines are stored in the same lists, hence
- * type and ID have to be used for the identification.
+ * type and ID have to be used for the identification. The ID bucket
+ * keeps the list order, so the first match is the same as in the list.
  */
 struct ipc_comp_dev *ipc_get_comp_dev(struct ipc *ipc, uint16_t type, uint32_t id)
 {
 	struct ipc_comp_dev *icd;
-	struct list_item *clist;
 
-	list_for_item(clist, &ipc->comp_list) {
-		icd = container_of(clist, struct ipc_comp_dev, list);
+	for (icd = ipc->comp_hash[ipc_comp_hash(id)]; icd; icd = icd->hash_next)
 		if (icd->id == id && (type == icd->type || type == COMP_TYPE_ANY))
 			return icd;
-	}
 
 	return NULL;
 }
@@ -104,11 +167,10 @@ struct ipc_comp_dev *ipc_get_ppl_comp(struct ipc *ipc, uint32_t pipeline_id, int
 	struct ipc_comp_dev *icd;
 	struct comp_buffer *buffer;
 	struct comp_dev *buff_comp;
-	struct list_item *clist, *blist;
+	struct list_item *blist;
 	struct ipc_comp_dev *next_ppl_icd = NULL;
 
-	list_for_item(clist, &ipc->comp_list) {
-		icd = container_of(clist, struct ipc_comp_dev, list);
+	for (icd = ipc_ppl_comp_first(ipc, pipeline_id); icd; icd = ipc_ppl_comp_next(icd)) {
 		if (icd->type != COMP_TYPE_COMPONENT)
 			continue;
 
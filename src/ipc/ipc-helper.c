@@ -305,12 +305,16 @@ int ipc_comp_free(struct ipc *ipc, uint32_t comp_id)
 	}
 	irq_local_enable(flags);
 
+	/* the graph changed, the copy schedule is rebuilt on the next prepare */
+	if (icd->cd->pipeline)
+		pipeline_copy_schedule_free(icd->cd->pipeline);
+
 	/* free component and remove from list */
 	comp_free(icd->cd);
 
 	icd->cd = NULL;
 
-	list_item_del(&icd->list);
+	ipc_comp_list_del(ipc, icd);
 	rfree(icd);
 
 	return 0;
@@ -724,7 +724,7 @@ static int ipc4_process_chain_dma(struct ipc4_message_request *ipc4)
 		return IPC4_INVALID_CHAIN_STATE_TRANSITION;
 
 	if (!cdma.primary.r.allocate && !cdma.primary.r.enable)
-		list_item_del(&cdma_comp->list);
+		ipc_comp_list_del(ipc, cdma_comp);
 
 	return IPC4_SUCCESS;
 #else
@@ -121,18 +121,18 @@ struct comp_dev *comp_new_ipc4(struct ipc4_module_init_instance *module_init)
 	ipc_config.core = module_init->extension.r.core_id;
 	ipc_config.ipc_config_size = module_init->extension.r.param_block_size * sizeof(uint32_t);
 
-#if CONFIG_ZEPHYR_DP_SCHEDULER
+#if CONFIG_DP_SCHEDULER
 	if (module_init->extension.r.proc_domain)
 		ipc_config.proc_domain = COMP_PROCESSING_DOMAIN_DP;
 	else
 		ipc_config.proc_domain = COMP_PROCESSING_DOMAIN_LL;
-#else /* CONFIG_ZEPHYR_DP_SCHEDULER */
+#else /* CONFIG_DP_SCHEDULER */
 	if (module_init->extension.r.proc_domain) {
 		tr_err(&ipc_tr, "ipc: DP scheduling is disabled, cannot create comp %d", comp_id);
 		return NULL;
 	}
 	ipc_config.proc_domain = COMP_PROCESSING_DOMAIN_LL;
-#endif /* CONFIG_ZEPHYR_DP_SCHEDULER */
+#endif /* CONFIG_DP_SCHEDULER */
 
 	dcache_invalidate_region((__sparse_force void __sparse_cache *)MAILBOX_HOSTBOX_BASE,
 				 MAILBOX_HOSTBOX_SIZE);
@@ -165,25 +165,20 @@ struct ipc_comp_dev *ipc_get_comp_by_ppl_id(struct ipc *ipc, uint16_t type,
 					    uint32_t ignore_remote)
 {
 	struct ipc_comp_dev *icd;
-	struct list_item *clist;
 
-	list_for_item(clist, &ipc->comp_list) {
-		icd = container_of(clist, struct ipc_comp_dev, list);
+	/* For IPC4, ipc_comp_dev.id field is equal to Pipeline ID
+	 * in case of type COMP_TYPE_PIPELINE - can look it up directly here
+	 */
+	if (type == COMP_TYPE_PIPELINE)
+		return ipc_get_comp_dev(ipc, COMP_TYPE_PIPELINE, ppl_id);
+
+	for (icd = ipc_ppl_comp_first(ipc, ppl_id); icd; icd = ipc_ppl_comp_next(icd)) {
 		if (icd->type != type)
 			continue;
-
-		/* For IPC4, ipc_comp_dev.id field is equal to Pipeline ID
-		 * in case of type COMP_TYPE_PIPELINE - can check directly here
-		 */
-		if (type == COMP_TYPE_PIPELINE) {
-			if (icd->id == ppl_id)
-				return icd;
-		} else {
-			if ((!cpu_is_me(icd->core)) && ignore_remote)
-				continue;
-			if (ipc_comp_pipe_id(icd) == ppl_id)
-				return icd;
-		}
+		if ((!cpu_is_me(icd->core)) && ignore_remote)
+			continue;
+		if (ipc_comp_pipe_id(icd) == ppl_id)
+			return icd;
 	}
 	return NULL;
 }
@@ -232,7 +227,7 @@ static int ipc4_create_pipeline(struct ipc4_pipeline_create *pipe_desc)
 	ipc_pipe->pipeline->attributes = pipe_desc->extension.r.attributes;
 
 	/* add new pipeline to the list */
-	list_item_append(&ipc_pipe->list, &ipc->comp_list);
+	ipc_comp_list_add(ipc, ipc_pipe);
 
 	return IPC4_SUCCESS;
 }
@@ -337,7 +332,7 @@ int ipc_pipeline_free(struct ipc *ipc, uint32_t comp_id)
 	}
 
 	ipc_pipe->pipeline = NULL;
-	list_item_del(&ipc_pipe->list);
+	ipc_comp_list_del(ipc, ipc_pipe);
 	rfree(ipc_pipe);
 
 	return IPC4_SUCCESS;
@@ -776,11 +771,9 @@ int ipc4_chain_dma_state(struct comp_dev *dev, struct ipc4_chain_dma *cdma)
 static int ipc4_update_comps_direction(struct ipc *ipc, uint32_t ppl_id)
 {
 	struct ipc_comp_dev *icd;
-	struct list_item *clist;
 	struct comp_buffer *src_buf;
 
-	list_for_item(clist, &ipc->comp_list) {
-		icd = container_of(clist, struct ipc_comp_dev, list);
+	for (icd = ipc_ppl_comp_first(ipc, ppl_id); icd; icd = ipc_ppl_comp_next(icd)) {
 		if (icd->type != COMP_TYPE_COMPONENT)
 			continue;
 
@@ -1018,7 +1011,7 @@ int ipc4_add_comp_dev(struct comp_dev *dev)
 
 	tr_dbg(&ipc_tr, "ipc4_add_comp_dev add comp %x", icd->id);
 	/* add new component to the list */
-	list_item_append(&icd->list, &ipc->comp_list);
+	ipc_comp_list_add(ipc, icd);
 
 	return IPC4_SUCCESS;
 };
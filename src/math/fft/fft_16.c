@@ -11,6 +11,7 @@
 
 #ifdef FFT_GENERIC
 #include <sof/audio/coefficients/fft/twiddle_16.h>
+#include "fft_twiddle.h"
 
 /*
  * Helpers for 16 bit FFT calculation
@@ -100,7 +101,7 @@ void fft_execute_16(struct fft_plan *plan, bool ifft)
 	}
 
 	/* step 1: re-arrange input in bit reverse order, and shrink the level to avoid overflow */
-	for (i = 1; i < plan->size; ++i)
+	for (i = 0; i < plan->size; ++i)
 		icomplex16_shift(&inb[i], -(plan->len), &outb[plan->bit_reverse_idx[i]]);
 
 	/* step 2: loop to do FFT transform in smaller size */
@@ -116,8 +117,7 @@ void fft_execute_16(struct fft_plan *plan, bool ifft)
 				index = i * j;
 				top = k + j;
 				bottom = top + n;
-				tmp1.real = twiddle_real_16[index];
-				tmp1.imag = twiddle_imag_16[index];
+				fft_twiddle_16(index, &tmp1);
 				/* calculate the accumulator: twiddle * bottom */
 				icomplex16_mul(&tmp1, &outb[bottom], &tmp2);
 				tmp1 = outb[top];
@@ -10,6 +10,7 @@
 
 #ifdef FFT_HIFI3
 #include <sof/audio/coefficients/fft/twiddle_16.h>
+#include "fft_twiddle.h"
 #include <xtensa/tie/xt_hifi3.h>
 
 /**
@@ -20,6 +21,7 @@
  */
 void fft_execute_16(struct fft_plan *plan, bool ifft)
 {
+	struct icomplex16 tw;
 	struct icomplex16 *outb;
 	ae_int16 *in;
 	ae_int16x4 sample;
@@ -54,8 +56,8 @@ void fft_execute_16(struct fft_plan *plan, bool ifft)
 	}
 
 	/* step 1: re-arrange input in bit reverse order, and shrink the level to avoid overflow */
-	in = (ae_int16 *)&plan->inb16[1];
-	for (i = 1; i < size ; ++i) {
+	in = (ae_int16 *)&plan->inb16[0];
+	for (i = 0; i < size ; ++i) {
 		out = (ae_int16 *)&outb[plan->bit_reverse_idx[i]];
 		AE_L16_IP(sample, in, 2);
 		sample = AE_SRAA16RS(sample, len);
@@ -81,8 +83,8 @@ void fft_execute_16(struct fft_plan *plan, bool ifft)
 				bottom = top + n;
 				/* store twiddle and bottom as Q9.23*/
 				temp1 = AE_CVTP24A16X2_LL(outb[bottom].real, outb[bottom].imag);
-				temp2 = AE_CVTP24A16X2_LL(twiddle_real_16[index],
-							  twiddle_imag_16[index]);
+				fft_twiddle_16(index, &tw);
+				temp2 = AE_CVTP24A16X2_LL(tw.real, tw.imag);
 				/* calculate the accumulator: twiddle * bottom */
 				res = AE_MULFC24RA(temp1, temp2);
 				/* saturate and round the result to 16bit and put it in
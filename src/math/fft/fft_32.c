@@ -11,7 +11,7 @@
 #include <sof/math/fft.h>
 
 #ifdef FFT_GENERIC
-#include <sof/audio/coefficients/fft/twiddle_32.h>
+#include "fft_twiddle.h"
 
 /*
  * These helpers are optimized for FFT calculation only.
@@ -36,8 +36,10 @@ static inline void icomplex32_sub(const struct icomplex32 *in1, const struct ico
 static inline void icomplex32_mul(const struct icomplex32 *in1, const struct icomplex32 *in2,
 				  struct icomplex32 *out)
 {
-	out->real = ((int64_t)in1->real * in2->real - (int64_t)in1->imag * in2->imag) >> 31;
-	out->imag = ((int64_t)in1->real * in2->imag + (int64_t)in1->imag * in2->real) >> 31;
+	out->real = Q_SHIFT_RND((int64_t)in1->real * in2->real -
+				(int64_t)in1->imag * in2->imag, 62, 31);
+	out->imag = Q_SHIFT_RND((int64_t)in1->real * in2->imag +
+				(int64_t)in1->imag * in2->real, 62, 31);
 }
 
 /* complex conjugate */
@@ -60,6 +62,90 @@ static inline void icomplex32_shift(const struct icomplex32 *input, int32_t n,
 	}
 }
 
+/* Radix-2 stage with twiddle factor one, used first for odd FFT length */
+static void fft_radix2_32(struct icomplex32 *outb, int size)
+{
+	struct icomplex32 tmp;
+	int k;
+
+	for (k = 0; k < size; k += 2) {
+		tmp = outb[k];
+		icomplex32_add(&tmp, &outb[k + 1], &outb[k]);
+		icomplex32_sub(&tmp, &outb[k + 1], &outb[k + 1]);
+	}
+}
+
+/*
+ * Radix-4 stage that does two successive radix-2 stages for transforms of
+ * size m = 4 * n. With twiddle factor W = exp(-j * 2 * pi / m) the inputs
+ * a, b, c, d at offsets j, j + n, j + 2n, j + 3n in the bit reversed data
+ * become
+ *	a' = a + W^2j * b + (W^j * c + W^3j * d)
+ *	b' = a - W^2j * b - j * (W^j * c - W^3j * d)
+ *	c' = a + W^2j * b - (W^j * c + W^3j * d)
+ *	d' = a - W^2j * b + j * (W^j * c - W^3j * d)
+ * so three complex multiplies are needed instead of four.
+ */
+static inline void fft_butterfly4_32(struct icomplex32 *x, int n, const struct icomplex32 *b,
+				     const struct icomplex32 *c, const struct icomplex32 *d)
+{
+	struct icomplex32 t0;
+	struct icomplex32 t1;
+	struct icomplex32 t2;
+	struct icomplex32 t3;
+
+	icomplex32_add(&x[0], b, &t0);
+	icomplex32_sub(&x[0], b, &t1);
+	icomplex32_add(c, d, &t2);
+	icomplex32_sub(c, d, &t3);
+
+	icomplex32_add(&t0, &t2, &x[0]);
+	icomplex32_sub(&t0, &t2, &x[2 * n]);
+	/* -j * t3 and +j * t3 */
+	x[n].real = t1.real + t3.imag;
+	x[n].imag = t1.imag - t3.real;
+	x[3 * n].real = t1.real - t3.imag;
+	x[3 * n].imag = t1.imag + t3.real;
+}
+
+static void fft_radix4_32(struct icomplex32 *outb, int size, int depth)
+{
+	struct icomplex32 w1;
+	struct icomplex32 w2;
+	struct icomplex32 w3;
+	struct icomplex32 b;
+	struct icomplex32 c;
+	struct icomplex32 d;
+	struct icomplex32 *x;
+	const int m = 1 << depth;
+	const int n = m >> 2;
+	const int step = FFT_SIZE_MAX >> depth;
+	int j;
+	int k;
+
+	/* Twiddle factors are one for the first butterfly */
+	for (k = 0; k < size; k += m) {
+		x = &outb[k];
+		b = x[n];
+		c = x[2 * n];
+		d = x[3 * n];
+		fft_butterfly4_32(x, n, &b, &c, &d);
+	}
+
+	for (j = 1; j < n; j++) {
+		fft_twiddle_32(j * step, &w1);
+		fft_twiddle_32(2 * j * step, &w2);
+		fft_twiddle_32(3 * j * step, &w3);
+		for (k = j; k < size; k += m) {
+			x = &outb[k];
+			icomplex32_mul(&w2, &x[n], &b);
+			icomplex32_mul(&w1, &x[2 * n], &c);
+			icomplex32_mul(&w3, &x[3 * n], &d);
+			fft_butterfly4_32(x, n, &b, &c, &d);
+		}
+	}
+}
+
 /**
  * \brief Execute the 32-bits Fast Fourier Transform (FFT) or Inverse FFT (IFFT)
  *	  For the configured fft_pan.
@@ -68,19 +154,10 @@ static inline void icomplex32_shift(const struct icomplex32 *input, int32_t n,
  */
 void fft_execute_32(struct fft_plan *plan, bool ifft)
 {
-	struct icomplex32 tmp1;
-	struct icomplex32 tmp2;
 	struct icomplex32 *inb;
 	struct icomplex32 *outb;
 	int depth;
-	int top;
-	int bottom;
-	int index;
 	int i;
-	int j;
-	int k;
-	int m;
-	int n;
 
 	if (!plan || !plan->bit_reverse_idx)
 		return;
@@ -97,35 +174,21 @@ void fft_execute_32(struct fft_plan *plan, bool ifft)
 	}
 
 	/* step 1: re-arrange input in bit reverse order, and shrink the level to avoid overflow */
-	for (i = 1; i < plan->size; ++i)
+	for (i = 0; i < plan->size; ++i)
 		icomplex32_shift(&inb[i], -(plan->len), &outb[plan->bit_reverse_idx[i]]);
 
-	/* step 2: loop to do FFT transform in smaller size */
-	for (depth = 1; depth <= plan->len; ++depth) {
-		m = 1 << depth;
-		n = m >> 1;
-		i = FFT_SIZE_MAX >> depth;
-
-		/* doing FFT transforms in size m */
-		for (k = 0; k < plan->size; k += m) {
-			/* doing one FFT transform for size m */
-			for (j = 0; j < n; ++j) {
-				index = i * j;
-				top = k + j;
-				bottom = top + n;
-				tmp1.real = twiddle_real_32[index];
-				tmp1.imag = twiddle_imag_32[index];
-				/* calculate the accumulator: twiddle * bottom */
-				icomplex32_mul(&tmp1, &outb[bottom], &tmp2);
-				tmp1 = outb[top];
-				/* calculate the top output: top = top + accumulate */
-				icomplex32_add(&tmp1, &tmp2, &outb[top]);
-				/* calculate the bottom output: bottom = top - accumulate */
-				icomplex32_sub(&tmp1, &tmp2, &outb[bottom]);
-			}
-		}
+	/* step 2: FFT transforms in sizes 4, 16, 64, ... with radix-4 stages. For
+	 * odd FFT length the first stage is radix-2 and the sizes are 2, 8, 32, ...
+	 */
+	depth = 0;
+	if (plan->len & 1) {
+		fft_radix2_32(outb, plan->size);
+		depth = 1;
 	}
 
+	for (depth += 2; depth <= plan->len; depth += 2)
+		fft_radix4_32(outb, plan->size, depth);
+
 	/* shift back for ifft */
 	if (ifft) {
 		/*
@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <sof/audio/format.h>
+#include <sof/common.h>
+#include <rtos/alloc.h>
+#include <sof/math/fft.h>
+#include <ipc/topology.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "fft_twiddle.h"
+
+/* The 32 bit twiddle factors are shared by the FFT versions */
+#include <sof/audio/coefficients/fft/twiddle_32.h>
+
+/**
+ * \brief Create a plan for real input FFT of size samples.
+ * \param[in] real - pointer to real data, size samples.
+ * \param[in] spectrum - pointer to spectrum, size / 2 + 1 bins.
+ * \param[in] size - FFT size, a power of two up to FFT_SIZE_MAX.
+ * \return Pointer to plan or NULL if failed.
+ */
+struct fft_real_plan *fft_plan_new_real(int32_t *real, struct icomplex32 *spectrum,
+					uint32_t size)
+{
+	struct fft_real_plan *plan;
+	uint32_t half = size >> 1;
+
+	if (!real || !spectrum || size < 2 || size > FFT_SIZE_MAX || (size & (size - 1)))
+		return NULL;
+
+	plan = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(struct fft_real_plan));
+	if (!plan)
+		return NULL;
+
+	plan->buf = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			    2 * half * sizeof(struct icomplex32));
+	if (!plan->buf) {
+		rfree(plan);
+		return NULL;
+	}
+
+	plan->plan = fft_plan_new(plan->buf, plan->buf + half, half, 32);
+	if (!plan->plan) {
+		rfree(plan->buf);
+		rfree(plan);
+		return NULL;
+	}
+
+	plan->size = size;
+	plan->real = real;
+	plan->spectrum = spectrum;
+	return plan;
+}
+
+void fft_plan_free_real(struct fft_real_plan *plan)
+{
+	if (!plan)
+		return;
+
+	fft_plan_free(plan->plan);
+	rfree(plan->buf);
+	rfree(plan);
+}
+
+/*
+ * The even samples are the real part and the odd samples the imaginary part
+ * of the half size complex FFT input. The spectrum is then
+ *	X[k] = (E[k] + W^k * O[k]) / 2
+ * where E[k] = Z[k] + conj(Z[N/2 - k]), O[k] = -j * (Z[k] - conj(Z[N/2 - k]))
+ * and W = exp(-j * 2 * pi / N). The input is halved to keep E and O in range.
+ */
+static void fft_real_forward_32(struct fft_real_plan *plan)
+{
+	struct icomplex32 *inb = plan->plan->inb32;
+	struct icomplex32 *z = plan->plan->outb32;
+	struct icomplex32 *x = plan->spectrum;
+	struct icomplex32 *a;
+	struct icomplex32 *b;
+	struct icomplex32 w;
+	int32_t *real = plan->real;
+	int64_t er;
+	int64_t ei;
+	int32_t or;
+	int32_t oi;
+	const int half = plan->size >> 1;
+	const int step = FFT_SIZE_MAX / plan->size;
+	int k;
+
+	for (k = 0; k < half; k++) {
+		inb[k].real = real[2 * k] >> 1;
+		inb[k].imag = real[2 * k + 1] >> 1;
+	}
+
+	fft_execute_32(plan->plan, false);
+
+	for (k = 0; k <= half; k++) {
+		a = &z[k & (half - 1)];
+		b = &z[(half - k) & (half - 1)];
+		er = (int64_t)a->real + b->real;
+		ei = (int64_t)a->imag - b->imag;
+		or = ((int64_t)a->imag + b->imag) >> 1;
+		oi = ((int64_t)b->real - a->real) >> 1;
+		fft_twiddle_32(k * step, &w);
+		x[k].real = sat_int32((er >> 1) +
+				      (((int64_t)w.real * or - (int64_t)w.imag * oi) >> 31));
+		x[k].imag = sat_int32((ei >> 1) +
+				      (((int64_t)w.real * oi + (int64_t)w.imag * or) >> 31));
+	}
+}
+
+/*
+ * The inverse of the above. The half size complex IFFT input is
+ *	Z[k] = E[k] + j * conj(W^k) * D[k]
+ * where E[k] = (X[k] + conj(X[N/2 - k])) / 2 and D[k] = (X[k] - conj(X[N/2 - k])) / 2.
+ * The IFFT output is half of the real data.
+ */
+static void fft_real_inverse_32(struct fft_real_plan *plan)
+{
+	struct icomplex32 *inb = plan->plan->inb32;
+	struct icomplex32 *z = plan->plan->outb32;
+	struct icomplex32 *x = plan->spectrum;
+	struct icomplex32 *a;
+	struct icomplex32 *b;
+	struct icomplex32 w;
+	int32_t *real = plan->real;
+	int64_t er;
+	int64_t ei;
+	int64_t dr;
+	int64_t di;
+	int64_t or;
+	int64_t oi;
+	const int half = plan->size >> 1;
+	const int step = FFT_SIZE_MAX / plan->size;
+	int k;
+
+	for (k = 0; k < half; k++) {
+		a = &x[k];
+		b = &x[half - k];
+		er = ((int64_t)a->real + b->real) >> 1;
+		ei = ((int64_t)a->imag - b->imag) >> 1;
+		dr = ((int64_t)a->real - b->real) >> 1;
+		di = ((int64_t)a->imag + b->imag) >> 1;
+		fft_twiddle_32(k * step, &w);
+		or = (w.real * dr + w.imag * di) >> 31;
+		oi = (w.real * di - w.imag * dr) >> 31;
+		inb[k].real = sat_int32(er - oi);
+		inb[k].imag = sat_int32(ei + or);
+	}
+
+	fft_execute_32(plan->plan, true);
+
+	/* The IFFT output is complex conjugate */
+	for (k = 0; k < half; k++) {
+		real[2 * k] = sat_int32((int64_t)z[k].real << 1);
+		real[2 * k + 1] = sat_int32(-((int64_t)z[k].imag << 1));
+	}
+}
+
+/**
+ * \brief Execute the 32-bits real FFT or IFFT for the configured plan.
+ *	  The FFT output is scaled by 1 / size as with fft_execute_32().
+ * \param[in] plan - pointer to fft_real_plan which will be executed.
+ * \param[in] ifft - set to 0 for real to spectrum FFT and 1 for spectrum
+ *		     to real IFFT.
+ */
+void fft_execute_real_32(struct fft_real_plan *plan, bool ifft)
+{
+	if (!plan)
+		return;
+
+	if (ifft)
+		fft_real_inverse_32(plan);
+	else
+		fft_real_forward_32(plan);
+}
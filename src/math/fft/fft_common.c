@@ -18,7 +18,7 @@ struct fft_plan *fft_plan_new(void *inb, void *outb, uint32_t size, int bits)
 	int len = 0;
 	int i;
 
-	if (!inb || !outb)
+	if (!inb || !outb || size > FFT_SIZE_MAX)
 		return NULL;
 
 	plan = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(struct fft_plan));
@@ -0,0 +1,77 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2023 Intel Corporation. All rights reserved.
+ */
+
+#ifndef __SOF_MATH_FFT_TWIDDLE_H__
+#define __SOF_MATH_FFT_TWIDDLE_H__
+
+#include <sof/math/fft.h>
+#include <stdint.h>
+
+/*
+ * The twiddle tables contain the cosine for the first quarter of the unit
+ * circle. The rest of the factors are got from it with symmetry. The 16 bit
+ * table is defined in the 16 bit FFT, the 32 bit table is defined in
+ * fft_32_common.c.
+ */
+
+#define FFT_TWIDDLE_QUARTER	(FFT_SIZE_MAX / 4)
+
+extern const int16_t twiddle_cos_16[FFT_TWIDDLE_QUARTER + 1];
+extern const int32_t twiddle_cos_32[FFT_TWIDDLE_QUARTER + 1];
+
+/* w = exp(-j * 2 * pi * index / FFT_SIZE_MAX), index is 0 .. FFT_SIZE_MAX - 1 */
+static inline void fft_twiddle_32(int index, struct icomplex32 *w)
+{
+	int r = index & (FFT_TWIDDLE_QUARTER - 1);
+	int32_t c = twiddle_cos_32[r];
+	int32_t s = twiddle_cos_32[FFT_TWIDDLE_QUARTER - r];
+
+	switch (index / FFT_TWIDDLE_QUARTER) {
+	case 0:
+		w->real = c;
+		w->imag = -s;
+		break;
+	case 1:
+		w->real = -s;
+		w->imag = -c;
+		break;
+	case 2:
+		w->real = -c;
+		w->imag = s;
+		break;
+	default:
+		w->real = s;
+		w->imag = c;
+		break;
+	}
+}
+
+static inline void fft_twiddle_16(int index, struct icomplex16 *w)
+{
+	int r = index & (FFT_TWIDDLE_QUARTER - 1);
+	int16_t c = twiddle_cos_16[r];
+	int16_t s = twiddle_cos_16[FFT_TWIDDLE_QUARTER - r];
+
+	switch (index / FFT_TWIDDLE_QUARTER) {
+	case 0:
+		w->real = c;
+		w->imag = -s;
+		break;
+	case 1:
+		w->real = -s;
+		w->imag = -c;
+		break;
+	case 2:
+		w->real = -c;
+		w->imag = s;
+		break;
+	default:
+		w->real = s;
+		w->imag = c;
+		break;
+	}
+}
+
+#endif /* __SOF_MATH_FFT_TWIDDLE_H__ */
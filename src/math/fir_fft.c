@@ -0,0 +1,207 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <sof/audio/format.h>
+#include <sof/common.h>
+#include <sof/math/fft.h>
+#include <sof/math/fir_fft.h>
+#include <sof/math/numbers.h>
+#include <rtos/alloc.h>
+#include <rtos/string.h>
+#include <ipc/topology.h>
+#include <user/fir.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * The real FFT scales its output by 1 / FIR_FFT_SIZE, so the input and the
+ * coefficient spectra are scaled by it. The product of them is scaled up
+ * by FIR_FFT_SIZE before the IFFT, which then returns the convolution. The
+ * FIR output shift is applied to the product too to keep it in range.
+ */
+
+bool fir_fft_length_valid(struct sof_fir_coef_data *config)
+{
+	return config->length >= 4 && config->length <= FIR_FFT_MAX_LENGTH;
+}
+
+/* FFT of a real block that is zero padded to FIR_FFT_SIZE */
+static void fir_fft_real(struct fir_fft_state *fft, const int32_t *x, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++)
+		fft->fft_real[i] = x[i];
+
+	for (i = n; i < FIR_FFT_SIZE; i++)
+		fft->fft_real[i] = 0;
+
+	fft_execute_real_32(fft->plan, false);
+}
+
+int fir_fft_init(struct fir_fft_state *fft, struct sof_fir_coef_data *config)
+{
+	struct icomplex32 *h;
+	int32_t coef[FIR_FFT_BLOCK];
+	size_t spectra;
+	size_t size;
+	int taps;
+	int i;
+	int j;
+	int n;
+
+	if (!fir_fft_length_valid(config))
+		return -EINVAL;
+
+	taps = config->length;
+	fft->coef = ASSUME_ALIGNED(&config->coef[0], 4);
+	fft->out_shift = config->out_shift;
+	fft->head_taps = MIN(taps, FIR_FFT_BLOCK);
+	fft->partitions = (taps - fft->head_taps + FIR_FFT_BLOCK - 1) / FIR_FFT_BLOCK;
+	fft->newest = 0;
+	fft->pos = 0;
+
+	/* All buffers are allocated in one chunk */
+	spectra = fft->partitions * FIR_FFT_BINS;
+	size = (FIR_FFT_BINS + 2 * spectra) * sizeof(struct icomplex32) +
+	       (2 * FIR_FFT_SIZE + FIR_FFT_BLOCK) * sizeof(int32_t);
+	fft->fft_spectrum = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, size);
+	if (!fft->fft_spectrum)
+		return -ENOMEM;
+
+	fft->coef_spectra = fft->fft_spectrum + FIR_FFT_BINS;
+	fft->input_spectra = fft->coef_spectra + spectra;
+	fft->fft_real = (int32_t *)(fft->input_spectra + spectra);
+	fft->window = fft->fft_real + FIR_FFT_SIZE;
+	fft->tail = fft->window + FIR_FFT_SIZE;
+
+	if (!fft->partitions)
+		return 0;
+
+	fft->plan = fft_plan_new_real(fft->fft_real, fft->fft_spectrum, FIR_FFT_SIZE);
+	if (!fft->plan) {
+		rfree(fft->fft_spectrum);
+		fft->fft_spectrum = NULL;
+		return -ENOMEM;
+	}
+
+	/* Spectra of the partitions after the direct form head, Q1.15 taps
+	 * are converted to Q1.31 for the FFT.
+	 */
+	h = fft->coef_spectra;
+	for (i = 0; i < fft->partitions; i++) {
+		j = (i + 1) * FIR_FFT_BLOCK;
+		n = MIN(taps - j, FIR_FFT_BLOCK);
+		for (j = 0; j < n; j++)
+			coef[j] = (int32_t)fft->coef[(i + 1) * FIR_FFT_BLOCK + j] << 16;
+
+		fir_fft_real(fft, coef, n);
+		memcpy_s(h, FIR_FFT_BINS * sizeof(*h), fft->fft_spectrum,
+			 FIR_FFT_BINS * sizeof(*h));
+		h += FIR_FFT_BINS;
+	}
+
+	return 0;
+}
+
+void fir_fft_free(struct fir_fft_state *fft)
+{
+	fft_plan_free_real(fft->plan);
+	fft->plan = NULL;
+	rfree(fft->fft_spectrum);
+	fft->fft_spectrum = NULL;
+	fft->partitions = 0;
+	fft->head_taps = 0;
+}
+
+/*
+ * Called when the current input block is complete. The spectrum of the
+ * last two blocks is added to the delay line and the output of the
+ * partitions after the head is calculated for the next block.
+ */
+static void fir_fft_block(struct fir_fft_state *fft)
+{
+	struct icomplex32 *x;
+	struct icomplex32 *h;
+	int64_t re;
+	int64_t im;
+	const int shift = 31 - FIR_FFT_LEN + fft->out_shift;
+	int p;
+	int i;
+	int k;
+
+	fir_fft_real(fft, fft->window, FIR_FFT_SIZE);
+	if (++fft->newest == fft->partitions)
+		fft->newest = 0;
+
+	memcpy_s(&fft->input_spectra[fft->newest * FIR_FFT_BINS],
+		 FIR_FFT_BINS * sizeof(struct icomplex32),
+		 fft->fft_spectrum, FIR_FFT_BINS * sizeof(struct icomplex32));
+
+	/* The newest input spectrum is multiplied with partition 1, the
+	 * one before it with partition 2 and so on.
+	 */
+	for (k = 0; k < FIR_FFT_BINS; k++) {
+		re = 0;
+		im = 0;
+		i = fft->newest;
+		h = &fft->coef_spectra[k];
+		for (p = 0; p < fft->partitions; p++) {
+			x = &fft->input_spectra[i * FIR_FFT_BINS + k];
+			re += (int64_t)x->real * h->real - (int64_t)x->imag * h->imag;
+			im += (int64_t)x->real * h->imag + (int64_t)x->imag * h->real;
+			h += FIR_FFT_BINS;
+			if (--i < 0)
+				i = fft->partitions - 1;
+		}
+
+		fft->fft_spectrum[k].real = sat_int32(re >> shift);
+		fft->fft_spectrum[k].imag = sat_int32(im >> shift);
+	}
+
+	fft_execute_real_32(fft->plan, true);
+
+	/* Overlap-save, the last block of the circular convolution is valid */
+	memcpy_s(fft->tail, FIR_FFT_BLOCK * sizeof(int32_t),
+		 &fft->fft_real[FIR_FFT_BLOCK], FIR_FFT_BLOCK * sizeof(int32_t));
+}
+
+int32_t fir_fft_32x16(struct fir_fft_state *fft, int32_t x)
+{
+	int64_t y = 0;
+	int32_t *data = &fft->window[FIR_FFT_BLOCK + fft->pos];
+	int16_t *coef = fft->coef;
+	const int shift = 15 + fft->out_shift;
+	int n;
+
+	/* Bypass is set with no taps. */
+	if (!fft->head_taps)
+		return x;
+
+	*data = x;
+
+	/* Direct form for the first partition */
+	for (n = 0; n < fft->head_taps; n++) {
+		y += (int64_t)(*coef) * (*data);
+		coef++;
+		data--;
+	}
+
+	y = (y >> shift) + fft->tail[fft->pos];
+
+	if (++fft->pos == FIR_FFT_BLOCK) {
+		fft->pos = 0;
+		if (fft->partitions)
+			fir_fft_block(fft);
+
+		/* Current block becomes the previous block */
+		memcpy_s(fft->window, FIR_FFT_BLOCK * sizeof(int32_t),
+			 &fft->window[FIR_FFT_BLOCK], FIR_FFT_BLOCK * sizeof(int32_t));
+	}
+
+	/* Q2.46 -> Q2.31, saturate to Q1.31 */
+	return sat_int32(y);
+}
@@ -34,6 +34,7 @@ void fir_reset(struct fir_state_32x16 *fir)
 	 */
 }
 
+#if !FIR_SIMD
 int fir_delay_size(struct sof_fir_coef_data *config)
 {
 	/* Check FIR tap count for implementation specific constraints */
@@ -49,6 +50,7 @@ int fir_delay_size(struct sof_fir_coef_data *config)
 	 */
 	return (config->length + 4) * sizeof(int32_t);
 }
+#endif /* !FIR_SIMD */
 
 int fir_init_coef(struct fir_state_32x16 *fir,
 		  struct sof_fir_coef_data *config)
@@ -61,6 +63,7 @@ int fir_init_coef(struct fir_state_32x16 *fir,
 	return 0;
 }
 
+#if !FIR_SIMD
 void fir_init_delay(struct fir_state_32x16 *fir, int32_t **data)
 {
 	fir->delay = *data;
@@ -179,5 +182,6 @@ void fir_32x16_2x(struct fir_state_32x16 *fir, int32_t x0, int32_t x1, int32_t *
 	*y0 = sat_int32(a0 >> shift);
 	*y1 = sat_int32(a1 >> shift);
 }
+#endif /* !FIR_SIMD */
 
 #endif
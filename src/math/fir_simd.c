@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <sof/math/fir_config.h>
+
+#if FIR_GENERIC && FIR_SIMD
+
+#include <sof/common.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/format.h>
+#include <sof/math/fir_generic.h>
+#include <user/fir.h>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * EQ FIR algorithm code with SSE4.1 or NEON intrinsics. AVX2 builds use
+ * the SSE4.1 version. The delay line is mirrored so the taps are processed
+ * four at a time from contiguous data without a circular wrap. The products
+ * are accumulated in 64 bits like in the generic version so the output is
+ * bit exact with it.
+ */
+
+#if defined __SSE4_1__ && defined __x86_64__
+
+#include <smmintrin.h>
+
+struct fir_simd_acc {
+	__m128i v;
+};
+
+struct fir_simd_coef {
+	__m128i even; /* coefficients 0 and 2 as 32 bits in 64 bit lanes */
+	__m128i odd; /* coefficients 1 and 3 */
+};
+
+static inline struct fir_simd_acc fir_simd_zero(void)
+{
+	struct fir_simd_acc acc = { _mm_setzero_si128() };
+
+	return acc;
+}
+
+static inline struct fir_simd_coef fir_simd_load_coef(const int16_t *coef)
+{
+	struct fir_simd_coef c;
+
+	c.even = _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)coef));
+	c.odd = _mm_srli_epi64(c.even, 32);
+	return c;
+}
+
+/* acc += four products of 32 bit samples and 16 bit coefficients */
+static inline struct fir_simd_acc fir_simd_mac(struct fir_simd_acc acc,
+					       struct fir_simd_coef c,
+					       const int32_t *data)
+{
+	__m128i d = _mm_loadu_si128((const __m128i *)data);
+
+	acc.v = _mm_add_epi64(acc.v, _mm_mul_epi32(c.even, d));
+	acc.v = _mm_add_epi64(acc.v, _mm_mul_epi32(c.odd, _mm_srli_epi64(d, 32)));
+	return acc;
+}
+
+static inline int64_t fir_simd_sum(struct fir_simd_acc acc)
+{
+	return _mm_cvtsi128_si64(acc.v) + _mm_extract_epi64(acc.v, 1);
+}
+
+#elif defined __ARM_NEON
+
+#include <arm_neon.h>
+
+struct fir_simd_acc {
+	int64x2_t v;
+};
+
+struct fir_simd_coef {
+	int32x4_t v;
+};
+
+static inline struct fir_simd_acc fir_simd_zero(void)
+{
+	struct fir_simd_acc acc = { vdupq_n_s64(0) };
+
+	return acc;
+}
+
+static inline struct fir_simd_coef fir_simd_load_coef(const int16_t *coef)
+{
+	struct fir_simd_coef c = { vmovl_s16(vld1_s16(coef)) };
+
+	return c;
+}
+
+/* acc += four products of 32 bit samples and 16 bit coefficients */
+static inline struct fir_simd_acc fir_simd_mac(struct fir_simd_acc acc,
+					       struct fir_simd_coef c,
+					       const int32_t *data)
+{
+	int32x4_t d = vld1q_s32(data);
+
+	acc.v = vmlal_s32(acc.v, vget_low_s32(c.v), vget_low_s32(d));
+	acc.v = vmlal_s32(acc.v, vget_high_s32(c.v), vget_high_s32(d));
+	return acc;
+}
+
+static inline int64_t fir_simd_sum(struct fir_simd_acc acc)
+{
+	return vgetq_lane_s64(acc.v, 0) + vgetq_lane_s64(acc.v, 1);
+}
+
+#else
+#error "FIR_SIMD needs SSE4.1 or NEON."
+#endif
+
+int fir_delay_size(struct sof_fir_coef_data *config)
+{
+	/* Check FIR tap count for implementation specific constraints */
+	if (config->length > SOF_FIR_MAX_LENGTH || config->length < 4)
+		return -EINVAL;
+
+	/* The optimization requires the tap count to be multiple of four */
+	if (config->length & 0x3)
+		return -EINVAL;
+
+	/* The dual sample version needs one more delay entry, two are added
+	 * to preserve 64 bit align. Then the line is mirrored.
+	 */
+	return 2 * (config->length + 2) * sizeof(int32_t);
+}
+
+void fir_init_delay(struct fir_state_32x16 *fir, int32_t **data)
+{
+	fir->delay = *data;
+	*data += 2 * fir->length; /* Point to next delay line start */
+}
+
+/* Store a new sample in both halves of the mirrored delay line */
+static inline int32_t *fir_simd_write(struct fir_state_32x16 *fir, int32_t x)
+{
+	int32_t *data;
+
+	if (--fir->rwi < 0)
+		fir->rwi = fir->length - 1;
+
+	data = &fir->delay[fir->rwi];
+	data[0] = x;
+	data[fir->length] = x;
+	return data;
+}
+
+int32_t fir_32x16(struct fir_state_32x16 *fir, int32_t x)
+{
+	struct fir_simd_acc acc = fir_simd_zero();
+	int32_t *data;
+	int16_t *coef = &fir->coef[0];
+	int n;
+	const int taps = fir->taps;
+	const int shift = 15 + fir->out_shift;
+
+	/* Bypass is set with length set to zero. */
+	if (!fir->length)
+		return x;
+
+	data = fir_simd_write(fir, x);
+
+	for (n = 0; n < taps; n += 4)
+		acc = fir_simd_mac(acc, fir_simd_load_coef(&coef[n]), &data[n]);
+
+	/* Q2.46 -> Q2.31, saturate to Q1.31 */
+	return sat_int32(fir_simd_sum(acc) >> shift);
+}
+
+void fir_32x16_2x(struct fir_state_32x16 *fir, int32_t x0, int32_t x1, int32_t *y0, int32_t *y1)
+{
+	struct fir_simd_acc a0 = fir_simd_zero();
+	struct fir_simd_acc a1 = fir_simd_zero();
+	struct fir_simd_coef c;
+	int32_t *data;
+	int16_t *coef = &fir->coef[0];
+	int n;
+	const int taps = fir->taps;
+	const int shift = 15 + fir->out_shift;
+
+	/* Bypass is set with length set to zero. */
+	if (!fir->taps) {
+		*y0 = x0;
+		*y1 = x1;
+		return;
+	}
+
+	/* Write samples to delay, x1 is the newest and x0 follows it */
+	fir_simd_write(fir, x0);
+	data = fir_simd_write(fir, x1);
+
+	for (n = 0; n < taps; n += 4) {
+		c = fir_simd_load_coef(&coef[n]);
+		a1 = fir_simd_mac(a1, c, &data[n]);
+		a0 = fir_simd_mac(a0, c, &data[n + 1]);
+	}
+
+	/* Q2.46 -> Q2.31, saturate to Q1.31 */
+	*y0 = sat_int32(fir_simd_sum(a0) >> shift);
+	*y1 = sat_int32(fir_simd_sum(a1) >> shift);
+}
+
+#endif
@@ -0,0 +1,355 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <sof/audio/format.h>
+#include <sof/common.h>
+#include <sof/math/iir_block.h>
+#include <sof/math/numbers.h>
+#include <rtos/alloc.h>
+#include <rtos/string.h>
+#include <ipc/topology.h>
+#include <user/eq.h>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Coefficients {a2, a1, b2, b1, b0, shift, gain} of a bit exact pass-through
+ * biquad. The gain of two with shift of one is exact also with the HiFi3
+ * fractional multiply that would drop the LSB with a unity Q2.14 gain.
+ */
+static const int32_t iir_block_passthrough[SOF_EQ_IIR_NBIQUAD] = {
+	0, 0, 0, 0, ONE_Q2_30, 1, 1 << 15
+};
+
+/* All zeros coefficients, a biquad that outputs silence */
+static const int32_t iir_block_silence[SOF_EQ_IIR_NBIQUAD];
+
+/* Merge the biquads of a channel to the common shape of the block filter. The
+ * series cascades can be of different length, the shorter ones are padded. The
+ * parallel cascades need to be the same for all channels.
+ */
+static int iir_block_shape(int *biquads, int *in_series, int ch_biquads, int ch_in_series)
+{
+	/* Bypass channels fit any shape */
+	if (!ch_biquads)
+		return 0;
+
+	if (!*biquads) {
+		*biquads = ch_biquads;
+		*in_series = ch_in_series;
+		return 0;
+	}
+
+	if (ch_biquads != ch_in_series || *biquads != *in_series) {
+		if (ch_biquads != *biquads || ch_in_series != *in_series)
+			return -EINVAL;
+
+		return 0;
+	}
+
+	*biquads = MAX(*biquads, ch_biquads);
+	*in_series = *biquads;
+	return 0;
+}
+
+/* Get the coefficients of biquad b for a channel with ch_biquads */
+static const int32_t *iir_block_biquad_coef(const int32_t *ch_coef, int ch_biquads,
+					    int in_series, int b)
+{
+	/* Pass the input through with the first cascade and silence the
+	 * parallel ones for a channel in bypass.
+	 */
+	if (!ch_biquads)
+		return b < in_series ? iir_block_passthrough : iir_block_silence;
+
+	if (b < ch_biquads)
+		return &ch_coef[b * SOF_EQ_IIR_NBIQUAD];
+
+	return iir_block_passthrough;
+}
+
+static void iir_block_set_coef(int32_t *coef, int stride, int ch, int b, const int32_t *src)
+{
+	int k;
+
+	for (k = 0; k < SOF_EQ_IIR_NBIQUAD; k++)
+		coef[(b * SOF_EQ_IIR_NBIQUAD + k) * stride + ch] = src[k];
+}
+
+int iir_block_init_df1(struct iir_block_df1 *iir, const struct iir_state_df1 filters[],
+		       int channels)
+{
+	int32_t *data;
+	size_t size;
+	int biquads = 0;
+	int in_series = 0;
+	int stride;
+	int ch;
+	int b;
+	int k;
+	int ret;
+
+	iir->channels = channels;
+	iir->biquads = 0;
+	iir->biquads_in_series = 0;
+	iir->coef = NULL;
+	iir->delay = NULL;
+	iir->branch = NULL;
+	iir->sum = NULL;
+	if (channels < 1)
+		return -EINVAL;
+
+	for (ch = 0; ch < channels; ch++) {
+		ret = iir_block_shape(&biquads, &in_series, filters[ch].biquads,
+				      filters[ch].biquads_in_series);
+		if (ret < 0)
+			return ret;
+	}
+
+	/* All channels in bypass */
+	if (!biquads)
+		return 0;
+
+	stride = ALIGN_UP(channels, 2);
+	size = biquads * (SOF_EQ_IIR_NBIQUAD + IIR_DF1_NUM_STATE) * stride * sizeof(int32_t);
+	if (biquads > in_series)
+		size += IIR_BLOCK_FRAMES * channels * (sizeof(int32_t) + sizeof(int64_t));
+
+	data = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, size);
+	if (!data)
+		return -ENOMEM;
+
+	/* The 64 bit sum is placed first to keep it aligned */
+	if (biquads > in_series) {
+		iir->sum = (int64_t *)data;
+		data += 2 * IIR_BLOCK_FRAMES * channels;
+		iir->branch = data;
+		data += IIR_BLOCK_FRAMES * channels;
+	}
+
+	iir->coef = data;
+	iir->delay = data + biquads * SOF_EQ_IIR_NBIQUAD * stride;
+	iir->stride = stride;
+	iir->biquads = biquads;
+	iir->biquads_in_series = in_series;
+
+	/* Continue from the current state of the per channel filters */
+	for (ch = 0; ch < channels; ch++) {
+		for (b = 0; b < biquads; b++) {
+			iir_block_set_coef(iir->coef, stride, ch, b,
+					   iir_block_biquad_coef(filters[ch].coef,
+								 filters[ch].biquads,
+								 in_series, b));
+			if (b >= filters[ch].biquads || !filters[ch].delay)
+				continue;
+
+			for (k = 0; k < IIR_DF1_NUM_STATE; k++)
+				iir->delay[(b * IIR_DF1_NUM_STATE + k) * stride + ch] =
+					filters[ch].delay[b * IIR_DF1_NUM_STATE + k];
+		}
+	}
+
+	return 0;
+}
+
+void iir_block_free_df1(struct iir_block_df1 *iir)
+{
+	if (iir->sum)
+		rfree(iir->sum);
+	else
+		rfree(iir->coef);
+
+	iir->coef = NULL;
+	iir->delay = NULL;
+	iir->branch = NULL;
+	iir->sum = NULL;
+	iir->biquads = 0;
+	iir->biquads_in_series = 0;
+}
+
+void iir_block_df1(struct iir_block_df1 *iir, const int32_t *x, int32_t *y, int frames)
+{
+	int nseries = iir->biquads_in_series;
+	int samples;
+	int n;
+	int i;
+	int j;
+	int k;
+
+	if (!iir->biquads) {
+		if (x != y)
+			memcpy_s(y, frames * iir->channels * sizeof(int32_t),
+				 x, frames * iir->channels * sizeof(int32_t));
+		return;
+	}
+
+	/* Series cascade is run in place in the output after the first biquad */
+	if (iir->biquads == nseries) {
+		iir_block_biquad_df1(iir, 0, x, y, frames);
+		for (j = 1; j < nseries; j++)
+			iir_block_biquad_df1(iir, j, y, y, frames);
+
+		return;
+	}
+
+	/* The parallel cascades are summed in 64 bits and saturated once as in
+	 * iir_df1(). The input is read until the last cascade so the output is
+	 * written after it.
+	 */
+	while (frames) {
+		n = MIN(frames, IIR_BLOCK_FRAMES);
+		samples = n * iir->channels;
+		for (j = 0; j < iir->biquads; j += nseries) {
+			iir_block_biquad_df1(iir, j, x, iir->branch, n);
+			for (k = 1; k < nseries; k++)
+				iir_block_biquad_df1(iir, j + k, iir->branch, iir->branch, n);
+
+			for (i = 0; i < samples; i++)
+				iir->sum[i] = j ? iir->sum[i] + iir->branch[i] : iir->branch[i];
+		}
+
+		for (i = 0; i < samples; i++)
+			y[i] = sat_int32(iir->sum[i]);
+
+		x += samples;
+		y += samples;
+		frames -= n;
+	}
+}
+
+int iir_block_init_df2t(struct iir_block_df2t *iir, const struct iir_state_df2t filters[],
+			int channels)
+{
+	int64_t *data;
+	size_t size;
+	int biquads = 0;
+	int in_series = 0;
+	int stride;
+	int ch;
+	int b;
+	int k;
+	int ret;
+
+	iir->channels = channels;
+	iir->biquads = 0;
+	iir->biquads_in_series = 0;
+	iir->coef = NULL;
+	iir->delay = NULL;
+	iir->branch = NULL;
+	iir->sum = NULL;
+	if (channels < 1)
+		return -EINVAL;
+
+	for (ch = 0; ch < channels; ch++) {
+		ret = iir_block_shape(&biquads, &in_series, filters[ch].biquads,
+				      filters[ch].biquads_in_series);
+		if (ret < 0)
+			return ret;
+	}
+
+	/* All channels in bypass */
+	if (!biquads)
+		return 0;
+
+	stride = ALIGN_UP(channels, 2);
+	size = biquads * stride * (IIR_DF2T_NUM_DELAYS * sizeof(int64_t) +
+				   SOF_EQ_IIR_NBIQUAD * sizeof(int32_t));
+	if (biquads > in_series)
+		size += 2 * IIR_BLOCK_FRAMES * channels * sizeof(int32_t);
+
+	/* The 64 bit delay lines are placed first to keep them aligned */
+	data = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, size);
+	if (!data)
+		return -ENOMEM;
+
+	iir->delay = data;
+	iir->coef = (int32_t *)(data + biquads * IIR_DF2T_NUM_DELAYS * stride);
+	if (biquads > in_series) {
+		iir->branch = iir->coef + biquads * SOF_EQ_IIR_NBIQUAD * stride;
+		iir->sum = iir->branch + IIR_BLOCK_FRAMES * channels;
+	}
+
+	iir->stride = stride;
+	iir->biquads = biquads;
+	iir->biquads_in_series = in_series;
+
+	/* Continue from the current state of the per channel filters */
+	for (ch = 0; ch < channels; ch++) {
+		for (b = 0; b < biquads; b++) {
+			iir_block_set_coef(iir->coef, stride, ch, b,
+					   iir_block_biquad_coef(filters[ch].coef,
+								 filters[ch].biquads,
+								 in_series, b));
+			if (b >= filters[ch].biquads || !filters[ch].delay)
+				continue;
+
+			for (k = 0; k < IIR_DF2T_NUM_DELAYS; k++)
+				iir->delay[(b * IIR_DF2T_NUM_DELAYS + k) * stride + ch] =
+					filters[ch].delay[b * IIR_DF2T_NUM_DELAYS + k];
+		}
+	}
+
+	return 0;
+}
+
+void iir_block_free_df2t(struct iir_block_df2t *iir)
+{
+	rfree(iir->delay);
+	iir->coef = NULL;
+	iir->delay = NULL;
+	iir->branch = NULL;
+	iir->sum = NULL;
+	iir->biquads = 0;
+	iir->biquads_in_series = 0;
+}
+
+void iir_block_df2t(struct iir_block_df2t *iir, const int32_t *x, int32_t *y, int frames)
+{
+	int nseries = iir->biquads_in_series;
+	int samples;
+	int n;
+	int i;
+	int j;
+	int k;
+
+	if (!iir->biquads) {
+		if (x != y)
+			memcpy_s(y, frames * iir->channels * sizeof(int32_t),
+				 x, frames * iir->channels * sizeof(int32_t));
+		return;
+	}
+
+	/* Series cascade is run in place in the output after the first biquad */
+	if (iir->biquads == nseries) {
+		iir_block_biquad_df2t(iir, 0, x, y, frames);
+		for (j = 1; j < nseries; j++)
+			iir_block_biquad_df2t(iir, j, y, y, frames);
+
+		return;
+	}
+
+	/* The parallel cascades are summed with saturation after each one as
+	 * in iir_df2t().
+	 */
+	while (frames) {
+		n = MIN(frames, IIR_BLOCK_FRAMES);
+		samples = n * iir->channels;
+		for (j = 0; j < iir->biquads; j += nseries) {
+			iir_block_biquad_df2t(iir, j, x, iir->branch, n);
+			for (k = 1; k < nseries; k++)
+				iir_block_biquad_df2t(iir, j + k, iir->branch, iir->branch, n);
+
+			for (i = 0; i < samples; i++)
+				iir->sum[i] = j ? sat_int32((int64_t)iir->sum[i] + iir->branch[i]) :
+					iir->branch[i];
+		}
+
+		for (i = 0; i < samples; i++)
+			y[i] = iir->sum[i];
+
+		x += samples;
+		y += samples;
+		frames -= n;
+	}
+}
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <sof/math/iir_block.h>
+
+#if IIR_BLOCK_GENERIC
+
+#include <sof/audio/format.h>
+#include <user/eq.h>
+#include <stdint.h>
+
+/*
+ * One biquad of every channel is run for the block of frames. The
+ * coefficients and delay lines of the channel are kept in local variables
+ * for the frames loop. The arithmetic is the same as in iir_df1() and
+ * iir_df2t() so the output is bit exact with them.
+ */
+
+void iir_block_biquad_df1(struct iir_block_df1 *iir, int biquad, const int32_t *x,
+			  int32_t *y, int frames)
+{
+	const int32_t *coef = &iir->coef[biquad * SOF_EQ_IIR_NBIQUAD * iir->stride];
+	int32_t *delay = &iir->delay[biquad * IIR_DF1_NUM_STATE * iir->stride];
+	const int stride = iir->stride;
+	const int nch = iir->channels;
+	int64_t acc;
+	int32_t a2, a1, b2, b1, b0, gain;
+	int32_t y2, y1, x2, x1;
+	int32_t in;
+	int32_t tmp;
+	int shift;
+	int ch;
+	int i;
+	int n;
+
+	for (ch = 0; ch < nch; ch++) {
+		/* Coefficients order is {a2, a1, b2, b1, b0, shift, gain} */
+		a2 = coef[ch];
+		a1 = coef[stride + ch];
+		b2 = coef[2 * stride + ch];
+		b1 = coef[3 * stride + ch];
+		b0 = coef[4 * stride + ch];
+		shift = coef[5 * stride + ch];
+		gain = coef[6 * stride + ch];
+
+		/* Delay order is {y(n - 2), y(n - 1), x(n - 2), x(n - 1)} */
+		y2 = delay[ch];
+		y1 = delay[stride + ch];
+		x2 = delay[2 * stride + ch];
+		x1 = delay[3 * stride + ch];
+
+		for (n = 0, i = ch; n < frames; n++, i += nch) {
+			in = x[i];
+			acc = (int64_t)a2 * y2 + (int64_t)a1 * y1 + (int64_t)b2 * x2 +
+			      (int64_t)b1 * x1 + (int64_t)b0 * in;
+			tmp = sat_int32(Q_SHIFT_RND(acc, 61, 31));
+			y2 = y1;
+			y1 = tmp;
+			x2 = x1;
+			x1 = in;
+
+			/* Gain Q2.14 x Q1.31 -> Q3.45, shift and saturate to Q1.31 */
+			acc = (int64_t)gain * tmp;
+			y[i] = sat_int32(Q_SHIFT_RND(acc, 45 + shift, 31));
+		}
+
+		delay[ch] = y2;
+		delay[stride + ch] = y1;
+		delay[2 * stride + ch] = x2;
+		delay[3 * stride + ch] = x1;
+	}
+}
+
+void iir_block_biquad_df2t(struct iir_block_df2t *iir, int biquad, const int32_t *x,
+			   int32_t *y, int frames)
+{
+	const int32_t *coef = &iir->coef[biquad * SOF_EQ_IIR_NBIQUAD * iir->stride];
+	int64_t *delay = &iir->delay[biquad * IIR_DF2T_NUM_DELAYS * iir->stride];
+	const int stride = iir->stride;
+	const int nch = iir->channels;
+	int64_t acc;
+	int64_t d0, d1;
+	int32_t a2, a1, b2, b1, b0, gain;
+	int32_t in;
+	int32_t tmp;
+	int shift;
+	int ch;
+	int i;
+	int n;
+
+	for (ch = 0; ch < nch; ch++) {
+		/* Coefficients order is {a2, a1, b2, b1, b0, shift, gain} */
+		a2 = coef[ch];
+		a1 = coef[stride + ch];
+		b2 = coef[2 * stride + ch];
+		b1 = coef[3 * stride + ch];
+		b0 = coef[4 * stride + ch];
+		shift = coef[5 * stride + ch];
+		gain = coef[6 * stride + ch];
+		d0 = delay[ch];
+		d1 = delay[stride + ch];
+
+		for (n = 0, i = ch; n < frames; n++, i += nch) {
+			in = x[i];
+			acc = (int64_t)b0 * in + d0;
+			tmp = sat_int32(Q_SHIFT_RND(acc, 61, 31));
+			d0 = d1 + (int64_t)b1 * in + (int64_t)a1 * tmp;
+			d1 = (int64_t)b2 * in + (int64_t)a2 * tmp;
+
+			/* Gain Q2.14 x Q1.31 -> Q3.45, shift and saturate to Q1.31 */
+			acc = (int64_t)gain * tmp;
+			y[i] = sat_int32(Q_SHIFT_RND(acc, 45 + shift, 31));
+		}
+
+		delay[ch] = d0;
+		delay[stride + ch] = d1;
+	}
+}
+
+#endif /* IIR_BLOCK_GENERIC */
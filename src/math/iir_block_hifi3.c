@@ -0,0 +1,206 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <sof/math/iir_block.h>
+
+#if IIR_BLOCK_HIFI3
+
+#include <sof/audio/format.h>
+#include <user/eq.h>
+#include <xtensa/tie/xt_hifi3.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Block IIR with HiFi3 intrinsics. Two adjacent channels are run in the
+ * high and low lanes of ae_int32x2 vectors. The arithmetic is the same as in
+ * the HiFi3 versions of iir_df1() and iir_df2t(), e.g. the DF2T delay lines
+ * are kept in Q17.47.
+ */
+
+/* The coefficients and delay lines are padded to even channels count so
+ * they are always loaded in pairs. The odd last channel is run with single
+ * sample loads and stores of the data.
+ */
+static inline ae_int32x2 iir_hifi3_load(const int32_t *x, int i, bool pair)
+{
+	ae_int32x2 h = AE_L32_X((const ae_int32 *)x, i * sizeof(int32_t));
+
+	if (!pair)
+		return h;
+
+	return AE_SEL32_HH(h, AE_L32_X((const ae_int32 *)x, (i + 1) * sizeof(int32_t)));
+}
+
+static inline void iir_hifi3_store(int32_t *y, int i, ae_int32x2 out, bool pair)
+{
+	AE_S32_L_X(AE_SEL32_HH(out, out), (ae_int32 *)y, i * sizeof(int32_t));
+	if (pair)
+		AE_S32_L_X(out, (ae_int32 *)y, (i + 1) * sizeof(int32_t));
+}
+
+static inline void iir_hifi3_df1(struct iir_block_df1 *iir, int biquad, const int32_t *x,
+				 int32_t *y, int frames, int ch, bool pair)
+{
+	const int32_t *coef = &iir->coef[biquad * SOF_EQ_IIR_NBIQUAD * iir->stride + ch];
+	ae_int32x2 *delay = (ae_int32x2 *)&iir->delay[biquad * IIR_DF1_NUM_STATE *
+						      iir->stride + ch];
+	const int stride_bytes = iir->stride * sizeof(int32_t);
+	const int nch = iir->channels;
+	const int shift_h = coef[5 * iir->stride];
+	const int shift_l = coef[5 * iir->stride + 1];
+	ae_int32x2 a2, a1, b2, b1, b0, gain;
+	ae_int32x2 y2, y1, x2, x1;
+	ae_int32x2 in;
+	ae_int32x2 tmp;
+	ae_int64 acc_h;
+	ae_int64 acc_l;
+	int i;
+	int n;
+
+	/* Coefficients order is {a2, a1, b2, b1, b0, shift, gain} */
+	a2 = AE_L32X2_X((const ae_int32x2 *)coef, 0);
+	a1 = AE_L32X2_X((const ae_int32x2 *)coef, stride_bytes);
+	b2 = AE_L32X2_X((const ae_int32x2 *)coef, 2 * stride_bytes);
+	b1 = AE_L32X2_X((const ae_int32x2 *)coef, 3 * stride_bytes);
+	b0 = AE_L32X2_X((const ae_int32x2 *)coef, 4 * stride_bytes);
+	gain = AE_L32X2_X((const ae_int32x2 *)coef, 6 * stride_bytes);
+
+	/* Delay order is {y(n - 2), y(n - 1), x(n - 2), x(n - 1)} */
+	y2 = AE_L32X2_X(delay, 0);
+	y1 = AE_L32X2_X(delay, stride_bytes);
+	x2 = AE_L32X2_X(delay, 2 * stride_bytes);
+	x1 = AE_L32X2_X(delay, 3 * stride_bytes);
+
+	for (n = 0, i = ch; n < frames; n++, i += nch) {
+		in = iir_hifi3_load(x, i, pair);
+
+		/* Q2.30 x Q1.31 -> Q18.46, convert to Q17.47 and round to Q1.31 */
+		acc_h = AE_MULF32R_HH(a2, y2);
+		AE_MULAF32R_HH(acc_h, a1, y1);
+		AE_MULAF32R_HH(acc_h, b2, x2);
+		AE_MULAF32R_HH(acc_h, b1, x1);
+		AE_MULAF32R_HH(acc_h, b0, in);
+		acc_l = AE_MULF32R_LL(a2, y2);
+		AE_MULAF32R_LL(acc_l, a1, y1);
+		AE_MULAF32R_LL(acc_l, b2, x2);
+		AE_MULAF32R_LL(acc_l, b1, x1);
+		AE_MULAF32R_LL(acc_l, b0, in);
+		tmp = AE_ROUND32X2F48SSYM(AE_SLAI64S(acc_h, 1), AE_SLAI64S(acc_l, 1));
+		y2 = y1;
+		y1 = tmp;
+		x2 = x1;
+		x1 = in;
+
+		/* Gain Q18.14 x Q1.31 -> Q34.30, convert to Q17.47, shift and round */
+		acc_h = AE_SRAA64(AE_SLAI64S(AE_MULF32R_HH(gain, tmp), 17), shift_h);
+		acc_l = AE_SRAA64(AE_SLAI64S(AE_MULF32R_LL(gain, tmp), 17), shift_l);
+		iir_hifi3_store(y, i, AE_ROUND32X2F48SSYM(acc_h, acc_l), pair);
+	}
+
+	AE_S32X2_X(y2, delay, 0);
+	AE_S32X2_X(y1, delay, stride_bytes);
+	AE_S32X2_X(x2, delay, 2 * stride_bytes);
+	AE_S32X2_X(x1, delay, 3 * stride_bytes);
+}
+
+void iir_block_biquad_df1(struct iir_block_df1 *iir, int biquad, const int32_t *x,
+			  int32_t *y, int frames)
+{
+	int ch;
+
+	for (ch = 0; ch + 1 < iir->channels; ch += 2)
+		iir_hifi3_df1(iir, biquad, x, y, frames, ch, true);
+
+	if (ch < iir->channels)
+		iir_hifi3_df1(iir, biquad, x, y, frames, ch, false);
+}
+
+static inline void iir_hifi3_df2t(struct iir_block_df2t *iir, int biquad, const int32_t *x,
+				  int32_t *y, int frames, int ch, bool pair)
+{
+	const int32_t *coef = &iir->coef[biquad * SOF_EQ_IIR_NBIQUAD * iir->stride + ch];
+	ae_int64 *delay = (ae_int64 *)&iir->delay[biquad * IIR_DF2T_NUM_DELAYS *
+						  iir->stride + ch];
+	const int stride_bytes = iir->stride * sizeof(int32_t);
+	const int stride = iir->stride;
+	const int nch = iir->channels;
+	const int shift_h = coef[5 * stride];
+	const int shift_l = coef[5 * stride + 1];
+	ae_int32x2 a2, a1, b2, b1, b0, gain;
+	ae_int32x2 in;
+	ae_int32x2 tmp;
+	ae_int64 d0_h, d0_l, d1_h, d1_l;
+	ae_int64 acc_h;
+	ae_int64 acc_l;
+	int i;
+	int n;
+
+	/* Coefficients order is {a2, a1, b2, b1, b0, shift, gain} */
+	a2 = AE_L32X2_X((const ae_int32x2 *)coef, 0);
+	a1 = AE_L32X2_X((const ae_int32x2 *)coef, stride_bytes);
+	b2 = AE_L32X2_X((const ae_int32x2 *)coef, 2 * stride_bytes);
+	b1 = AE_L32X2_X((const ae_int32x2 *)coef, 3 * stride_bytes);
+	b0 = AE_L32X2_X((const ae_int32x2 *)coef, 4 * stride_bytes);
+	gain = AE_L32X2_X((const ae_int32x2 *)coef, 6 * stride_bytes);
+
+	/* The delay lines are Q17.47 */
+	d0_h = delay[0];
+	d0_l = delay[1];
+	d1_h = delay[stride];
+	d1_l = delay[stride + 1];
+
+	for (n = 0, i = ch; n < frames; n++, i += nch) {
+		in = iir_hifi3_load(x, i, pair);
+
+		/* Output of biquad, Q18.46 MAC to Q17.47 and round to Q1.31 */
+		acc_h = AE_SRAI64(d0_h, 1);
+		acc_l = AE_SRAI64(d0_l, 1);
+		AE_MULAF32R_HH(acc_h, b0, in);
+		AE_MULAF32R_LL(acc_l, b0, in);
+		tmp = AE_ROUND32X2F48SSYM(AE_SLAI64S(acc_h, 1), AE_SLAI64S(acc_l, 1));
+
+		/* Delay d0 */
+		acc_h = AE_SRAI64(d1_h, 1);
+		acc_l = AE_SRAI64(d1_l, 1);
+		AE_MULAF32R_HH(acc_h, b1, in);
+		AE_MULAF32R_HH(acc_h, a1, tmp);
+		AE_MULAF32R_LL(acc_l, b1, in);
+		AE_MULAF32R_LL(acc_l, a1, tmp);
+		d0_h = AE_SLAI64S(acc_h, 1);
+		d0_l = AE_SLAI64S(acc_l, 1);
+
+		/* Delay d1 */
+		acc_h = AE_MULF32R_HH(b2, in);
+		acc_l = AE_MULF32R_LL(b2, in);
+		AE_MULAF32R_HH(acc_h, a2, tmp);
+		AE_MULAF32R_LL(acc_l, a2, tmp);
+		d1_h = AE_SLAI64S(acc_h, 1);
+		d1_l = AE_SLAI64S(acc_l, 1);
+
+		/* Gain Q18.14 x Q1.31 -> Q34.30, convert to Q17.47, shift and round */
+		acc_h = AE_SRAA64(AE_SLAI64S(AE_MULF32R_HH(gain, tmp), 17), shift_h);
+		acc_l = AE_SRAA64(AE_SLAI64S(AE_MULF32R_LL(gain, tmp), 17), shift_l);
+		iir_hifi3_store(y, i, AE_ROUND32X2F48SSYM(acc_h, acc_l), pair);
+	}
+
+	delay[0] = d0_h;
+	delay[1] = d0_l;
+	delay[stride] = d1_h;
+	delay[stride + 1] = d1_l;
+}
+
+void iir_block_biquad_df2t(struct iir_block_df2t *iir, int biquad, const int32_t *x,
+			   int32_t *y, int frames)
+{
+	int ch;
+
+	for (ch = 0; ch + 1 < iir->channels; ch += 2)
+		iir_hifi3_df2t(iir, biquad, x, y, frames, ch, true);
+
+	if (ch < iir->channels)
+		iir_hifi3_df2t(iir, biquad, x, y, frames, ch, false);
+}
+
+#endif /* IIR_BLOCK_HIFI3 */
@@ -0,0 +1,348 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <sof/math/iir_block.h>
+
+#if IIR_BLOCK_SIMD
+
+#include <sof/audio/format.h>
+#include <user/eq.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Block IIR with SSE4.2 or NEON intrinsics. Two adjacent channels are run
+ * in the lanes of 64 bit vectors. The arithmetic is the same as in the
+ * generic version so the output is bit exact with it. SSE4.2 is needed for
+ * the 64 bit compare that the arithmetic shift and the saturation are
+ * built on.
+ */
+
+#if defined __SSE4_2__ && defined __x86_64__
+
+#include <nmmintrin.h>
+
+/* 32 bit samples or coefficients, sign extended to the 64 bit lanes */
+struct iir_simd_v32 {
+	__m128i v;
+};
+
+struct iir_simd_v64 {
+	__m128i v;
+};
+
+/* Right shifts for the lanes */
+struct iir_simd_shift {
+	int s0;
+	int s1;
+};
+
+static inline struct iir_simd_shift iir_simd_set_shift(int s0, int s1)
+{
+	struct iir_simd_shift s = { s0, s1 };
+
+	return s;
+}
+
+static inline struct iir_simd_v32 iir_simd_load2(const int32_t *p)
+{
+	struct iir_simd_v32 r = { _mm_cvtepi32_epi64(_mm_loadl_epi64((const __m128i *)p)) };
+
+	return r;
+}
+
+static inline struct iir_simd_v32 iir_simd_load1(const int32_t *p)
+{
+	struct iir_simd_v32 r = { _mm_cvtepi32_epi64(_mm_cvtsi32_si128(*p)) };
+
+	return r;
+}
+
+static inline void iir_simd_store2(int32_t *p, struct iir_simd_v32 a)
+{
+	_mm_storel_epi64((__m128i *)p, _mm_shuffle_epi32(a.v, _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+static inline void iir_simd_store1(int32_t *p, struct iir_simd_v32 a)
+{
+	*p = _mm_cvtsi128_si32(a.v);
+}
+
+static inline struct iir_simd_v64 iir_simd_load64(const int64_t *p)
+{
+	struct iir_simd_v64 r = { _mm_loadu_si128((const __m128i *)p) };
+
+	return r;
+}
+
+static inline void iir_simd_store64(int64_t *p, struct iir_simd_v64 a)
+{
+	_mm_storeu_si128((__m128i *)p, a.v);
+}
+
+static inline struct iir_simd_v64 iir_simd_mul(struct iir_simd_v32 a, struct iir_simd_v32 b)
+{
+	struct iir_simd_v64 r = { _mm_mul_epi32(a.v, b.v) };
+
+	return r;
+}
+
+static inline struct iir_simd_v64 iir_simd_mac(struct iir_simd_v64 acc, struct iir_simd_v32 a,
+					       struct iir_simd_v32 b)
+{
+	acc.v = _mm_add_epi64(acc.v, _mm_mul_epi32(a.v, b.v));
+	return acc;
+}
+
+/* Arithmetic right shift of 64 bit lanes by 0 < n < 64 */
+static inline __m128i iir_simd_sra64(__m128i a, int n)
+{
+	__m128i sign = _mm_cmpgt_epi64(_mm_setzero_si128(), a);
+
+	return _mm_or_si128(_mm_srl_epi64(a, _mm_cvtsi32_si128(n)),
+			    _mm_sll_epi64(sign, _mm_cvtsi32_si128(64 - n)));
+}
+
+/* Same as Q_SHIFT_RND(), i.e. ((a >> (n - 1)) + 1) >> 1 */
+static inline __m128i iir_simd_rnd64(__m128i a, int n)
+{
+	a = iir_simd_sra64(a, n - 1);
+	a = _mm_add_epi64(a, _mm_set1_epi64x(1));
+	return iir_simd_sra64(a, 1);
+}
+
+/* Round right shift and saturate to 32 bits */
+static inline struct iir_simd_v32 iir_simd_rnd_sat(struct iir_simd_v64 acc,
+						   struct iir_simd_shift s)
+{
+	const __m128i max = _mm_set1_epi64x(INT32_MAX);
+	const __m128i min = _mm_set1_epi64x(INT32_MIN);
+	struct iir_simd_v32 r;
+	__m128i a = iir_simd_rnd64(acc.v, s.s0);
+
+	/* The channels can have a different output shift */
+	if (s.s1 != s.s0)
+		a = _mm_blend_epi16(a, iir_simd_rnd64(acc.v, s.s1), 0xf0);
+
+	a = _mm_blendv_epi8(a, max, _mm_cmpgt_epi64(a, max));
+	r.v = _mm_blendv_epi8(a, min, _mm_cmpgt_epi64(min, a));
+	return r;
+}
+
+#elif defined __ARM_NEON
+
+#include <arm_neon.h>
+
+struct iir_simd_v32 {
+	int32x2_t v;
+};
+
+struct iir_simd_v64 {
+	int64x2_t v;
+};
+
+/* Right shifts for the lanes as negative left shifts */
+struct iir_simd_shift {
+	int64x2_t v;
+};
+
+static inline struct iir_simd_shift iir_simd_set_shift(int s0, int s1)
+{
+	struct iir_simd_shift s = { vcombine_s64(vdup_n_s64(-s0), vdup_n_s64(-s1)) };
+
+	return s;
+}
+
+static inline struct iir_simd_v32 iir_simd_load2(const int32_t *p)
+{
+	struct iir_simd_v32 r = { vld1_s32(p) };
+
+	return r;
+}
+
+static inline struct iir_simd_v32 iir_simd_load1(const int32_t *p)
+{
+	struct iir_simd_v32 r = { vld1_dup_s32(p) };
+
+	return r;
+}
+
+static inline void iir_simd_store2(int32_t *p, struct iir_simd_v32 a)
+{
+	vst1_s32(p, a.v);
+}
+
+static inline void iir_simd_store1(int32_t *p, struct iir_simd_v32 a)
+{
+	vst1_lane_s32(p, a.v, 0);
+}
+
+static inline struct iir_simd_v64 iir_simd_load64(const int64_t *p)
+{
+	struct iir_simd_v64 r = { vld1q_s64(p) };
+
+	return r;
+}
+
+static inline void iir_simd_store64(int64_t *p, struct iir_simd_v64 a)
+{
+	vst1q_s64(p, a.v);
+}
+
+static inline struct iir_simd_v64 iir_simd_mul(struct iir_simd_v32 a, struct iir_simd_v32 b)
+{
+	struct iir_simd_v64 r = { vmull_s32(a.v, b.v) };
+
+	return r;
+}
+
+static inline struct iir_simd_v64 iir_simd_mac(struct iir_simd_v64 acc, struct iir_simd_v32 a,
+					       struct iir_simd_v32 b)
+{
+	acc.v = vmlal_s32(acc.v, a.v, b.v);
+	return acc;
+}
+
+/* Rounding shift is the same as Q_SHIFT_RND(), then saturate to 32 bits */
+static inline struct iir_simd_v32 iir_simd_rnd_sat(struct iir_simd_v64 acc,
+						   struct iir_simd_shift s)
+{
+	struct iir_simd_v32 r = { vqmovn_s64(vrshlq_s64(acc.v, s.v)) };
+
+	return r;
+}
+
+#else
+#error "IIR_BLOCK_SIMD needs SSE4.2 or NEON."
+#endif
+
+/* The coefficients and delay lines are padded to even channels count so
+ * they are always loaded in pairs. The odd last channel is run with single
+ * sample loads and stores of the data.
+ */
+static inline void iir_simd_df1(struct iir_block_df1 *iir, int biquad, const int32_t *x,
+				int32_t *y, int frames, int ch, bool pair)
+{
+	const int32_t *coef = &iir->coef[biquad * SOF_EQ_IIR_NBIQUAD * iir->stride + ch];
+	int32_t *delay = &iir->delay[biquad * IIR_DF1_NUM_STATE * iir->stride + ch];
+	const int stride = iir->stride;
+	const int nch = iir->channels;
+	struct iir_simd_shift s_q31 = iir_simd_set_shift(30, 30);
+	struct iir_simd_shift s_out;
+	struct iir_simd_v32 a2, a1, b2, b1, b0, gain;
+	struct iir_simd_v32 y2, y1, x2, x1;
+	struct iir_simd_v32 in;
+	struct iir_simd_v32 tmp;
+	struct iir_simd_v64 acc;
+	int i;
+	int n;
+
+	/* Coefficients order is {a2, a1, b2, b1, b0, shift, gain} */
+	a2 = iir_simd_load2(coef);
+	a1 = iir_simd_load2(coef + stride);
+	b2 = iir_simd_load2(coef + 2 * stride);
+	b1 = iir_simd_load2(coef + 3 * stride);
+	b0 = iir_simd_load2(coef + 4 * stride);
+	gain = iir_simd_load2(coef + 6 * stride);
+	s_out = iir_simd_set_shift(14 + coef[5 * stride], 14 + coef[5 * stride + 1]);
+
+	/* Delay order is {y(n - 2), y(n - 1), x(n - 2), x(n - 1)} */
+	y2 = iir_simd_load2(delay);
+	y1 = iir_simd_load2(delay + stride);
+	x2 = iir_simd_load2(delay + 2 * stride);
+	x1 = iir_simd_load2(delay + 3 * stride);
+
+	for (n = 0, i = ch; n < frames; n++, i += nch) {
+		in = pair ? iir_simd_load2(&x[i]) : iir_simd_load1(&x[i]);
+		acc = iir_simd_mul(a2, y2);
+		acc = iir_simd_mac(acc, a1, y1);
+		acc = iir_simd_mac(acc, b2, x2);
+		acc = iir_simd_mac(acc, b1, x1);
+		acc = iir_simd_mac(acc, b0, in);
+		tmp = iir_simd_rnd_sat(acc, s_q31);
+		y2 = y1;
+		y1 = tmp;
+		x2 = x1;
+		x1 = in;
+		tmp = iir_simd_rnd_sat(iir_simd_mul(gain, tmp), s_out);
+		if (pair)
+			iir_simd_store2(&y[i], tmp);
+		else
+			iir_simd_store1(&y[i], tmp);
+	}
+
+	iir_simd_store2(delay, y2);
+	iir_simd_store2(delay + stride, y1);
+	iir_simd_store2(delay + 2 * stride, x2);
+	iir_simd_store2(delay + 3 * stride, x1);
+}
+
+void iir_block_biquad_df1(struct iir_block_df1 *iir, int biquad, const int32_t *x,
+			  int32_t *y, int frames)
+{
+	int ch;
+
+	for (ch = 0; ch + 1 < iir->channels; ch += 2)
+		iir_simd_df1(iir, biquad, x, y, frames, ch, true);
+
+	if (ch < iir->channels)
+		iir_simd_df1(iir, biquad, x, y, frames, ch, false);
+}
+
+static inline void iir_simd_df2t(struct iir_block_df2t *iir, int biquad, const int32_t *x,
+				 int32_t *y, int frames, int ch, bool pair)
+{
+	const int32_t *coef = &iir->coef[biquad * SOF_EQ_IIR_NBIQUAD * iir->stride + ch];
+	int64_t *delay = &iir->delay[biquad * IIR_DF2T_NUM_DELAYS * iir->stride + ch];
+	const int stride = iir->stride;
+	const int nch = iir->channels;
+	struct iir_simd_shift s_q31 = iir_simd_set_shift(30, 30);
+	struct iir_simd_shift s_out;
+	struct iir_simd_v32 a2, a1, b2, b1, b0, gain;
+	struct iir_simd_v32 in;
+	struct iir_simd_v32 tmp;
+	struct iir_simd_v64 d0, d1;
+	int i;
+	int n;
+
+	/* Coefficients order is {a2, a1, b2, b1, b0, shift, gain} */
+	a2 = iir_simd_load2(coef);
+	a1 = iir_simd_load2(coef + stride);
+	b2 = iir_simd_load2(coef + 2 * stride);
+	b1 = iir_simd_load2(coef + 3 * stride);
+	b0 = iir_simd_load2(coef + 4 * stride);
+	gain = iir_simd_load2(coef + 6 * stride);
+	s_out = iir_simd_set_shift(14 + coef[5 * stride], 14 + coef[5 * stride + 1]);
+	d0 = iir_simd_load64(delay);
+	d1 = iir_simd_load64(delay + stride);
+
+	for (n = 0, i = ch; n < frames; n++, i += nch) {
+		in = pair ? iir_simd_load2(&x[i]) : iir_simd_load1(&x[i]);
+		tmp = iir_simd_rnd_sat(iir_simd_mac(d0, b0, in), s_q31);
+		d0 = iir_simd_mac(iir_simd_mac(d1, b1, in), a1, tmp);
+		d1 = iir_simd_mac(iir_simd_mul(b2, in), a2, tmp);
+		tmp = iir_simd_rnd_sat(iir_simd_mul(gain, tmp), s_out);
+		if (pair)
+			iir_simd_store2(&y[i], tmp);
+		else
+			iir_simd_store1(&y[i], tmp);
+	}
+
+	iir_simd_store64(delay, d0);
+	iir_simd_store64(delay + stride, d1);
+}
+
+void iir_block_biquad_df2t(struct iir_block_df2t *iir, int biquad, const int32_t *x,
+			   int32_t *y, int frames)
+{
+	int ch;
+
+	for (ch = 0; ch + 1 < iir->channels; ch += 2)
+		iir_simd_df2t(iir, biquad, x, y, frames, ch, true);
+
+	if (ch < iir->channels)
+		iir_simd_df2t(iir, biquad, x, y, frames, ch, false);
+}
+
+#endif /* IIR_BLOCK_SIMD */
@@ -12,8 +12,42 @@ struct task;
 struct sof_uuid_entry;
 struct ll_schedule_domain;
 
+/*
+ * Tasks are kept in a separate list per host core. The core is taken from
+ * task->core when the task is scheduled, so host applications that run DSP
+ * cores on their own threads can map a task by setting it before scheduling.
+ */
+#define SCHEDULE_LL_HOST_CORES	8
+
+/*
+ * Tasks run when their start time is reached and then every period, in
+ * priority order. The tick period in us is passed in domain next_tick to
+ * scheduler_init_ll(). With zero tick the scheduler runs in virtual time
+ * that advances on each call to the earliest start of the periodic tasks,
+ * otherwise the host monotonic clock is used.
+ */
+
+/* advance scheduler time and run due tasks of all host cores */
 void schedule_ll_run_tasks(void);
 
+/* advance scheduler time, needed before running the tasks of each core */
+void schedule_ll_update_time(void);
+
+/* run due tasks of a single host core, called from that core's thread */
+void schedule_ll_run_core_tasks(int core);
+
+/*
+ * notify the end of a tick to LL_POST_RUN listeners e.g. the DP scheduler,
+ * called by schedule_ll_run_tasks() or once all core threads are done
+ */
+void schedule_ll_post_run(void);
+
+/* sleep until the next real time tick, returns immediately in virtual time */
+int schedule_ll_wait_tick(void);
+
+/* print and clear the task period, latency, overrun and load statistics */
+void schedule_ll_report(void);
+
 int scheduler_init_ll(struct ll_schedule_domain *domain);
 
 int schedule_task_init_ll(struct task *task,
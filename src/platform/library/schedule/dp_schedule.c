@@ -0,0 +1,375 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+/*
+ * DP scheduler for host library builds, the pthread counterpart of
+ * src/schedule/zephyr_dp_schedule.c. Every DP task has its own worker
+ * thread. On each LL tick the queued tasks are checked for data on all
+ * sources and space on all sinks, the ready ones get a deadline in LL
+ * ticks and are triggered. The triggered tasks of a DSP core run one at
+ * a time, earliest deadline first, while tasks of different cores and
+ * the LL pipelines run in parallel on the host cores.
+ */
+
+#include <sof/audio/component.h>
+#include <sof/audio/module_adapter/module/generic.h>
+#include <sof/lib/notifier.h>
+#include <sof/schedule/dp_schedule.h>
+#include <sof/schedule/ll_schedule_domain.h>
+#include <sof/schedule/schedule.h>
+#include <sof/trace/trace.h>
+#include <platform/lib/ll_schedule.h>
+#include <rtos/alloc.h>
+#include <rtos/task.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+/* 87858bc2-baa9-40b6-8e4c-2c95ba8b1545 */
+DECLARE_SOF_UUID("dp-schedule", dp_sched_uuid, 0x87858bc2, 0xbaa9, 0x40b6,
+		 0x8e, 0x4c, 0x2c, 0x95, 0xba, 0x8b, 0x15, 0x45);
+
+DECLARE_TR_CTX(dp_tr, SOF_UUID(dp_sched_uuid), LOG_LEVEL_INFO);
+
+struct scheduler_dp_data {
+	struct list_item tasks;		/* list of active dp tasks */
+	pthread_mutex_t lock;		/* protects tasks and their scheduling state */
+	pthread_cond_t cond;		/* task triggered, finished or freed */
+	bool core_busy[SCHEDULE_LL_HOST_CORES];	/* a task of the core is running */
+};
+
+struct task_dp_pdata {
+	pthread_t thread;
+	struct processing_module *mod;	/* the module to be scheduled */
+	uint32_t deadline_ll_cycles;	/* dp module deadline in LL cycles */
+	uint32_t ll_cycles_to_deadline;	/* current number of LL cycles till deadline */
+	bool triggered;			/* ready and waiting for the core */
+	bool exit;			/* task freed, terminate the thread */
+
+	/* statistics, reported when the task is freed */
+	uint32_t runs;
+	uint32_t deadline_misses;
+	uint64_t exec_max;		/* ns */
+};
+
+static uint64_t dp_host_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/*
+ * function called after every LL tick, see scheduler_dp_ll_tick() in
+ * zephyr_dp_schedule.c for the scheduling model. A task still running
+ * when its deadline is reached is counted as a deadline miss.
+ */
+static void scheduler_dp_ll_tick(void *receiver_data, enum notify_id event_type,
+				 void *caller_data)
+{
+	struct scheduler_dp_data *dp_sch = receiver_data;
+	struct processing_module *mod;
+	struct task_dp_pdata *pdata;
+	struct list_item *tlist;
+	struct task *curr_task;
+	bool triggered = false;
+
+	pthread_mutex_lock(&dp_sch->lock);
+	list_for_item(tlist, &dp_sch->tasks) {
+		curr_task = container_of(tlist, struct task, list);
+		pdata = curr_task->priv_data;
+		mod = pdata->mod;
+
+		/* decrease number of LL ticks/cycles left till the module reaches its deadline */
+		if (pdata->ll_cycles_to_deadline) {
+			pdata->ll_cycles_to_deadline--;
+			if (!pdata->ll_cycles_to_deadline) {
+				/* deadline reached, clear startup delay flag */
+				mod->dp_startup_delay = false;
+
+				if (curr_task->state == SOF_TASK_STATE_RUNNING) {
+					pdata->deadline_misses++;
+					tr_warn(&dp_tr, "DP task of comp 0x%x missed deadline",
+						dev_comp_id(mod->dev));
+				}
+			}
+		}
+
+		if (curr_task->state == SOF_TASK_STATE_QUEUED &&
+		    module_is_ready_to_process(mod, mod->sources, mod->num_of_sources,
+					       mod->sinks, mod->num_of_sinks)) {
+			/* set a deadline for given num of ticks, starting now */
+			pdata->ll_cycles_to_deadline = pdata->deadline_ll_cycles;
+
+			/* trigger the task */
+			curr_task->state = SOF_TASK_STATE_RUNNING;
+			pdata->triggered = true;
+			triggered = true;
+		}
+	}
+
+	if (triggered)
+		pthread_cond_broadcast(&dp_sch->cond);
+	pthread_mutex_unlock(&dp_sch->lock);
+}
+
+/* EDF: the task may run if its core is idle and no triggered task of the core is due earlier */
+static bool scheduler_dp_task_is_next(struct scheduler_dp_data *dp_sch, struct task *task)
+{
+	struct task_dp_pdata *pdata = task->priv_data;
+	struct task_dp_pdata *curr_pdata;
+	struct list_item *tlist;
+	struct task *curr_task;
+
+	if (!pdata->triggered || dp_sch->core_busy[task->core])
+		return false;
+
+	list_for_item(tlist, &dp_sch->tasks) {
+		curr_task = container_of(tlist, struct task, list);
+		curr_pdata = curr_task->priv_data;
+		if (curr_task != task && curr_task->core == task->core && curr_pdata->triggered &&
+		    curr_pdata->ll_cycles_to_deadline < pdata->ll_cycles_to_deadline)
+			return false;
+	}
+
+	return true;
+}
+
+static void *dp_thread_fn(void *arg)
+{
+	struct task *task = arg;
+	struct task_dp_pdata *pdata = task->priv_data;
+	struct scheduler_dp_data *dp_sch = scheduler_get_data(SOF_SCHEDULE_DP);
+	enum task_state state;
+	uint64_t t0, delta;
+
+	pthread_mutex_lock(&dp_sch->lock);
+	for (;;) {
+		while (!pdata->exit && !scheduler_dp_task_is_next(dp_sch, task))
+			pthread_cond_wait(&dp_sch->cond, &dp_sch->lock);
+
+		if (pdata->exit)
+			break;
+
+		pdata->triggered = false;
+		dp_sch->core_busy[task->core] = true;
+		pthread_mutex_unlock(&dp_sch->lock);
+
+		t0 = dp_host_time_ns();
+		if (task->state == SOF_TASK_STATE_RUNNING)
+			state = task_run(task);
+		else
+			state = task->state;	/* to avoid undefined variable warning */
+		delta = dp_host_time_ns() - t0;
+
+		pthread_mutex_lock(&dp_sch->lock);
+		dp_sch->core_busy[task->core] = false;
+		pdata->runs++;
+		pdata->exec_max = MAX(pdata->exec_max, delta);
+
+		/*
+		 * check if task is still running, may have been canceled by external call
+		 * if not, set the state returned by run procedure
+		 */
+		if (task->state == SOF_TASK_STATE_RUNNING) {
+			switch (state) {
+			case SOF_TASK_STATE_RESCHEDULE:
+				/* mark to reschedule, schedule time is already calculated */
+				task->state = SOF_TASK_STATE_QUEUED;
+				break;
+
+			case SOF_TASK_STATE_CANCEL:
+			case SOF_TASK_STATE_COMPLETED:
+				/* remove from scheduling */
+				task->state = state;
+				list_item_del(&task->list);
+				break;
+
+			default:
+				/* illegal state, serious defect, won't happen */
+				tr_err(&dp_tr, "dp_thread_fn(): illegal task state %d", state);
+				task->state = SOF_TASK_STATE_CANCEL;
+				list_item_del(&task->list);
+				break;
+			}
+		}
+
+		/* let the next task of the core run */
+		pthread_cond_broadcast(&dp_sch->cond);
+
+		if (task->state == SOF_TASK_STATE_COMPLETED) {
+			/* call task_complete out of lock, it may eventually call schedule again */
+			pthread_mutex_unlock(&dp_sch->lock);
+			task_complete(task);
+			pthread_mutex_lock(&dp_sch->lock);
+		}
+	}
+	pthread_mutex_unlock(&dp_sch->lock);
+
+	return NULL;
+}
+
+static int scheduler_dp_task_cancel(void *data, struct task *task)
+{
+	struct scheduler_dp_data *dp_sch = data;
+
+	/* this is asyn cancel - mark the task as canceled and remove it from scheduling */
+	pthread_mutex_lock(&dp_sch->lock);
+	if (task->state == SOF_TASK_STATE_QUEUED || task->state == SOF_TASK_STATE_RUNNING)
+		list_item_del(&task->list);
+	task->state = SOF_TASK_STATE_CANCEL;
+	pthread_mutex_unlock(&dp_sch->lock);
+
+	return 0;
+}
+
+static int scheduler_dp_task_free(void *data, struct task *task)
+{
+	struct scheduler_dp_data *dp_sch = data;
+	struct task_dp_pdata *pdata = task->priv_data;
+
+	scheduler_dp_task_cancel(data, task);
+
+	/* stop the thread, a task that is running is completed first */
+	pthread_mutex_lock(&dp_sch->lock);
+	pdata->exit = true;
+	pthread_cond_broadcast(&dp_sch->cond);
+	pthread_mutex_unlock(&dp_sch->lock);
+	pthread_join(pdata->thread, NULL);
+
+	tr_info(&dp_tr, "DP task of comp 0x%x: runs %u deadline misses %u max %u us",
+		dev_comp_id(pdata->mod->dev), pdata->runs, pdata->deadline_misses,
+		(uint32_t)(pdata->exec_max / 1000));
+
+	/* all other memory has been allocated as a single malloc, will be freed later by caller */
+	return 0;
+}
+
+static int scheduler_dp_task_shedule(void *data, struct task *task, uint64_t start,
+				     uint64_t period)
+{
+	struct scheduler_dp_data *dp_sch = data;
+	struct task_dp_pdata *pdata = task->priv_data;
+
+	pthread_mutex_lock(&dp_sch->lock);
+
+	if (task->state != SOF_TASK_STATE_INIT &&
+	    task->state != SOF_TASK_STATE_CANCEL &&
+	    task->state != SOF_TASK_STATE_COMPLETED) {
+		pthread_mutex_unlock(&dp_sch->lock);
+		return -EINVAL;
+	}
+
+	/* add a task to DP scheduler list */
+	task->state = SOF_TASK_STATE_QUEUED;
+	list_item_prepend(&task->list, &dp_sch->tasks);
+
+	pdata->deadline_ll_cycles = MAX(period / LL_TIMER_PERIOD_US, 1ULL);
+	pdata->ll_cycles_to_deadline = 0;
+	pdata->triggered = false;
+	pdata->mod->dp_startup_delay = true;
+	pthread_mutex_unlock(&dp_sch->lock);
+
+	tr_dbg(&dp_tr, "DP task scheduled with period %u [us]", (uint32_t)period);
+	return 0;
+}
+
+static void scheduler_dp_free(void *data, uint32_t flags)
+{
+	struct scheduler_dp_data *dp_sch = data;
+
+	notifier_unregister(dp_sch, NULL, NOTIFIER_ID_LL_POST_RUN);
+	pthread_mutex_destroy(&dp_sch->lock);
+	pthread_cond_destroy(&dp_sch->cond);
+	rfree(dp_sch);
+}
+
+static struct scheduler_ops schedule_dp_ops = {
+	.schedule_task		= scheduler_dp_task_shedule,
+	.schedule_task_cancel	= scheduler_dp_task_cancel,
+	.schedule_task_free	= scheduler_dp_task_free,
+	.scheduler_free		= scheduler_dp_free,
+};
+
+int scheduler_dp_init(void)
+{
+	struct scheduler_dp_data *dp_sch = rzalloc(SOF_MEM_ZONE_SYS_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+						   sizeof(struct scheduler_dp_data));
+	if (!dp_sch)
+		return -ENOMEM;
+
+	list_init(&dp_sch->tasks);
+	pthread_mutex_init(&dp_sch->lock, NULL);
+	pthread_cond_init(&dp_sch->cond, NULL);
+
+	scheduler_init(SOF_SCHEDULE_DP, &schedule_dp_ops, dp_sch);
+
+	return notifier_register(dp_sch, NULL, NOTIFIER_ID_LL_POST_RUN, scheduler_dp_ll_tick, 0);
+}
+
+int scheduler_dp_task_init(struct task **task,
+			   const struct sof_uuid_entry *uid,
+			   const struct task_ops *ops,
+			   struct processing_module *mod,
+			   uint16_t core,
+			   size_t stack_size,
+			   uint32_t task_priority)
+{
+	/* memory allocation helper structure, freed by the caller as *task */
+	struct {
+		struct task task;
+		struct task_dp_pdata pdata;
+	} *task_memory;
+	int ret;
+
+	if (core >= SCHEDULE_LL_HOST_CORES) {
+		tr_err(&dp_tr, "scheduler_dp_task_init(): invalid core %u", core);
+		return -EINVAL;
+	}
+
+	task_memory = rzalloc(SOF_MEM_ZONE_RUNTIME_SHARED, 0, SOF_MEM_CAPS_RAM,
+			      sizeof(*task_memory));
+	if (!task_memory) {
+		tr_err(&dp_tr, "scheduler_dp_task_init(): memory alloc failed");
+		return -ENOMEM;
+	}
+
+	/* internal SOF task init */
+	ret = schedule_task_init(&task_memory->task, uid, SOF_SCHEDULE_DP, 0, ops->run,
+				 mod, core, 0);
+	if (ret < 0) {
+		tr_err(&dp_tr, "scheduler_dp_task_init(): schedule_task_init failed");
+		goto err;
+	}
+
+	/* initialize other task structures */
+	task_memory->task.ops.complete = ops->complete;
+	task_memory->task.ops.get_deadline = ops->get_deadline;
+	task_memory->task.state = SOF_TASK_STATE_INIT;
+	task_memory->task.core = core;
+	task_memory->task.priv_data = &task_memory->pdata;
+	task_memory->pdata.mod = mod;
+
+	/*
+	 * the thread waits until the task is scheduled and triggered, stack size and
+	 * priority are firmware thread parameters, host threads use the defaults
+	 */
+	ret = pthread_create(&task_memory->pdata.thread, NULL, dp_thread_fn,
+			     &task_memory->task);
+	if (ret) {
+		tr_err(&dp_tr, "scheduler_dp_task_init(): thread create failed %d", ret);
+		ret = -ret;
+		goto err;
+	}
+
+	*task = &task_memory->task;
+	return 0;
+
+err:
+	rfree(task_memory);
+	return ret;
+}
@@ -7,13 +7,20 @@
 #define _GNU_SOURCE
 
 #include <sof/audio/component.h>
+#include <rtos/alloc.h>
 #include <rtos/task.h>
+#include <sof/lib/notifier.h>
+#include <sof/lib/perf_cnt.h>
 #include <sof/schedule/schedule.h>
 #include <platform/lib/ll_schedule.h>
 #include <sof/schedule/ll_schedule_domain.h>
 #include <rtos/wait.h>
+#include <errno.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <time.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <stdint.h>
@@ -26,46 +33,349 @@ DECLARE_SOF_UUID("ll-schedule", ll_sched_uuid, 0x77de2074, 0x828c, 0x4044,
 
 DECLARE_TR_CTX(ll_tr, SOF_UUID(ll_sched_uuid), LOG_LEVEL_INFO);
 
-/* list of all tasks */
-static struct list_item sched_list;
+/* perf measurement windows size 2^x */
+#define LL_PERF_WINDOW_SIZE	10
 
-void schedule_ll_run_tasks(void)
+/* per task scheduling data and statistics, times in us */
+struct ll_task_pdata {
+	struct list_item list;		/* all tasks, kept for report after cancel */
+	struct task *task;
+	uint64_t period;
+	uint64_t runs;
+	uint64_t overruns;		/* periods missed */
+	uint64_t latency_sum;		/* from task start time to run */
+	uint64_t latency_max;
+	uint64_t exec_sum;		/* in ns */
+	uint64_t exec_max;
+};
+
+struct ll_host_schedule {
+	struct list_item tasks[SCHEDULE_LL_HOST_CORES];	/* tasks of each core */
+	struct perf_cnt_data pcd[SCHEDULE_LL_HOST_CORES];	/* ll_work of each core */
+	struct list_item all_tasks;
+	uint64_t tick;		/* tick period, 0 for virtual time */
+	uint64_t time;		/* time of current tick */
+	uint64_t next_tick;	/* deadline of next real time tick */
+	uint64_t ticks;
+	uint64_t missed_ticks;
+};
+
+static struct ll_host_schedule ll_sch;
+
+static inline struct ll_task_pdata *ll_sch_get_pdata(struct task *task)
+{
+	return task->priv_data;
+}
+
+/* monotonic time in ns, xt-run has no clock and runs in virtual time only */
+static uint64_t ll_host_time_ns(void)
+{
+#if defined __XCC__
+	return 0;
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+static void perf_ll_sched_trace(struct perf_cnt_data *pcd, int core)
+{
+	tr_info(&ll_tr, "perf ll_work core %d peak %u ns", core, pcd->cpu_delta_peak);
+}
+
+static void perf_avg_ll_sched_trace(struct perf_cnt_data *pcd, int core)
+{
+	tr_info(&ll_tr, "perf ll_work core %d avg %u ns (current peak %u ns)",
+		core, pcd->cpu_delta_sum, pcd->cpu_delta_peak);
+}
+
+/* perf_cnt_stamp() and perf_cnt_average() with host clock */
+static void ll_perf_update(struct perf_cnt_data *pcd, uint64_t delta, int core)
+{
+	pcd->cpu_delta_last = MIN(delta, UINT32_MAX);
+	if (pcd->cpu_delta_last > pcd->cpu_delta_peak) {
+		pcd->cpu_delta_peak = pcd->cpu_delta_last;
+		perf_ll_sched_trace(pcd, core);
+	}
+
+	pcd->cpu_delta_sum += pcd->cpu_delta_last;
+	if (++pcd->sample_cnt == 1 << LL_PERF_WINDOW_SIZE) {
+		pcd->cpu_delta_sum >>= LL_PERF_WINDOW_SIZE;
+		perf_avg_ll_sched_trace(pcd, core);
+		pcd->cpu_delta_sum = 0;
+		pcd->sample_cnt = 0;
+		pcd->cpu_delta_peak = 0;
+	}
+}
+
+/* set start time of the next period, skipping the periods already missed */
+static void schedule_ll_task_update_start(struct task *task, struct ll_task_pdata *pdata)
+{
+	uint64_t missed;
+
+	/* tasks without period run on every tick */
+	if (!pdata->period)
+		return;
+
+	task->start += pdata->period;
+	if (task->start <= ll_sch.time) {
+		missed = (ll_sch.time - task->start) / pdata->period + 1;
+		pdata->overruns += missed;
+		task->start += missed * pdata->period;
+	}
+}
+
+void schedule_ll_run_core_tasks(int core)
 {
 	struct list_item *tlist, *tlist_;
+	struct ll_task_pdata *pdata;
+	struct task *task;
+	uint64_t tick_start = 0;
+	uint64_t latency;
+	uint64_t t0, t1;
+
+	/* iterate through the task list, ordered by priority */
+	list_for_item_safe(tlist, tlist_, &ll_sch.tasks[core]) {
+		task = container_of(tlist, struct task, list);
+
+		/* only run queued tasks with start time reached */
+		if (task->state != SOF_TASK_STATE_QUEUED || task->start > ll_sch.time)
+			continue;
+
+		pdata = ll_sch_get_pdata(task);
+		latency = ll_sch.time - task->start;
+		t0 = ll_host_time_ns();
+		if (!tick_start)
+			tick_start = t0;
+
+		task->state = SOF_TASK_STATE_RUNNING;
+
+		task->ops.run(task->data);
+
+		/* only re-queue if not cancelled */
+		if (task->state == SOF_TASK_STATE_RUNNING)
+			task->state = SOF_TASK_STATE_QUEUED;
+
+		t1 = ll_host_time_ns();
+		pdata->runs++;
+		pdata->latency_sum += latency;
+		pdata->latency_max = MAX(pdata->latency_max, latency);
+		pdata->exec_sum += t1 - t0;
+		pdata->exec_max = MAX(pdata->exec_max, t1 - t0);
+		schedule_ll_task_update_start(task, pdata);
+	}
+
+	if (tick_start)
+		ll_perf_update(&ll_sch.pcd[core], ll_host_time_ns() - tick_start, core);
+}
+
+void schedule_ll_update_time(void)
+{
+	struct list_item *tlist;
 	struct task *task;
+	uint64_t next = UINT64_MAX;
+	int core;
+
+	ll_sch.ticks++;
+
+	if (ll_sch.tick) {
+		ll_sch.time = ll_host_time_ns() / 1000;
+		return;
+	}
+
+	/* virtual time jumps to the earliest start of periodic tasks */
+	for (core = 0; core < SCHEDULE_LL_HOST_CORES; core++) {
+		list_for_item(tlist, &ll_sch.tasks[core]) {
+			task = container_of(tlist, struct task, list);
+			if (task->state == SOF_TASK_STATE_QUEUED && ll_sch_get_pdata(task)->period)
+				next = MIN(next, task->start);
+		}
+	}
+
+	if (next != UINT64_MAX)
+		ll_sch.time = MAX(ll_sch.time, next);
+}
+
+void schedule_ll_run_tasks(void)
+{
+	bool empty = true;
+	int core;
+
+	schedule_ll_update_time();
+
+	for (core = 0; core < SCHEDULE_LL_HOST_CORES; core++) {
+		if (list_is_empty(&ll_sch.tasks[core]))
+			continue;
+
+		empty = false;
+		schedule_ll_run_core_tasks(core);
+	}
+
+	schedule_ll_post_run();
 
 	/* list empty then return */
-	if (list_is_empty(&sched_list))
+	if (empty)
 		fprintf(stdout, "LL scheduler thread exit - list empty\n");
+}
 
-	/* iterate through the task list */
-	list_for_item_safe(tlist, tlist_, &sched_list) {
-		task = container_of(tlist, struct task, list);
+void schedule_ll_post_run(void)
+{
+	notifier_event(&ll_sch, NOTIFIER_ID_LL_POST_RUN,
+		       NOTIFIER_TARGET_CORE_LOCAL, NULL, 0);
+}
+
+int schedule_ll_wait_tick(void)
+{
+#if defined __XCC__
+	return 0;
+#else
+	struct timespec ts;
+	uint64_t now;
+	int ret;
+
+	if (!ll_sch.tick)
+		return 0;
+
+	/* sleep to absolute deadline so the tick does not drift */
+	ts.tv_sec = ll_sch.next_tick / 1000000;
+	ts.tv_nsec = (ll_sch.next_tick % 1000000) * 1000;
+	do {
+		ret = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+	} while (ret == EINTR);
+
+	if (ret)
+		return -ret;
+
+	/* ticks passed while the previous tick was still running */
+	now = ll_host_time_ns() / 1000;
+	ll_sch.next_tick += ll_sch.tick;
+	if (now >= ll_sch.next_tick) {
+		ll_sch.missed_ticks += (now - ll_sch.next_tick) / ll_sch.tick + 1;
+		ll_sch.next_tick = now + ll_sch.tick;
+	}
 
-		/* only run queued tasks */
-		if (task->state == SOF_TASK_STATE_QUEUED) {
-			task->state = SOF_TASK_STATE_RUNNING;
+	return 0;
+#endif
+}
+
+void schedule_ll_report(void)
+{
+	struct ll_task_pdata *pdata;
+	struct list_item *tlist;
+	struct task *task;
+
+	printf("LL scheduler: ticks %llu missed %llu, tick %llu us\n",
+	       (unsigned long long)ll_sch.ticks, (unsigned long long)ll_sch.missed_ticks,
+	       (unsigned long long)ll_sch.tick);
+	printf("%4s %-16s %4s %10s %10s %9s %13s %13s %12s %12s %6s\n",
+	       "core", "task", "pri", "period us", "runs", "overruns", "latency avg",
+	       "latency max", "exec avg ns", "exec max ns", "load%");
 
-			task->ops.run(task->data);
+	list_for_item(tlist, &ll_sch.all_tasks) {
+		pdata = container_of(tlist, struct ll_task_pdata, list);
+		task = pdata->task;
+		if (!pdata->runs)
+			continue;
 
-			/* only re-queue if not cancelled */
-			if (task->state == SOF_TASK_STATE_RUNNING)
-				task->state = SOF_TASK_STATE_QUEUED;
+		printf("%4u %-16.16s %4u %10llu %10llu %9llu %13llu %13llu %12llu %12llu %6.2f\n",
+		       task->core, task->uid ? task->uid->name : "unknown", task->priority,
+		       (unsigned long long)pdata->period,
+		       (unsigned long long)pdata->runs,
+		       (unsigned long long)pdata->overruns,
+		       (unsigned long long)(pdata->latency_sum / pdata->runs),
+		       (unsigned long long)pdata->latency_max,
+		       (unsigned long long)(pdata->exec_sum / pdata->runs),
+		       (unsigned long long)pdata->exec_max,
+		       pdata->period ?
+		       pdata->exec_sum / (10.0 * pdata->runs * pdata->period) : 0.0);
+
+		/* clear for the next run */
+		pdata->runs = 0;
+		pdata->overruns = 0;
+		pdata->latency_sum = 0;
+		pdata->latency_max = 0;
+		pdata->exec_sum = 0;
+		pdata->exec_max = 0;
+	}
 
+	printf("\n");
+	ll_sch.ticks = 0;
+	ll_sch.missed_ticks = 0;
+}
+
+/* tasks are kept from highest to lowest priority, first come first served */
+static void schedule_ll_task_insert(struct task *task, struct list_item *tasks)
+{
+	struct list_item *tlist;
+	struct task *curr_task;
+
+	list_for_item(tlist, tasks) {
+		curr_task = container_of(tlist, struct task, list);
+		if (task->priority < curr_task->priority) {
+			list_item_append(&task->list, &curr_task->list);
+			return;
 		}
 	}
+
+	list_item_append(&task->list, tasks);
+}
+
+static int schedule_ll_task_common(struct task *task, uint64_t start, uint64_t period,
+				   struct task *reference, bool before)
+{
+	struct ll_task_pdata *pdata = ll_sch_get_pdata(task);
+
+	if (task->core >= SCHEDULE_LL_HOST_CORES) {
+		tr_err(&ll_tr, "schedule_ll_task(): invalid core %u", task->core);
+		return -EINVAL;
+	}
+
+	/* already queued, keep original start */
+	if (task->state == SOF_TASK_STATE_QUEUED)
+		return 0;
+
+	pdata->period = period;
+
+	/* restart real time ticks when the scheduler has been idle */
+	if (ll_sch.tick && ll_sch.next_tick <= ll_host_time_ns() / 1000)
+		ll_sch.next_tick = ll_host_time_ns() / 1000 + ll_sch.tick;
+
+	/* first run on the next tick, or with the reference task */
+	if (reference && reference->core == task->core && task_is_active(reference)) {
+		if (before)
+			list_item_append(&task->list, &reference->list);
+		else
+			list_item_prepend(&task->list, &reference->list);
+		task->start = reference->start;
+	} else {
+		schedule_ll_task_insert(task, &ll_sch.tasks[task->core]);
+		task->start = (ll_sch.tick ? ll_sch.next_tick : ll_sch.time) + start;
+	}
+
+	task->state = SOF_TASK_STATE_QUEUED;
+
+	return 0;
 }
 
 /* schedule new LL task */
 static int schedule_ll_task(void *data, struct task *task, uint64_t start,
 			    uint64_t period)
 {
-	/* add task to list */
-	list_item_prepend(&task->list, &sched_list);
-	task->state = SOF_TASK_STATE_QUEUED;
-	task->start = 0;
+	return schedule_ll_task_common(task, start, period, NULL, false);
+}
 
-	return 0;
+static int schedule_ll_task_before(void *data, struct task *task, uint64_t start,
+				   uint64_t period, struct task *before)
+{
+	return schedule_ll_task_common(task, start, period, before, true);
+}
+
+static int schedule_ll_task_after(void *data, struct task *task, uint64_t start,
+				  uint64_t period, struct task *after)
+{
+	return schedule_ll_task_common(task, start, period, after, false);
 }
 
 static void ll_scheduler_free(void *data, uint32_t flags)
@@ -86,14 +396,22 @@ static int schedule_ll_task_cancel(void *data, struct task *task)
 /* TODO: scheduler free and cancel APIs can merge as part of Zephyr */
 static int schedule_ll_task_free(void *data, struct task *task)
 {
+	struct ll_task_pdata *pdata = ll_sch_get_pdata(task);
+
 	task->state = SOF_TASK_STATE_FREE;
 	list_item_del(&task->list);
 
+	list_item_del(&pdata->list);
+	rfree(pdata);
+	task->priv_data = NULL;
+
 	return 0;
 }
 
 static struct scheduler_ops schedule_ll_ops = {
 	.schedule_task		= schedule_ll_task,
+	.schedule_task_before	= schedule_ll_task_before,
+	.schedule_task_after	= schedule_ll_task_after,
 	.schedule_task_running	= NULL,
 	.reschedule_task	= NULL,
 	.schedule_task_cancel	= schedule_ll_task_cancel,
@@ -106,16 +424,45 @@ int schedule_task_init_ll(struct task *task,
 			  uint16_t priority, enum task_state (*run)(void *data),
 			  void *data, uint16_t core, uint32_t flags)
 {
-	return schedule_task_init(task, uid, SOF_SCHEDULE_LL_TIMER, 0, run,
-				  data, core, flags);
+	struct ll_task_pdata *pdata;
+	int ret;
+
+	ret = schedule_task_init(task, uid, SOF_SCHEDULE_LL_TIMER, priority, run,
+				 data, core, flags);
+	if (ret < 0)
+		return ret;
+
+	pdata = rzalloc(SOF_MEM_ZONE_SYS_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(*pdata));
+	if (!pdata) {
+		tr_err(&ll_tr, "schedule_task_init_ll(): alloc failed");
+		return -ENOMEM;
+	}
+
+	pdata->task = task;
+	list_item_append(&pdata->list, &ll_sch.all_tasks);
+	task->priv_data = pdata;
+
+	return 0;
 }
 
-/* initialize scheduler */
+/* initialize scheduler, domain next_tick is the tick period in us */
 int scheduler_init_ll(struct ll_schedule_domain *domain)
 {
+	int core;
+
 	tr_info(&ll_tr, "ll_scheduler_init()");
 
-	list_init(&sched_list);
+	for (core = 0; core < SCHEDULE_LL_HOST_CORES; core++)
+		list_init(&ll_sch.tasks[core]);
+
+	list_init(&ll_sch.all_tasks);
+	memset(ll_sch.pcd, 0, sizeof(ll_sch.pcd));
+	ll_sch.tick = domain->next_tick;
+	ll_sch.time = ll_host_time_ns() / 1000;
+	ll_sch.next_tick = ll_sch.time + ll_sch.tick;
+	ll_sch.ticks = 0;
+	ll_sch.missed_ticks = 0;
+
 	scheduler_init(SOF_SCHEDULE_LL_TIMER, &schedule_ll_ops, NULL);
 
 	return 0;
@@ -12,8 +12,9 @@
 #include <user/trace.h>
 #include <rtos/alloc.h>
 #include <rtos/init.h>
+#include <rtos/interrupt.h>
+#include <sof/lib/cpu.h>
 #include <sof/lib/dma.h>
-#include <sof/lib/notifier.h>
 #include <sof/lib/uuid.h>
 #include <sof/ipc/topology.h>
 #include <sof/ipc/driver.h>
@@ -78,6 +79,28 @@ struct probe_dma_ext {
 	struct dma_copy dc;		/**< DMA copy */
 };
 
+#if CONFIG_PROBE_EXTRACT_SEGMENTS_MAX
+/**
+ * Extraction segment, produced data left in the component buffer
+ */
+struct probe_segment {
+	void *addr;		/**< data start in the component buffer */
+	uint32_t bytes;		/**< data size */
+	uint32_t point;		/**< probe point index */
+};
+
+/**
+ * Extraction data queued for one probe point, sent as a single packet
+ */
+struct probe_batch {
+	uint64_t timestamp;		/**< timestamp of the first transaction */
+	struct audio_stream *stream;	/**< component buffer stream */
+	void *w_ptr;			/**< stream write pointer after the last transaction */
+	uint32_t format;		/**< audio format */
+	uint32_t bytes;			/**< data size of all queued segments */
+};
+#endif
+
 /**
  * Probe main struct
  */
@@ -85,8 +108,15 @@ struct probe_pdata {
 	struct probe_dma_ext ext_dma;				  /**< extraction DMA */
 	struct probe_dma_ext inject_dma[CONFIG_PROBE_DMA_MAX];	  /**< injection DMA */
 	struct probe_point probe_points[CONFIG_PROBE_POINTS_MAX]; /**< probe points */
+	struct buffer_hook hooks[CONFIG_PROBE_POINTS_MAX];	  /**< probe point hooks */
 	struct probe_data_packet header;			  /**< data packet header */
 	struct task dmap_work;					  /**< probe task */
+#if CONFIG_PROBE_EXTRACT_SEGMENTS_MAX
+	struct probe_batch batch[CONFIG_PROBE_POINTS_MAX];	  /**< queued packets */
+	struct probe_segment segments[CONFIG_PROBE_EXTRACT_SEGMENTS_MAX]; /**< queued data */
+	uint32_t num_segments;					  /**< queued segments */
+	uint32_t lost_packets;					  /**< overwritten packets */
+#endif
 };
 
 /**
@@ -282,6 +312,10 @@ static int probe_dma_deinit(struct probe_dma_ext *dma)
 	return 0;
 }
 
+#if CONFIG_PROBE_EXTRACT_SEGMENTS_MAX
+static void probe_extract_flush(struct probe_pdata *_probe);
+#endif
+
 /*
  * \brief Probe task for extraction.
  *
@@ -294,6 +328,11 @@ static enum task_state probe_task(void *data)
 	uint32_t copy_align, avail;
 	int err;
 
+#if CONFIG_PROBE_EXTRACT_SEGMENTS_MAX
+	/* gather the data queued since the last run */
+	probe_extract_flush(_probe);
+#endif
+
 	if (!_probe->ext_dma.dmapb.avail)
 		return SOF_TASK_STATE_RESCHEDULE;
 #if CONFIG_ZEPHYR_NATIVE_DRIVERS
@@ -690,18 +729,17 @@ static int copy_from_pbuffer(struct probe_dma_buf *pbuf, void *data,
  * \param[in] buffer_id component buffer id
  * \param[in] size data size.
  * \param[in] format audio format.
+ * \param[in] timestamp of the data.
  * \param[out] checksum.
  * \return 0 on success, error code otherwise.
  */
 static int probe_gen_header(uint32_t buffer_id, uint32_t size,
-			    uint32_t format, uint64_t *checksum)
+			    uint32_t format, uint64_t timestamp, uint64_t *checksum)
 {
 	struct probe_pdata *_probe = probe_get();
 	struct probe_data_packet *header;
-	uint64_t timestamp;
 
 	header = &_probe->header;
-	timestamp = sof_cycle_get_64();
 
 	header->sync_word = PROBE_EXTRACT_SYNC_WORD;
 	header->buffer_id = buffer_id;
@@ -844,7 +882,8 @@ void probe_logging_hook(uint8_t *buffer, size_t length)
 	uint64_t checksum;
 	int ret;
 
-	ret = probe_gen_header(PROBE_LOGGING_BUFFER_ID, length, 0, &checksum);
+	ret = probe_gen_header(PROBE_LOGGING_BUFFER_ID, length, 0, sof_cycle_get_64(),
+			       &checksum);
 	if (ret < 0)
 		return;
 
@@ -862,92 +901,268 @@ void probe_logging_hook(uint8_t *buffer, size_t length)
 }
 #endif
 
+#if CONFIG_PROBE_EXTRACT_SEGMENTS_MAX
+/**
+ * \brief Send the queued extraction data of one probe point as a packet.
+ *	  The data is dropped if it was overwritten in the component buffer
+ *	  since it was queued or if there is no room for it.
+ * \param[in] _probe probe main struct.
+ * \param[in] point probe point index.
+ */
+static void probe_extract_gather(struct probe_pdata *_probe, uint32_t point)
+{
+	struct probe_dma_buf *pbuf = &_probe->ext_dma.dmapb;
+	struct probe_batch *batch = &_probe->batch[point];
+	struct probe_segment *segment;
+	uint64_t checksum;
+	uint32_t i;
+	int ret;
+
+	/* every write to the buffer is queued, a moved write pointer means
+	 * the queued data may have been overwritten
+	 */
+	if (audio_stream_get_wptr(batch->stream) != batch->w_ptr) {
+		_probe->lost_packets++;
+		tr_warn(&pr_tr, "probe_extract_gather(): %u bytes overwritten, %u packets lost",
+			batch->bytes, _probe->lost_packets);
+		batch->bytes = 0;
+		return;
+	}
+
+	/* drop the whole packet rather than sending a truncated one */
+	if (pbuf->size - pbuf->avail < sizeof(struct probe_data_packet) +
+	    batch->bytes + sizeof(checksum)) {
+		tr_err(&pr_tr, "probe_extract_gather(): no room for %u bytes",
+		       batch->bytes);
+		batch->bytes = 0;
+		return;
+	}
+
+	ret = probe_gen_header(_probe->probe_points[point].buffer_id.full_id,
+			       batch->bytes, batch->format, batch->timestamp,
+			       &checksum);
+
+	for (i = 0; i < _probe->num_segments && ret >= 0; i++) {
+		segment = &_probe->segments[i];
+		if (segment->point == point)
+			ret = copy_to_pbuffer(pbuf, segment->addr, segment->bytes);
+	}
+
+	if (ret >= 0)
+		ret = copy_to_pbuffer(pbuf, &checksum, sizeof(checksum));
+	if (ret < 0)
+		tr_err(&pr_tr, "probe_extract_gather(): failed to generate probe data");
+
+	batch->bytes = 0;
+}
+
+/**
+ * \brief Send the queued extraction data, one packet per probe point.
+ * \param[in] _probe probe main struct.
+ */
+static void probe_extract_flush(struct probe_pdata *_probe)
+{
+	uint32_t i;
+
+	for (i = 0; i < CONFIG_PROBE_POINTS_MAX; i++)
+		if (_probe->batch[i].bytes)
+			probe_extract_gather(_probe, i);
+
+	_probe->num_segments = 0;
+}
+
+/**
+ * \brief Release the queued extraction data of one probe point.
+ * \param[in] _probe probe main struct.
+ * \param[in] point probe point index.
+ */
+static void probe_extract_release(struct probe_pdata *_probe, uint32_t point)
+{
+	uint32_t i;
+	uint32_t j = 0;
+
+	for (i = 0; i < _probe->num_segments; i++)
+		if (_probe->segments[i].point != point)
+			_probe->segments[j++] = _probe->segments[i];
+
+	_probe->num_segments = j;
+	_probe->batch[point].bytes = 0;
+}
+
+/**
+ * \brief Drop the queued extraction data of a removed probe point.
+ * \param[in] _probe probe main struct.
+ * \param[in] point probe point index.
+ */
+static void probe_extract_drop(struct probe_pdata *_probe, uint32_t point)
+{
+	uint32_t flags;
+
+	irq_local_disable(flags);
+	probe_extract_release(_probe, point);
+	irq_local_enable(flags);
+}
+
+static void probe_extract_segment(struct probe_pdata *_probe, uint32_t point,
+				  void *addr, uint32_t bytes)
+{
+	struct probe_segment *segment = &_probe->segments[_probe->num_segments++];
+
+	segment->addr = addr;
+	segment->bytes = bytes;
+	segment->point = point;
+}
+
+/**
+ * \brief Queue an extraction transaction for the probe task, the data is
+ *	  left in the component buffer until the task gathers it.
+ * \param[in] _probe probe main struct.
+ * \param[in] point probe point attached to the buffer.
+ * \param[in] cb_data buffer transaction.
+ */
+static void probe_extract_queue(struct probe_pdata *_probe, struct probe_point *point,
+				struct buffer_cb_transact *cb_data)
+{
+	struct audio_stream *stream = &cb_data->buffer->stream;
+	uint32_t index = point - _probe->probe_points;
+	struct probe_batch *batch = &_probe->batch[index];
+	char *addr = cb_data->transaction_begin_address;
+	uint32_t bytes = cb_data->transaction_amount;
+	uint32_t size = audio_stream_get_size(stream);
+	uint32_t head = MIN(bytes, (uint32_t)((char *)audio_stream_get_end_addr(stream) - addr));
+
+	/* the transaction overwrote the oldest queued data */
+	if (batch->bytes && (addr != batch->w_ptr || batch->bytes + bytes > size)) {
+		_probe->lost_packets++;
+		tr_warn(&pr_tr, "probe_extract_queue(): %u bytes overwritten, %u packets lost",
+			batch->bytes, _probe->lost_packets);
+		probe_extract_release(_probe, index);
+	}
+
+	/* a wrapping transaction takes two segments, the queue only fills up
+	 * when it is too small for the probe points and periods per task run
+	 */
+	if (_probe->num_segments + 2 > CONFIG_PROBE_EXTRACT_SEGMENTS_MAX)
+		probe_extract_flush(_probe);
+
+	if (!batch->bytes) {
+		batch->timestamp = sof_cycle_get_64();
+		batch->stream = stream;
+		batch->format = probe_gen_format(audio_stream_get_frm_fmt(stream),
+						 audio_stream_get_rate(stream),
+						 audio_stream_get_channels(stream));
+	}
+
+	probe_extract_segment(_probe, index, addr, head);
+	if (bytes > head)
+		probe_extract_segment(_probe, index, audio_stream_get_addr(stream),
+				      bytes - head);
+	batch->bytes += bytes;
+	batch->w_ptr = audio_stream_get_wptr(stream);
+
+	/*
+	 * The producer may write all free space of the buffer before the
+	 * probe task runs, copy the queued data now if that would overwrite it,
+	 * e.g. once the consumer released it on single period buffers.
+	 */
+	if (batch->bytes + audio_stream_get_free_bytes(stream) > size) {
+		probe_extract_gather(_probe, index);
+		probe_extract_release(_probe, index);
+		kick_probe_task(_probe);
+	}
+}
+#else
+/**
+ * \brief Copy an extraction transaction with its header and checksum to
+ *	  the probe buffer.
+ * \param[in] _probe probe main struct.
+ * \param[in] point probe point attached to the buffer.
+ * \param[in] cb_data buffer transaction.
+ * \return 0 on success, error code otherwise.
+ */
+static int probe_extract_copy(struct probe_pdata *_probe, struct probe_point *point,
+			      struct buffer_cb_transact *cb_data)
+{
+	struct comp_buffer *buffer = cb_data->buffer;
+	uint32_t head, tail;
+	uint32_t format;
+	uint64_t checksum;
+	int ret;
+
+	format = probe_gen_format(audio_stream_get_frm_fmt(&buffer->stream),
+				  audio_stream_get_rate(&buffer->stream),
+				  audio_stream_get_channels(&buffer->stream));
+	ret = probe_gen_header(point->buffer_id.full_id,
+			       cb_data->transaction_amount,
+			       format, sof_cycle_get_64(), &checksum);
+	if (ret < 0)
+		return ret;
+
+	/* check if transaction amount exceeds component buffer end addr */
+	/* if yes: divide copying into two stages, head and tail */
+	if ((char *)cb_data->transaction_begin_address + cb_data->transaction_amount >
+	    (char *)audio_stream_get_end_addr(&buffer->stream)) {
+		head = (uintptr_t)audio_stream_get_end_addr(&buffer->stream) -
+		       (uintptr_t)cb_data->transaction_begin_address;
+		tail = (uintptr_t)cb_data->transaction_amount - head;
+		ret = copy_to_pbuffer(&_probe->ext_dma.dmapb,
+				      cb_data->transaction_begin_address,
+				      head);
+		if (ret < 0)
+			return ret;
+
+		ret = copy_to_pbuffer(&_probe->ext_dma.dmapb,
+				      audio_stream_get_addr(&buffer->stream), tail);
+		if (ret < 0)
+			return ret;
+	} else {
+		ret = copy_to_pbuffer(&_probe->ext_dma.dmapb,
+				      cb_data->transaction_begin_address,
+				      cb_data->transaction_amount);
+		if (ret < 0)
+			return ret;
+	}
+
+	return copy_to_pbuffer(&_probe->ext_dma.dmapb,
+			       &checksum, sizeof(checksum));
+}
+#endif
+
 /**
  * \brief General extraction probe callback, called from buffer produce.
- *	  It will search for probe point connected to this buffer.
  *	  Extraction probe: generate format, header and copy data to probe buffer.
  *	  Injection probe: find corresponding DMA, check avail data, copy data,
  *	  update pointers and request more data from host if needed.
- * \param[in] arg pointer (not used).
- * \param[in] type of notify.
- * \param[in] data pointer.
+ * \param[in] point probe point attached to the buffer.
+ * \param[in] cb_data buffer transaction.
  */
-static void probe_cb_produce(void *arg, enum notify_id type, void *data)
+static void probe_cb_produce(struct probe_point *point, struct buffer_cb_transact *cb_data)
 {
 	struct probe_pdata *_probe = probe_get();
-	struct buffer_cb_transact *cb_data = data;
 	struct comp_buffer *buffer = cb_data->buffer;
 	struct probe_dma_ext *dma;
-	uint32_t buffer_id;
 	uint32_t head, tail;
 	uint32_t free_bytes = 0;
 	int32_t copy_bytes = 0;
 	int ret;
-	uint32_t i, j;
-	uint32_t format;
-	uint64_t checksum;
-
-	buffer_id = *(int *)arg;
-
-	/* search for probe point connected to this buffer */
-	for (i = 0; i < CONFIG_PROBE_POINTS_MAX; i++)
-		if (_probe->probe_points[i].buffer_id.full_id == buffer_id)
-			break;
-
-	if (i == CONFIG_PROBE_POINTS_MAX) {
-		tr_err(&pr_tr, "probe_cb_produce(): probe not found for buffer id: %d",
-		       buffer_id);
-		return;
-	}
-
-	if (_probe->probe_points[i].purpose == PROBE_PURPOSE_EXTRACTION) {
-		format = probe_gen_format(audio_stream_get_frm_fmt(&buffer->stream),
-					  audio_stream_get_rate(&buffer->stream),
-					  audio_stream_get_channels(&buffer->stream));
-		ret = probe_gen_header(buffer_id,
-				       cb_data->transaction_amount,
-				       format, &checksum);
-		if (ret < 0)
-			goto err;
-
-		/* check if transaction amount exceeds component buffer end addr */
-		/* if yes: divide copying into two stages, head and tail */
-		if ((char *)cb_data->transaction_begin_address + cb_data->transaction_amount >
-		    (char *)audio_stream_get_end_addr(&buffer->stream)) {
-			head = (uintptr_t)audio_stream_get_end_addr(&buffer->stream) -
-			       (uintptr_t)cb_data->transaction_begin_address;
-			tail = (uintptr_t)cb_data->transaction_amount - head;
-			ret = copy_to_pbuffer(&_probe->ext_dma.dmapb,
-					      cb_data->transaction_begin_address,
-					      head);
-			if (ret < 0)
-				goto err;
-
-			ret = copy_to_pbuffer(&_probe->ext_dma.dmapb,
-					      audio_stream_get_addr(&buffer->stream), tail);
-			if (ret < 0)
-				goto err;
-		} else {
-			ret = copy_to_pbuffer(&_probe->ext_dma.dmapb,
-					      cb_data->transaction_begin_address,
-					      cb_data->transaction_amount);
-			if (ret < 0)
-				goto err;
-		}
+	uint32_t j;
 
-		ret = copy_to_pbuffer(&_probe->ext_dma.dmapb,
-				      &checksum, sizeof(checksum));
+	if (point->purpose == PROBE_PURPOSE_EXTRACTION) {
+#if CONFIG_PROBE_EXTRACT_SEGMENTS_MAX
+		probe_extract_queue(_probe, point, cb_data);
+#else
+		ret = probe_extract_copy(_probe, point, cb_data);
 		if (ret < 0)
 			goto err;
 
 		kick_probe_task(_probe);
+#endif
 	} else {
 		/* search for DMA used by this probe point */
 		for (j = 0; j < CONFIG_PROBE_DMA_MAX; j++) {
 			if (_probe->inject_dma[j].stream_tag !=
 			    PROBE_DMA_INVALID &&
-			    _probe->inject_dma[j].stream_tag ==
-			    _probe->probe_points[i].stream_tag) {
+			    _probe->inject_dma[j].stream_tag == point->stream_tag) {
 				break;
 			}
 		}
@@ -1034,13 +1249,11 @@ err:
 
 /**
  * \brief Callback for buffer free, it will remove probe point.
- * \param[in] arg pointer (not used).
- * \param[in] type of notify.
- * \param[in] data pointer.
+ * \param[in] point probe point attached to the buffer.
  */
-static void probe_cb_free(void *arg, enum notify_id type, void *data)
+static void probe_cb_free(struct probe_point *point)
 {
-	uint32_t buffer_id = *(int *)arg;
+	uint32_t buffer_id = point->buffer_id.full_id;
 	int ret;
 
 	tr_dbg(&pr_tr, "probe_cb_free() buffer_id = %u", buffer_id);
@@ -1050,6 +1263,20 @@ static void probe_cb_free(void *arg, enum notify_id type, void *data)
 		tr_err(&pr_tr, "probe_cb_free(): probe_point_remove() failed");
 }
 
+/**
+ * \brief Buffer hook of a probe point.
+ * \param[in] arg probe point attached to the buffer.
+ * \param[in] type BUFF_CB_TYPE_* of the buffer event.
+ * \param[in] data buffer callback data.
+ */
+static void probe_buffer_hook(void *arg, uint32_t type, void *data)
+{
+	if (type == BUFF_CB_TYPE_FREE)
+		probe_cb_free(arg);
+	else
+		probe_cb_produce(arg, data);
+}
+
 static bool probe_purpose_needs_ext_dma(uint32_t purpose)
 {
 #if CONFIG_IPC_MAJOR_4
@@ -1090,6 +1317,17 @@ static struct comp_buffer *ipc4_get_buffer(struct ipc_comp_dev *dev, probe_point
 }
 #endif
 
+/* The probe hooks run on the core producing to the buffer and share the
+ * probe state with the probe task, so only buffers produced on the probe
+ * task core can be probed.
+ */
+static bool probe_buffer_core_valid(struct probe_pdata *_probe, struct comp_buffer *buf)
+{
+	uint32_t core = buf->source ? buf->source->ipc_config.core : buf->core;
+
+	return core == _probe->dmap_work.core;
+}
+
 static bool enable_logs(const struct probe_point *probe)
 {
 #if CONFIG_IPC_MAJOR_4
@@ -1179,6 +1417,13 @@ int probe_point_add(uint32_t count, const struct probe_point *probe)
 
 				return -EINVAL;
 			}
+
+			if (!probe_buffer_core_valid(_probe, buf)) {
+				tr_err(&pr_tr, "probe_point_add(): buffer %u not on probe core.",
+				       buf_id->full_id);
+
+				return -EINVAL;
+			}
 #else
 			if (dev->type != COMP_TYPE_BUFFER) {
 				tr_err(&pr_tr, "probe_point_add(): Device ID %u is not a buffer.",
@@ -1186,6 +1431,13 @@ int probe_point_add(uint32_t count, const struct probe_point *probe)
 
 				return -EINVAL;
 			}
+
+			if (!probe_buffer_core_valid(_probe, dev->cb)) {
+				tr_err(&pr_tr, "probe_point_add(): buffer %u not on probe core.",
+				       buf_id->full_id);
+
+				return -EINVAL;
+			}
 #endif
 		}
 
@@ -1281,18 +1533,15 @@ int probe_point_add(uint32_t count, const struct probe_point *probe)
 			return -EINVAL;
 #endif
 		} else {
-			probe_point_id_t *new_buf_id = &_probe->probe_points[first_free].buffer_id;
+			struct buffer_hook *hook = &_probe->hooks[first_free];
 
+			hook->types = BUFF_CB_TYPE_PRODUCE | BUFF_CB_TYPE_FREE;
+			hook->cb = probe_buffer_hook;
+			hook->arg = &_probe->probe_points[first_free];
 #if CONFIG_IPC_MAJOR_4
-			notifier_register(&new_buf_id->full_id, buf, NOTIFIER_ID_BUFFER_PRODUCE,
-					  &probe_cb_produce, 0);
-			notifier_register(&new_buf_id->full_id, buf, NOTIFIER_ID_BUFFER_FREE,
-					  &probe_cb_free, 0);
+			buffer_hook_add(buf, hook);
 #else
-			notifier_register(&new_buf_id->full_id, dev->cb, NOTIFIER_ID_BUFFER_PRODUCE,
-					  &probe_cb_produce, 0);
-			notifier_register(&new_buf_id->full_id, dev->cb, NOTIFIER_ID_BUFFER_FREE,
-					  &probe_cb_free, 0);
+			buffer_hook_add(dev->cb, hook);
 #endif
 		}
 	}
@@ -1380,12 +1629,8 @@ int probe_point_info(struct sof_ipc_probe_info_params *data, uint32_t max_size)
 int probe_point_remove(uint32_t count, const uint32_t *buffer_id)
 {
 	struct probe_pdata *_probe = probe_get();
-	struct ipc_comp_dev *dev;
 	uint32_t i;
 	uint32_t j;
-#if CONFIG_IPC_MAJOR_4
-	struct comp_buffer *buf;
-#endif
 
 	tr_dbg(&pr_tr, "probe_point_remove() count = %u", count);
 
@@ -1402,27 +1647,10 @@ int probe_point_remove(uint32_t count, const uint32_t *buffer_id)
 
 			if (_probe->probe_points[j].stream_tag != PROBE_POINT_INVALID &&
 			    buf_id->full_id == buffer_id[i]) {
-#if CONFIG_IPC_MAJOR_4
-				dev = ipc_get_comp_by_id(ipc_get(),
-							 IPC4_COMP_ID(buf_id->fields.module_id,
-								      buf_id->fields.instance_id));
-				if (dev) {
-					buf = ipc4_get_buffer(dev, *buf_id);
-					if (buf) {
-						notifier_unregister(NULL, buf,
-								    NOTIFIER_ID_BUFFER_PRODUCE);
-						notifier_unregister(NULL, buf,
-								    NOTIFIER_ID_BUFFER_FREE);
-					}
-				}
-#else
-				dev = ipc_get_comp_by_id(ipc_get(), buffer_id[i]);
-				if (dev) {
-					notifier_unregister(&buf_id->full_id, dev->cb,
-							    NOTIFIER_ID_BUFFER_PRODUCE);
-					notifier_unregister(&buf_id->full_id, dev->cb,
-							    NOTIFIER_ID_BUFFER_FREE);
-				}
+				/* no-op for logging and freed buffers */
+				buffer_hook_remove(&_probe->hooks[j]);
+#if CONFIG_PROBE_EXTRACT_SEGMENTS_MAX
+				probe_extract_drop(_probe, j);
 #endif
 				_probe->probe_points[j].stream_tag =
 					PROBE_POINT_INVALID;
@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/buffer.h>
+#include <sof/ipc/driver.h>
+#include <sof/ipc/msg.h>
+#include <sof/ipc/topology.h>
+#include <sof/ipc/schedule.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+struct test_hook {
+	struct buffer_hook hook;
+	uint32_t calls;
+	uint32_t last_type;
+	uint32_t last_amount;
+	void *last_address;
+	bool remove_on_free;
+};
+
+static void test_hook_cb(void *arg, uint32_t type, void *data)
+{
+	struct test_hook *th = arg;
+	struct buffer_cb_transact *transact = data;
+
+	th->calls++;
+	th->last_type = type;
+
+	if (type == BUFF_CB_TYPE_FREE) {
+		if (th->remove_on_free)
+			buffer_hook_remove(&th->hook);
+		return;
+	}
+
+	th->last_amount = transact->transaction_amount;
+	th->last_address = transact->transaction_begin_address;
+}
+
+static void test_hook_init(struct test_hook *th, uint32_t types)
+{
+	memset(th, 0, sizeof(*th));
+	th->hook.types = types;
+	th->hook.cb = test_hook_cb;
+	th->hook.arg = th;
+}
+
+static struct comp_buffer *test_buffer_new(void)
+{
+	struct sof_ipc_buffer test_buf_desc = {
+		.size = 256
+	};
+
+	return buffer_new(&test_buf_desc, false);
+}
+
+static void test_audio_buffer_hook_none(void **state)
+{
+	struct comp_buffer *buf = test_buffer_new();
+
+	(void)state;
+
+	assert_non_null(buf);
+	assert_int_equal(buf->hook_types, 0);
+
+	comp_update_buffer_produce(buf, 10);
+	comp_update_buffer_consume(buf, 10);
+	assert_int_equal(audio_stream_get_avail_bytes(&buf->stream), 0);
+
+	buffer_free(buf);
+}
+
+static void test_audio_buffer_hook_produce_consume(void **state)
+{
+	struct comp_buffer *buf = test_buffer_new();
+	struct test_hook produce;
+	struct test_hook consume;
+	void *rptr;
+	void *wptr;
+
+	(void)state;
+
+	assert_non_null(buf);
+	test_hook_init(&produce, BUFF_CB_TYPE_PRODUCE);
+	test_hook_init(&consume, BUFF_CB_TYPE_CONSUME);
+	buffer_hook_add(buf, &produce.hook);
+	buffer_hook_add(buf, &consume.hook);
+	assert_int_equal(buf->hook_types, BUFF_CB_TYPE_PRODUCE | BUFF_CB_TYPE_CONSUME);
+
+	/* produce hook sees the data written before the update */
+	wptr = audio_stream_get_wptr(&buf->stream);
+	comp_update_buffer_produce(buf, 20);
+	assert_int_equal(produce.calls, 1);
+	assert_int_equal(produce.last_type, BUFF_CB_TYPE_PRODUCE);
+	assert_int_equal(produce.last_amount, 20);
+	assert_ptr_equal(produce.last_address, wptr);
+	assert_int_equal(consume.calls, 0);
+
+	rptr = audio_stream_get_rptr(&buf->stream);
+	comp_update_buffer_consume(buf, 12);
+	assert_int_equal(produce.calls, 1);
+	assert_int_equal(consume.calls, 1);
+	assert_int_equal(consume.last_type, BUFF_CB_TYPE_CONSUME);
+	assert_int_equal(consume.last_amount, 12);
+	assert_ptr_equal(consume.last_address, rptr);
+
+	/* no transaction, no hook */
+	comp_update_buffer_produce(buf, 0);
+	assert_int_equal(produce.calls, 1);
+
+	buffer_hook_remove(&produce.hook);
+	assert_null(produce.hook.buffer);
+	assert_int_equal(buf->hook_types, BUFF_CB_TYPE_CONSUME);
+	comp_update_buffer_produce(buf, 10);
+	assert_int_equal(produce.calls, 1);
+
+	/* removing twice is harmless */
+	buffer_hook_remove(&produce.hook);
+
+	buffer_hook_remove(&consume.hook);
+	assert_int_equal(buf->hook_types, 0);
+
+	buffer_free(buf);
+}
+
+static void test_audio_buffer_hook_free(void **state)
+{
+	struct comp_buffer *buf = test_buffer_new();
+	struct test_hook self_remove;
+	struct test_hook produce;
+	struct test_hook on_free;
+
+	(void)state;
+
+	assert_non_null(buf);
+	test_hook_init(&self_remove, BUFF_CB_TYPE_PRODUCE | BUFF_CB_TYPE_FREE);
+	test_hook_init(&produce, BUFF_CB_TYPE_PRODUCE);
+	test_hook_init(&on_free, BUFF_CB_TYPE_FREE);
+	self_remove.remove_on_free = true;
+	buffer_hook_add(buf, &self_remove.hook);
+	buffer_hook_add(buf, &produce.hook);
+	buffer_hook_add(buf, &on_free.hook);
+
+	comp_update_buffer_produce(buf, 8);
+	assert_int_equal(self_remove.calls, 1);
+	assert_int_equal(produce.calls, 1);
+	assert_int_equal(on_free.calls, 0);
+
+	/* free hooks may remove themselves, the others are detached */
+	buffer_free(buf);
+	assert_int_equal(self_remove.calls, 2);
+	assert_int_equal(self_remove.last_type, BUFF_CB_TYPE_FREE);
+	assert_int_equal(produce.calls, 1);
+	assert_int_equal(on_free.calls, 1);
+	assert_null(self_remove.hook.buffer);
+	assert_null(produce.hook.buffer);
+	assert_null(on_free.hook.buffer);
+
+	/* removing a detached hook does not touch the freed buffer */
+	buffer_hook_remove(&produce.hook);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_audio_buffer_hook_none),
+		cmocka_unit_test(test_audio_buffer_hook_produce_consume),
+		cmocka_unit_test(test_audio_buffer_hook_free),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
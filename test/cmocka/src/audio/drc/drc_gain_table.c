@@ -0,0 +1,273 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <math.h>
+#include <string.h>
+
+#include <sof/audio/format.h>
+#include <sof/common.h>
+
+#include "drc/drc.h"
+#include "drc/drc_algorithm.h"
+
+#define TEST_POINTS		20000
+#define TEST_RATE		48000
+
+/* Gain error allowed for the interpolated curve, in dB */
+#define TEST_GAIN_MAX_ERR_DB	0.05
+/* Relative release rate error allowed */
+#define TEST_RELEASE_MAX_ERR	0.05
+
+struct test_drc_setup {
+	double threshold; /* dB */
+	double knee;      /* dB */
+	double ratio;
+};
+
+static const struct test_drc_setup test_setups[] = {
+	{ -24.0, 20.0, 12.0 },
+	{ -40.0, 10.0, 4.0 },
+	{ -60.0, 6.0, 2.0 },
+	{ -50.0, 20.0, 20.0 },
+	{ -10.0, 3.0, 1.5 },
+};
+
+static uint32_t test_seed;
+
+static double db2mag(double db)
+{
+	return pow(10.0, db / 20.0);
+}
+
+static double mag2db(double mag)
+{
+	return 20.0 * log10(mag);
+}
+
+static double knee_curve(double linear_threshold, double x, double k)
+{
+	if (x < linear_threshold)
+		return x;
+
+	return linear_threshold + (1.0 - exp(-k * (x - linear_threshold))) / k;
+}
+
+static double slope_at(double linear_threshold, double x, double k)
+{
+	double x2 = x * 1.001;
+
+	if (x < linear_threshold)
+		return 1.0;
+
+	return (mag2db(knee_curve(linear_threshold, x2, k)) -
+		mag2db(knee_curve(linear_threshold, x, k))) /
+		(mag2db(x2) - mag2db(x));
+}
+
+/* Same as drc_gen_coefs.m in tools/tune/drc */
+static void test_drc_params(struct sof_drc_params *p, const struct test_drc_setup *s)
+{
+	double linear_threshold = db2mag(s->threshold);
+	double knee_threshold = db2mag(s->threshold + s->knee);
+	double slope = 1.0 / s->ratio;
+	double sat_release_frames_inv_neg = -1.0 / (0.0025 * TEST_RATE);
+	double min_k = 0.1;
+	double max_k = 10000.0;
+	double k = 5.0;
+	double y0;
+	int i;
+
+	for (i = 0; i < 15; i++) {
+		if (slope_at(linear_threshold, knee_threshold, k) < slope)
+			max_k = k;
+		else
+			min_k = k;
+
+		k = sqrt(min_k * max_k);
+	}
+
+	y0 = knee_curve(linear_threshold, knee_threshold, k);
+
+	memset(p, 0, sizeof(*p));
+	p->enabled = 1;
+	p->db_threshold = Q_CONVERT_FLOAT(s->threshold, 24);
+	p->db_knee = Q_CONVERT_FLOAT(s->knee, 24);
+	p->ratio = Q_CONVERT_FLOAT(s->ratio, 24);
+	p->linear_threshold = Q_CONVERT_FLOAT(linear_threshold, 30);
+	p->slope = Q_CONVERT_FLOAT(slope, 30);
+	p->K = Q_CONVERT_FLOAT(k, 20);
+	p->knee_alpha = Q_CONVERT_FLOAT(linear_threshold + 1.0 / k, 24);
+	p->knee_beta = Q_CONVERT_FLOAT(-exp(k * linear_threshold) / k, 24);
+	p->knee_threshold = Q_CONVERT_FLOAT(knee_threshold, 24);
+	p->ratio_base = Q_CONVERT_FLOAT(y0 * pow(knee_threshold, -slope), 30);
+	p->sat_release_frames_inv_neg = Q_CONVERT_FLOAT(sat_release_frames_inv_neg, 30);
+	p->sat_release_rate_at_neg_two_db =
+		Q_CONVERT_FLOAT(db2mag(-2.0 * sat_release_frames_inv_neg) - 1.0, 30);
+}
+
+/* Input levels from -130 dB to full scale, log spaced and random */
+static int32_t test_level(int i)
+{
+	double db;
+
+	if (i == 0)
+		return INT32_MAX;
+
+	if (i < TEST_POINTS / 2) {
+		db = -130.0 * i / (TEST_POINTS / 2);
+	} else {
+		test_seed = test_seed * 1664525 + 1013904223;
+		db = -130.0 * (test_seed >> 8) / (1 << 24);
+	}
+
+	return (int32_t)(db2mag(db) * 2147483647.0);
+}
+
+static void test_gain_table_accuracy(const struct test_drc_setup *s)
+{
+	struct sof_drc_params p;
+	struct drc_state state;
+	int32_t ref_gain;
+	int32_t gain;
+	int32_t ref_rate;
+	int32_t rate;
+	int32_t x;
+	double err;
+	int i;
+
+	test_drc_params(&p, s);
+	memset(&state, 0, sizeof(state));
+	drc_reset_state(&state);
+	assert_int_equal(drc_init_gain_table(&state, &p), 0);
+	assert_non_null(state.gain_table);
+
+	test_seed = 12345;
+	for (i = 0; i < TEST_POINTS; i++) {
+		x = test_level(i);
+		ref_gain = drc_volume_gain(&p, x);
+		gain = drc_gain_table_gain(state.gain_table, x);
+
+		/* Linear part of the curve is exact */
+		if (x < state.gain_table->linear_threshold) {
+			assert_int_equal(gain, ref_gain);
+			continue;
+		}
+
+		err = fabs(mag2db((double)gain / ref_gain));
+		if (err > TEST_GAIN_MAX_ERR_DB)
+			fail_msg("x %d gain %d ref %d error %f dB", x, gain, ref_gain, err);
+
+		/* The release rate is used for gains at or below -2 dB */
+		if (ref_gain > Q_CONVERT_FLOAT(0.7943282347242815, 30))
+			continue;
+
+		ref_rate = drc_release_rate(&p, ref_gain);
+		rate = drc_gain_table_release(state.gain_table, x);
+		err = fabs((double)(rate - ref_rate) / ref_rate);
+		if (err > TEST_RELEASE_MAX_ERR)
+			fail_msg("x %d rate %d ref %d error %f", x, rate, ref_rate, err);
+	}
+
+	drc_reset_state(&state);
+	assert_null(state.gain_table);
+}
+
+static void test_drc_gain_table_accuracy(void **state)
+{
+	int i;
+
+	(void)state;
+
+	for (i = 0; i < ARRAY_SIZE(test_setups); i++)
+		test_gain_table_accuracy(&test_setups[i]);
+}
+
+static void test_drc_gain_table_detector(void **state)
+{
+	struct sof_drc_params p;
+	struct drc_state ref;
+	struct drc_state drc;
+	int32_t *ref_buf;
+	int32_t *buf;
+	double level;
+	double err;
+	int div;
+	int i;
+
+	(void)state;
+
+	test_drc_params(&p, &test_setups[1]);
+	memset(&ref, 0, sizeof(ref));
+	memset(&drc, 0, sizeof(drc));
+	drc_reset_state(&ref);
+	drc_reset_state(&drc);
+	assert_int_equal(drc_init_pre_delay_buffers(&ref, sizeof(int32_t), 1), 0);
+	assert_int_equal(drc_init_pre_delay_buffers(&drc, sizeof(int32_t), 1), 0);
+	assert_int_equal(drc_init_gain_table(&drc, &p), 0);
+	assert_non_null(drc.gain_table);
+	assert_null(ref.gain_table);
+
+	/* The detector reads the division before the write index */
+	ref.pre_delay_write_index = DRC_DIVISION_FRAMES;
+	drc.pre_delay_write_index = DRC_DIVISION_FRAMES;
+	ref_buf = (int32_t *)ref.pre_delay_buffers[0];
+	buf = (int32_t *)drc.pre_delay_buffers[0];
+
+	/* Noise bursts with attacks and releases through the whole curve */
+	test_seed = 12345;
+	for (div = 0; div < 1000; div++) {
+		level = db2mag(-100.0 * ((div / 50) % 5) / 4);
+		for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
+			test_seed = test_seed * 1664525 + 1013904223;
+			buf[i] = (int32_t)(level * (int32_t)test_seed);
+			ref_buf[i] = buf[i];
+		}
+
+		drc_update_detector_average(&ref, &p, sizeof(int32_t), 1);
+		drc_update_detector_average(&drc, &p, sizeof(int32_t), 1);
+		err = fabs(mag2db((double)drc.detector_average / ref.detector_average));
+		if (err > TEST_GAIN_MAX_ERR_DB)
+			fail_msg("division %d average %d ref %d error %f dB", div,
+				 drc.detector_average, ref.detector_average, err);
+	}
+
+	drc_reset_state(&ref);
+	drc_reset_state(&drc);
+}
+
+static void test_drc_gain_table_below_range(void **state)
+{
+	const struct test_drc_setup s = { -125.0, 10.0, 4.0 };
+	struct sof_drc_params p;
+	struct drc_state drc;
+
+	(void)state;
+
+	/* The curve is computed when the threshold is below the table */
+	test_drc_params(&p, &s);
+	memset(&drc, 0, sizeof(drc));
+	drc_reset_state(&drc);
+	assert_int_equal(drc_init_gain_table(&drc, &p), 0);
+	assert_null(drc.gain_table);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_drc_gain_table_accuracy),
+		cmocka_unit_test(test_drc_gain_table_detector),
+		cmocka_unit_test(test_drc_gain_table_below_range),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <errno.h>
+#include <math.h>
+#include <cmocka.h>
+#include <stdbool.h>
+
+#include <sof/audio/format.h>
+#include <sof/math/fir_config.h>
+#include <sof/math/fir_fft.h>
+#include <sof/math/fir_generic.h>
+#include <user/fir.h>
+
+/* Minimum SNR of partitioned FFT convolution output vs. direct form */
+#define FIR_FFT_MIN_SNR		80.0
+#define FIR_FFT_TEST_FRAMES	4800
+
+static uint32_t rand_state;
+
+static int32_t test_rand(void)
+{
+	rand_state = rand_state * 1664525 + 1013904223;
+	return (int32_t)rand_state;
+}
+
+/* Random response with exponential decay, Q1.15 */
+static struct sof_fir_coef_data *test_response(int length, int out_shift)
+{
+	struct sof_fir_coef_data *config;
+	double gain = 1.0;
+	double decay = exp(log(0.01) / length);
+	int i;
+
+	config = calloc(1, sizeof(*config) + length * sizeof(int16_t));
+	assert_non_null(config);
+	config->length = length;
+	config->out_shift = out_shift;
+	for (i = 0; i < length; i++) {
+		config->coef[i] = (int16_t)((test_rand() >> 16) * gain);
+		gain *= decay;
+	}
+
+	return config;
+}
+
+/* Direct form reference with 64 bit accumulator and no length limits */
+static int32_t test_reference(struct sof_fir_coef_data *config, int32_t *x, int n)
+{
+	int64_t y = 0;
+	int i;
+
+	for (i = 0; i < config->length && i <= n; i++)
+		y += (int64_t)config->coef[i] * x[n - i];
+
+	return sat_int32(y >> (15 + config->out_shift));
+}
+
+static double test_snr(struct sof_fir_coef_data *config, int32_t *x, int32_t *y,
+		       int32_t *ref, bool direct)
+{
+	struct fir_state_32x16 fir;
+	int32_t *delay = NULL;
+	int32_t *data;
+	double signal = 0;
+	double noise = 0;
+	double e;
+	int i;
+
+	if (direct) {
+		fir_reset(&fir);
+		delay = calloc(1, fir_delay_size(config));
+		assert_non_null(delay);
+		fir_init_coef(&fir, config);
+		data = delay;
+		fir_init_delay(&fir, &data);
+	}
+
+	for (i = 0; i < FIR_FFT_TEST_FRAMES; i++) {
+		ref[i] = direct ? fir_32x16(&fir, x[i]) : test_reference(config, x, i);
+		e = (double)y[i] - ref[i];
+		signal += (double)ref[i] * ref[i];
+		noise += e * e;
+	}
+
+	free(delay);
+	if (noise == 0)
+		return INFINITY;
+
+	return 10 * log10(signal / noise);
+}
+
+static double test_fir_fft(int length, int out_shift, bool direct)
+{
+	struct sof_fir_coef_data *config;
+	struct fir_fft_state fft = { 0 };
+	int32_t *x;
+	int32_t *y;
+	int32_t *ref;
+	double snr;
+	int i;
+
+	rand_state = length;
+	config = test_response(length, out_shift);
+	x = malloc(FIR_FFT_TEST_FRAMES * sizeof(int32_t));
+	y = malloc(FIR_FFT_TEST_FRAMES * sizeof(int32_t));
+	ref = malloc(FIR_FFT_TEST_FRAMES * sizeof(int32_t));
+	assert_non_null(x);
+	assert_non_null(y);
+	assert_non_null(ref);
+
+	/* White noise at -20 dBFS */
+	for (i = 0; i < FIR_FFT_TEST_FRAMES; i++)
+		x[i] = test_rand() / 10;
+
+	assert_int_equal(fir_fft_init(&fft, config), 0);
+	for (i = 0; i < FIR_FFT_TEST_FRAMES; i++)
+		y[i] = fir_fft_32x16(&fft, x[i]);
+
+	snr = test_snr(config, x, y, ref, direct);
+
+	fir_fft_free(&fft);
+	free(ref);
+	free(y);
+	free(x);
+	free(config);
+	return snr;
+}
+
+static void test_fir_fft_head_only(void **state)
+{
+	(void)state;
+
+	/* The first partition is run in direct form, it must be bit exact */
+	assert_true(isinf(test_fir_fft(FIR_FFT_BLOCK, 1, true)));
+}
+
+static void test_fir_fft_256(void **state)
+{
+	(void)state;
+
+	assert_true(test_fir_fft(256, 1, true) > FIR_FFT_MIN_SNR);
+}
+
+static void test_fir_fft_1000(void **state)
+{
+	(void)state;
+
+	assert_true(test_fir_fft(1000, 2, false) > FIR_FFT_MIN_SNR);
+}
+
+static void test_fir_fft_4096(void **state)
+{
+	(void)state;
+
+	assert_true(test_fir_fft(FIR_FFT_MAX_LENGTH, 3, false) > FIR_FFT_MIN_SNR);
+}
+
+static void test_fir_fft_invalid(void **state)
+{
+	struct sof_fir_coef_data config = { 0 };
+	struct fir_fft_state fft = { 0 };
+
+	(void)state;
+
+	config.length = FIR_FFT_MAX_LENGTH + 1;
+	assert_int_equal(fir_fft_init(&fft, &config), -EINVAL);
+
+	/* Not initialized filter is a pass-through */
+	assert_int_equal(fir_fft_32x16(&fft, 12345), 12345);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_fir_fft_head_only),
+		cmocka_unit_test(test_fir_fft_256),
+		cmocka_unit_test(test_fir_fft_1000),
+		cmocka_unit_test(test_fir_fft_4096),
+		cmocka_unit_test(test_fir_fft_invalid),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -11,6 +11,8 @@
 #include <sof/audio/component_ext.h>
 #include <eq_fir/eq_fir.h>
 #include <sof/audio/module_adapter/module/generic.h>
+#include <sof/audio/data_blob.h>
+#include <user/eq.h>
 
 #include "../../util.h"
 #include "../../../include/cmocka_chirp_2ch.h"
@@ -66,26 +68,25 @@ static int setup_group(void **state)
 	return 0;
 }
 
-static struct sof_ipc_comp_process *create_eq_fir_comp_ipc(struct test_data *td)
+static struct sof_ipc_comp_process *create_eq_fir_comp_ipc(const void *config, uint32_t size)
 {
 	struct sof_ipc_comp_process *ipc;
 	struct sof_eq_fir_config *eq;
 	size_t ipc_size = sizeof(struct sof_ipc_comp_process);
-	struct sof_abi_hdr *blob = (struct sof_abi_hdr *)fir_coef_2ch;
 	const struct sof_uuid uuid = {
 		.a = 0x43a90ce7, .b = 0xf3a5, .c = 0x41df,
 		.d = {0xac, 0x06, 0xba, 0x98, 0x65, 0x1a, 0xe6, 0xa3}
 	};
 
-	ipc = calloc(1, ipc_size + blob->size + SOF_UUID_SIZE);
+	ipc = calloc(1, ipc_size + size + SOF_UUID_SIZE);
 	memcpy_s(ipc + 1, SOF_UUID_SIZE, &uuid, SOF_UUID_SIZE);
 	eq = (struct sof_eq_fir_config *)((char *)(ipc + 1) + SOF_UUID_SIZE);
 	ipc->comp.hdr.size = ipc_size + SOF_UUID_SIZE;
 	ipc->comp.type = SOF_COMP_EQ_FIR;
 	ipc->config.hdr.size = sizeof(struct sof_ipc_comp_config);
-	ipc->size = blob->size;
+	ipc->size = size;
 	ipc->comp.ext_data_length = SOF_UUID_SIZE;
-	memcpy_s(eq, blob->size, blob->data, blob->size);
+	memcpy_s(eq, size, config, size);
 	return ipc;
 }
 
@@ -128,7 +129,7 @@ static void prepare_source(struct test_data *td, struct processing_module *mod)
 	assert_int_equal(free, size);
 }
 
-static int setup(void **state)
+static int setup_config(void **state, const void *config, uint32_t size)
 {
 	struct test_parameters *params = *state;
 	struct processing_module *mod;
@@ -146,7 +147,7 @@ static int setup(void **state)
 		return -EINVAL;
 
 	memcpy_s(td->params, sizeof(*td->params), params, sizeof(*params));
-	ipc = create_eq_fir_comp_ipc(td);
+	ipc = create_eq_fir_comp_ipc(config, size);
 	buffer_fill_data.idx = 0;
 	buffer_verify_data.idx = 0;
 
@@ -181,6 +182,13 @@ static int setup(void **state)
 	return 0;
 }
 
+static int setup(void **state)
+{
+	struct sof_abi_hdr *blob = (struct sof_abi_hdr *)fir_coef_2ch;
+
+	return setup_config(state, blob->data, blob->size);
+}
+
 static int teardown(void **state)
 {
 	struct test_data *td = *state;
@@ -465,6 +473,146 @@ static void test_audio_eq_fir(void **state)
 	}
 }
 
+#if CONFIG_MATH_FIR_FFT && CONFIG_FORMAT_S32LE
+/* The short response is run in direct form, the long one with FFT */
+#define FFT_TEST_SHORT		SOF_FIR_MAX_LENGTH
+#define FFT_TEST_LONG		(SOF_FIR_MAX_LENGTH + 64)
+#define FFT_TEST_IMPULSE	(1 << 30)
+#define ERROR_TOLERANCE_FFT	4096 /* -102 dB of the output impulse */
+#define FFT_TEST_COUNT		1
+
+static struct test_parameters fft_parameters = {
+	2, 48, 2, SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S32_LE
+};
+
+/* Blob with one response for both channels, it is a single 0.5 tap at the
+ * end so the output is the input delayed by length - 1 frames.
+ */
+static struct sof_eq_fir_config *fft_test_config(int length)
+{
+	struct sof_eq_fir_config *config;
+	struct sof_fir_coef_data *coef;
+	size_t size = sizeof(*config) + 2 * sizeof(int16_t) + sizeof(*coef) +
+		      length * sizeof(int16_t);
+
+	config = calloc(1, size);
+	assert_non_null(config);
+	config->size = size;
+	config->channels_in_config = 2;
+	config->number_of_responses = 1;
+	coef = (struct sof_fir_coef_data *)&config->data[2];
+	coef->length = length;
+	coef->coef[length - 1] = 16384;
+
+	return config;
+}
+
+static int setup_fft(void **state)
+{
+	struct sof_eq_fir_config *config = fft_test_config(FFT_TEST_LONG);
+	int ret;
+
+	ret = setup_config(state, config, config->size);
+	free(config);
+	return ret;
+}
+
+/* Sends a new blob while streaming, it is applied in next process() */
+static void fft_test_set_config(struct test_data *td, int length)
+{
+	struct processing_module *mod = comp_get_drvdata(td->dev);
+	struct comp_data *cd = module_get_private_data(mod);
+	struct sof_eq_fir_config *config = fft_test_config(length);
+	struct sof_ipc_ctrl_data *cdata;
+	int ret;
+
+	cdata = calloc(1, sizeof(*cdata) + sizeof(struct sof_abi_hdr) + config->size);
+	assert_non_null(cdata);
+	cdata->cmd = SOF_CTRL_CMD_BINARY;
+	memcpy_s(cdata->data[0].data, config->size, config, config->size);
+
+	td->dev->state = COMP_STATE_ACTIVE;
+	ret = comp_data_blob_set(cd->model_handler, MODULE_CFG_FRAGMENT_SINGLE, config->size,
+				 (const uint8_t *)cdata, config->size);
+	assert_int_equal(ret, 0);
+	free(cdata);
+	free(config);
+}
+
+/* Runs an impulse through the filter and checks the delayed output */
+static void fft_test_run(struct test_data *td, int length)
+{
+	struct processing_module *mod = comp_get_drvdata(td->dev);
+	struct audio_stream *source = &td->source->stream;
+	struct audio_stream *sink = &td->sink->stream;
+	int channels = td->params->channels;
+	int frames = td->params->frames;
+	int32_t delta;
+	int32_t ref;
+	int32_t *x;
+	int samples;
+	int ret;
+	int n;
+	int i;
+
+	for (n = 0; n < length + frames; n += frames) {
+		samples = frames * channels;
+		for (i = 0; i < samples; i++) {
+			x = audio_stream_write_frag_s32(source, i);
+			*x = !n && i < channels ? FFT_TEST_IMPULSE : 0;
+		}
+
+		comp_update_buffer_produce(td->source, samples * sizeof(int32_t));
+		mod->input_buffers[0].size = frames;
+		mod->input_buffers[0].consumed = 0;
+		mod->output_buffers[0].size = 0;
+
+		ret = module_process_legacy(mod, mod->input_buffers, 1,
+					    mod->output_buffers, 1);
+		assert_int_equal(ret, 0);
+
+		comp_update_buffer_consume(td->source, mod->input_buffers[0].consumed);
+		comp_update_buffer_produce(td->sink, mod->output_buffers[0].size);
+		assert_int_equal(mod->output_buffers[0].size, samples * sizeof(int32_t));
+
+		for (i = 0; i < samples; i++) {
+			x = audio_stream_read_frag_s32(sink, i);
+			ref = n + i / channels == length - 1 ? FFT_TEST_IMPULSE >> 1 : 0;
+			delta = ref - *x;
+			if (delta > ERROR_TOLERANCE_FFT || delta < -ERROR_TOLERANCE_FFT)
+				assert_int_equal(*x, ref);
+		}
+
+		comp_update_buffer_consume(td->sink, mod->output_buffers[0].size);
+	}
+}
+
+static void test_audio_eq_fir_fft_switch(void **state)
+{
+	struct test_data *td = *state;
+	struct processing_module *mod = comp_get_drvdata(td->dev);
+	struct comp_data *cd = module_get_private_data(mod);
+
+	/* The long response from init is set up in prepare() */
+	assert_true(cd->fft_mode);
+	fft_test_run(td, FFT_TEST_LONG);
+
+	/* Switch to direct form while streaming */
+	fft_test_set_config(td, FFT_TEST_SHORT);
+	fft_test_run(td, FFT_TEST_SHORT);
+	assert_false(cd->fft_mode);
+	assert_true(cd->fir_delay_size > 0);
+
+	/* And back to FFT, the direct form delay lines are released */
+	fft_test_set_config(td, FFT_TEST_LONG);
+	fft_test_run(td, FFT_TEST_LONG);
+	assert_true(cd->fft_mode);
+	assert_int_equal(cd->fir_delay_size, 0);
+}
+#else
+#define FFT_TEST_COUNT		0
+#endif
+
 static struct test_parameters parameters[] = {
 #if CONFIG_FORMAT_S16LE
 	{ 2, 48, 2, SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE },
@@ -483,7 +631,7 @@ int main(void)
 	int ret;
 	int i;
 
-	struct CMUnitTest tests[ARRAY_SIZE(parameters)];
+	struct CMUnitTest tests[ARRAY_SIZE(parameters) + FFT_TEST_COUNT];
 
 	for (i = 0; i < ARRAY_SIZE(parameters); i++) {
 		tests[i].name = "test_audio_eq_fir";
@@ -493,6 +641,14 @@ int main(void)
 		tests[i].initial_state = &parameters[i];
 	}
 
+#if FFT_TEST_COUNT
+	tests[i].name = "test_audio_eq_fir_fft_switch";
+	tests[i].test_func = test_audio_eq_fir_fft_switch;
+	tests[i].setup_func = setup_fft;
+	tests[i].teardown_func = teardown;
+	tests[i].initial_state = &fft_parameters;
+#endif
+
 	cmocka_set_message_output(CM_OUTPUT_TAP);
 
 #ifdef DEBUG_FILES
@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+
+#include <sof/audio/format.h>
+#include <sof/common.h>
+#include <ipc/stream.h>
+
+#include "mixin_mixout/mixin_mixout.h"
+
+#define TEST_SOURCES	IPC4_MIXOUT_MODULE_MAX_INPUT_QUEUES
+#define TEST_SAMPLES	150
+/* Different buffer sizes make the sources and the sink wrap at different samples */
+#define TEST_BUF_SAMPLES(i)	(TEST_SAMPLES + 7 + 13 * (i))
+#define TEST_BUF_MAX		TEST_BUF_SAMPLES(TEST_SOURCES)
+
+static int32_t test_buf[TEST_SOURCES + 1][TEST_BUF_MAX];
+static int64_t test_ref[TEST_SAMPLES];
+
+/* Mixin sink gains of the attenuated cases, unity gain is mixed too */
+static const uint16_t test_gains[TEST_SOURCES] = {
+	0x200, IPC4_MIXIN_UNITY_GAIN, 0x3ff, 0, 0x155, 0x001, 0x2c0, 0x100
+};
+
+static uint32_t test_seed;
+
+static int32_t test_rand(void)
+{
+	test_seed = test_seed * 1664525 + 1013904223;
+	return (int32_t)test_seed;
+}
+
+static void test_cir_buf(struct cir_buf_ptr *buf, int i, int sample_bytes)
+{
+	buf->buf_start = test_buf[i];
+	buf->buf_end = (uint8_t *)test_buf[i] + TEST_BUF_SAMPLES(i) * sample_bytes;
+	/* start close to the end to wrap in the middle of the data */
+	buf->ptr = (uint8_t *)test_buf[i] + (TEST_BUF_SAMPLES(i) - 11 * i - 5) * sample_bytes;
+}
+
+static int32_t test_sample(const struct cir_buf_ptr *buf, int sample_bytes, int i)
+{
+	uint8_t *ptr = (uint8_t *)buf->ptr + i * sample_bytes;
+
+	if (ptr >= (uint8_t *)buf->buf_end)
+		ptr -= (uint8_t *)buf->buf_end - (uint8_t *)buf->buf_start;
+
+	switch (sample_bytes) {
+	case sizeof(int16_t):
+		return *(int16_t *)ptr;
+	default:
+		return *(int32_t *)ptr;
+	}
+}
+
+static void test_mix_n(enum sof_ipc_frame fmt, int source_count, int mixed_samples,
+		       bool attenuate)
+{
+	const int sample_bytes = fmt == SOF_IPC_FRAME_S16_LE ? sizeof(int16_t) : sizeof(int32_t);
+	mix_n_func mix_n = mixout_get_processing_function(fmt);
+	struct cir_buf_ptr sources[TEST_SOURCES];
+	struct cir_buf_ptr sink;
+	uint16_t gains[TEST_SOURCES];
+	int64_t sample;
+	int i, j;
+
+	if (!mix_n)
+		return;
+
+	/* full scale noise to exercise the saturation */
+	for (i = 0; i <= TEST_SOURCES; i++)
+		for (j = 0; j < TEST_BUF_MAX; j++)
+			test_buf[i][j] = test_rand();
+
+	for (i = 0; i < source_count; i++) {
+		test_cir_buf(&sources[i], i + 1, sample_bytes);
+		gains[i] = attenuate ? test_gains[i] : IPC4_MIXIN_UNITY_GAIN;
+	}
+
+	test_cir_buf(&sink, 0, sample_bytes);
+
+	/* the samples already in sink are mixed, the rest are overwritten */
+	for (i = 0; i < TEST_SAMPLES; i++) {
+		test_ref[i] = 0;
+		for (j = -1; j < source_count; j++) {
+			if (j < 0 && i >= mixed_samples)
+				continue;
+
+			sample = test_sample(j < 0 ? &sink : &sources[j], sample_bytes, i);
+			if (fmt == SOF_IPC_FRAME_S24_4LE)
+				sample = sign_extend_s24(sample);
+
+			/* only the sources are scaled by the mixin sink gain */
+			if (j >= 0)
+				sample = (sample * gains[j]) >> IPC4_MIXIN_GAIN_SHIFT;
+
+			test_ref[i] += sample;
+		}
+	}
+
+	mix_n(&sink, mixed_samples, sources, gains, source_count, TEST_SAMPLES);
+
+	for (i = 0; i < TEST_SAMPLES; i++) {
+		switch (fmt) {
+		case SOF_IPC_FRAME_S16_LE:
+			assert_int_equal(test_sample(&sink, sample_bytes, i),
+					 sat_int16(test_ref[i]));
+			break;
+		case SOF_IPC_FRAME_S24_4LE:
+			assert_int_equal(test_sample(&sink, sample_bytes, i),
+					 sat_int24(test_ref[i]));
+			break;
+		default:
+			assert_int_equal(test_sample(&sink, sample_bytes, i),
+					 sat_int32(test_ref[i]));
+			break;
+		}
+	}
+}
+
+static void test_mix_n_fmt(enum sof_ipc_frame fmt, bool attenuate)
+{
+	const int mixed_samples[] = {0, 1, 37, TEST_SAMPLES, 2 * TEST_SAMPLES};
+	int source_count;
+	int i;
+
+	test_seed = 12345;
+	for (source_count = 1; source_count <= TEST_SOURCES; source_count++)
+		for (i = 0; i < ARRAY_SIZE(mixed_samples); i++)
+			test_mix_n(fmt, source_count, mixed_samples[i], attenuate);
+}
+
+static void test_audio_mix_n_s16(void **state)
+{
+	(void)state;
+
+	test_mix_n_fmt(SOF_IPC_FRAME_S16_LE, false);
+}
+
+static void test_audio_mix_n_s16_gain(void **state)
+{
+	(void)state;
+
+	test_mix_n_fmt(SOF_IPC_FRAME_S16_LE, true);
+}
+
+static void test_audio_mix_n_s24(void **state)
+{
+	(void)state;
+
+	test_mix_n_fmt(SOF_IPC_FRAME_S24_4LE, false);
+}
+
+static void test_audio_mix_n_s24_gain(void **state)
+{
+	(void)state;
+
+	test_mix_n_fmt(SOF_IPC_FRAME_S24_4LE, true);
+}
+
+static void test_audio_mix_n_s32(void **state)
+{
+	(void)state;
+
+	test_mix_n_fmt(SOF_IPC_FRAME_S32_LE, false);
+}
+
+static void test_audio_mix_n_s32_gain(void **state)
+{
+	(void)state;
+
+	test_mix_n_fmt(SOF_IPC_FRAME_S32_LE, true);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_audio_mix_n_s16),
+		cmocka_unit_test(test_audio_mix_n_s24),
+		cmocka_unit_test(test_audio_mix_n_s32),
+		cmocka_unit_test(test_audio_mix_n_s16_gain),
+		cmocka_unit_test(test_audio_mix_n_s24_gain),
+		cmocka_unit_test(test_audio_mix_n_s32_gain),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,212 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <sof/audio/pcm_converter.h>
+#include <sof/audio/format.h>
+#include <sof/common.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+/* Odd lengths and offsets exercise the scalar tail after the SIMD part */
+#define TEST_SAMPLES	67
+#define TEST_OFFSETS	4
+
+static int32_t test_in[TEST_SAMPLES + TEST_OFFSETS];
+static int32_t test_out[TEST_SAMPLES + TEST_OFFSETS];
+
+/* Full scale noise with the extreme values in the beginning */
+static void test_input(void)
+{
+	uint32_t seed = 12345;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(test_in); i++) {
+		seed = seed * 1664525 + 1013904223;
+		test_in[i] = (int32_t)seed;
+	}
+
+	test_in[0] = INT32_MAX;
+	test_in[1] = INT32_MIN;
+	test_in[2] = INT24_MAXVALUE;
+	test_in[3] = INT24_MINVALUE;
+	test_in[4] = 0x7fff8000;
+	test_in[5] = -1;
+}
+
+static void test_s16_in(void (*kernel)(const void *, void *, uint32_t),
+			int32_t (*ref)(int16_t))
+{
+	const int16_t *src = (const int16_t *)test_in;
+	int n;
+	int i;
+
+	test_input();
+	for (n = 0; n < TEST_SAMPLES; n++) {
+		memset(test_out, 0, sizeof(test_out));
+		kernel(src + (n % TEST_OFFSETS), test_out, n);
+		for (i = 0; i < n; i++)
+			assert_int_equal(test_out[i], ref(src[i + n % TEST_OFFSETS]));
+	}
+}
+
+static void test_s32_in(void (*kernel)(const void *, void *, uint32_t),
+			int32_t (*ref)(int32_t))
+{
+	int n;
+	int i;
+
+	test_input();
+	for (n = 0; n < TEST_SAMPLES; n++) {
+		memset(test_out, 0, sizeof(test_out));
+		kernel(test_in + (n % TEST_OFFSETS), test_out, n);
+		for (i = 0; i < n; i++)
+			assert_int_equal(test_out[i], ref(test_in[i + n % TEST_OFFSETS]));
+	}
+}
+
+static void test_s16_out(void (*kernel)(const void *, void *, uint32_t),
+			 int16_t (*ref)(int32_t))
+{
+	int16_t *dst = (int16_t *)test_out;
+	int n;
+	int i;
+
+	test_input();
+	for (n = 0; n < TEST_SAMPLES; n++) {
+		memset(test_out, 0, sizeof(test_out));
+		kernel(test_in + (n % TEST_OFFSETS), dst + (n % TEST_OFFSETS), n);
+		for (i = 0; i < n; i++)
+			assert_int_equal(dst[i + n % TEST_OFFSETS],
+					 ref(test_in[i + n % TEST_OFFSETS]));
+		assert_int_equal(dst[n + n % TEST_OFFSETS], 0);
+	}
+}
+
+static int32_t ref_s16_to_s24(int16_t x)
+{
+	return x << 8;
+}
+
+static int32_t ref_s16_to_s32(int16_t x)
+{
+	return x << 16;
+}
+
+static int32_t ref_s16_c16_to_s16_c32(int16_t x)
+{
+	return x;
+}
+
+static int32_t ref_s24_to_s32(int32_t x)
+{
+	return x << 8;
+}
+
+static int32_t ref_s16_c32_to_s32_c32(int32_t x)
+{
+	return x << 16;
+}
+
+static int32_t ref_s32_to_s24(int32_t x)
+{
+	return sat_int24(Q_SHIFT_RND(x, 31, 23));
+}
+
+static int32_t ref_s32_to_s24_be(int32_t x)
+{
+	return sat_int24(Q_SHIFT_RND(x, 31, 23)) << 8;
+}
+
+static int32_t ref_s32_c32_to_s16_c32(int32_t x)
+{
+	return sat_int16(Q_SHIFT_RND(x, 31, 15));
+}
+
+static int32_t ref_s24_c32_to_s16_c32(int32_t x)
+{
+	return sat_int16(Q_SHIFT_RND(sign_extend_s24(x & 0xffffff), 23, 15));
+}
+
+static int16_t ref_s24_to_s16(int32_t x)
+{
+	return sat_int16(Q_SHIFT_RND(sign_extend_s24(x), 23, 15));
+}
+
+static int16_t ref_s32_to_s16(int32_t x)
+{
+	return sat_int16(Q_SHIFT_RND(x, 31, 15));
+}
+
+static int16_t ref_s16_c32_to_s16_c16(int32_t x)
+{
+	return x & 0xffff;
+}
+
+static void test_pcm_lin_s16_in(void **state)
+{
+	(void)state;
+
+	test_s16_in(pcm_lin_s16_to_s24, ref_s16_to_s24);
+	test_s16_in(pcm_lin_s16_to_s32, ref_s16_to_s32);
+	test_s16_in(pcm_lin_s16_c16_to_s16_c32, ref_s16_c16_to_s16_c32);
+}
+
+static void test_pcm_lin_s32_in(void **state)
+{
+	(void)state;
+
+	test_s32_in(pcm_lin_s24_to_s32, ref_s24_to_s32);
+	test_s32_in(pcm_lin_s16_c32_to_s32_c32, ref_s16_c32_to_s32_c32);
+	test_s32_in(pcm_lin_s32_to_s24, ref_s32_to_s24);
+	test_s32_in(pcm_lin_s32_to_s24_be, ref_s32_to_s24_be);
+	test_s32_in(pcm_lin_s32_c32_to_s16_c32, ref_s32_c32_to_s16_c32);
+	test_s32_in(pcm_lin_s24_c32_to_s16_c32, ref_s24_c32_to_s16_c32);
+}
+
+static void test_pcm_lin_s16_out(void **state)
+{
+	(void)state;
+
+	test_s16_out(pcm_lin_s24_to_s16, ref_s24_to_s16);
+	test_s16_out(pcm_lin_s32_to_s16, ref_s32_to_s16);
+	test_s16_out(pcm_lin_s16_c32_to_s16_c16, ref_s16_c32_to_s16_c16);
+}
+
+static void test_pcm_lin_attenuate(void **state)
+{
+	uint32_t shift;
+	int i;
+
+	(void)state;
+
+	for (shift = 0; shift < 32; shift++) {
+		test_input();
+		for (i = 0; i < ARRAY_SIZE(test_in); i++)
+			test_out[i] = test_in[i];
+		pcm_lin_attenuate_s32(test_out + 1, TEST_SAMPLES, shift);
+		assert_int_equal(test_out[0], test_in[0]);
+		for (i = 0; i < TEST_SAMPLES; i++)
+			assert_int_equal(test_out[i + 1], test_in[i + 1] >> shift);
+	}
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_pcm_lin_s16_in),
+		cmocka_unit_test(test_pcm_lin_s32_in),
+		cmocka_unit_test(test_pcm_lin_s16_out),
+		cmocka_unit_test(test_pcm_lin_attenuate),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
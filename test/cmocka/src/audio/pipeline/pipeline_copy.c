@@ -0,0 +1,290 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <stdint.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/component.h>
+#include <sof/audio/pipeline.h>
+#include <sof/list.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#ifdef HAVE_MALLOC_H
+#include <malloc.h>
+#else
+#include <stdlib.h>
+#endif
+
+#define TEST_PIPE_ID		1
+#define TEST_OTHER_PIPE_ID	2
+#define TEST_NUM_COMPS		8
+#define TEST_NUM_BUFFERS	9
+#define TEST_MAX_COPIES		64
+
+/*
+ * Test graph, component 7 is in another pipeline and 4 is copied twice
+ * per walk because of the diamond 2 -> {3, 5} -> 4:
+ *
+ *   0 -> 1 -> 2 -> 3 -> 4 -> 6
+ *             |         ^
+ *             +--> 5 ---+
+ *             |
+ *             +--> 7
+ */
+static const int test_edges[TEST_NUM_BUFFERS][2] = {
+	{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 6}, {2, 5}, {5, 4}, {2, 7}, {7, 6},
+};
+
+struct test_graph {
+	struct pipeline p;
+	struct comp_dev comps[TEST_NUM_COMPS];
+	struct comp_buffer buffers[TEST_NUM_BUFFERS];
+	int copy_ret[TEST_NUM_COMPS];
+	int copies[TEST_MAX_COPIES];
+	int num_copies;
+};
+
+static struct test_graph *graph;
+
+static int test_comp_copy(struct comp_dev *dev)
+{
+	int id = dev->ipc_config.id;
+
+	assert_true(graph->num_copies < TEST_MAX_COPIES);
+	graph->copies[graph->num_copies++] = id;
+
+	return graph->copy_ret[id];
+}
+
+static const struct comp_driver test_drv = {
+	.ops = {
+		.copy = test_comp_copy,
+	},
+};
+
+static int setup(void **state)
+{
+	struct comp_buffer *buffer;
+	struct comp_dev *dev;
+	int i;
+
+	graph = calloc(1, sizeof(*graph));
+	if (!graph)
+		return -1;
+
+	for (i = 0; i < TEST_NUM_COMPS; i++) {
+		dev = &graph->comps[i];
+		dev->drv = &test_drv;
+		dev->ipc_config.id = i;
+		dev->ipc_config.pipeline_id = i == 7 ? TEST_OTHER_PIPE_ID : TEST_PIPE_ID;
+		dev->state = COMP_STATE_ACTIVE;
+		dev->pipeline = &graph->p;
+		list_init(&dev->bsource_list);
+		list_init(&dev->bsink_list);
+	}
+
+	/* append keeps the walk order of the edges above */
+	for (i = 0; i < TEST_NUM_BUFFERS; i++) {
+		buffer = &graph->buffers[i];
+		buffer->source = &graph->comps[test_edges[i][0]];
+		buffer->sink = &graph->comps[test_edges[i][1]];
+		list_item_append(&buffer->source_list, &buffer->source->bsink_list);
+		list_item_append(&buffer->sink_list, &buffer->sink->bsource_list);
+	}
+
+	graph->p.pipeline_id = TEST_PIPE_ID;
+	graph->p.source_comp = &graph->comps[0];
+	graph->p.sink_comp = &graph->comps[6];
+
+	*state = graph;
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	struct test_graph *g = *state;
+
+	pipeline_copy_schedule_free(&g->p);
+	free(g);
+	return 0;
+}
+
+/* copy once walking the graph and once with the flat schedule */
+static void test_copy_both(struct test_graph *g, int *walk_copies, int *num_walk,
+			   int *walk_ret, int *flat_ret)
+{
+	int i;
+
+	pipeline_copy_schedule_free(&g->p);
+	g->num_copies = 0;
+	*walk_ret = pipeline_copy(&g->p);
+	*num_walk = g->num_copies;
+	for (i = 0; i < g->num_copies; i++)
+		walk_copies[i] = g->copies[i];
+
+	assert_int_equal(pipeline_copy_schedule_build(&g->p), 0);
+	assert_non_null(g->p.copy_steps);
+	g->num_copies = 0;
+	*flat_ret = pipeline_copy(&g->p);
+}
+
+static void test_copy_compare(struct test_graph *g, int direction,
+			      const int *expect, int num_expect)
+{
+	int walk_copies[TEST_MAX_COPIES];
+	int num_walk;
+	int walk_ret;
+	int flat_ret;
+	int i;
+
+	g->comps[0].direction = direction;
+	test_copy_both(g, walk_copies, &num_walk, &walk_ret, &flat_ret);
+
+	assert_int_equal(flat_ret, walk_ret);
+	assert_int_equal(g->num_copies, num_walk);
+	assert_int_equal(num_walk, num_expect);
+	for (i = 0; i < num_expect; i++) {
+		assert_int_equal(walk_copies[i], expect[i]);
+		assert_int_equal(g->copies[i], expect[i]);
+	}
+}
+
+static void test_pipeline_copy_capture(void **state)
+{
+	static const int expect[] = {0, 1, 2, 3, 4, 6, 5, 4, 6};
+	struct test_graph *g = *state;
+
+	test_copy_compare(g, SOF_IPC_STREAM_CAPTURE, expect, ARRAY_SIZE(expect));
+	assert_int_equal(g->p.copy_step_count, ARRAY_SIZE(expect));
+}
+
+static void test_pipeline_copy_playback(void **state)
+{
+	static const int expect[] = {0, 1, 2, 3, 0, 1, 2, 5, 4, 6};
+	struct test_graph *g = *state;
+
+	test_copy_compare(g, SOF_IPC_STREAM_PLAYBACK, expect, ARRAY_SIZE(expect));
+	assert_int_equal(g->p.copy_step_count, ARRAY_SIZE(expect));
+}
+
+static void test_pipeline_copy_capture_inactive(void **state)
+{
+	static const int expect[] = {0, 1, 2, 5, 4, 6};
+	struct test_graph *g = *state;
+
+	g->comps[3].state = COMP_STATE_PAUSED;
+	test_copy_compare(g, SOF_IPC_STREAM_CAPTURE, expect, ARRAY_SIZE(expect));
+}
+
+static void test_pipeline_copy_playback_inactive(void **state)
+{
+	static const int expect[] = {0, 1, 2, 3, 4, 6};
+	struct test_graph *g = *state;
+
+	g->comps[5].state = COMP_STATE_PAUSED;
+	test_copy_compare(g, SOF_IPC_STREAM_PLAYBACK, expect, ARRAY_SIZE(expect));
+
+	/* nothing is copied when the sink is inactive */
+	g->comps[6].state = COMP_STATE_PAUSED;
+	test_copy_compare(g, SOF_IPC_STREAM_PLAYBACK, NULL, 0);
+}
+
+static void test_copy_check(struct test_graph *g, const int *expect, int num_expect)
+{
+	int i;
+
+	g->num_copies = 0;
+	assert_true(pipeline_copy(&g->p) >= 0);
+	assert_int_equal(g->num_copies, num_expect);
+	for (i = 0; i < num_expect; i++)
+		assert_int_equal(g->copies[i], expect[i]);
+}
+
+static void test_pipeline_copy_state_change(void **state)
+{
+	static const int capture[] = {0, 1, 2, 3, 4, 6, 5, 4, 6};
+	static const int capture_paused[] = {0, 1, 2, 3, 4, 6};
+	static const int playback[] = {0, 1, 2, 3, 0, 1, 2, 5, 4, 6};
+	static const int playback_paused[] = {0, 1, 2, 3, 4, 6};
+	struct test_graph *g = *state;
+
+	/* the schedule is kept across trigger, activity is checked on copy */
+	g->comps[0].direction = SOF_IPC_STREAM_CAPTURE;
+	assert_int_equal(pipeline_copy_schedule_build(&g->p), 0);
+	test_copy_check(g, capture, ARRAY_SIZE(capture));
+	g->comps[5].state = COMP_STATE_PAUSED;
+	test_copy_check(g, capture_paused, ARRAY_SIZE(capture_paused));
+	g->comps[5].state = COMP_STATE_ACTIVE;
+	test_copy_check(g, capture, ARRAY_SIZE(capture));
+
+	g->comps[0].direction = SOF_IPC_STREAM_PLAYBACK;
+	assert_int_equal(pipeline_copy_schedule_build(&g->p), 0);
+	test_copy_check(g, playback, ARRAY_SIZE(playback));
+	g->comps[5].state = COMP_STATE_PAUSED;
+	test_copy_check(g, playback_paused, ARRAY_SIZE(playback_paused));
+	g->comps[5].state = COMP_STATE_ACTIVE;
+	test_copy_check(g, playback, ARRAY_SIZE(playback));
+}
+
+static void test_pipeline_copy_capture_path_stop(void **state)
+{
+	static const int expect[] = {0, 1, 2, 3};
+	struct test_graph *g = *state;
+
+	g->copy_ret[3] = PPL_STATUS_PATH_STOP;
+	test_copy_compare(g, SOF_IPC_STREAM_CAPTURE, expect, ARRAY_SIZE(expect));
+}
+
+static void test_pipeline_copy_playback_error(void **state)
+{
+	static const int expect[] = {0, 1, 2, 3, 0, 1, 2, 5};
+	struct test_graph *g = *state;
+
+	g->copy_ret[5] = -EPIPE;
+	test_copy_compare(g, SOF_IPC_STREAM_PLAYBACK, expect, ARRAY_SIZE(expect));
+	assert_int_equal(pipeline_copy(&g->p), -EPIPE);
+}
+
+static void test_pipeline_copy_disconnect(void **state)
+{
+	static const int expect[] = {0, 1, 2, 3, 4, 6};
+	struct test_graph *g = *state;
+
+	g->comps[0].direction = SOF_IPC_STREAM_CAPTURE;
+	assert_int_equal(pipeline_copy_schedule_build(&g->p), 0);
+
+	/* a graph change drops the schedule until the next build */
+	pipeline_disconnect(&g->comps[2], &g->buffers[5], PPL_CONN_DIR_COMP_TO_BUFFER);
+	assert_null(g->p.copy_steps);
+
+	test_copy_compare(g, SOF_IPC_STREAM_CAPTURE, expect, ARRAY_SIZE(expect));
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_pipeline_copy_capture,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_pipeline_copy_playback,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_pipeline_copy_capture_inactive,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_pipeline_copy_playback_inactive,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_pipeline_copy_state_change,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_pipeline_copy_capture_path_stop,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_pipeline_copy_playback_error,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_pipeline_copy_disconnect,
+						setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
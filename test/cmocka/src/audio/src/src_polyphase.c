@@ -0,0 +1,297 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+
+#include <sof/audio/format.h>
+#include <sof/common.h>
+
+#include "src.h"
+#include "src_config.h"
+
+#if SRC_SHORT
+#include "coef/src_tiny_int16_define.h"
+#include "coef/src_tiny_int16_table.h"
+#else
+#include "coef/src_std_int32_define.h"
+#include "coef/src_std_int32_table.h"
+#endif
+
+#if SRC_SHORT
+#define TEST_COEF(c)		(c)
+#define TEST_COEF_QSHIFT	15
+#else
+#define TEST_COEF(c)		((c) >> 8)
+#define TEST_COEF_QSHIFT	23
+#endif
+
+#define TEST_CHANNELS_MAX	8
+#define TEST_BLOCKS		30
+#define TEST_IN_MAX		(TEST_BLOCKS * MAX_BLK_IN)
+#define TEST_OUT_MAX		(TEST_BLOCKS * MAX_OUT_DELAY_SIZE)
+
+static const int test_channels[] = {1, 2, 3, 4, 5, 6, 8};
+
+/* Input history per channel in Q1.31 */
+static int32_t test_x[TEST_CHANNELS_MAX][TEST_IN_MAX];
+static int32_t test_delay[TEST_CHANNELS_MAX *
+			  (MAX_FIR_DELAY_SIZE + MAX_FIR_DELAY_SIZE + MAX_OUT_DELAY_SIZE)];
+static int32_t test_ref_out[TEST_CHANNELS_MAX * MAX_OUT_DELAY_SIZE];
+static int32_t test_ref[TEST_CHANNELS_MAX * TEST_OUT_MAX];
+static int32_t test_out[TEST_CHANNELS_MAX * TEST_OUT_MAX];
+
+/* Buffers for the stage, the sizes are not multiple of the blocks to
+ * exercise the circular wraps.
+ */
+static int32_t test_in_buf[TEST_CHANNELS_MAX * (2 * MAX_BLK_IN + 3)];
+static int32_t test_out_buf[TEST_CHANNELS_MAX * (2 * MAX_OUT_DELAY_SIZE + 5)];
+
+static int32_t test_sample(uint32_t *seed, int fmt)
+{
+	int32_t v;
+
+	*seed = *seed * 1664525 + 1013904223;
+	v = (int32_t)*seed;
+
+	/* Add full scale samples to exercise the saturations */
+	if (((*seed >> 8) & 31) == 0)
+		v = (*seed & 0x100) ? INT32_MAX : INT32_MIN;
+
+	switch (fmt) {
+	case 16:
+		return v >> 16;
+	case 24:
+		return v >> 8;
+	default:
+		return v;
+	}
+}
+
+/* Direct form of the polyphase stage with linear input history */
+static int test_ref_stage(struct src_stage *cfg, int fmt, int nch, int blocks)
+{
+	const int shift = fmt == 24 ? 8 : 0;
+	const int qshift = TEST_COEF_QSHIFT + cfg->shift;
+	const int out_frames = src_out_delay_length(cfg);
+	const int taps = cfg->subfilter_length;
+	const int a0 = cfg->blk_in + (cfg->num_of_subfilters - 1) * cfg->idm - 1;
+#if SRC_SHORT
+	const int16_t *coef = cfg->coefs;
+#else
+	const int32_t *coef = cfg->coefs;
+#endif
+	int64_t y;
+	int32_t v;
+	int out_rp = 0;
+	int wp;
+	int n_in;
+	int idx;
+	int n = 0;
+	int b;
+	int i;
+	int t;
+	int ch;
+
+	memset(test_ref_out, 0, sizeof(test_ref_out));
+	for (b = 0; b < blocks; b++) {
+		n_in = (b + 1) * cfg->blk_in;
+		wp = out_rp;
+		for (i = 0; i < cfg->num_of_subfilters; i++) {
+			for (ch = 0; ch < nch; ch++) {
+				y = 1LL << (qshift - 1);
+				for (t = 0; t < taps; t++) {
+					idx = n_in - 1 - (a0 - i * cfg->idm) - t;
+					if (idx >= 0)
+						y += (int64_t)TEST_COEF(coef[i * taps + t]) *
+							test_x[ch][idx];
+				}
+
+				test_ref_out[wp * nch + ch] = sat_int32(y >> qshift);
+			}
+
+			wp = (wp + cfg->odm) % out_frames;
+		}
+
+		for (i = 0; i < cfg->num_of_subfilters; i++) {
+			for (ch = 0; ch < nch; ch++) {
+				v = test_ref_out[out_rp * nch + ch];
+				if (fmt == 16)
+					test_ref[n++] = sat_int16(Q_SHIFT_RND(v, 31, 15));
+				else
+					test_ref[n++] = v >> shift;
+			}
+
+			out_rp = (out_rp + 1) % out_frames;
+		}
+	}
+
+	return n;
+}
+
+static int test_stage(struct src_stage *cfg, int fmt, int nch, int blocks)
+{
+	struct src_state state;
+	struct src_stage_prm s;
+	int16_t *in16 = (int16_t *)test_in_buf;
+	int16_t *out16 = (int16_t *)test_out_buf;
+	const int in_size = nch * (2 * cfg->blk_in + 3);
+	const int out_size = nch * (2 * cfg->num_of_subfilters + 5);
+	const int bytes = fmt == 16 ? sizeof(int16_t) : sizeof(int32_t);
+	const int fir_size = nch * src_fir_delay_length(cfg);
+	const int mirror_size = nch * src_fir_mirror_length(cfg);
+	uint32_t seed = 1;
+	int32_t v;
+	int in_wp = 0;
+	int out_rp = 0;
+	int n_in = 0;
+	int n = 0;
+	int b;
+	int i;
+	int ch;
+
+	memset(test_delay, 0, sizeof(test_delay));
+	memset(&state, 0, sizeof(state));
+	state.fir_delay_size = fir_size;
+	state.fir_mirror_size = mirror_size;
+	state.out_delay_size = nch * src_out_delay_length(cfg);
+	state.fir_delay = test_delay;
+	state.out_delay = test_delay + fir_size + mirror_size;
+	state.fir_wp = &state.fir_delay[fir_size - 1];
+	state.out_rp = state.out_delay;
+
+	memset(&s, 0, sizeof(s));
+	s.nch = nch;
+	s.x_rptr = test_in_buf;
+	s.x_end_addr = (uint8_t *)test_in_buf + in_size * bytes;
+	s.x_size = in_size * bytes;
+	s.y_wptr = test_out_buf;
+	s.y_addr = test_out_buf;
+	s.y_end_addr = (uint8_t *)test_out_buf + out_size * bytes;
+	s.y_size = out_size * bytes;
+	s.shift = fmt == 24 ? 8 : 0;
+	s.state = &state;
+	s.stage = cfg;
+
+	/* Run one or two blocks per call */
+	for (b = 0; b < blocks; b += s.times) {
+		s.times = (b & 1) && b + 2 <= blocks ? 2 : 1;
+		for (i = 0; i < s.times * cfg->blk_in; i++) {
+			for (ch = 0; ch < nch; ch++) {
+				v = test_sample(&seed, fmt);
+				if (fmt == 16) {
+					in16[in_wp] = v;
+					test_x[ch][n_in] = Q_SHIFT_LEFT(v, 15, 31);
+				} else {
+					test_in_buf[in_wp] = v;
+					test_x[ch][n_in] = v << s.shift;
+				}
+
+				in_wp = (in_wp + 1) % in_size;
+			}
+
+			n_in++;
+		}
+
+		if (fmt == 16)
+			src_polyphase_stage_cir_s16(&s);
+		else
+			src_polyphase_stage_cir(&s);
+
+		for (i = 0; i < s.times * cfg->num_of_subfilters * nch; i++) {
+			test_out[n++] = fmt == 16 ? out16[out_rp] : test_out_buf[out_rp];
+			out_rp = (out_rp + 1) % out_size;
+		}
+	}
+
+	return n;
+}
+
+static void test_src_polyphase_stage(struct src_stage *cfg, int fmt, int stage,
+				     int fs_in, int fs_out)
+{
+	int n_ref;
+	int n_out;
+	int k;
+	int i;
+
+	for (k = 0; k < ARRAY_SIZE(test_channels); k++) {
+		n_out = test_stage(cfg, fmt, test_channels[k], TEST_BLOCKS);
+		n_ref = test_ref_stage(cfg, fmt, test_channels[k], TEST_BLOCKS);
+		assert_int_equal(n_out, n_ref);
+		for (i = 0; i < n_ref; i++) {
+			if (test_out[i] == test_ref[i])
+				continue;
+
+			printf("%s: fs %d -> %d stage %d, s%d, %d ch, sample %d\n",
+			       __func__, fs_in, fs_out, stage, fmt,
+			       test_channels[k], i);
+			assert_int_equal(test_out[i], test_ref[i]);
+		}
+	}
+}
+
+static void test_src_polyphase_fmt(int fmt)
+{
+	struct src_stage *stages[2];
+	struct src_stage *cfg;
+	int io;
+	int ii;
+	int j;
+
+	for (io = 0; io < NUM_OUT_FS; io++) {
+		for (ii = 0; ii < NUM_IN_FS; ii++) {
+			stages[0] = src_table1[io][ii];
+			stages[1] = src_table2[io][ii];
+			for (j = 0; j < 2; j++) {
+				cfg = stages[j];
+				if (cfg->filter_length <= 1 || cfg->blk_out == 0)
+					continue;
+
+				test_src_polyphase_stage(cfg, fmt, j + 1, src_in_fs[ii],
+							 src_out_fs[io]);
+			}
+		}
+	}
+}
+
+static void test_src_polyphase_s16(void **state)
+{
+	(void)state;
+
+	test_src_polyphase_fmt(16);
+}
+
+static void test_src_polyphase_s24(void **state)
+{
+	(void)state;
+
+	test_src_polyphase_fmt(24);
+}
+
+static void test_src_polyphase_s32(void **state)
+{
+	(void)state;
+
+	test_src_polyphase_fmt(32);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_src_polyphase_s16),
+		cmocka_unit_test(test_src_polyphase_s24),
+		cmocka_unit_test(test_src_polyphase_s32),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
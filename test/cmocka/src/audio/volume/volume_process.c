@@ -7,6 +7,7 @@
 #include "../../util.h"
 
 #include <stdarg.h>
+#include <stdio.h>
 #include <stddef.h>
 #include <setjmp.h>
 #include <stdint.h>
@@ -25,6 +26,9 @@
  */
 #define VOL_MINUS_80DB (VOL_ZERO_DB / 10000)
 
+/* Size of the test names with format and volume */
+#define TEST_NAME_SIZE 64
+
 /* Max S24_4LE format value */
 #define INT24_MAX 8388607
 
@@ -74,8 +78,10 @@ static int setup(void **state)
 	/* set processing function and volume */
 #if CONFIG_IPC_MAJOR_4
 	cd->scale_vol = vol_get_processing_function(vol_state->mod->dev, cd);
+	cd->ramp_vol = vol_get_ramp_function(vol_state->mod->dev);
 #else
 	cd->scale_vol = vol_get_processing_function(vol_state->mod->dev, vol_state->sinks[0], cd);
+	cd->ramp_vol = vol_get_ramp_function(vol_state->sinks[0]);
 #endif
 	set_volume(cd->volume, vol_parameters->volume, vol_state->parameters.channels);
 
@@ -295,6 +301,221 @@ static void test_audio_vol(void **state)
 	vol_state->verify(mod, vol_state->sinks[0], vol_state->sources[0]);
 }
 
+/* Square wave with different level in every channel for zero crossings */
+static int32_t ramp_source_value(int frame, int channel)
+{
+	return ((frame / 5) & 1 ? 1 : -1) * (1000 + 100 * channel);
+}
+
+/* First zero crossing of hold_source_value() */
+#define RAMP_HOLD_ZC_FRAME	40
+
+/* Step with the only zero crossing in frame RAMP_HOLD_ZC_FRAME */
+static int32_t hold_source_value(int frame, int channel)
+{
+	return (frame < RAMP_HOLD_ZC_FRAME ? 1 : -1) * (1000 + 100 * channel);
+}
+
+static void fill_source_ramp(struct processing_module_test_data *vol_state,
+			     int32_t (*value)(int frame, int channel))
+{
+	struct audio_stream *source = &vol_state->sources[0]->stream;
+	int16_t *src16 = audio_stream_get_rptr(source);
+	int32_t *src32 = audio_stream_get_rptr(source);
+	int channels = audio_stream_get_channels(source);
+	int i;
+
+	for (i = 0; i < vol_state->mod->dev->frames * channels; i++) {
+		switch (audio_stream_get_frm_fmt(source)) {
+		case SOF_IPC_FRAME_S16_LE:
+			src16[i] = value(i / channels, i % channels) << 3;
+			break;
+		case SOF_IPC_FRAME_S24_4LE:
+			src32[i] = value(i / channels, i % channels) << 8;
+			break;
+		default:
+			src32[i] = value(i / channels, i % channels) << 16;
+			break;
+		}
+	}
+}
+
+/* The ramp output of every frame must match the constant gain output with
+ * the interpolated gain of the frame.
+ */
+static void test_audio_vol_ramp_run(void **state, bool zc)
+{
+	struct processing_module_test_data *vol_state = *state;
+	struct processing_module *mod = vol_state->mod;
+	struct vol_data *cd = module_get_private_data(mod);
+	struct audio_stream *sink = &vol_state->sinks[0]->stream;
+	const int channels = audio_stream_get_channels(sink);
+	const int frames = mod->dev->frames;
+	const int frame_bytes = audio_stream_frame_bytes(sink);
+	int32_t gain[SOF_IPC_MAX_CHANNELS];
+	int32_t delta;
+	int64_t sum;
+	int64_t prev_sum = 0;
+	uint8_t *ref;
+	uint8_t *dst;
+	int frame;
+	int ch;
+
+	if (!cd->ramp_vol)
+		return;
+
+	/* ramp up odd and down even channels by half of the volume */
+	for (ch = 0; ch < channels; ch++) {
+		delta = cd->volume[ch] / 2;
+		cd->ramp_gain[ch] = ch & 1 ? cd->volume[ch] : cd->volume[ch] - delta;
+		cd->ramp_step[ch] = (ch & 1 ? -delta : delta) / frames;
+		cd->zc_gain[ch] = cd->ramp_gain[ch];
+		gain[ch] = cd->ramp_gain[ch];
+	}
+
+	cd->zc_sum = 0;
+	fill_source_ramp(vol_state, ramp_source_value);
+	vol_state->input_buffers[0]->consumed = 0;
+	vol_state->output_buffers[0]->size = 0;
+	cd->ramp_vol(mod, vol_state->input_buffers[0], vol_state->output_buffers[0], frames, zc);
+
+	ref = test_malloc(frames * frame_bytes);
+	dst = audio_stream_get_wptr(sink);
+	memcpy_s(ref, frames * frame_bytes, dst, frames * frame_bytes);
+
+	for (frame = 0; frame < frames; frame++) {
+		sum = 0;
+		for (ch = 0; ch < channels; ch++) {
+			gain[ch] += cd->ramp_step[ch];
+			sum += ramp_source_value(frame, ch);
+		}
+
+		/* with zero crossings the gain is updated when the sum changes sign */
+		if (!zc || (sum ^ prev_sum) < 0) {
+			for (ch = 0; ch < channels; ch++)
+				cd->volume[ch] = gain[ch];
+		}
+
+		prev_sum = sum;
+		cd->copy_gain = true;
+		vol_state->input_buffers[0]->consumed = frame * frame_bytes;
+		vol_state->output_buffers[0]->size = frame * frame_bytes;
+		cd->scale_vol(mod, vol_state->input_buffers[0], vol_state->output_buffers[0], 1,
+			      cd->attenuation);
+		assert_memory_equal(dst + frame * frame_bytes, ref + frame * frame_bytes,
+				    frame_bytes);
+	}
+
+	test_free(ref);
+}
+
+static void test_audio_vol_ramp(void **state)
+{
+	test_audio_vol_ramp_run(state, false);
+}
+
+/* The HiFi versions check zero crossings once per gain buffer period */
+#ifdef VOLUME_GENERIC
+static void test_audio_vol_ramp_zc(void **state)
+{
+	test_audio_vol_ramp_run(state, true);
+}
+#endif
+
+/* The zero crossing ramp keeps the held gain after the ramp end until the
+ * next zero crossing.
+ */
+#ifdef VOLUME_GENERIC
+static void test_audio_vol_ramp_zc_hold(void **state)
+{
+	struct processing_module_test_data *vol_state = *state;
+	struct processing_module *mod = vol_state->mod;
+	struct vol_data *cd = module_get_private_data(mod);
+	struct audio_stream *sink = &vol_state->sinks[0]->stream;
+	const int channels = audio_stream_get_channels(sink);
+	const int frames = mod->dev->frames;
+	const int frame_bytes = audio_stream_frame_bytes(sink);
+	int32_t start[SOF_IPC_MAX_CHANNELS];
+	uint8_t *ref;
+	uint8_t *dst;
+	int frame;
+	int ch;
+
+	if (!cd->ramp_vol)
+		return;
+
+	/* ramp down by half, it ends in the first ramp block */
+	for (ch = 0; ch < channels; ch++) {
+		start[ch] = cd->volume[ch];
+		cd->rvolume[ch] = cd->volume[ch];
+		cd->tvolume[ch] = cd->volume[ch] / 2;
+		cd->ramp_coef[ch] = -cd->volume[ch];
+	}
+
+	cd->channels = channels;
+	cd->ramp_channel_counter = channels;
+	cd->ramp_type = SOF_VOLUME_LINEAR_ZC;
+	cd->ramp_finished = false;
+	cd->vol_ramp_frames = 8;
+	cd->vol_ramp_elapsed_frames = 0;
+	cd->sample_rate_inv = INT32_MAX;
+	cd->zc_hold = false;
+	cd->copy_gain = true;
+
+	fill_source_ramp(vol_state, hold_source_value);
+	vol_state->input_buffers[0]->size = frames;
+	vol_state->input_buffers[0]->consumed = 0;
+	vol_state->output_buffers[0]->size = 0;
+	assert_int_equal(volume_process(mod, vol_state->input_buffers[0], 1,
+					vol_state->output_buffers[0], 1), 0);
+	assert_true(cd->ramp_finished);
+	assert_false(cd->zc_hold);
+
+	ref = test_malloc(frames * frame_bytes);
+	dst = audio_stream_get_wptr(sink);
+	memcpy_s(ref, frames * frame_bytes, dst, frames * frame_bytes);
+
+	for (frame = 0; frame < frames; frame++) {
+		for (ch = 0; ch < channels; ch++)
+			cd->volume[ch] = frame < RAMP_HOLD_ZC_FRAME ? start[ch] : cd->tvolume[ch];
+
+		cd->copy_gain = true;
+		vol_state->input_buffers[0]->consumed = frame * frame_bytes;
+		vol_state->output_buffers[0]->size = frame * frame_bytes;
+		cd->scale_vol(mod, vol_state->input_buffers[0], vol_state->output_buffers[0], 1,
+			      cd->attenuation);
+		assert_memory_equal(dst + frame * frame_bytes, ref + frame * frame_bytes,
+				    frame_bytes);
+	}
+
+	test_free(ref);
+}
+#endif
+
+static const struct {
+	const char *name;
+	CMUnitTestFunction func;
+} test_functions[] = {
+	{ "test_audio_vol", test_audio_vol },
+	{ "test_audio_vol_ramp", test_audio_vol_ramp },
+#ifdef VOLUME_GENERIC
+	{ "test_audio_vol_ramp_zc", test_audio_vol_ramp_zc },
+	{ "test_audio_vol_ramp_zc_hold", test_audio_vol_ramp_zc_hold },
+#endif
+};
+
+static const char *test_format_name(enum sof_ipc_frame frame_fmt)
+{
+	switch (frame_fmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		return "s16";
+	case SOF_IPC_FRAME_S24_4LE:
+		return "s24";
+	default:
+		return "s32";
+	}
+}
+
 static struct processing_module_test_parameters test_parameters[] = {
 #if CONFIG_FORMAT_S16LE
 	{ 2, 48, 1, SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE,   verify_s16_to_s16 },
@@ -326,14 +547,20 @@ int main(void)
 		}
 	}
 
-	struct CMUnitTest tests[num_tests];
+	struct CMUnitTest tests[num_tests * ARRAY_SIZE(test_functions)];
+	char names[ARRAY_SIZE(tests)][TEST_NAME_SIZE];
+
+	for (i = 0; i < ARRAY_SIZE(tests); i++) {
+		struct vol_test_parameters *p = &parameters[i % num_tests];
 
-	for (i = 0; i < num_tests; i++) {
-		tests[i].name = "test_audio_vol";
-		tests[i].test_func = test_audio_vol;
+		snprintf(names[i], TEST_NAME_SIZE, "%s_%s_vol_0x%x",
+			 test_functions[i / num_tests].name,
+			 test_format_name(p->module_parameters.source_format), p->volume);
+		tests[i].name = names[i];
+		tests[i].test_func = test_functions[i / num_tests].func;
 		tests[i].setup_func = setup;
 		tests[i].teardown_func = teardown;
-		tests[i].initial_state = &parameters[i];
+		tests[i].initial_state = p;
 	}
 
 	cmocka_set_message_output(CM_OUTPUT_TAP);
@@ -53,6 +53,16 @@ void WEAK *rballoc_align(uint32_t flags, uint32_t caps, size_t bytes,
 	return calloc(bytes, 1);
 }
 
+void WEAK *rmalloc(enum mem_zone zone, uint32_t flags, uint32_t caps,
+		   size_t bytes)
+{
+	(void)zone;
+	(void)flags;
+	(void)caps;
+
+	return malloc(bytes);
+}
+
 void WEAK *rzalloc(enum mem_zone zone, uint32_t flags, uint32_t caps,
 		   size_t bytes)
 {
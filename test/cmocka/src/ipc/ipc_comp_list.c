@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <sof/audio/buffer.h>
+#include <sof/audio/component.h>
+#include <sof/audio/pipeline.h>
+#include <sof/ipc/common.h>
+#include <sof/ipc/topology.h>
+#include <sof/list.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+/* more buffers and pipelines than buckets, so both indexes have collisions */
+#define TEST_BUFFERS		(2 * IPC_COMP_HASH_SIZE + 1)
+#define TEST_PIPELINES		(IPC_COMP_HASH_SIZE + 1)
+
+/* IPC4 style IDs with the instance in the upper half */
+#define TEST_BUFFER_ID(i)	(((i) << 16) | ((i) & 0x3))
+#define TEST_PIPELINE_ID(i)	(i)
+
+static struct ipc test_ipc;
+static struct ipc_comp_dev test_buf_icd[TEST_BUFFERS];
+static struct ipc_comp_dev test_ppl_icd[TEST_PIPELINES];
+static struct comp_buffer test_buf[TEST_BUFFERS];
+static struct pipeline test_ppl[TEST_PIPELINES];
+
+static int setup(void **state)
+{
+	int i;
+
+	memset(&test_ipc, 0, sizeof(test_ipc));
+	list_init(&test_ipc.comp_list);
+
+	/* each pipeline is added before its buffers */
+	for (i = 0; i < TEST_PIPELINES; i++) {
+		test_ppl[i].pipeline_id = TEST_PIPELINE_ID(i);
+		test_ppl_icd[i].type = COMP_TYPE_PIPELINE;
+		test_ppl_icd[i].id = TEST_PIPELINE_ID(i);
+		test_ppl_icd[i].pipeline = &test_ppl[i];
+		ipc_comp_list_add(&test_ipc, &test_ppl_icd[i]);
+	}
+
+	for (i = 0; i < TEST_BUFFERS; i++) {
+		test_buf[i].pipeline_id = TEST_PIPELINE_ID(i % TEST_PIPELINES);
+		test_buf_icd[i].type = COMP_TYPE_BUFFER;
+		test_buf_icd[i].id = TEST_BUFFER_ID(i);
+		test_buf_icd[i].cb = &test_buf[i];
+		ipc_comp_list_add(&test_ipc, &test_buf_icd[i]);
+	}
+
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	struct list_item *clist, *tmp;
+
+	list_for_item_safe(clist, tmp, &test_ipc.comp_list)
+		ipc_comp_list_del(&test_ipc, container_of(clist, struct ipc_comp_dev, list));
+
+	return 0;
+}
+
+/* checks the pipeline iterator against a walk of comp_list */
+static void test_check_ppl(uint32_t ppl_id)
+{
+	struct ipc_comp_dev *icd = ipc_ppl_comp_first(&test_ipc, ppl_id);
+	struct list_item *clist;
+
+	list_for_item(clist, &test_ipc.comp_list) {
+		if (ipc_comp_pipe_id(container_of(clist, struct ipc_comp_dev, list)) != ppl_id)
+			continue;
+
+		assert_ptr_equal(icd, container_of(clist, struct ipc_comp_dev, list));
+		icd = ipc_ppl_comp_next(icd);
+	}
+
+	assert_null(icd);
+}
+
+static void test_ipc_comp_list_get(void **state)
+{
+	int i;
+
+	(void)state;
+
+	for (i = 0; i < TEST_BUFFERS; i++)
+		assert_ptr_equal(ipc_get_comp_dev(&test_ipc, COMP_TYPE_BUFFER, TEST_BUFFER_ID(i)),
+				 &test_buf_icd[i]);
+
+	/* buffer 0 shares the ID with pipeline 0, see test_ipc_comp_list_get_type() */
+	for (i = 1; i < TEST_BUFFERS; i++)
+		assert_ptr_equal(ipc_get_comp_dev(&test_ipc, COMP_TYPE_ANY, TEST_BUFFER_ID(i)),
+				 &test_buf_icd[i]);
+
+	for (i = 0; i < TEST_PIPELINES; i++)
+		assert_ptr_equal(ipc_get_comp_dev(&test_ipc, COMP_TYPE_PIPELINE,
+						  TEST_PIPELINE_ID(i)), &test_ppl_icd[i]);
+
+	/* not added */
+	assert_null(ipc_get_comp_dev(&test_ipc, COMP_TYPE_ANY, TEST_BUFFER_ID(TEST_BUFFERS)));
+	assert_null(ipc_get_comp_dev(&test_ipc, COMP_TYPE_COMPONENT, TEST_BUFFER_ID(1)));
+}
+
+/* the same ID is used by a pipeline and a buffer */
+static void test_ipc_comp_list_get_type(void **state)
+{
+	(void)state;
+
+	/* TEST_BUFFER_ID(0) == TEST_PIPELINE_ID(0) */
+	assert_ptr_equal(ipc_get_comp_dev(&test_ipc, COMP_TYPE_BUFFER, 0), &test_buf_icd[0]);
+	assert_ptr_equal(ipc_get_comp_dev(&test_ipc, COMP_TYPE_PIPELINE, 0), &test_ppl_icd[0]);
+
+	/* any type returns the first one in comp_list */
+	assert_ptr_equal(ipc_get_comp_dev(&test_ipc, COMP_TYPE_ANY, 0), &test_ppl_icd[0]);
+}
+
+static void test_ipc_comp_list_ppl(void **state)
+{
+	struct ipc_comp_dev *icd;
+	int count = 0;
+	int i;
+
+	(void)state;
+
+	for (i = 0; i < TEST_PIPELINES; i++)
+		test_check_ppl(TEST_PIPELINE_ID(i));
+
+	/* pipeline 0 has buffers 0 and TEST_PIPELINES */
+	for (icd = ipc_ppl_comp_first(&test_ipc, 0); icd; icd = ipc_ppl_comp_next(icd))
+		count++;
+
+	assert_int_equal(count, 3);
+	assert_null(ipc_ppl_comp_first(&test_ipc, TEST_PIPELINE_ID(TEST_PIPELINES)));
+}
+
+static void test_ipc_comp_list_del(void **state)
+{
+	int i;
+
+	(void)state;
+
+	/* from the head, the middle and the tail of the chains */
+	for (i = 0; i < TEST_BUFFERS; i += 3)
+		ipc_comp_list_del(&test_ipc, &test_buf_icd[i]);
+
+	ipc_comp_list_del(&test_ipc, &test_ppl_icd[1]);
+
+	for (i = 0; i < TEST_BUFFERS; i++) {
+		if (i % 3)
+			assert_ptr_equal(ipc_get_comp_dev(&test_ipc, COMP_TYPE_BUFFER,
+							  TEST_BUFFER_ID(i)), &test_buf_icd[i]);
+		else
+			assert_null(ipc_get_comp_dev(&test_ipc, COMP_TYPE_BUFFER,
+						     TEST_BUFFER_ID(i)));
+	}
+
+	assert_null(ipc_get_comp_dev(&test_ipc, COMP_TYPE_PIPELINE, TEST_PIPELINE_ID(1)));
+	assert_ptr_equal(ipc_get_comp_dev(&test_ipc, COMP_TYPE_ANY, 0), &test_ppl_icd[0]);
+
+	for (i = 0; i < TEST_PIPELINES; i++)
+		test_check_ppl(TEST_PIPELINE_ID(i));
+
+	/* removed devices can be added back, at the end of comp_list */
+	ipc_comp_list_add(&test_ipc, &test_buf_icd[0]);
+	assert_ptr_equal(ipc_get_comp_dev(&test_ipc, COMP_TYPE_BUFFER, 0), &test_buf_icd[0]);
+	test_check_ppl(TEST_PIPELINE_ID(0));
+}
+
+static void test_ipc_comp_list_empty(void **state)
+{
+	int i;
+
+	(void)state;
+
+	teardown(state);
+
+	assert_true(list_is_empty(&test_ipc.comp_list));
+	for (i = 0; i < IPC_COMP_HASH_SIZE; i++) {
+		assert_null(test_ipc.comp_hash[i]);
+		assert_null(test_ipc.ppl_hash[i]);
+	}
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_ipc_comp_list_get, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_ipc_comp_list_get_type, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_ipc_comp_list_ppl, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_ipc_comp_list_del, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_ipc_comp_list_empty, setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
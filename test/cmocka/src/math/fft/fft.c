@@ -38,6 +38,7 @@
 #define MIN_SNR_256	132.0
 #define MIN_SNR_512	125.0
 #define MIN_SNR_1024	119.0
+#define MIN_SNR_8192	102.0
 
 /**
  * \brief Doing Fast Fourier Transform (FFT) for mono real input buffers.
@@ -469,6 +470,166 @@ static void test_math_fft_512_2ch(void **state)
 	assert_in_range(r, i - 1, i + 1);
 }
 
+static void test_math_fft_8192(void **state)
+{
+	struct sof_ipc_buffer test_buf_desc = {
+		.size = 8192 * 2 * sizeof(int32_t),
+	};
+	struct comp_buffer *source = buffer_new(&test_buf_desc, false);
+	struct comp_buffer *sink = buffer_new(&test_buf_desc, false);
+	struct icomplex32 *out = (struct icomplex32 *)sink->stream.addr;
+	int32_t *in = (int32_t *)source->stream.addr;
+	int fft_size = 8192;
+	int r;
+	int i;
+	double signal;
+	double noise;
+	double snr;
+
+	(void)state;
+
+	/* create sine wave */
+	get_sine_32(in, SINE_FREQ, SINE_FS, fft_size);
+	audio_stream_set_channels(&source->stream, 1);
+
+	/* do fft transform */
+	fft_real(source, sink, fft_size);
+
+	/* find peak */
+	r = power_peak_index_32(out, fft_size);
+	i = (int)round((SINE_FREQ * fft_size) / SINE_FS);
+	printf("%s: peak at point %d\n", __func__, r);
+
+	/* the peak should be in range i +/-1 */
+	assert_in_range(r, i - 1, i + 1);
+
+	/* the min. SNR should be met */
+	noise = integrate_power_32(out, 0, i - 2);
+	signal = integrate_power_32(out, i - 1, i + 1);
+	noise += integrate_power_32(out, i + 2, fft_size / 2 - 1);
+	snr = 10 * log10(signal / noise);
+	printf("%s: SNR %5.2f dB\n", __func__, snr);
+	assert_int_equal(snr < MIN_SNR_8192, 0);
+}
+
+/**
+ * \brief Run real input FFT for a sine and check the peak and SNR of the spectrum.
+ * \param[in] fft_size - FFT size.
+ * \param[in] min_snr - SNR that the real FFT must meet.
+ */
+static void fft_real_input_sine(int fft_size, double min_snr)
+{
+	struct fft_real_plan *plan;
+	struct icomplex32 *out;
+	int32_t *in;
+	int r;
+	int i;
+	double signal;
+	double noise;
+	double snr;
+
+	in = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, fft_size * sizeof(int32_t));
+	out = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+		      (fft_size / 2 + 1) * sizeof(struct icomplex32));
+	assert_non_null(in);
+	assert_non_null(out);
+
+	plan = fft_plan_new_real(in, out, fft_size);
+	assert_non_null(plan);
+
+	get_sine_32(in, SINE_FREQ, SINE_FS, fft_size);
+	fft_execute_real_32(plan, false);
+
+	/* find peak, the spectrum has bins 0 .. fft_size / 2 */
+	r = power_peak_index_32(out, fft_size);
+	i = (int)round((SINE_FREQ * fft_size) / SINE_FS);
+	printf("%s: size %d, peak at point %d\n", __func__, fft_size, r);
+	assert_in_range(r, i - 1, i + 1);
+
+	noise = integrate_power_32(out, 0, i - 2);
+	signal = integrate_power_32(out, i - 1, i + 1);
+	noise += integrate_power_32(out, i + 2, fft_size / 2);
+	snr = 10 * log10(signal / noise);
+	printf("%s: size %d, SNR %5.2f dB\n", __func__, fft_size, snr);
+	assert_int_equal(snr < min_snr, 0);
+
+	fft_plan_free_real(plan);
+	rfree(out);
+	rfree(in);
+}
+
+static void test_math_fft_real_1024(void **state)
+{
+	(void)state;
+
+	fft_real_input_sine(1024, MIN_SNR_1024);
+}
+
+static void test_math_fft_real_8192(void **state)
+{
+	(void)state;
+
+	fft_real_input_sine(8192, MIN_SNR_8192);
+}
+
+static void test_math_fft_real_1024_ifft(void **state)
+{
+	struct fft_real_plan *plan;
+	struct icomplex32 *spectrum;
+	int32_t *in;
+	int32_t *out;
+	int64_t signal = 0;
+	int64_t noise = 0;
+	int fft_size = 1024;
+	float db;
+	int i;
+
+	(void)state;
+
+	in = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, fft_size * sizeof(int32_t));
+	out = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, fft_size * sizeof(int32_t));
+	spectrum = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			   (fft_size / 2 + 1) * sizeof(struct icomplex32));
+	assert_non_null(in);
+	assert_non_null(out);
+	assert_non_null(spectrum);
+
+	get_sine_32(in, SINE_FREQ, SINE_FS, fft_size);
+
+	/* The same spectrum buffer is shared by the forward and inverse plans */
+	plan = fft_plan_new_real(in, spectrum, fft_size);
+	assert_non_null(plan);
+	fft_execute_real_32(plan, false);
+	fft_plan_free_real(plan);
+
+	plan = fft_plan_new_real(out, spectrum, fft_size);
+	assert_non_null(plan);
+	fft_execute_real_32(plan, true);
+	fft_plan_free_real(plan);
+
+	/* The FFT is scaled by 1 / size, so the IFFT output matches the input */
+	for (i = 0; i < fft_size; i++) {
+		signal += (int64_t)(in[i] / 32) * (in[i] / 32);
+		noise += (int64_t)((out[i] - in[i]) / 32) * ((out[i] - in[i]) / 32);
+	}
+
+	db = 10 * log10((float)signal / noise);
+	printf("%s: SNR: %6.2f dB\n", __func__, db);
+	assert_int_equal(db < FFT_DB_TH, 0);
+}
+
+static void test_math_fft_real_invalid(void **state)
+{
+	struct icomplex32 spectrum[2];
+	int32_t real[2];
+
+	(void)state;
+
+	assert_null(fft_plan_new_real(real, spectrum, 1000));
+	assert_null(fft_plan_new_real(real, spectrum, 2 * FFT_SIZE_MAX));
+	assert_null(fft_plan_new_real(NULL, spectrum, 2));
+}
+
 /**
  * \brief Doing Fast Fourier Transform (FFT) for mono real input buffers.
  * \param[in] src - pointer to input buffer.
@@ -798,6 +959,11 @@ int main(void)
 		cmocka_unit_test(test_math_fft_1024),
 		cmocka_unit_test(test_math_fft_1024_ifft),
 		cmocka_unit_test(test_math_fft_512_2ch),
+		cmocka_unit_test(test_math_fft_8192),
+		cmocka_unit_test(test_math_fft_real_1024),
+		cmocka_unit_test(test_math_fft_real_8192),
+		cmocka_unit_test(test_math_fft_real_1024_ifft),
+		cmocka_unit_test(test_math_fft_real_invalid),
 	};
 
 	cmocka_set_message_output(CM_OUTPUT_TAP);
@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <time.h>
+#include <math.h>
+#include <cmocka.h>
+#include <stdbool.h>
+
+#include <sof/audio/format.h>
+#include <sof/math/fft.h>
+#include <rtos/alloc.h>
+
+#include "fft_twiddle.h"
+
+/* Minimum SNR of the optimized versions vs. the radix-2 reference */
+#define FFT_BENCH_MIN_SNR	90.0
+#define FFT_BENCH_MIN_SIZE	256
+#define FFT_BENCH_SAMPLES	(1 << 21) /* Samples to transform per size */
+
+static uint32_t rand_state;
+
+static int32_t test_rand(void)
+{
+	rand_state = rand_state * 1664525 + 1013904223;
+	return (int32_t)rand_state;
+}
+
+/*
+ * Reference radix-2 decimation in time FFT, the version before radix-4
+ * stages. The output is scaled by 1 / size.
+ */
+static void fft_reference_32(struct fft_plan *plan)
+{
+	struct icomplex32 *outb = plan->outb32;
+	struct icomplex32 w;
+	struct icomplex32 b;
+	struct icomplex32 a;
+	int depth;
+	int i;
+	int j;
+	int k;
+	int m;
+	int n;
+
+	for (i = 0; i < plan->size; i++) {
+		outb[plan->bit_reverse_idx[i]].real = plan->inb32[i].real >> plan->len;
+		outb[plan->bit_reverse_idx[i]].imag = plan->inb32[i].imag >> plan->len;
+	}
+
+	for (depth = 1; depth <= plan->len; depth++) {
+		m = 1 << depth;
+		n = m >> 1;
+		for (k = 0; k < plan->size; k += m) {
+			for (j = 0; j < n; j++) {
+				fft_twiddle_32(j * (FFT_SIZE_MAX >> depth), &w);
+				a = outb[k + j];
+				b.real = ((int64_t)w.real * outb[k + j + n].real -
+					  (int64_t)w.imag * outb[k + j + n].imag) >> 31;
+				b.imag = ((int64_t)w.real * outb[k + j + n].imag +
+					  (int64_t)w.imag * outb[k + j + n].real) >> 31;
+				outb[k + j].real = a.real + b.real;
+				outb[k + j].imag = a.imag + b.imag;
+				outb[k + j + n].real = a.real - b.real;
+				outb[k + j + n].imag = a.imag - b.imag;
+			}
+		}
+	}
+}
+
+static double compare_snr(struct icomplex32 *ref, struct icomplex32 *out, int bins)
+{
+	double signal = 0;
+	double noise = 0;
+	double er;
+	double ei;
+	int i;
+
+	for (i = 0; i < bins; i++) {
+		er = (double)out[i].real - ref[i].real;
+		ei = (double)out[i].imag - ref[i].imag;
+		signal += (double)ref[i].real * ref[i].real + (double)ref[i].imag * ref[i].imag;
+		noise += er * er + ei * ei;
+	}
+
+	if (noise == 0)
+		return INFINITY;
+
+	return 10 * log10(signal / noise);
+}
+
+static double time_us(clock_t start, int count)
+{
+	return 1e6 * (double)(clock() - start) / CLOCKS_PER_SEC / count;
+}
+
+static void fft_bench(int size)
+{
+	struct fft_real_plan *real_plan;
+	struct icomplex32 *ref;
+	struct icomplex32 *inb;
+	struct icomplex32 *outb;
+	struct icomplex32 *spectrum;
+	struct fft_plan *plan;
+	int32_t *real;
+	int count = FFT_BENCH_SAMPLES / size;
+	double t_ref;
+	double t_complex;
+	double t_real;
+	double snr_complex;
+	double snr_real;
+	clock_t start;
+	int i;
+
+	ref = malloc(size * sizeof(struct icomplex32));
+	inb = malloc(size * sizeof(struct icomplex32));
+	outb = malloc(size * sizeof(struct icomplex32));
+	spectrum = malloc((size / 2 + 1) * sizeof(struct icomplex32));
+	real = malloc(size * sizeof(int32_t));
+	assert_non_null(ref);
+	assert_non_null(inb);
+	assert_non_null(outb);
+	assert_non_null(spectrum);
+	assert_non_null(real);
+
+	plan = fft_plan_new(inb, outb, size, 32);
+	real_plan = fft_plan_new_real(real, spectrum, size);
+	assert_non_null(plan);
+	assert_non_null(real_plan);
+
+	/* White noise at -6 dBFS */
+	rand_state = size;
+	for (i = 0; i < size; i++) {
+		real[i] = test_rand() / 2;
+		inb[i].real = real[i];
+		inb[i].imag = 0;
+	}
+
+	start = clock();
+	for (i = 0; i < count; i++)
+		fft_reference_32(plan);
+
+	t_ref = time_us(start, count);
+	for (i = 0; i < size; i++)
+		ref[i] = outb[i];
+
+	start = clock();
+	for (i = 0; i < count; i++)
+		fft_execute_32(plan, false);
+
+	t_complex = time_us(start, count);
+	snr_complex = compare_snr(ref, outb, size);
+
+	start = clock();
+	for (i = 0; i < count; i++)
+		fft_execute_real_32(real_plan, false);
+
+	t_real = time_us(start, count);
+	snr_real = compare_snr(ref, spectrum, size / 2 + 1);
+
+	printf("%s: size %4d, radix-2 %8.2f us, complex %8.2f us, real %8.2f us\n",
+	       __func__, size, t_ref, t_complex, t_real);
+	printf("%s: size %4d, complex SNR %6.2f dB, real SNR %6.2f dB\n",
+	       __func__, size, snr_complex, snr_real);
+	assert_true(snr_complex > FFT_BENCH_MIN_SNR);
+	assert_true(snr_real > FFT_BENCH_MIN_SNR);
+
+	fft_plan_free_real(real_plan);
+	fft_plan_free(plan);
+	free(real);
+	free(spectrum);
+	free(outb);
+	free(inb);
+	free(ref);
+}
+
+static void test_math_fft_bench(void **state)
+{
+	int size;
+
+	(void)state;
+
+	for (size = FFT_BENCH_MIN_SIZE; size <= FFT_SIZE_MAX; size <<= 1)
+		fft_bench(size);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_math_fft_bench),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,314 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <errno.h>
+#include <string.h>
+
+#include <sof/audio/format.h>
+#include <sof/common.h>
+#include <sof/math/iir_block.h>
+#include <sof/math/numbers.h>
+#include <user/eq.h>
+
+#define TEST_CHANNELS_MAX	8
+#define TEST_BIQUADS_MAX	4
+#define TEST_FRAMES		101
+
+/* The block filter is run with varying number of frames per call */
+static const int test_chunks[] = {1, 16, 7, 33, 44};
+
+/* Coefficients {a2, a1, b2, b1, b0, shift, gain}, the a1 and a2 are negated */
+static const int32_t test_coef[TEST_BIQUADS_MAX][SOF_EQ_IIR_NBIQUAD] = {
+	{ -268435456, 536870912, 107374182, 214748365, 322122547, 0, 16384 },
+	{ -107374182, -322122547, 214748365, -429496730, 536870912, 1, 20000 },
+	{ -53687091, 429496730, 322122547, 644245094, 322122547, 0, 12000 },
+	{ -429496730, -214748365, -107374182, 107374182, 858993459, 2, 30000 },
+};
+
+static int32_t test_delay_df1[TEST_CHANNELS_MAX][TEST_BIQUADS_MAX * IIR_DF1_NUM_STATE];
+static int64_t test_delay_df2t[TEST_CHANNELS_MAX][TEST_BIQUADS_MAX * IIR_DF2T_NUM_DELAYS];
+static int32_t test_in[TEST_FRAMES * TEST_CHANNELS_MAX];
+static int32_t test_out[TEST_FRAMES * TEST_CHANNELS_MAX];
+
+static void test_input(int channels)
+{
+	uint32_t seed = 12345;
+	int i;
+
+	/* Full scale noise to exercise the saturations */
+	for (i = 0; i < TEST_FRAMES * channels; i++) {
+		seed = seed * 1664525 + 1013904223;
+		test_in[i] = (int32_t)seed;
+	}
+}
+
+/* Series cascades with in_series zero, else parallel cascades of in_series */
+static void test_run_df1(int channels, const int biquads[], int in_series, bool in_place)
+{
+	struct iir_state_df1 filters[TEST_CHANNELS_MAX];
+	struct iir_block_df1 block;
+	const int32_t *x = test_in;
+	int32_t *y = in_place ? test_in : test_out;
+	int32_t ref[TEST_FRAMES * TEST_CHANNELS_MAX];
+	int frames = TEST_FRAMES;
+	int n;
+	int i;
+	int ch;
+
+	memset(test_delay_df1, 0, sizeof(test_delay_df1));
+	for (ch = 0; ch < channels; ch++) {
+		filters[ch].biquads = biquads[ch];
+		filters[ch].biquads_in_series = in_series ? in_series : biquads[ch];
+		filters[ch].coef = (int32_t *)test_coef;
+		filters[ch].delay = test_delay_df1[ch];
+	}
+
+	test_input(channels);
+	assert_int_equal(iir_block_init_df1(&block, filters, channels), 0);
+
+	/* Reference with the per channel filters */
+	for (i = 0; i < TEST_FRAMES * channels; i++)
+		ref[i] = iir_df1(&filters[i % channels], test_in[i]);
+
+	for (i = 0; frames; i++) {
+		n = MIN(frames, test_chunks[i % ARRAY_SIZE(test_chunks)]);
+		iir_block_df1(&block, x, y, n);
+		x += n * channels;
+		y += n * channels;
+		frames -= n;
+	}
+
+	y = in_place ? test_in : test_out;
+	for (i = 0; i < TEST_FRAMES * channels; i++)
+		assert_int_equal(y[i], ref[i]);
+
+	iir_block_free_df1(&block);
+}
+
+static void test_run_df2t(int channels, const int biquads[], int in_series, bool in_place)
+{
+	struct iir_state_df2t filters[TEST_CHANNELS_MAX];
+	struct iir_block_df2t block;
+	const int32_t *x = test_in;
+	int32_t *y = in_place ? test_in : test_out;
+	int32_t ref[TEST_FRAMES * TEST_CHANNELS_MAX];
+	int frames = TEST_FRAMES;
+	int n;
+	int i;
+	int ch;
+
+	memset(test_delay_df2t, 0, sizeof(test_delay_df2t));
+	for (ch = 0; ch < channels; ch++) {
+		filters[ch].biquads = biquads[ch];
+		filters[ch].biquads_in_series = in_series ? in_series : biquads[ch];
+		filters[ch].coef = (int32_t *)test_coef;
+		filters[ch].delay = test_delay_df2t[ch];
+	}
+
+	test_input(channels);
+	assert_int_equal(iir_block_init_df2t(&block, filters, channels), 0);
+
+	for (i = 0; i < TEST_FRAMES * channels; i++)
+		ref[i] = iir_df2t(&filters[i % channels], test_in[i]);
+
+	for (i = 0; frames; i++) {
+		n = MIN(frames, test_chunks[i % ARRAY_SIZE(test_chunks)]);
+		iir_block_df2t(&block, x, y, n);
+		x += n * channels;
+		y += n * channels;
+		frames -= n;
+	}
+
+	y = in_place ? test_in : test_out;
+	for (i = 0; i < TEST_FRAMES * channels; i++)
+		assert_int_equal(y[i], ref[i]);
+
+	iir_block_free_df2t(&block);
+}
+
+static void test_math_iir_block_df1_series(void **state)
+{
+	const int biquads[TEST_CHANNELS_MAX] = {4, 4, 4, 4, 4, 4, 4, 4};
+	int channels;
+
+	(void)state;
+
+	for (channels = 1; channels <= TEST_CHANNELS_MAX; channels++) {
+		test_run_df1(channels, biquads, 4, false);
+		test_run_df1(channels, biquads, 4, true);
+	}
+}
+
+static void test_math_iir_block_df1_parallel(void **state)
+{
+	const int biquads[TEST_CHANNELS_MAX] = {4, 4, 4, 4, 4, 4, 4, 4};
+	int channels;
+
+	(void)state;
+
+	for (channels = 1; channels <= TEST_CHANNELS_MAX; channels++) {
+		test_run_df1(channels, biquads, 2, false);
+		test_run_df1(channels, biquads, 1, true);
+	}
+}
+
+static void test_math_iir_block_df1_padding(void **state)
+{
+	const int series[TEST_CHANNELS_MAX] = {0, 1, 4, 2, 0, 3, 4, 1};
+	const int parallel[TEST_CHANNELS_MAX] = {4, 0, 4, 4, 0, 4, 4, 0};
+
+	(void)state;
+
+	test_run_df1(5, series, 0, false);
+	test_run_df1(8, series, 0, true);
+	test_run_df1(7, parallel, 2, false);
+	test_run_df1(8, parallel, 2, true);
+}
+
+static void test_math_iir_block_df2t_series(void **state)
+{
+	const int biquads[TEST_CHANNELS_MAX] = {4, 4, 4, 4, 4, 4, 4, 4};
+	int channels;
+
+	(void)state;
+
+	for (channels = 1; channels <= TEST_CHANNELS_MAX; channels++) {
+		test_run_df2t(channels, biquads, 4, false);
+		test_run_df2t(channels, biquads, 4, true);
+	}
+}
+
+static void test_math_iir_block_df2t_parallel(void **state)
+{
+	const int biquads[TEST_CHANNELS_MAX] = {4, 4, 4, 4, 4, 4, 4, 4};
+	int channels;
+
+	(void)state;
+
+	for (channels = 1; channels <= TEST_CHANNELS_MAX; channels++) {
+		test_run_df2t(channels, biquads, 2, false);
+		test_run_df2t(channels, biquads, 1, true);
+	}
+}
+
+static void test_math_iir_block_df2t_padding(void **state)
+{
+	const int series[TEST_CHANNELS_MAX] = {0, 1, 4, 2, 0, 3, 4, 1};
+	const int parallel[TEST_CHANNELS_MAX] = {4, 0, 4, 4, 0, 4, 4, 0};
+
+	(void)state;
+
+	test_run_df2t(5, series, 0, false);
+	test_run_df2t(8, series, 0, true);
+	test_run_df2t(7, parallel, 2, false);
+	test_run_df2t(8, parallel, 2, true);
+}
+
+/* The bypass channels and the channels with a shorter series cascade are
+ * padded with pass-through biquads that must keep the input bit exact.
+ */
+static void test_bypass(int channels, const int biquads[], int in_series, bool df2t)
+{
+	struct iir_state_df1 filters_df1[TEST_CHANNELS_MAX];
+	struct iir_state_df2t filters_df2t[TEST_CHANNELS_MAX];
+	struct iir_block_df1 block_df1;
+	struct iir_block_df2t block_df2t;
+	int i;
+	int ch;
+
+	for (ch = 0; ch < channels; ch++) {
+		filters_df1[ch].biquads = biquads[ch];
+		filters_df1[ch].biquads_in_series = in_series ? in_series : biquads[ch];
+		filters_df1[ch].coef = (int32_t *)test_coef;
+		filters_df1[ch].delay = NULL;
+		filters_df2t[ch].biquads = biquads[ch];
+		filters_df2t[ch].biquads_in_series = in_series ? in_series : biquads[ch];
+		filters_df2t[ch].coef = (int32_t *)test_coef;
+		filters_df2t[ch].delay = NULL;
+	}
+
+	test_input(channels);
+	if (df2t) {
+		assert_int_equal(iir_block_init_df2t(&block_df2t, filters_df2t, channels), 0);
+		iir_block_df2t(&block_df2t, test_in, test_out, TEST_FRAMES);
+		iir_block_free_df2t(&block_df2t);
+	} else {
+		assert_int_equal(iir_block_init_df1(&block_df1, filters_df1, channels), 0);
+		iir_block_df1(&block_df1, test_in, test_out, TEST_FRAMES);
+		iir_block_free_df1(&block_df1);
+	}
+
+	for (i = 0; i < TEST_FRAMES * channels; i++)
+		if (!biquads[i % channels])
+			assert_int_equal(test_out[i], test_in[i]);
+}
+
+static void test_math_iir_block_bypass(void **state)
+{
+	const int series[TEST_CHANNELS_MAX] = {4, 0, 0, 1, 0, 2, 0, 3};
+	const int parallel[TEST_CHANNELS_MAX] = {0, 4, 0, 0, 4, 0, 4, 0};
+	const int single[TEST_CHANNELS_MAX] = {1, 0, 0, 0, 0, 0, 0, 0};
+	int channels;
+
+	(void)state;
+
+	for (channels = 2; channels <= TEST_CHANNELS_MAX; channels++) {
+		test_bypass(channels, series, 0, false);
+		test_bypass(channels, series, 0, true);
+		test_bypass(channels, parallel, 1, false);
+		test_bypass(channels, parallel, 2, true);
+		test_bypass(channels, single, 0, false);
+		test_bypass(channels, single, 0, true);
+	}
+}
+
+static void test_math_iir_block_invalid(void **state)
+{
+	struct iir_state_df1 filters_df1[2];
+	struct iir_state_df2t filters_df2t[2];
+	struct iir_block_df1 block_df1;
+	struct iir_block_df2t block_df2t;
+
+	(void)state;
+
+	/* Parallel cascades of different shape can't be run as a block */
+	filters_df1[0].biquads = 4;
+	filters_df1[0].biquads_in_series = 2;
+	filters_df1[1].biquads = 4;
+	filters_df1[1].biquads_in_series = 4;
+	assert_int_equal(iir_block_init_df1(&block_df1, filters_df1, 2), -EINVAL);
+	assert_int_equal(block_df1.biquads, 0);
+
+	filters_df2t[0].biquads = 2;
+	filters_df2t[0].biquads_in_series = 1;
+	filters_df2t[1].biquads = 4;
+	filters_df2t[1].biquads_in_series = 2;
+	assert_int_equal(iir_block_init_df2t(&block_df2t, filters_df2t, 2), -EINVAL);
+	assert_int_equal(block_df2t.biquads, 0);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_math_iir_block_df1_series),
+		cmocka_unit_test(test_math_iir_block_df1_parallel),
+		cmocka_unit_test(test_math_iir_block_df1_padding),
+		cmocka_unit_test(test_math_iir_block_df2t_series),
+		cmocka_unit_test(test_math_iir_block_df2t_parallel),
+		cmocka_unit_test(test_math_iir_block_df2t_padding),
+		cmocka_unit_test(test_math_iir_block_bypass),
+		cmocka_unit_test(test_math_iir_block_invalid),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
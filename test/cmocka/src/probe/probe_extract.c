@@ -0,0 +1,337 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <sof/audio/buffer.h>
+#include <sof/audio/component.h>
+#include <sof/ipc/topology.h>
+#include <sof/lib/dma.h>
+#include <sof/probe/probe.h>
+#include <sof/schedule/ll_schedule.h>
+#include <ipc/probe_dma_frame.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+#define TEST_BUFFER_ID		7
+#define TEST_BUFFER_SIZE	384
+#define TEST_STREAM_TAG		1
+#define TEST_HOST_SIZE		4096
+
+/* data copied by the probe DMA to host */
+static uint8_t test_host[TEST_HOST_SIZE];
+static uint32_t test_host_bytes;
+static uint32_t test_host_read;
+
+/* probe task and the buffer the probe point is attached to */
+static struct task *test_task;
+static struct comp_buffer *test_buf;
+static struct ipc_comp_dev test_icd;
+
+/* no scheduler, the test runs the probe task */
+static struct schedulers test_schedulers;
+static struct schedulers *test_schedulers_ptr = &test_schedulers;
+
+static uint8_t test_pattern;
+
+static int test_dma_get_attribute(struct dma *dma, uint32_t type, uint32_t *value)
+{
+	*value = 4;
+	return 0;
+}
+
+static int test_dma_set_config(struct dma_chan_data *channel, struct dma_sg_config *config)
+{
+	return 0;
+}
+
+static int test_dma_start(struct dma_chan_data *channel)
+{
+	return 0;
+}
+
+static void test_dma_channel_put(struct dma_chan_data *channel)
+{
+}
+
+static const struct dma_ops test_dma_ops = {
+	.channel_put	= test_dma_channel_put,
+	.start		= test_dma_start,
+	.stop		= test_dma_start,
+	.set_config	= test_dma_set_config,
+	.get_attribute	= test_dma_get_attribute,
+};
+
+static struct dma_chan_data test_dma_chan;
+static struct dma test_dma = {
+	.ops = &test_dma_ops,
+	.chan = &test_dma_chan,
+};
+
+struct dma *dma_get(uint32_t dir, uint32_t caps, uint32_t dev, uint32_t flags)
+{
+	test_dma_chan.dma = &test_dma;
+	return &test_dma;
+}
+
+void dma_put(struct dma *dma)
+{
+}
+
+int dma_copy_set_stream_tag(struct dma_copy *dc, uint32_t stream_tag)
+{
+	dc->chan = &test_dma_chan;
+	return 0;
+}
+
+int dma_sg_alloc(struct dma_sg_elem_array *ea, enum mem_zone zone, uint32_t direction,
+		 uint32_t buffer_count, uint32_t buffer_bytes,
+		 uintptr_t dma_buffer_addr, uintptr_t external_addr)
+{
+	return 0;
+}
+
+void dma_sg_free(struct dma_sg_elem_array *ea)
+{
+}
+
+int dma_copy_to_host_nowait(struct dma_copy *dc, struct dma_sg_config *host_sg,
+			    int32_t host_offset, void *local_ptr, int32_t size)
+{
+	assert_true(test_host_bytes + size <= TEST_HOST_SIZE);
+	memcpy_s(test_host + test_host_bytes, TEST_HOST_SIZE - test_host_bytes,
+		 local_ptr, size);
+	test_host_bytes += size;
+
+	return 0;
+}
+
+struct schedulers **arch_schedulers_get(void)
+{
+	return &test_schedulers_ptr;
+}
+
+int schedule_task_init_ll(struct task *task,
+			  const struct sof_uuid_entry *uid, uint16_t type,
+			  uint16_t priority, enum task_state (*run)(void *data),
+			  void *data, uint16_t core, uint32_t flags)
+{
+	task->ops.run = run;
+	task->data = data;
+	task->core = core;
+	test_task = task;
+
+	return 0;
+}
+
+struct ipc_comp_dev *ipc_get_comp_dev(struct ipc *ipc, uint16_t type, uint32_t id)
+{
+	return id == TEST_BUFFER_ID ? &test_icd : NULL;
+}
+
+/* Writes a transaction to the buffer and produces it */
+static void test_produce(uint32_t bytes, bool hook)
+{
+	uint8_t *ptr = audio_stream_get_wptr(&test_buf->stream);
+	uint32_t i;
+
+	for (i = 0; i < bytes; i++) {
+		ptr = audio_stream_wrap(&test_buf->stream, ptr);
+		*ptr++ = test_pattern++;
+	}
+
+	if (hook)
+		comp_update_buffer_produce(test_buf, bytes);
+	else
+		audio_stream_produce(&test_buf->stream, bytes);
+}
+
+static void test_run_task(void)
+{
+	/* the DMA transfer is split at the end of the probe buffer */
+	test_task->ops.run(test_task->data);
+	test_task->ops.run(test_task->data);
+}
+
+/* Checks the next packet sent to host, returns the first data byte */
+static uint8_t test_packet(uint32_t bytes)
+{
+	struct probe_data_packet *packet;
+	uint64_t checksum;
+
+	assert_true(test_host_bytes - test_host_read >= sizeof(*packet) + bytes +
+		    sizeof(checksum));
+
+	packet = (struct probe_data_packet *)(test_host + test_host_read);
+	assert_int_equal(packet->sync_word, PROBE_EXTRACT_SYNC_WORD);
+	assert_int_equal(packet->buffer_id, TEST_BUFFER_ID);
+	assert_int_equal(packet->data_size_bytes, bytes);
+
+	test_host_read += sizeof(*packet) + bytes + sizeof(checksum);
+
+	return packet->data[0];
+}
+
+static void test_check_data(uint8_t first, uint32_t bytes)
+{
+	const uint8_t *data = test_host + test_host_read - bytes - sizeof(uint64_t);
+	uint32_t i;
+
+	for (i = 0; i < bytes; i++)
+		assert_int_equal(data[i], (uint8_t)(first + i));
+}
+
+static const struct probe_point test_point = {
+	.buffer_id = { .full_id = TEST_BUFFER_ID },
+	.purpose = PROBE_PURPOSE_EXTRACTION,
+	.stream_tag = TEST_STREAM_TAG,
+};
+
+static int setup(void **state)
+{
+	struct probe_dma dma = {
+		.stream_tag = TEST_STREAM_TAG,
+		.dma_buffer_size = TEST_HOST_SIZE,
+	};
+
+	test_host_bytes = 0;
+	test_host_read = 0;
+	test_pattern = 0;
+	list_init(&test_schedulers.list);
+
+	test_buf = buffer_alloc(TEST_BUFFER_SIZE, SOF_MEM_CAPS_RAM, 0, PLATFORM_DCACHE_ALIGN,
+				false);
+	if (!test_buf)
+		return -ENOMEM;
+
+	audio_stream_set_frm_fmt(&test_buf->stream, SOF_IPC_FRAME_S16_LE);
+	audio_stream_set_rate(&test_buf->stream, 48000);
+	audio_stream_set_channels(&test_buf->stream, 2);
+
+	test_icd.type = COMP_TYPE_BUFFER;
+	test_icd.cb = test_buf;
+
+	if (probe_init(&dma) < 0)
+		return -EINVAL;
+
+	return probe_point_add(1, &test_point);
+}
+
+static int teardown(void **state)
+{
+	uint32_t buffer_id = TEST_BUFFER_ID;
+
+	probe_point_remove(1, &buffer_id);
+	buffer_free(test_buf);
+
+	return probe_deinit();
+}
+
+/* transactions queued in one task period are sent as one packet */
+static void test_probe_extract_batch(void **state)
+{
+	(void)state;
+
+	test_produce(64, true);
+	test_produce(64, true);
+	assert_int_equal(test_host_bytes, 0);
+
+	test_run_task();
+	assert_int_equal(test_packet(128), 0);
+	test_check_data(0, 128);
+	assert_int_equal(test_host_read, test_host_bytes);
+}
+
+/* a wrapping transaction is sent in order */
+static void test_probe_extract_wrap(void **state)
+{
+	(void)state;
+
+	test_produce(320, true);
+	comp_update_buffer_consume(test_buf, 320);
+	test_run_task();
+	test_packet(320);
+
+	test_produce(40, true);
+	test_produce(40, true);
+	test_run_task();
+	assert_int_equal(test_packet(80), 64);
+	test_check_data(64, 80);
+	assert_int_equal(test_host_read, test_host_bytes);
+}
+
+/* queued data released by the consumer is copied before it can be overwritten */
+static void test_probe_extract_eager(void **state)
+{
+	(void)state;
+
+	test_produce(64, true);
+	comp_update_buffer_consume(test_buf, 64);
+
+	/* the producer may next overwrite the first two transactions */
+	test_produce(64, true);
+	test_produce(256, true);
+	test_run_task();
+	assert_int_equal(test_packet(128), 0);
+	test_check_data(0, 128);
+	assert_int_equal(test_packet(256), 128);
+	test_check_data(128, 256);
+	assert_int_equal(test_host_read, test_host_bytes);
+}
+
+/* overwritten queued data is dropped, not sent */
+static void test_probe_extract_overwritten(void **state)
+{
+	(void)state;
+
+	/* written without the hook after it was queued */
+	test_produce(64, true);
+	test_produce(32, false);
+	test_run_task();
+	assert_int_equal(test_host_bytes, 0);
+
+	/* overwritten by a transaction after the consumer released it */
+	test_produce(64, true);
+	comp_update_buffer_consume(test_buf, 160);
+	test_produce(TEST_BUFFER_SIZE, true);
+	test_run_task();
+	assert_int_equal(test_packet(TEST_BUFFER_SIZE), 160);
+	test_check_data(160, TEST_BUFFER_SIZE);
+	assert_int_equal(test_host_read, test_host_bytes);
+}
+
+/* a buffer produced on another core than the probe task can't be probed */
+static void test_probe_extract_core(void **state)
+{
+	uint32_t buffer_id = TEST_BUFFER_ID;
+
+	(void)state;
+
+	assert_int_equal(probe_point_remove(1, &buffer_id), 0);
+
+	test_buf->core = test_task->core + 1;
+	assert_int_equal(probe_point_add(1, &test_point), -EINVAL);
+
+	test_buf->core = test_task->core;
+	assert_int_equal(probe_point_add(1, &test_point), 0);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_probe_extract_batch, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_probe_extract_wrap, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_probe_extract_eager, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_probe_extract_overwritten, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_probe_extract_core, setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
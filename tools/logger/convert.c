@@ -14,6 +14,9 @@
 #include <errno.h>
 #include <unistd.h>
 #include <math.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <sys/mman.h>
 #include <sof/lib/uuid.h>
 #include <time.h>
 #include <user/abi_dbg.h>
@@ -28,6 +31,7 @@
 #define TRACE_MAX_TEXT_LEN		1024
 #define TRACE_MAX_FILENAME_LEN		128
 #define TRACE_MAX_IDS_STR		10
+#define TRACE_MAX_PARAM_STR_LEN		128
 #define TRACE_IDS_MASK			((1 << TRACE_ID_LENGTH) - 1)
 #define INVALID_TRACE_ID		(-1 & TRACE_IDS_MASK)
 
@@ -43,51 +47,113 @@ struct ldc_entry_header {
 	uint32_t text_len;
 };
 
-/** Dictionary entry + unformatted parameters */
+/** Conversion applied to a parameter of a dictionary entry */
+enum ldc_param_type {
+	LDC_PARAM_RAW = 0,	/* passed to fprintf() without modification */
+	LDC_PARAM_STRING,	/* %s, strings can't be printed */
+	LDC_PARAM_UUID,		/* %pUx, uuid entry address */
+	LDC_PARAM_ENTRY,	/* %pQ, log entry address */
+};
+
+struct ldc_param_fmt {
+	enum ldc_param_type type;
+	bool be;		/* %pUb and %pUB */
+	bool upper;		/* %pUB and %pUL */
+};
+
+/** Dictionary entry parsed once from the memory mapped dictionary. The
+ * text has %pUx and %pQ conversions already replaced with %s.
+ */
 struct ldc_entry {
 	struct ldc_entry_header header;
-	char *file_name;
-	char *text;
-	uint32_t *params;
+	const char *file_name;	/* as shown in the location column */
+	const char *raw_text;	/* text as in the dictionary, for %pQ */
+	const char *text;
+	unsigned int fmt_params;	/* conversion specifiers found in text */
+	bool fmt_invalid;		/* text ends with a single % */
+	struct ldc_param_fmt param[TRACE_MAX_PARAMS_COUNT];
 };
 
-/** Dictionary entry + formatted parameters */
+/** Formatted parameters of one log statement */
 struct proc_ldc_entry {
-	int subst_mask;
-	struct ldc_entry_header header;
-	char *file_name;
-	char *text;
 	uintptr_t params[TRACE_MAX_PARAMS_COUNT];
+	char str[TRACE_MAX_PARAMS_COUNT][TRACE_MAX_PARAM_STR_LEN];
+};
+
+/** Log statement read from the input with everything that depends on
+ * the previous statements resolved, so records can be formatted in any
+ * order and by any thread.
+ */
+struct log_record {
+	struct log_entry_header dma_log;
+	const struct ldc_entry *entry;	/* NULL for a note only */
+	uint32_t params[TRACE_MAX_PARAMS_COUNT];
+	const struct ldc_entry *refs[TRACE_MAX_PARAMS_COUNT];	/* %pQ entries */
+	double timestamp;	/* us from the timestamp origin */
+	float dt;		/* us from the previous statement */
+	bool wrapped;		/* negative delta from the previous statement */
+	double wrap_delta;
+	char *note;		/* printed before the statement, allocated */
 };
 
+/** Open addressing hash index from log entry address to parsed entry */
+struct ldc_index_slot {
+	uint32_t address;
+	struct ldc_entry *entry;
+};
+
+struct ldc_index {
+	const uint8_t *map;	/* memory mapped ldc file */
+	size_t map_size;
+	struct ldc_index_slot *slots;
+	uint32_t mask;		/* number of slots - 1 */
+	uint32_t count;
+};
+
+static struct ldc_index ldc_index;
+
 #define BAD_PTR_STR "<bad uid ptr 0x%.8x>"
 #define UUID_LOWER "%s%s%s<%08x-%04x-%04x-%02x%02x-%02x%02x%02x%02x%02x%02x>%s%s%s"
 #define UUID_UPPER "%s%s%s<%08X-%04X-%04X-%02X%02X-%02X%02X%02X%02X%02X%02X>%s%s%s"
 
 static const char *missing = "<missing>";
 
-static int read_entry_from_ldc_file(struct ldc_entry *entry, uint32_t log_entry_address);
+static const struct ldc_entry *ldc_index_get(uint32_t address);
 
-char *format_uid_raw(const struct sof_uuid_entry *uid_entry, int use_colors, int name_first,
-		     bool be, bool upper)
+static int snprintf_uid(char *str, size_t size, const struct sof_uuid_entry *uid_entry,
+			int use_colors, int name_first, bool be, bool upper)
 {
 	const struct sof_uuid *uid_val = &uid_entry->id;
 	uint32_t a = be ? htobe32(uid_val->a) : uid_val->a;
 	uint16_t b = be ? htobe16(uid_val->b) : uid_val->b;
 	uint16_t c = be ? htobe16(uid_val->c) : uid_val->c;
+
+	return snprintf(str, size, upper ? UUID_UPPER : UUID_LOWER,
+			use_colors ? KBLU : "",
+			name_first ? uid_entry->name : "",
+			name_first ? " " : "",
+			a, b, c,
+			uid_val->d[0], uid_val->d[1], uid_val->d[2],
+			uid_val->d[3], uid_val->d[4], uid_val->d[5],
+			uid_val->d[6], uid_val->d[7],
+			name_first ? "" : " ",
+			name_first ? "" : uid_entry->name,
+			use_colors ? KNRM : "");
+}
+
+char *format_uid_raw(const struct sof_uuid_entry *uid_entry, int use_colors, int name_first,
+		     bool be, bool upper)
+{
+	int len = snprintf_uid(NULL, 0, uid_entry, use_colors, name_first, be, upper);
 	char *str;
 
-	str = log_asprintf(upper ? UUID_UPPER : UUID_LOWER,
-			   use_colors ? KBLU : "",
-			   name_first ? uid_entry->name : "",
-			   name_first ? " " : "",
-			   a, b, c,
-			   uid_val->d[0], uid_val->d[1], uid_val->d[2],
-			   uid_val->d[3], uid_val->d[4], uid_val->d[5],
-			   uid_val->d[6], uid_val->d[7],
-			   name_first ? "" : " ",
-			   name_first ? "" : uid_entry->name,
-			   use_colors ? KNRM : "");
+	if (len < 0)
+		return NULL;
+
+	str = malloc(len + 1);
+	if (str)
+		snprintf_uid(str, len + 1, uid_entry, use_colors, name_first, be, upper);
+
 	return str;
 }
 
@@ -120,194 +186,173 @@ uint32_t get_uuid_key(const struct sof_uuid_entry *entry)
 		uids_dict->data_offset + uids_dict->base_address;
 }
 
-static const char *format_uid(uint32_t uid_ptr, int use_colors, bool be, bool upper)
+/* format uuid of the uuid entry address from the log into str */
+static void format_uid(char *str, size_t size, uint32_t uid_ptr, int use_colors, bool be,
+		       bool upper)
 {
 	const struct snd_sof_uids_header *uids_dict = global_config->uids_dict;
-	const struct sof_uuid_entry *uid_entry;
-	char *str;
 
 	if (uid_ptr < uids_dict->base_address ||
-	    uid_ptr >= uids_dict->base_address + uids_dict->data_length) {
-		str = calloc(1, strlen(BAD_PTR_STR) + 1 + 6);
-		if (!str) {
-			log_err("can't allocate memory\n");
-			exit(EXIT_FAILURE);
-		}
-		sprintf(str, BAD_PTR_STR, uid_ptr);
-	} else {
-		uid_entry = get_uuid_entry(uid_ptr);
-		str = format_uid_raw(uid_entry, use_colors, 1, be, upper);
-	}
-
-	return str;
+	    uid_ptr >= uids_dict->base_address + uids_dict->data_length)
+		snprintf(str, size, BAD_PTR_STR, uid_ptr);
+	else
+		snprintf_uid(str, size, get_uuid_entry(uid_ptr), use_colors, 1, be, upper);
 }
 
-/* fmt should point '%pUx`, return pointer to UUID string or zero */
-static const char *asprintf_uuid(const char *fmt, uint32_t uuid_key, bool use_colors, int *fmt_len)
+/* fmt should point '%pUx`, return length of the conversion specifier */
+static int parse_uuid_fmt(const char *fmt, struct ldc_param_fmt *param)
 {
-	const char *fmt_end = fmt + strlen(fmt);
-	int be, upper;
-	int len = 4; /* assure full formating, with x */
+	param->type = LDC_PARAM_UUID;
 
-	if (fmt + 2 >= fmt_end || fmt[1] != 'p' || fmt[2] != 'U') {
-		*fmt_len = 0;
-		return NULL;
-	}
 	/* check 'x' value */
-	switch (fmt + 3 < fmt_end ? fmt[3] : 0) {
+	switch (fmt[3]) {
 	case 'b':
-		be = 1;
-		upper = 0;
+		param->be = true;
+		param->upper = false;
 		break;
 	case 'B':
-		be = 1;
-		upper = 1;
+		param->be = true;
+		param->upper = true;
 		break;
 	case 'l':
-		be = 0;
-		upper = 0;
+		param->be = false;
+		param->upper = false;
 		break;
 	case 'L':
-		be = 0;
-		upper = 1;
+		param->be = false;
+		param->upper = true;
 		break;
 	default:
-		be = 0;
-		upper = 0;
-		--len;
-		break;
+		param->be = false;
+		param->upper = false;
+		return 3;
 	}
-	*fmt_len = len;
-	return format_uid(uuid_key, use_colors, be, upper);
-}
-
-static const char *asprintf_entry_text(uint32_t entry_address)
-{
-	struct ldc_entry entry;
-	int ret;
-
-	ret = read_entry_from_ldc_file(&entry, entry_address);
-	if (ret)
-		return NULL;
-
-	free(entry.file_name);
 
-	return entry.text;
+	return 4;
 }
 
-/** printf-like formatting from the binary ldc_entry input to the
- *  formatted proc_lpc_entry output. Also copies the unmodified
- *  ldc_entry_header from input to output.
+/** Scans the text of a dictionary entry for conversion specifiers
+ *  once, when the entry is parsed, so that printing it only needs to
+ *  format the parameters. We follow the Linux kernel that uses %pUx
+ *  formats for UUID / GUID printing, where 'x' is optional and can be
+ *  one of 'b', 'B', 'l' (default), and 'L'. For decoding log entry text
+ *  from pointer %pQ is used. Both are replaced with %s in the text.
  *
- * @param[out] pe copy of the header + formatted output
- * @param[in] e copy of the dictionary entry where unformatted,
-    uint32_t params have been inserted.
-   @param[in] use_colors whether to use ANSI terminal codes
-*/
-static void process_params(struct proc_ldc_entry *pe,
-			   const struct ldc_entry *e,
-			   int use_colors)
+ * @param[in,out] e dictionary entry with the header filled
+ * @param[in,out] p copy of the entry text, modified in place
+ */
+static void parse_params(struct ldc_entry *e, char *p)
 {
-	char *p = e->text;
-	const char *t_end = p + strlen(e->text);
+	char *t_end = p + strlen(p);
+	unsigned int i = 0;
 	int uuid_fmt_len;
-	int i = 0;
 
-	pe->subst_mask = 0;
-	pe->header =  e->header;
-	pe->file_name = e->file_name;
-	pe->text = e->text;
+	e->text = p;
 
-	/*
-	 * Scan the text for possible replacements. We follow the Linux kernel
-	 * that uses %pUx formats for UUID / GUID printing, where 'x' is
-	 * optional and can be one of 'b', 'B', 'l' (default), and 'L'.
-	 * For decoding log entry text from pointer %pQ is used.
-	 */
 	while ((p = strchr(p, '%'))) {
-		uint32_t raw_param;
-
-		if (i >= e->header.params_num) {
-			/* Don't read e->params[] out of bounds. */
-			log_err("Too many %% conversion specifiers in '%s'\n",
-				e->text);
-			break;
-		}
-		raw_param = e->params[i];
-
 		/* % can't be the last char */
 		if (p + 1 >= t_end) {
-			log_err("Invalid format string\n");
+			e->fmt_invalid = true;
 			break;
 		}
 
-		/* scan format string */
+		/* Skip "%%" */
 		if (p[1] == '%') {
-			/* Skip "%%" */
 			p += 2;
-		} else if (p[1] == 's') {
+			continue;
+		}
+
+		if (i >= e->header.params_num) {
+			/* Too many conversion specifiers, reported when printed */
+			i++;
+			break;
+		}
+
+		if (p[1] == 's') {
 			/* %s format specifier */
-			/* check for string printing, because it leads to logger crash */
-			log_err("String printing is not supported\n");
-			pe->params[i] = (uintptr_t)log_asprintf("<String @ 0x%08x>", raw_param);
-			if (!pe->params[i])
-				abort();
-			pe->subst_mask |= 1 << i;
-			++i;
+			e->param[i].type = LDC_PARAM_STRING;
 			p += 2;
 		} else if (p + 2 < t_end && p[1] == 'p' && p[2] == 'U') {
-			/* %pUx format specifier */
-			/* substitute UUID entry address with formatted string pointer from heap */
-			pe->params[i] = (uintptr_t)asprintf_uuid(p, raw_param, use_colors,
-								 &uuid_fmt_len);
-			if (!pe->params[i])
-				abort();
-			pe->subst_mask |= 1 << i;
-			++i;
-			/* replace uuid formatter with %s */
+			/* %pUx format specifier, replace uuid formatter with %s */
+			uuid_fmt_len = parse_uuid_fmt(p, &e->param[i]);
 			p[1] = 's';
 			memmove(&p[2], &p[uuid_fmt_len], (int)(t_end - &p[uuid_fmt_len]) + 1);
-			p += uuid_fmt_len - 2;
 			t_end -= uuid_fmt_len - 2;
+			p += 2;
 		} else if (p + 2 < t_end && p[1] == 'p' && p[2] == 'Q') {
-			/* %pQ format specifier */
-			/* substitute log entry address with formatted entry text */
-			pe->params[i] = (uintptr_t)asprintf_entry_text(raw_param);
-
-			if (pe->params[i])
-				pe->subst_mask |= 1 << i;
-			else
-				pe->params[i] = (uintptr_t)missing;
-
-			++i;
-
-			/* replace entry formatter with %s */
+			/* %pQ format specifier, replace entry formatter with %s */
+			e->param[i].type = LDC_PARAM_ENTRY;
 			p[1] = 's';
 			memmove(&p[2], &p[3], t_end - &p[2]);
-			p++;
 			t_end--;
+			p += 2;
 		} else {
-			/* arguments different from %pU and %pQ should be passed without
-			 * modification
+			/* arguments different from %s, %pU and %pQ should be passed
+			 * without modification
 			 */
-			pe->params[i] = raw_param;
-			++i;
+			e->param[i].type = LDC_PARAM_RAW;
 			p += 2;
 		}
+		i++;
 	}
-	if (i < e->header.params_num)
-		log_err("Too few %% conversion specifiers in '%s'\n", e->text);
+
+	e->fmt_params = i;
 }
 
-static void free_proc_ldc_entry(struct proc_ldc_entry *pe)
+/** printf-like formatting of the parameters read from the log for the
+ *  parsed dictionary entry. Strings are formatted into pe, nothing is
+ *  allocated.
+ *
+ * @param[out] pe formatted parameters
+ * @param[in] rec log statement with the parsed dictionary entry and
+ * the unformatted parameters
+ * @param[in] use_colors whether to use ANSI terminal codes
+ */
+static void process_params(struct proc_ldc_entry *pe,
+			   const struct log_record *rec,
+			   int use_colors)
 {
-	int i;
+	const struct ldc_entry *e = rec->entry;
+	const uint32_t *params = rec->params;
+	unsigned int i;
+
+	if (e->fmt_params > e->header.params_num)
+		log_err("Too many %% conversion specifiers in '%s'\n", e->raw_text);
+	else if (e->fmt_invalid)
+		log_err("Invalid format string\n");
 
 	for (i = 0; i < TRACE_MAX_PARAMS_COUNT; i++) {
-		if (pe->subst_mask & (1 << i))
-			free((void *)pe->params[i]);
-		pe->params[i] = 0;
+		if (i >= e->fmt_params || i >= e->header.params_num) {
+			pe->params[i] = 0;
+			continue;
+		}
+
+		switch (e->param[i].type) {
+		case LDC_PARAM_STRING:
+			/* check for string printing, because it leads to logger crash */
+			log_err("String printing is not supported\n");
+			snprintf(pe->str[i], sizeof(pe->str[i]), "<String @ 0x%08x>", params[i]);
+			pe->params[i] = (uintptr_t)pe->str[i];
+			break;
+		case LDC_PARAM_UUID:
+			/* substitute UUID entry address with formatted string */
+			format_uid(pe->str[i], sizeof(pe->str[i]), params[i], use_colors,
+				   e->param[i].be, e->param[i].upper);
+			pe->params[i] = (uintptr_t)pe->str[i];
+			break;
+		case LDC_PARAM_ENTRY:
+			/* substitute log entry address with entry text */
+			pe->params[i] = rec->refs[i] ? (uintptr_t)rec->refs[i]->raw_text :
+				(uintptr_t)missing;
+			break;
+		default:
+			pe->params[i] = params[i];
+			break;
+		}
 	}
+
+	if (e->fmt_params < e->header.params_num)
+		log_err("Too few %% conversion specifiers in '%s'\n", e->raw_text);
 }
 
 static double to_usecs(uint64_t time)
@@ -454,37 +499,23 @@ static char *format_file_name(char *file_name_raw, int full_name)
 }
 
 static int entry_number = 1;
-/** Formats and outputs one entry from the trace + the corresponding
- * ldc_entry from the dictionary passed as arguments. Expects the log
- * variables to have already been copied into the ldc_entry.
+/** Computes the timestamps of a log statement, must be called for the
+ * statements in input order.
  */
-static void print_entry_params(const struct log_entry_header *dma_log,
-			       const struct ldc_entry *entry, uint64_t last_timestamp)
+static void record_timestamps(struct log_record *rec, uint64_t last_timestamp)
 {
 	static uint64_t timestamp_origin;
 
-	FILE *out_fd = global_config->out_fd;
-	int use_colors = global_config->use_colors;
-	int raw_output = global_config->raw_output;
-	int hide_location = global_config->hide_location;
-	int time_precision = global_config->time_precision;
-
-	char ids[TRACE_MAX_IDS_STR];
+	const struct log_entry_header *dma_log = &rec->dma_log;
 	float dt = to_usecs(dma_log->timestamp - last_timestamp);
-	struct proc_ldc_entry proc_entry;
-	int ret;
-
-	if (raw_output)
-		use_colors = 0;
 
 	/* Something somewhere went wrong */
 	if (dt > 1000.0 * 1000.0 * 1000.0)
 		dt = NAN;
 
-	if (dma_log->timestamp < last_timestamp) {
-		fprintf(out_fd,
-			"\n\t\t --- negative DELTA = %.3f us: wrap, IPC_TRACE, other? ---\n\n",
-			-to_usecs(last_timestamp - dma_log->timestamp));
+	rec->wrapped = dma_log->timestamp < last_timestamp;
+	if (rec->wrapped) {
+		rec->wrap_delta = -to_usecs(last_timestamp - dma_log->timestamp);
 		entry_number = 1;
 	}
 
@@ -504,6 +535,41 @@ static void print_entry_params(const struct log_entry_header *dma_log,
 			timestamp_origin = last_timestamp;
 	} /* We don't need the exact entry_number after 3 */
 
+	rec->dt = dt;
+	rec->timestamp = to_usecs(dma_log->timestamp - timestamp_origin);
+}
+
+/** Formats and outputs one log statement: the entry from the trace +
+ * the corresponding ldc_entry from the dictionary, preceded by the
+ * note of the record if any.
+ */
+static void print_record(FILE *out_fd, const struct log_record *rec)
+{
+	const struct log_entry_header *dma_log = &rec->dma_log;
+	const struct ldc_entry *entry = rec->entry;
+	int use_colors = global_config->use_colors;
+	int raw_output = global_config->raw_output;
+	int hide_location = global_config->hide_location;
+	int time_precision = global_config->time_precision;
+
+	char ids[TRACE_MAX_IDS_STR];
+	struct proc_ldc_entry proc_entry;
+	int ret;
+
+	if (rec->note)
+		fputs(rec->note, out_fd);
+
+	if (!entry)
+		return;
+
+	if (raw_output)
+		use_colors = 0;
+
+	if (rec->wrapped)
+		fprintf(out_fd,
+			"\n\t\t --- negative DELTA = %.3f us: wrap, IPC_TRACE, other? ---\n\n",
+			rec->wrap_delta);
+
 	if (dma_log->id_0 != INVALID_TRACE_ID &&
 	    dma_log->id_1 != INVALID_TRACE_ID)
 		sprintf(ids, "%d.%d", (dma_log->id_0 & TRACE_IDS_MASK),
@@ -523,22 +589,19 @@ static void print_entry_params(const struct log_entry_header *dma_log,
 
 		if (time_precision >= 0)
 			fprintf(out_fd, "%.*f %.*f ",
-				time_precision, to_usecs(dma_log->timestamp - timestamp_origin),
-				time_precision, dt);
+				time_precision, rec->timestamp,
+				time_precision, rec->dt);
 
 		if (!hide_location)
-			fprintf(out_fd, "(%s:%u) ",
-				format_file_name(entry->file_name, raw_output),
-				entry->header.line_idx);
+			fprintf(out_fd, "(%s:%u) ", entry->file_name, entry->header.line_idx);
 	} else {
 		if (time_precision >= 0) {
 			const unsigned int ts_width = timestamp_width(time_precision);
 
 			fprintf(out_fd, "%s[%*.*f] (%*.*f)%s ",
 				use_colors ? KGRN : "",
-				ts_width, time_precision,
-				to_usecs(dma_log->timestamp - timestamp_origin),
-				ts_width, time_precision, dt,
+				ts_width, time_precision, rec->timestamp,
+				ts_width, time_precision, rec->dt,
 				use_colors ? KNRM : "");
 		}
 
@@ -554,9 +617,7 @@ static void print_entry_params(const struct log_entry_header *dma_log,
 
 		/* location */
 		if (!hide_location)
-			fprintf(out_fd, "%24s:%-4u ",
-				format_file_name(entry->file_name, raw_output),
-				entry->header.line_idx);
+			fprintf(out_fd, "%24s:%-4u ", entry->file_name, entry->header.line_idx);
 
 		/* level name */
 		fprintf(out_fd, "%s%s",
@@ -565,133 +626,509 @@ static void print_entry_params(const struct log_entry_header *dma_log,
 	}
 
 	/* Minimal, printf-like formatting */
-	process_params(&proc_entry, entry, use_colors);
+	process_params(&proc_entry, rec, use_colors);
 
-	switch (proc_entry.header.params_num) {
+	switch (entry->header.params_num) {
 	case 0:
-		ret = fprintf(out_fd, "%s", proc_entry.text);
+		ret = fprintf(out_fd, "%s", entry->text);
 		break;
 	case 1:
-		ret = fprintf(out_fd, proc_entry.text, proc_entry.params[0]);
+		ret = fprintf(out_fd, entry->text, proc_entry.params[0]);
 		break;
 	case 2:
-		ret = fprintf(out_fd, proc_entry.text, proc_entry.params[0], proc_entry.params[1]);
+		ret = fprintf(out_fd, entry->text, proc_entry.params[0], proc_entry.params[1]);
 		break;
 	case 3:
-		ret = fprintf(out_fd, proc_entry.text, proc_entry.params[0], proc_entry.params[1],
+		ret = fprintf(out_fd, entry->text, proc_entry.params[0], proc_entry.params[1],
 			      proc_entry.params[2]);
 		break;
 	case 4:
-		ret = fprintf(out_fd, proc_entry.text, proc_entry.params[0], proc_entry.params[1],
+		ret = fprintf(out_fd, entry->text, proc_entry.params[0], proc_entry.params[1],
 			      proc_entry.params[2], proc_entry.params[3]);
 		break;
 	default:
-		log_err("Unsupported number of arguments for '%s'", proc_entry.text);
+		log_err("Unsupported number of arguments for '%s'", entry->text);
 		ret = 0; /* don't log ferror */
 		break;
 	}
-	free_proc_ldc_entry(&proc_entry);
 	/* log format text comes from ldc file (may be invalid), so error check is needed here */
 	if (ret < 0)
 		log_err("trace fprintf failed for '%s', %d '%s'",
-			proc_entry.text, ferror(out_fd), strerror(ferror(out_fd)));
+			entry->text, ferror(out_fd), strerror(ferror(out_fd)));
 	fprintf(out_fd, "%s\n", use_colors ? KNRM : "");
-	fflush(out_fd);
 }
 
-static int read_entry_from_ldc_file(struct ldc_entry *entry, uint32_t log_entry_address)
+/** Parses the dictionary entry at the given firmware address from the
+ *  memory mapped ldc file.
+ *
+ * @param[in] address log entry address
+ * @param[in] scan entry looked for while indexing the dictionary: stay
+ * quiet on errors and also require NUL terminated strings
+ * @return entry, allocated with its strings as a single block
+ */
+static struct ldc_entry *ldc_entry_parse(uint32_t address, bool scan)
 {
-	uint32_t base_address = global_config->logs_header->base_address;
-	uint32_t data_offset = global_config->logs_header->data_offset;
-
-	int ret;
+	const struct snd_sof_logs_header *logs_hdr = global_config->logs_header;
+	const struct ldc_entry_header *header;
+	const char *file_name_raw, *text_raw;
+	struct ldc_entry *entry;
+	char *file_name, *raw_text, *text;
+	size_t offset;
 
 	/* evaluate entry offset in input file */
-	uint32_t entry_offset = (log_entry_address - base_address) + data_offset;
+	offset = (size_t)(address - logs_hdr->base_address) + logs_hdr->data_offset;
+	if (address < logs_hdr->base_address ||
+	    offset + sizeof(*header) > ldc_index.map_size) {
+		if (!scan)
+			log_err("Failed to read entry header for offset 0x%zx in dictionary.\n",
+				offset);
+		return NULL;
+	}
+
+	header = (const struct ldc_entry_header *)(ldc_index.map + offset);
+	if (header->file_name_len > TRACE_MAX_FILENAME_LEN) {
+		if (!scan)
+			log_err("Invalid filename length %d or ldc file does not match firmware\n",
+				header->file_name_len);
+		return NULL;
+	}
+	if (header->text_len > TRACE_MAX_TEXT_LEN) {
+		if (!scan)
+			log_err("Invalid text length.\n");
+		return NULL;
+	}
+	if (offset + sizeof(*header) + header->file_name_len + header->text_len >
+	    ldc_index.map_size) {
+		if (!scan)
+			log_err("Failed to read log message at offset 0x%zx from dictionary.\n",
+				offset);
+		return NULL;
+	}
 
-	entry->file_name = NULL;
-	entry->text = NULL;
-	entry->params = NULL;
+	file_name_raw = (const char *)(header + 1);
+	text_raw = file_name_raw + header->file_name_len;
+	if (scan && (!header->file_name_len || !header->text_len ||
+		     file_name_raw[header->file_name_len - 1] ||
+		     text_raw[header->text_len - 1]))
+		return NULL;
 
-	/* set file position to beginning of processed entry */
-	ret = fseek(global_config->ldc_fd, entry_offset, SEEK_SET);
-	if (ret) {
-		log_err("Failed to seek to entry header for offset 0x%x in dictionary.\n",
-			entry_offset);
-		ret = -errno;
-		goto out;
+	entry = calloc(1, sizeof(*entry) + header->file_name_len + 2 * header->text_len + 3);
+	if (!entry) {
+		log_err("can't allocate memory for dictionary entry\n");
+		return NULL;
 	}
 
-	/* fetching elf header params */
-	ret = fread(&entry->header, sizeof(entry->header), 1, global_config->ldc_fd);
-	if (ret != 1) {
-		log_err("Failed to read entry header for offset 0x%x in dictionary.\n",
-			entry_offset);
-		ret = -1;
-		goto out;
+	file_name = (char *)(entry + 1);
+	raw_text = file_name + header->file_name_len + 1;
+	text = raw_text + header->text_len + 1;
+	strncpy(file_name, file_name_raw, header->file_name_len);
+	strncpy(raw_text, text_raw, header->text_len);
+	strncpy(text, text_raw, header->text_len);
+
+	entry->header = *header;
+	entry->file_name = format_file_name(file_name, global_config->raw_output);
+	entry->raw_text = raw_text;
+	if (header->params_num <= TRACE_MAX_PARAMS_COUNT)
+		parse_params(entry, text);
+	else
+		entry->text = text;
+
+	return entry;
+}
+
+static uint32_t ldc_index_hash(uint32_t address)
+{
+	/* entries are 4 bytes aligned, mix the remaining bits */
+	address >>= 2;
+	address ^= address >> 16;
+	address *= 0x45d9f3b;
+	address ^= address >> 16;
+
+	return address;
+}
+
+static void ldc_index_insert(uint32_t address, struct ldc_entry *entry)
+{
+	uint32_t i = ldc_index_hash(address) & ldc_index.mask;
+
+	while (ldc_index.slots[i].entry)
+		i = (i + 1) & ldc_index.mask;
+
+	ldc_index.slots[i].address = address;
+	ldc_index.slots[i].entry = entry;
+	ldc_index.count++;
+}
+
+/* double the number of slots to keep the index at most half full */
+static int ldc_index_grow(void)
+{
+	struct ldc_index_slot *old_slots = ldc_index.slots;
+	uint32_t old_size = ldc_index.mask + 1;
+	uint32_t i;
+
+	ldc_index.slots = calloc(old_size * 2, sizeof(*ldc_index.slots));
+	if (!ldc_index.slots) {
+		ldc_index.slots = old_slots;
+		return -ENOMEM;
 	}
-	if (entry->header.file_name_len > TRACE_MAX_FILENAME_LEN) {
-		log_err("Invalid filename length %d or ldc file does not match firmware\n",
-			entry->header.file_name_len);
-		ret = -EINVAL;
-		goto out;
+
+	ldc_index.mask = old_size * 2 - 1;
+	ldc_index.count = 0;
+	for (i = 0; i < old_size; i++)
+		if (old_slots[i].entry)
+			ldc_index_insert(old_slots[i].address, old_slots[i].entry);
+
+	free(old_slots);
+	return 0;
+}
+
+/** Looks up the dictionary entry for a log entry address. Entries that
+ *  were not found when the dictionary was indexed are parsed and added
+ *  on first use.
+ */
+static const struct ldc_entry *ldc_index_get(uint32_t address)
+{
+	uint32_t i = ldc_index_hash(address) & ldc_index.mask;
+	struct ldc_entry *entry;
+
+	while (ldc_index.slots[i].entry) {
+		if (ldc_index.slots[i].address == address)
+			return ldc_index.slots[i].entry;
+		i = (i + 1) & ldc_index.mask;
 	}
-	entry->file_name = (char *)malloc(entry->header.file_name_len + 1);
 
-	if (!entry->file_name) {
-		log_err("can't allocate %d byte for entry.file_name\n",
-			entry->header.file_name_len);
-		ret = -ENOMEM;
-		goto out;
+	entry = ldc_entry_parse(address, false);
+	if (!entry)
+		return NULL;
+
+	if (2 * (ldc_index.count + 1) > ldc_index.mask + 1 && ldc_index_grow() < 0) {
+		free(entry);
+		log_err("can't allocate memory for dictionary index\n");
+		return NULL;
 	}
 
-	ret = fread(entry->file_name, sizeof(char), entry->header.file_name_len,
-		    global_config->ldc_fd);
-	entry->file_name[entry->header.file_name_len] = '\0';
+	ldc_index_insert(address, entry);
+	return entry;
+}
 
-	if (ret != entry->header.file_name_len) {
-		log_err("Failed to read source filename for offset 0x%x in dictionary.\n",
-			entry_offset);
-		ret = -1;
-		goto out;
+/** Memory maps the ldc file and indexes all log entries of the
+ *  dictionary, so decoding a log statement needs no file access and no
+ *  memory allocation.
+ */
+static int ldc_index_init(void)
+{
+	const struct snd_sof_logs_header *logs_hdr = global_config->logs_header;
+	int fd = fileno(global_config->ldc_fd);
+	struct ldc_entry *entry;
+	uint32_t offset = 0;
+	uint32_t size = 64;
+	off_t file_size;
+	void *map;
+
+	file_size = lseek(fd, 0, SEEK_END);
+	if (file_size < 0) {
+		log_err("Failed to get size of %s.\n", global_config->ldc_file);
+		return -errno;
 	}
 
-	/* fetching text */
-	if (entry->header.text_len > TRACE_MAX_TEXT_LEN) {
-		log_err("Invalid text length.\n");
-		ret = -EINVAL;
-		goto out;
+	map = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (map == MAP_FAILED) {
+		log_err("Failed to map %s: %s\n", global_config->ldc_file, strerror(errno));
+		return -errno;
 	}
-	entry->text = (char *)malloc(entry->header.text_len + 1);
-	if (!entry->text) {
-		log_err("can't allocate %d byte for entry.text\n", entry->header.text_len);
-		ret = -ENOMEM;
-		goto out;
+
+	ldc_index.map = map;
+	ldc_index.map_size = file_size;
+
+	/* entry is at least a header and two NUL terminated strings */
+	while (size < logs_hdr->data_length / (sizeof(struct ldc_entry_header) + 2) * 2)
+		size *= 2;
+
+	ldc_index.slots = calloc(size, sizeof(*ldc_index.slots));
+	if (!ldc_index.slots)
+		return -ENOMEM;
+	ldc_index.mask = size - 1;
+
+	/* entries are 4 bytes aligned and follow each other in the dictionary */
+	while (offset + sizeof(struct ldc_entry_header) <= logs_hdr->data_length) {
+		entry = ldc_entry_parse(logs_hdr->base_address + offset, true);
+		if (!entry)
+			break;
+
+		ldc_index_insert(logs_hdr->base_address + offset, entry);
+		offset += CEIL(sizeof(struct ldc_entry_header) + entry->header.file_name_len +
+			       entry->header.text_len, 4) * 4;
 	}
-	ret = fread(entry->text, sizeof(char), entry->header.text_len, global_config->ldc_fd);
-	if (ret != entry->header.text_len) {
-		log_err("Failed to read log message at offset 0x%x from dictionary.\n",
-			entry_offset);
-		ret = -1;
-		goto out;
+
+	return 0;
+}
+
+static void ldc_index_free(void)
+{
+	uint32_t i;
+
+	if (ldc_index.slots)
+		for (i = 0; i <= ldc_index.mask; i++)
+			free(ldc_index.slots[i].entry);
+
+	free(ldc_index.slots);
+	if (ldc_index.map)
+		munmap((void *)ldc_index.map, ldc_index.map_size);
+
+	memset(&ldc_index, 0, sizeof(ldc_index));
+}
+
+/* Statements formatted by one decode worker at a time */
+#define LOG_BATCH_RECORDS	1024
+/* Batches in flight per decode worker */
+#define LOG_BATCHES_PER_JOB	4
+/* stdio buffer of the log input */
+#define LOG_READ_BUFFER_SIZE	(1 << 20)
+
+enum log_batch_state {
+	LOG_BATCH_FREE = 0,
+	LOG_BATCH_FILLED,
+	LOG_BATCH_FORMATTED,
+};
+
+struct log_batch {
+	struct log_record rec[LOG_BATCH_RECORDS];
+	unsigned int count;
+	enum log_batch_state state;
+	char *text;		/* formatted records */
+	size_t text_size;
+};
+
+/** Decode pipeline: the reader fills batches of records in input order,
+ * the workers format the batches in parallel and the printer writes them
+ * out in input order. The batches are used as a ring indexed by the
+ * sequence numbers modulo num_batches.
+ */
+struct log_pipeline {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	struct log_batch *batch;
+	unsigned int num_batches;
+	uint64_t fill_seq;	/* batches filled by the reader */
+	uint64_t format_seq;	/* batches taken by the workers */
+	uint64_t print_seq;	/* batches written by the printer */
+	bool done;		/* the reader will not fill more batches */
+	pthread_t printer;
+	pthread_t *workers;
+	unsigned int num_workers;
+};
+
+/* NULL when the statements are printed as soon as they are read */
+static struct log_pipeline *log_pipeline;
+
+static void *log_worker_thread(void *arg)
+{
+	struct log_pipeline *lp = arg;
+	struct log_batch *batch;
+	unsigned int i;
+	FILE *out;
+
+	pthread_mutex_lock(&lp->lock);
+	for (;;) {
+		while (lp->format_seq == lp->fill_seq && !lp->done)
+			pthread_cond_wait(&lp->cond, &lp->lock);
+		if (lp->format_seq == lp->fill_seq)
+			break;
+
+		batch = &lp->batch[lp->format_seq++ % lp->num_batches];
+		pthread_mutex_unlock(&lp->lock);
+
+		out = open_memstream(&batch->text, &batch->text_size);
+		if (out) {
+			log_err_redirect(out);
+			for (i = 0; i < batch->count; i++)
+				print_record(out, &batch->rec[i]);
+			log_err_redirect(NULL);
+			fclose(out);
+		} else {
+			log_err("failed to format %u log statements: %s\n",
+				batch->count, strerror(errno));
+			batch->text = NULL;
+		}
+
+		for (i = 0; i < batch->count; i++)
+			free(batch->rec[i].note);
+
+		pthread_mutex_lock(&lp->lock);
+		batch->state = LOG_BATCH_FORMATTED;
+		pthread_cond_broadcast(&lp->cond);
+	}
+	pthread_mutex_unlock(&lp->lock);
+
+	return NULL;
+}
+
+static void *log_printer_thread(void *arg)
+{
+	struct log_pipeline *lp = arg;
+	struct log_batch *batch;
+
+	pthread_mutex_lock(&lp->lock);
+	for (;;) {
+		while (lp->print_seq == lp->fill_seq && !lp->done)
+			pthread_cond_wait(&lp->cond, &lp->lock);
+		if (lp->print_seq == lp->fill_seq)
+			break;
+
+		batch = &lp->batch[lp->print_seq % lp->num_batches];
+		while (batch->state != LOG_BATCH_FORMATTED)
+			pthread_cond_wait(&lp->cond, &lp->lock);
+		pthread_mutex_unlock(&lp->lock);
+
+		if (batch->text) {
+			fwrite(batch->text, 1, batch->text_size, global_config->out_fd);
+			fflush(global_config->out_fd);
+			free(batch->text);
+			batch->text = NULL;
+		}
+
+		pthread_mutex_lock(&lp->lock);
+		batch->count = 0;
+		batch->state = LOG_BATCH_FREE;
+		lp->print_seq++;
+		pthread_cond_broadcast(&lp->cond);
+	}
+	pthread_mutex_unlock(&lp->lock);
+
+	return NULL;
+}
+
+static int log_pipeline_start(unsigned int jobs)
+{
+	struct log_pipeline *lp;
+	unsigned int i;
+	int ret;
+
+	lp = calloc(1, sizeof(*lp));
+	if (!lp)
+		return -ENOMEM;
+
+	lp->num_batches = jobs * LOG_BATCHES_PER_JOB;
+	lp->batch = calloc(lp->num_batches, sizeof(*lp->batch));
+	lp->workers = calloc(jobs, sizeof(*lp->workers));
+	if (!lp->batch || !lp->workers) {
+		free(lp->batch);
+		free(lp->workers);
+		free(lp);
+		return -ENOMEM;
+	}
+
+	pthread_mutex_init(&lp->lock, NULL);
+	pthread_cond_init(&lp->cond, NULL);
+
+	ret = pthread_create(&lp->printer, NULL, log_printer_thread, lp);
+	if (ret) {
+		log_err("failed to create log printer thread: %s\n", strerror(ret));
+		exit(EXIT_FAILURE);
 	}
-	entry->text[entry->header.text_len] = '\0';
 
+	for (i = 0; i < jobs; i++) {
+		ret = pthread_create(&lp->workers[i], NULL, log_worker_thread, lp);
+		if (ret) {
+			log_err("failed to create log decode thread: %s\n", strerror(ret));
+			exit(EXIT_FAILURE);
+		}
+		lp->num_workers++;
+	}
+
+	log_pipeline = lp;
 	return 0;
+}
 
-out:
-	free(entry->text);
-	entry->text = NULL;
-	free(entry->file_name);
-	entry->file_name = NULL;
+/* hand the partially filled batch over and wait for everything to be printed */
+static void log_pipeline_stop(void)
+{
+	struct log_pipeline *lp = log_pipeline;
+	struct log_batch *batch;
+	unsigned int i;
+
+	if (!lp)
+		return;
+
+	pthread_mutex_lock(&lp->lock);
+	batch = &lp->batch[lp->fill_seq % lp->num_batches];
+	if (batch->state == LOG_BATCH_FREE && batch->count) {
+		batch->state = LOG_BATCH_FILLED;
+		lp->fill_seq++;
+	}
+	lp->done = true;
+	pthread_cond_broadcast(&lp->cond);
+	pthread_mutex_unlock(&lp->lock);
+
+	for (i = 0; i < lp->num_workers; i++)
+		pthread_join(lp->workers[i], NULL);
+	pthread_join(lp->printer, NULL);
+
+	pthread_mutex_destroy(&lp->lock);
+	pthread_cond_destroy(&lp->cond);
+	free(lp->workers);
+	free(lp->batch);
+	free(lp);
+	log_pipeline = NULL;
+}
 
-	return ret;
+/** Queues a log record for formatting, the record is copied. Blocks
+ * while all batches are in flight.
+ */
+static void log_pipeline_put(struct log_pipeline *lp, const struct log_record *rec)
+{
+	struct log_batch *batch;
+
+	pthread_mutex_lock(&lp->lock);
+	batch = &lp->batch[lp->fill_seq % lp->num_batches];
+	while (batch->state != LOG_BATCH_FREE)
+		pthread_cond_wait(&lp->cond, &lp->lock);
+	pthread_mutex_unlock(&lp->lock);
+
+	/* only the reader touches a free batch */
+	batch->rec[batch->count++] = *rec;
+	if (batch->count < LOG_BATCH_RECORDS)
+		return;
+
+	pthread_mutex_lock(&lp->lock);
+	batch->state = LOG_BATCH_FILLED;
+	lp->fill_seq++;
+	pthread_cond_broadcast(&lp->cond);
+	pthread_mutex_unlock(&lp->lock);
+}
+
+/** Outputs a log record in input order, the note of the record is freed */
+static void emit_record(struct log_record *rec)
+{
+	if (log_pipeline) {
+		log_pipeline_put(log_pipeline, rec);
+		return;
+	}
+
+	print_record(global_config->out_fd, rec);
+	fflush(global_config->out_fd);
+	free(rec->note);
+}
+
+/** Outputs a message in order with the log statements */
+static void emit_note(const char *fmt, ...)
+{
+	struct log_record rec = { .entry = NULL };
+	va_list args;
+
+	va_start(args, fmt);
+	rec.note = log_vasprintf(fmt, args);
+	va_end(args);
+
+	if (rec.note)
+		emit_record(&rec);
 }
 
 /** Gets the dictionary entry matching the log entry argument, reads
  * from the log the variable number of arguments needed by this entry
- * and passes everything to print_entry_params() to finish processing
- * this log entry. So not just "fetch" but everything else after it too.
+ * and queues the record with emit_record(). The record is formatted
+ * and printed in input order, by the decode workers when the log is
+ * decoded in batches or right away otherwise.
  *
  * @param[in] dma_log protocol header from any trace (not just from the
  * "DMA" trace)
@@ -699,62 +1136,54 @@ out:
  */
 static int fetch_entry(const struct log_entry_header *dma_log, uint64_t *last_timestamp)
 {
-	struct ldc_entry entry;
+	struct log_record rec = { .dma_log = *dma_log };
+	const struct ldc_entry *entry;
+	unsigned int i;
 	int ret;
 
-	ret = read_entry_from_ldc_file(&entry, dma_log->log_entry_address);
-	if (ret < 0) {
-		log_err("read_entry_from_ldc_file(0x%x) returned %d\n",
-			dma_log->log_entry_address, ret);
-		goto out;
+	entry = ldc_index_get(dma_log->log_entry_address);
+	if (!entry) {
+		log_err("no dictionary entry for log entry address 0x%x\n",
+			dma_log->log_entry_address);
+		return -EINVAL;
 	}
 
 	/* fetching entry params from dma dump */
-	if (entry.header.params_num > TRACE_MAX_PARAMS_COUNT) {
+	if (entry->header.params_num > TRACE_MAX_PARAMS_COUNT) {
 		log_err("Invalid number of parameters.\n");
-		ret = -EINVAL;
-		goto out;
-	}
-	entry.params = (uint32_t *)malloc(sizeof(uint32_t) * entry.header.params_num);
-	if (!entry.params) {
-		log_err("can't allocate %d byte for entry.params\n",
-			(int)(sizeof(uint32_t) * entry.header.params_num));
-		ret = -ENOMEM;
-		goto out;
+		return -EINVAL;
 	}
 
 	if (global_config->serial_fd < 0) {
-		ret = fread(entry.params, sizeof(uint32_t), entry.header.params_num,
+		ret = fread(rec.params, sizeof(uint32_t), entry->header.params_num,
 			    global_config->in_fd);
-		if (ret != entry.header.params_num) {
-			fprintf(global_config->out_fd,
-				"warn: failed to fread() %d params from the log for %s:%d\n",
-				entry.header.params_num,
-				entry.file_name, entry.header.line_idx);
+		if (ret != entry->header.params_num) {
+			emit_note("warn: failed to fread() %d params from the log for %s:%d\n",
+				  entry->header.params_num,
+				  entry->file_name, entry->header.line_idx);
 
 			ret = ferror(global_config->in_fd) ? -1 : 0;
 
 			if (feof(global_config->in_fd))
-				fprintf(global_config->out_fd,
-					"warn: log's End Of File. Device suspend?\n");
+				emit_note("warn: log's End Of File. Device suspend?\n");
 
-			goto out;
+			return ret;
 		}
 	} else { /* serial */
-		size_t size = sizeof(uint32_t) * entry.header.params_num;
+		size_t size = sizeof(uint32_t) * entry->header.params_num;
 		uint8_t *n;
 
 		/* Repeatedly read() how much we still miss until we got
 		 * enough for the number of params needed by this
 		 * particular statement.
 		 */
-		for (n = (uint8_t *)entry.params; size; n += ret, size -= ret) {
+		for (n = (uint8_t *)rec.params; size; n += ret, size -= ret) {
 			ret = read(global_config->serial_fd, n, size);
 			if (ret < 0) {
 				ret = -errno;
 				log_err("Failed to fread %d params from serial: %s\n",
-					entry.header.params_num, strerror(errno));
-				goto out;
+					entry->header.params_num, strerror(errno));
+				return ret;
 			}
 			if (ret != size)
 				log_err("Partial read of %u bytes of %zu, reading more\n",
@@ -762,21 +1191,21 @@ static int fetch_entry(const struct log_entry_header *dma_log, uint64_t *last_ti
 		}
 	} /* serial */
 
-	/* printing entry content */
-	print_entry_params(dma_log, &entry, *last_timestamp);
-	*last_timestamp = dma_log->timestamp;
+	/* The dictionary index is not thread safe, look up the %pQ
+	 * entries here in the reader.
+	 */
+	rec.entry = entry;
+	for (i = 0; i < entry->header.params_num && i < entry->fmt_params; i++)
+		if (entry->param[i].type == LDC_PARAM_ENTRY)
+			rec.refs[i] = ldc_index_get(rec.params[i]);
 
-	/* set f_ldc file position to the beginning */
-	rewind(global_config->ldc_fd);
+	record_timestamps(&rec, *last_timestamp);
+	*last_timestamp = dma_log->timestamp;
 
-	ret = 0;
-out:
-	/* free alocated memory */
-	free(entry.params);
-	free(entry.text);
-	free(entry.file_name);
+	/* printing entry content */
+	emit_record(&rec);
 
-	return ret;
+	return 0;
 }
 
 static int serial_read(uint64_t *last_timestamp)
@@ -853,6 +1282,20 @@ static int logger_read(void)
 				return ret;
 		}
 
+	/* Statements read from a file or stdin are formatted in parallel
+	 * and printed in batches. The trace mode keeps printing every
+	 * statement as soon as it is read.
+	 */
+	if (!global_config->trace) {
+		setvbuf(global_config->in_fd, NULL, _IOFBF, LOG_READ_BUFFER_SIZE);
+
+		if (global_config->jobs > 1) {
+			ret = log_pipeline_start(global_config->jobs);
+			if (ret < 0)
+				return ret;
+		}
+	}
+
 	/* One iteration per log statement */
 	while (!ferror(global_config->in_fd)) {
 		/* getting entry parameters from dma dump */
@@ -871,10 +1314,9 @@ static int logger_read(void)
 			}
 			/* for trace mode, try to reopen */
 			if (global_config->trace) {
-				fprintf(global_config->out_fd,
-					"\n       ---- %s; %s -----\n\n",
-					"Re-opening trace input file",
-					"device suspend?");
+				emit_note("\n       ---- %s; %s -----\n\n",
+					  "Re-opening trace input file",
+					  "device suspend?");
 				if (freopen(NULL, "rb", global_config->in_fd)) {
 					entry_number = 1;
 					continue;
@@ -907,7 +1349,7 @@ static int logger_read(void)
 			if (global_config->trace && ldc_address_OK) {
 				log_err("log_entry_address %#10x is not in dictionary range!\n",
 					dma_log.log_entry_address);
-				fprintf(global_config->out_fd,
+				emit_note(
 					"warn: Seeking forward 4 bytes at a time until re-synchronize.\n");
 			}
 			ldc_address_OK = false;
@@ -931,9 +1373,9 @@ static int logger_read(void)
 			 * only when we just started to run.
 			 */
 			if (skipped_dwords != 0) {
-				fprintf(global_config->out_fd,
+				emit_note(
 					"\nFound valid LDC address after skipping %zu bytes (one line uses %zu + 0 to 16 bytes)\n",
-				       sizeof(uint32_t) * skipped_dwords, sizeof(dma_log));
+					sizeof(uint32_t) * skipped_dwords, sizeof(dma_log));
 			}
 
 			ldc_address_OK = true;
@@ -951,6 +1393,8 @@ static int logger_read(void)
 		}
 	} /* next log entry */
 
+	log_pipeline_stop();
+
 	/* End of (etrace) file */
 	fprintf(global_config->out_fd,
 		"Skipped %zu bytes after the last statement",
@@ -1148,8 +1592,13 @@ int convert(void)
 		}
 	}
 
+	ret = ldc_index_init();
+	if (ret)
+		goto out;
+
 	ret = logger_read();
 out:
+	ldc_index_free();
 	free(config->uids_dict);
 	return ret;
 }
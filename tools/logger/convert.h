@@ -42,6 +42,7 @@ struct convert_config {
 	int hide_location;
 	int relative_timestamps;
 	int time_precision;
+	int jobs;		/* decode threads, 1 to decode in the reader */
 	struct snd_sof_uids_header *uids_dict;
 	struct snd_sof_logs_header *logs_header;
 };
@@ -86,6 +86,12 @@ static void usage(void)
 	fprintf(stdout, "%s:\t -F filter\t\tUpdate trace filter, format: "
 		"<level>=<comp1>[, <comp2>]\n",
 		APP_NAME);
+	fprintf(stdout, "%s:\t -j jobs\t\tDecode with jobs threads, one per CPU by default\n",
+		APP_NAME);
+	fprintf(stdout, "%s:\t -R\t\t\tCapture the input to outfile without decoding,\n",
+		APP_NAME);
+	fprintf(stdout, "%s:\t\t\t\tdecode it later with -i. No ldc_file needed.\n",
+		APP_NAME);
 	exit(0);
 }
 
@@ -151,6 +157,59 @@ static int snapshot(const char *name)
 	return 0;
 }
 
+/* Copy the input to the output undecoded. Keeps up with fast traces and
+ * leaves the decoding for later, possibly on another machine.
+ */
+static int capture_raw(struct convert_config *config)
+{
+	static char buffer[64 * 1024];
+	int out = fileno(config->out_fd);
+	ssize_t len, count;
+	char *p;
+	int in;
+
+	in = config->serial_fd >= 0 ? config->serial_fd : fileno(config->in_fd);
+
+	for (;;) {
+		len = read(in, buffer, sizeof(buffer));
+		if (len < 0) {
+			if (errno == EINTR)
+				continue;
+			fprintf(stderr, "error: unable to read %s: %s\n",
+				config->in_file, strerror(errno));
+			return -errno;
+		}
+
+		if (!len) {
+			if (!config->trace || config->serial_fd >= 0)
+				return 0;
+
+			/* device suspend, see logger_read() */
+			if (!freopen(NULL, "rb", config->in_fd)) {
+				fprintf(stderr, "error: unable to reopen %s: %s\n",
+					config->in_file, strerror(errno));
+				return -errno;
+			}
+			in = fileno(config->in_fd);
+			continue;
+		}
+
+		for (p = buffer; len; p += count, len -= count) {
+			count = write(out, p, len);
+			if (count < 0) {
+				if (errno == EINTR) {
+					count = 0;
+					continue;
+				}
+				fprintf(stderr, "error: unable to write %s: %s\n",
+					config->out_file ? config->out_file : "stdout",
+					strerror(errno));
+				return -errno;
+			}
+		}
+	}
+}
+
 static int configure_uart(const char *file, unsigned int baud)
 {
 	struct termios tio = {};
@@ -297,10 +356,11 @@ struct convert_config * const global_config = &_global_config;
 
 int main(int argc, char *argv[])
 {
-	static const char optstring[] = "ho:i:l:ps:c:u:tv:rd:Le:f:gF:n";
+	static const char optstring[] = "ho:i:l:ps:c:u:tv:rd:Le:f:gF:nj:R";
 	struct convert_config config;
 	unsigned int baud = 0;
 	const char *snapshot_file = 0;
+	bool raw_capture = false;
 	int opt, ret = 0;
 
 	config.trace = 0;
@@ -324,6 +384,9 @@ int main(int argc, char *argv[])
 	config.time_precision = 6;
 	config.relative_timestamps = INT_MAX; /* unspecified */
 	config.filter_config = NULL;
+	config.jobs = sysconf(_SC_NPROCESSORS_ONLN);
+	if (config.jobs < 1)
+		config.jobs = 1;
 
 	while ((opt = getopt(argc, argv, optstring)) != -1) {
 		switch (opt) {
@@ -404,6 +467,18 @@ int main(int argc, char *argv[])
 			if (ret < 0)
 				return ret;
 			break;
+		case 'j':
+			config.jobs = atoi(optarg);
+			if (config.jobs < 1) {
+				fprintf(stderr, "%s: invalid option: -j %s\n",
+					APP_NAME, optarg);
+				ret = -EINVAL;
+				goto out;
+			}
+			break;
+		case 'R':
+			raw_capture = true;
+			break;
 		case 'h':
 		default: /* '?' */
 			usage();
@@ -420,13 +495,19 @@ int main(int argc, char *argv[])
 		goto out;
 	}
 
-	if (!config.ldc_file) {
+	if (!config.ldc_file && !raw_capture) {
 		fprintf(stderr, "error: Missing ldc file\n");
 		usage();
 	}
 
-	config.ldc_fd = fopen(config.ldc_file, "rb");
-	if (!config.ldc_fd) {
+	if (raw_capture && config.dump_ldc) {
+		fprintf(stderr, "error: Nothing to capture with -d\n");
+		usage();
+	}
+
+	if (config.ldc_file)
+		config.ldc_fd = fopen(config.ldc_file, "rb");
+	if (config.ldc_file && !config.ldc_fd) {
 		ret = errno;
 		fprintf(stderr, "error: Unable to open ldc file %s: %s\n",
 			config.ldc_file, strerror(ret));
@@ -500,6 +581,11 @@ int main(int argc, char *argv[])
 			goto out;
 		}
 	}
+	if (raw_capture) {
+		ret = -capture_raw(&config);
+		goto out;
+	}
+
 	if (isatty(fileno(config.out_fd)) != 1)
 		config.use_colors = 0;
 
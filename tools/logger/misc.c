@@ -41,6 +41,14 @@ char *log_asprintf(const char *format, ...)
 	return result;
 }
 
+/* decode threads format into their own buffers, see log_err_redirect() */
+static __thread FILE *log_err_fd;
+
+void log_err_redirect(FILE *fd)
+{
+	log_err_fd = fd;
+}
+
 /** Prints 1. once to stderr. 2. a second time to the global out_fd if
  * out_fd is neither stderr nor stdout (because the -o option was used).
  */
@@ -66,6 +74,8 @@ void log_err(const char *fmt, ...)
 
 		/* take care about out_fd validity and duplicated logging */
 		if (out_fd && out_fd != stderr && out_fd != stdout) {
+			if (log_err_fd)
+				out_fd = log_err_fd;
 			fprintf(out_fd, "%s%s", prefix, buff);
 			fflush(out_fd);
 		}
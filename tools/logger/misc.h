@@ -6,6 +6,7 @@
  */
 
 #include <stdarg.h>
+#include <stdio.h>
 #include <stdlib.h>
 
 char *log_vasprintf(const char *format, va_list args);
@@ -20,6 +21,9 @@ __attribute__((format(printf, 1, 2)))
 #endif
 void log_err(const char *fmt, ...);
 
+/* send the out_fd copy of log_err() of the calling thread to fd, NULL restores */
+void log_err_redirect(FILE *fd);
+
 /* trim whitespaces from string begin */
 char *ltrim(char *s);
 
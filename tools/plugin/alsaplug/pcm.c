@@ -35,7 +35,7 @@
 typedef struct snd_sof_pcm {
 	snd_pcm_ioplug_t io;
 	size_t frame_size;
-	struct timespec wait_timeout;
+	struct plug_spin spin;
 	int capture;
 	int events;
 
@@ -120,6 +120,27 @@ static int plug_pipelines_set_state(snd_sof_plug_t *plug, int state)
 	return 0;
 }
 
+/* tell pipeline i to copy and wait for it to complete or timeout */
+static int plug_pipeline_copy(snd_sof_pcm_t *pcm, int i, snd_pcm_uframes_t frames)
+{
+	int err, delay;
+
+	sem_post(pcm->ready[i].sem);
+
+	/* work out delay TODO: fix ALSA reader */
+	delay = pcm->frame_us * frames / 500;
+
+	/* wait for sof-pipe to consume or produce data or timeout */
+	err = plug_lock_timedwait(&pcm->done[i], &pcm->spin, delay);
+	if (err < 0) {
+		SNDERR("%s: waited %d ms for %ld frames, fatal timeout: %s",
+		       pcm->capture ? "read" : "write", delay, frames, strerror(-err));
+		return err;
+	}
+
+	return 0;
+}
+
 static int plug_pcm_start(snd_pcm_ioplug_t *io)
 {
 	snd_sof_plug_t *plug = io->private_data;
@@ -136,7 +157,7 @@ static int plug_pcm_start(snd_pcm_ioplug_t *io)
 	case SOF_PLUGIN_STATE_STREAM_RUNNING:
 	{
 		struct tplg_pipeline_list *pipeline_list;
-		int i, delay;
+		int i;
 
 		if (!pcm->capture)
 			break;
@@ -145,26 +166,9 @@ static int plug_pcm_start(snd_pcm_ioplug_t *io)
 
 		/* start the first period copy for capture */
 		for (i = pipeline_list->count - 1; i >= 0; i--) {
-			sem_post(pcm->ready[i].sem);
-
-			/* wait for sof-pipe reader to consume data or timeout */
-			err = clock_gettime(CLOCK_REALTIME, &pcm->wait_timeout);
-			if (err == -1) {
-				SNDERR("write: cant get time: %s", strerror(errno));
-				return -EPIPE;
-			}
-
-			/* work out delay TODO: fix ALSA reader */
-			delay = pcm->frame_us * io->period_size / 500;
-			plug_timespec_add_ms(&pcm->wait_timeout, delay);
-
-			/* wait for sof-pipe writer to produce data or timeout */
-			err = sem_timedwait(pcm->done[i].sem, &pcm->wait_timeout);
-			if (err == -1) {
-				SNDERR("read: waited %d ms for %ld frames fatal timeout: %s",
-				       delay, io->period_size, strerror(errno));
-				return -errno;
-			}
+			err = plug_pipeline_copy(pcm, i, io->period_size);
+			if (err < 0)
+				return err;
 		}
 	}
 		break;
@@ -290,9 +294,9 @@ static snd_pcm_sframes_t plug_pcm_write(snd_pcm_ioplug_t *io, const snd_pcm_chan
 	struct tplg_pipeline_list *pipeline_list;
 	snd_pcm_sframes_t frames = 0;
 	int i;
-	ssize_t bytes;
+	ssize_t bytes, head;
 	const char *buf;
-	int err, delay;
+	int err;
 
 	pipeline_list = &plug->pcm_info->playback_pipeline_list;
 
@@ -308,35 +312,18 @@ static snd_pcm_sframes_t plug_pcm_write(snd_pcm_ioplug_t *io, const snd_pcm_chan
 	if (frames == 0)
 		return frames;
 
-	/* write audio data to the pipe */
-	memcpy(plug_ep_wptr(ctx), buf, bytes);
+	/* write audio data to the pipe, mmap commits can cross the ring end */
+	head = MIN(bytes, plug_ep_wrap_wsize(ctx));
+	memcpy(plug_ep_wptr(ctx), buf, head);
+	memcpy(ctx->data, buf + head, bytes - head);
 
 	plug_ep_produce(ctx, bytes);
 
 	/* tell the pipelines data is ready starting at the source pipeline */
 	for (i = 0; i < pipeline_list->count; i++) {
-		struct tplg_pipeline_info *pipe_info = pipeline_list->pipelines[i];
-
-		sem_post(pcm->ready[i].sem);
-
-		/* wait for sof-pipe reader to consume data or timeout */
-		err = clock_gettime(CLOCK_REALTIME, &pcm->wait_timeout);
-		if (err == -1) {
-			SNDERR("write: cant get time: %s", strerror(errno));
-			return -EPIPE;
-		}
-
-		/* work out delay */
-		delay = pcm->frame_us * frames / 500;
-		plug_timespec_add_ms(&pcm->wait_timeout, delay);
-
-		/* now block caller on pipeline IO to PCM device */
-		err = sem_timedwait(pcm->done[i].sem, &pcm->wait_timeout);
-		if (err == -1) {
-			SNDERR("write: waited %d ms for %ld frames, fatal timeout: %s",
-			       delay, frames, strerror(errno));
-			return -errno;
-		}
+		err = plug_pipeline_copy(pcm, i, frames);
+		if (err < 0)
+			return err;
 	}
 
 	return frames;
@@ -351,12 +338,24 @@ static snd_pcm_sframes_t plug_pcm_read(snd_pcm_ioplug_t *io, const snd_pcm_chann
 	snd_pcm_sframes_t frames;
 	struct plug_shm_endpoint *ctx = pcm->shm_pcm.addr;
 	struct tplg_pipeline_list *pipeline_list;
-	ssize_t bytes;
+	ssize_t bytes, head;
 	char *buf;
-	int err, delay, i;
+	int err, i;
 
 	pipeline_list = &plug->pcm_info->capture_pipeline_list;
 
+	/*
+	 * Only wake the pipelines when the ring runs below a period, reads
+	 * of data they have already produced need no round trip to sof-pipe.
+	 */
+	if (plug_ep_get_avail(ctx) < io->period_size * pcm->frame_size) {
+		for (i = pipeline_list->count - 1; i >= 0; i--) {
+			err = plug_pipeline_copy(pcm, i, size);
+			if (err < 0)
+				return err;
+		}
+	}
+
 	/* calculate the buffer position and size */
 	buf = (char *)areas->addr + (areas->first + areas->step * offset) / 8;
 	bytes = size * pcm->frame_size;
@@ -368,32 +367,10 @@ static snd_pcm_sframes_t plug_pcm_read(snd_pcm_ioplug_t *io, const snd_pcm_chann
 	if (!frames)
 		return 0;
 
-	/* tell the pipe ready we are ready for next period */
-	for (i = pipeline_list->count - 1; i >= 0; i--) {
-		sem_post(pcm->ready[i].sem);
-
-		/* wait for sof-pipe reader to consume data or timeout */
-		err = clock_gettime(CLOCK_REALTIME, &pcm->wait_timeout);
-		if (err == -1) {
-			SNDERR("write: cant get time: %s", strerror(errno));
-			return -EPIPE;
-		}
-
-		/* work out delay TODO: fix ALSA reader */
-		delay = pcm->frame_us * frames / 500;
-		plug_timespec_add_ms(&pcm->wait_timeout, delay);
-
-		/* wait for sof-pipe writer to produce data or timeout */
-		err = sem_timedwait(pcm->done[i].sem, &pcm->wait_timeout);
-		if (err == -1) {
-			SNDERR("read: waited %d ms for %ld frames fatal timeout: %s",
-			       delay, frames, strerror(errno));
-			return -errno;
-		}
-	}
-
-	/* copy audio data from pipe */
-	memcpy(buf, plug_ep_rptr(ctx), bytes);
+	/* copy audio data from pipe, mmap reads can cross the ring end */
+	head = MIN(bytes, plug_ep_wrap_rsize(ctx));
+	memcpy(buf, plug_ep_rptr(ctx), head);
+	memcpy(buf + head, ctx->data, bytes - head);
 	plug_ep_consume(ctx, bytes);
 
 	return frames;
@@ -406,12 +383,7 @@ static int plug_pcm_prepare(snd_pcm_ioplug_t *io)
 	struct plug_shm_endpoint *ctx = pcm->shm_pcm.addr;
 	int err = 0;
 
-	ctx->wtotal = 0;
-	ctx->rtotal = 0;
-	ctx->rpos = 0;
-	ctx->rwrap = 0;
-	ctx->wpos = 0;
-	ctx->wwrap = 0;
+	plug_ep_reset(ctx);
 
 	/* start the pipeline threads
 	 *
@@ -461,6 +433,7 @@ static int plug_pcm_hw_params(snd_pcm_ioplug_t *io, snd_pcm_hw_params_t *params)
 	int i, err;
 
 	pcm->frame_size = (snd_pcm_format_physical_width(io->format) * io->channels) / 8;
+	plug_spin_init(&pcm->spin);
 
 	plug->period_size = io->period_size;
 
@@ -730,8 +703,14 @@ static const snd_pcm_ioplug_callback_t sof_capture_callback = {
 	.close = plug_pcm_close,
 };
 
+/*
+ * The ioplug layer owns the mmap buffer and hands committed mmap areas to
+ * the transfer callbacks, so mmap clients get a single copy into the SHM
+ * ring. sof-pipe runs the pipeline on the ring in place.
+ */
 static const snd_pcm_access_t access_list[] = {
-	SND_PCM_ACCESS_RW_INTERLEAVED
+	SND_PCM_ACCESS_RW_INTERLEAVED,
+	SND_PCM_ACCESS_MMAP_INTERLEAVED,
 };
 
 static const unsigned int formats[] = {
@@ -814,7 +793,7 @@ static int plug_hw_constraint(snd_sof_plug_t *plug)
 /*
  * Register the plugin with ALSA and make available for use.
  * TODO: setup all audio params
- * TODO: setup polling fd for RW or mmap IOs
+ * TODO: setup polling fd for non blocking IOs
  */
 static int plug_create(snd_sof_plug_t *plug, snd_pcm_t **pcmp, const char *name,
 		       snd_pcm_stream_t stream, int mode)
@@ -29,6 +29,7 @@
 #include <errno.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <time.h>
 
 #include "common.h"
 
@@ -128,6 +129,66 @@ int plug_lock_init(struct plug_sem_desc *lock, const char *tplg, const char *typ
 	return 0;
 }
 
+/*
+ * Read the spin setting from the SOF_PLUGIN_SPIN_US environment variable:
+ * unset or 0 sleeps on locks right away, N spins adaptively for up to N us
+ * before sleeping and -1 busy-polls.
+ */
+void plug_spin_init(struct plug_spin *spin)
+{
+	const char *env = getenv("SOF_PLUGIN_SPIN_US");
+	long us = env ? atol(env) : 0;
+
+	spin->max_ns = us < 0 ? -1 : us * 1000;
+	spin->budget_ns = spin->max_ns;
+}
+
+/*
+ * Wait for the peer to post the lock. With spinning enabled the lock is
+ * polled first: the peer usually posts within a few tens of us at short
+ * periods and the futex sleep and wake up cost more than the spin. The
+ * spin budget doubles while the peer posts within it and halves while it
+ * does not.
+ */
+int plug_lock_timedwait(struct plug_sem_desc *lock, struct plug_spin *spin,
+			unsigned long timeout_ms)
+{
+	struct timespec start, now;
+	long spin_ns;
+	int err;
+
+	err = clock_gettime(CLOCK_REALTIME, &start);
+	if (err == -1)
+		return -errno;
+
+	spin_ns = spin->max_ns < 0 ? (long)timeout_ms * 1000000 : spin->budget_ns;
+	if (spin_ns > 0) {
+		do {
+			if (!sem_trywait(lock->sem)) {
+				if (spin->max_ns > 0 && spin->budget_ns < spin->max_ns / 2)
+					spin->budget_ns *= 2;
+				else if (spin->max_ns > 0)
+					spin->budget_ns = spin->max_ns;
+				return 0;
+			}
+
+			clock_gettime(CLOCK_REALTIME, &now);
+		} while (plug_timespec_delta_ns(&start, &now) < spin_ns);
+
+		if (spin->max_ns > 0 && spin->budget_ns / 2 > PLUG_SPIN_MIN_NS)
+			spin->budget_ns /= 2;
+		else if (spin->max_ns > 0)
+			spin->budget_ns = PLUG_SPIN_MIN_NS;
+	}
+
+	plug_timespec_add_ms(&start, timeout_ms);
+	err = sem_timedwait(lock->sem, &start);
+	if (err == -1)
+		return -errno;
+
+	return 0;
+}
+
 /*
  * SHM
  *
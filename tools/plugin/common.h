@@ -9,6 +9,7 @@
 #define __SOF_PLUGIN_COMMON_H__
 
 #include <stdint.h>
+#include <stdatomic.h>
 #include <mqueue.h>
 #include <semaphore.h>
 #include <alsa/asoundlib.h>
@@ -37,6 +38,9 @@
 
 #define NUM_EP_CONFIGS		8
 
+/* shortest spin before sleeping on a lock once spinning is enabled */
+#define PLUG_SPIN_MIN_NS	2000
+
 /*
  * Run with valgrind
  * valgrind --trace-children=yes aplay -v -Dsof:blah.tplg,1,hw:1,2  -f dat /dev/zero
@@ -124,13 +128,14 @@ struct plug_shm_endpoint {
 	uint32_t pipeline_id;
 	uint32_t comp_id;
 	uint32_t idx;
-	unsigned long rpos;	/* current position in ring buffer */
-	unsigned long rwrap;
-	unsigned long wpos;	/* current position in ring buffer */
-	unsigned long wwrap;
+	/*
+	 * Single producer single consumer ring. Only the producer updates
+	 * wtotal and only the consumer updates rtotal, so no lock is needed.
+	 * The ring positions are the totals modulo buffer_size.
+	 */
+	atomic_ulong wtotal;		/* total bytes produced */
+	atomic_ulong rtotal;		/* total bytes consumed */
 	unsigned long buffer_size;		/* buffer size */
-	unsigned long wtotal;		/* total frames copied */
-	unsigned long rtotal;		/* total frames copied */
 	int frame_size;
 	char data[0];		// TODO: align this on SIMD/cache
 };
@@ -165,82 +170,93 @@ struct plug_sem_desc {
 	sem_t *sem;
 };
 
+/* adaptive spinning before sleeping on a lock, see plug_lock_timedwait() */
+struct plug_spin {
+	long max_ns;		/* 0 never spins, < 0 busy-polls */
+	long budget_ns;		/* current spin before sleeping */
+};
+
 struct plug_ctl_container {
 	struct snd_soc_tplg_ctl_hdr *tplg[MAX_CTLS];
 	int updated[MAX_CTLS];
 	int count;
 };
 
+static inline unsigned long plug_ep_rpos(struct plug_shm_endpoint *ep)
+{
+	return atomic_load_explicit(&ep->rtotal, memory_order_relaxed) % ep->buffer_size;
+}
+
+static inline unsigned long plug_ep_wpos(struct plug_shm_endpoint *ep)
+{
+	return atomic_load_explicit(&ep->wtotal, memory_order_relaxed) % ep->buffer_size;
+}
+
+/* consumer side */
 static inline void *plug_ep_rptr(struct plug_shm_endpoint *ep)
 {
-	return ep->data + ep->rpos;
+	return ep->data + plug_ep_rpos(ep);
 }
 
+/* producer side */
 static inline void *plug_ep_wptr(struct plug_shm_endpoint *ep)
 {
-	return ep->data + ep->wpos;
+	return ep->data + plug_ep_wpos(ep);
 }
 
 static inline int plug_ep_wrap_rsize(struct plug_shm_endpoint *ep)
 {
-	return ep->buffer_size - ep->rpos;
+	return ep->buffer_size - plug_ep_rpos(ep);
 }
 
 static inline int plug_ep_wrap_wsize(struct plug_shm_endpoint *ep)
 {
-	return ep->buffer_size - ep->wpos;
+	return ep->buffer_size - plug_ep_wpos(ep);
 }
 
+/* producer side, the acquire pairs with the release in plug_ep_consume() */
 static inline int plug_ep_get_free(struct plug_shm_endpoint *ep)
 {
-	if (ep->rwrap == ep->wwrap) {
-		/* calculate available bytes */
-		if (ep->rpos < ep->wpos)
-			return ep->buffer_size - (ep->wpos - ep->rpos);
-		else
-			return ep->buffer_size;
-	} else {
-		return ep->rpos - ep->wpos;
-	}
+	unsigned long rtotal = atomic_load_explicit(&ep->rtotal, memory_order_acquire);
+	unsigned long wtotal = atomic_load_explicit(&ep->wtotal, memory_order_relaxed);
+
+	return ep->buffer_size - (wtotal - rtotal);
 }
 
+/* consumer side, the acquire pairs with the release in plug_ep_produce() */
 static inline int plug_ep_get_avail(struct plug_shm_endpoint *ep)
 {
-	if (ep->rwrap == ep->wwrap) {
-		/* calculate available bytes */
-		if (ep->rpos < ep->wpos)
-			return ep->wpos - ep->rpos;
-		else
-			return 0;
-	} else {
-		return (ep->buffer_size - ep->rpos) + ep->wpos;
-	}
+	unsigned long wtotal = atomic_load_explicit(&ep->wtotal, memory_order_acquire);
+	unsigned long rtotal = atomic_load_explicit(&ep->rtotal, memory_order_relaxed);
+
+	return wtotal - rtotal;
 }
 
+/* release the consumed bytes to the producer */
 static inline void *plug_ep_consume(struct plug_shm_endpoint *ep, unsigned int bytes)
 {
-	ep->rtotal += bytes;
-	ep->rpos += bytes;
+	unsigned long rtotal = atomic_load_explicit(&ep->rtotal, memory_order_relaxed);
 
-	if (ep->rpos >= ep->buffer_size) {
-		ep->rpos -= ep->buffer_size;
-		ep->rwrap++;
-	}
+	atomic_store_explicit(&ep->rtotal, rtotal + bytes, memory_order_release);
 
-	return ep->data + ep->rpos;
+	return plug_ep_rptr(ep);
 }
 
+/* publish the produced bytes to the consumer */
 static inline void *plug_ep_produce(struct plug_shm_endpoint *ep, unsigned int bytes)
 {
-	ep->wtotal += bytes;
-	ep->wpos += bytes;
+	unsigned long wtotal = atomic_load_explicit(&ep->wtotal, memory_order_relaxed);
 
-	if (ep->wpos >= ep->buffer_size) {
-		ep->wpos -= ep->buffer_size;
-		ep->wwrap++;
-	}
+	atomic_store_explicit(&ep->wtotal, wtotal + bytes, memory_order_release);
 
-	return ep->data + ep->wpos;
+	return plug_ep_wptr(ep);
+}
+
+/* only when neither side is running */
+static inline void plug_ep_reset(struct plug_shm_endpoint *ep)
+{
+	atomic_store(&ep->wtotal, 0);
+	atomic_store(&ep->rtotal, 0);
 }
 
 /*
@@ -281,6 +297,11 @@ int plug_lock_init(struct plug_sem_desc *lock, const char *tplg, const char *typ
 
 int plug_lock_open(struct plug_sem_desc *lock);
 
+void plug_spin_init(struct plug_spin *spin);
+
+int plug_lock_timedwait(struct plug_sem_desc *lock, struct plug_spin *spin,
+			unsigned long timeout_ms);
+
 /*
  * Timing.
  */
@@ -18,6 +18,7 @@
 
 #include <rtos/sof.h>
 #include <sof/list.h>
+#include <sof/audio/buffer.h>
 #include <sof/audio/stream.h>
 #include <sof/audio/ipc-config.h>
 #include <sof/ipc/driver.h>
@@ -47,6 +48,17 @@ struct shm_comp_data {
 	/* PCM data */
 	struct plug_shm_desc pcm;
 	struct plug_shm_endpoint *ctx;
+
+	/*
+	 * Pipeline buffer using the SHM ring in place. The plugin and the
+	 * pipeline then share the samples and only the ring totals and
+	 * the buffer pointers are synced on copy.
+	 */
+	struct comp_buffer *attached;
+	void *buffer_addr;		/* own memory of the attached buffer */
+	uint32_t buffer_size;
+	unsigned long synced;		/* ring total the buffer is synced to */
+	struct buffer_hook free_hook;	/* detaches before the buffer is freed */
 #if CONFIG_IPC_MAJOR_4
 	struct ipc4_base_module_cfg base_cfg;
 #endif
@@ -87,10 +99,81 @@ static int shm_process_new(struct comp_dev *dev,
 	return 0;
 }
 
+/* give the pipeline buffer its own memory back */
+static void shm_detach(struct comp_dev *dev)
+{
+	struct shm_comp_data *cd = comp_get_drvdata(dev);
+	struct audio_stream *stream;
+
+	if (!cd->attached)
+		return;
+
+	/* no-op when called from the free hook */
+	buffer_hook_remove(&cd->free_hook);
+
+	stream = &cd->attached->stream;
+	audio_stream_set_addr(stream, cd->buffer_addr);
+	audio_stream_set_size(stream, cd->buffer_size);
+	audio_stream_set_end_addr(stream, (char *)cd->buffer_addr + cd->buffer_size);
+	audio_stream_reset(stream);
+	cd->attached = NULL;
+}
+
+/* the buffer is about to be freed, it must not rfree() the SHM ring */
+static void shm_buffer_free_cb(void *arg, uint32_t type, void *data)
+{
+	shm_detach(arg);
+}
+
+/*
+ * Use the SHM ring as the memory of the pipeline buffer. This is done on
+ * copy and not on prepare since components can still resize the buffer
+ * during prepare. The buffer must be empty so no samples get lost, and it
+ * is set up to hold what the ring holds.
+ */
+static void shm_attach(struct comp_dev *dev, struct comp_buffer *buffer)
+{
+	struct shm_comp_data *cd = comp_get_drvdata(dev);
+	struct plug_shm_endpoint *ctx = cd->ctx;
+	struct audio_stream *stream = &buffer->stream;
+	unsigned long rtotal, wtotal;
+
+	if (audio_stream_get_avail_bytes(stream) || !ctx->buffer_size ||
+	    ctx->buffer_size > cd->pcm.size - sizeof(*ctx) ||
+	    ctx->buffer_size % audio_stream_frame_bytes(stream))
+		return;
+
+	cd->attached = buffer;
+	cd->buffer_addr = audio_stream_get_addr(stream);
+	cd->buffer_size = audio_stream_get_size(stream);
+
+	cd->free_hook.types = BUFF_CB_TYPE_FREE;
+	cd->free_hook.cb = shm_buffer_free_cb;
+	cd->free_hook.arg = dev;
+	buffer_hook_add(buffer, &cd->free_hook);
+
+	rtotal = atomic_load_explicit(&ctx->rtotal, memory_order_acquire);
+	wtotal = atomic_load_explicit(&ctx->wtotal, memory_order_acquire);
+
+	audio_stream_set_addr(stream, ctx->data);
+	audio_stream_set_size(stream, ctx->buffer_size);
+	audio_stream_set_end_addr(stream, ctx->data + ctx->buffer_size);
+	audio_stream_set_rptr(stream, plug_ep_rptr(ctx));
+	audio_stream_set_wptr(stream, plug_ep_wptr(ctx));
+	audio_stream_set_avail(stream, wtotal - rtotal);
+	audio_stream_set_free(stream, ctx->buffer_size - (wtotal - rtotal));
+
+	/* the buffer has seen everything written by the producer so far */
+	cd->synced = dev->direction == SOF_IPC_STREAM_PLAYBACK ? wtotal : rtotal;
+
+	comp_info(dev, "shm_attach(): buffer uses SHM ring of %lu bytes", ctx->buffer_size);
+}
+
 static void shm_free(struct comp_dev *dev)
 {
 	struct shm_comp_data *cd = comp_get_drvdata(dev);
 
+	shm_detach(dev);
 	cd->ctx = NULL;
 
 	plug_shm_free(&cd->pcm);
@@ -254,6 +337,25 @@ static int shmread_copy(struct comp_dev *dev)
 	buffer = list_first_item(&dev->bsource_list, struct comp_buffer,
 				 sink_list);
 	source = &buffer->stream;
+
+	if (cd->attached) {
+		unsigned long rtotal = atomic_load_explicit(&ctx->rtotal, memory_order_acquire);
+
+		/* the plugin resets the ring on prepare, start over */
+		if (rtotal < cd->synced) {
+			shm_detach(dev);
+			shm_attach(dev, buffer);
+			return 0;
+		}
+
+		/* free what the plugin has read, publish what the pipeline wrote */
+		comp_update_buffer_consume(buffer, rtotal - cd->synced);
+		cd->synced = rtotal;
+		plug_ep_produce(ctx, rtotal + audio_stream_get_avail_bytes(source) -
+				atomic_load_explicit(&ctx->wtotal, memory_order_relaxed));
+		return 0;
+	}
+
 	rptr = source->r_ptr;
 
 	/* remote SHM sink buffer */
@@ -291,6 +393,8 @@ static int shmread_copy(struct comp_dev *dev)
 	comp_update_buffer_consume(buffer, total);
 	comp_dbg(dev, "wrote %d bytes", total);
 
+	shm_attach(dev, buffer);
+
 	return 0;
 }
 
@@ -313,6 +417,29 @@ static int shmwrite_copy(struct comp_dev *dev)
 	buffer = list_first_item(&dev->bsink_list, struct comp_buffer,
 				 source_list);
 	sink = &buffer->stream;
+
+	if (!cd->attached)
+		shm_attach(dev, buffer);
+
+	if (cd->attached) {
+		unsigned long wtotal = atomic_load_explicit(&ctx->wtotal, memory_order_acquire);
+		unsigned long rtotal = cd->synced - audio_stream_get_avail_bytes(sink);
+
+		/* the plugin resets the ring on prepare, start over */
+		if (wtotal < cd->synced) {
+			shm_detach(dev);
+			shm_attach(dev, buffer);
+			return 0;
+		}
+
+		/* free what the pipeline has read, pass on what the plugin wrote */
+		plug_ep_consume(ctx, rtotal -
+				atomic_load_explicit(&ctx->rtotal, memory_order_relaxed));
+		comp_update_buffer_produce(buffer, wtotal - cd->synced);
+		cd->synced = wtotal;
+		return 0;
+	}
+
 	wptr = sink->w_ptr;
 
 	/* remote SHM source buffer */
@@ -378,6 +505,7 @@ static int shm_reset(struct comp_dev *dev)
 	struct shm_comp_data *cd = comp_get_drvdata(dev);
 	struct plug_shm_endpoint *ctx = cd->ctx;
 
+	shm_detach(dev);
 	comp_set_state(dev, COMP_TRIGGER_RESET);
 	ctx->state = SOF_PLUGIN_STATE_INIT;
 
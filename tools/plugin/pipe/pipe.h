@@ -35,6 +35,7 @@ struct pipethread_data {
 	/* PCM flow control */
 	struct plug_sem_desc ready;
 	struct plug_sem_desc done;
+	struct plug_spin spin;
 	atomic_int pipe_users;
 };
 
@@ -33,10 +33,12 @@
 #include <sof/audio/component_ext.h>
 #include <rtos/task.h>
 #include <sof/lib/notifier.h>
+#include <sof/schedule/dp_schedule.h>
 #include <sof/schedule/edf_schedule.h>
 #include <sof/schedule/ll_schedule.h>
 #include <sof/schedule/ll_schedule_domain.h>
 #include <sof/schedule/schedule.h>
+#include <platform/lib/ll_schedule.h>
 #include <stdatomic.h>
 
 #include "common.h"
@@ -46,6 +48,27 @@
 
 static struct ll_schedule_domain domain = {0};
 
+/*
+ * Every running pipeline thread copies once per period. The DP scheduler
+ * counts deadlines in LL ticks so only one of them, the tick owner, ends
+ * the LL tick. The first thread to copy takes it over when it is free.
+ */
+static _Atomic(struct pipethread_data *) tick_owner;
+
+static bool pipe_tick_owner(struct pipethread_data *pd)
+{
+	struct pipethread_data *owner = NULL;
+
+	return atomic_compare_exchange_strong(&tick_owner, &owner, pd) || owner == pd;
+}
+
+static void pipe_tick_release(struct pipethread_data *pd)
+{
+	struct pipethread_data *owner = pd;
+
+	atomic_compare_exchange_strong(&tick_owner, &owner, NULL);
+}
+
 // TODO: all these steps are probably not needed - i.e we only need IPC and pipeline.
 int pipe_sof_setup(struct sof *sof)
 {
@@ -78,30 +101,27 @@ int pipe_sof_setup(struct sof *sof)
 		return -EINVAL;
 	}
 
+#if CONFIG_DP_SCHEDULER
+	/* init DP scheduler */
+	if (scheduler_dp_init() < 0) {
+		fprintf(stderr, "error: dp scheduler init\n");
+		return -EINVAL;
+	}
+#endif
+
 	return 0;
 }
 
 static inline int pipe_copy_ready(struct pipethread_data *pd)
 {
-	struct timespec delay;
 	int err;
 
-	/* get the current time for source delay */
-	err = clock_gettime(CLOCK_REALTIME, &delay);
-	if (err == -1) {
-		fprintf(_sp->log, "shm: cant get time: %s", strerror(errno));
-		return -errno;
-	}
-
-	// TODO get from rate
-	plug_timespec_add_ms(&delay, 2000);
-
-	/* wait for data from source */
-	err = sem_timedwait(pd->ready.sem, &delay);
-	if (err == -1) {
+	/* wait for data from source, TODO get timeout from rate */
+	err = plug_lock_timedwait(&pd->ready, &pd->spin, 2000);
+	if (err < 0) {
 		fprintf(_sp->log, "%s %d: fatal timeout: %s on %s\n", __FILE__, __LINE__,
-			strerror(errno), pd->ready.name);
-		return -errno;
+			strerror(-err), pd->ready.name);
+		return err;
 	}
 
 	return 0;
@@ -145,6 +165,10 @@ static void *pipe_process_thread(void *arg)
 		/* sink has read data so now generate more it */
 		err = pipeline_copy(pd->pcm_pipeline);
 
+		/* LL tick done, trigger the DP modules that are ready */
+		if (pipe_tick_owner(pd))
+			schedule_ll_post_run();
+
 		pipe_copy_done(pd);
 
 		if (err < 0) {
@@ -157,6 +181,7 @@ static void *pipe_process_thread(void *arg)
 
 	} while (1);
 
+	pipe_tick_release(pd);
 	fprintf(_sp->log, "pipe complete for pipeline %d\n",
 		pd->pcm_pipeline->pipeline_id);
 	return 0;
@@ -270,6 +295,9 @@ int pipe_thread_stop(struct sof_pipe *sp, struct pipeline *p)
 		return -errno;
 	}
 
+	/* a cancelled thread does not release the tick itself */
+	pipe_tick_release(pd);
+
 	return ret;
 }
 
@@ -296,6 +324,7 @@ int pipe_thread_new(struct sof_pipe *sp, struct pipeline *p)
 	pd = &pipeline_ctx[p->pipeline_id];
 	pd->sp = _sp;
 	pd->pcm_pipeline = p;
+	plug_spin_init(&pd->spin);
 
 	/* initialise global IPC data */
 	/* TODO: change the PCM name to tplg or make it per PID*/
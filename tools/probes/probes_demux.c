@@ -5,8 +5,11 @@
 // Author: Adrian Bonislawski <adrian.bonislawski@intel.com>
 //         Jyri Sarha <jyri.sarha@intel.com> (restructured and moved to this file)
 
+#define _GNU_SOURCE
+
 #include <ctype.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <inttypes.h>
 #include <stdbool.h>
 #include <stddef.h>
@@ -14,7 +17,9 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
+#include <sys/ioctl.h>
 
 #include <ipc/probe_dma_frame.h>
 
@@ -23,18 +28,27 @@
 #define APP_NAME "sof-probes"
 
 #define PACKET_MAX_SIZE	4096	/**< Size limit for probe data packet */
-#define DATA_READ_LIMIT 4096	/**< Data limit for file read */
+#define DATA_READ_LIMIT 65536	/**< Data limit for input read */
 #define FILES_LIMIT	32	/**< Maximum num of probe output files */
 #define FILE_PATH_LIMIT 128	/**< Path limit for probe output files */
+#define WAVE_UPDATE_PERIOD 1	/**< Seconds between wave header updates */
 
 struct wave_files {
 	FILE *fd;
 	uint32_t buffer_id;
 	uint32_t fmt;
 	uint32_t size;
+	uint32_t header_size;	/* Data size in the written header */
 	struct wave header;
 };
 
+/* Live copy of one probe point to a named pipe */
+struct probe_tap {
+	const char *path;
+	uint32_t buffer_id;
+	int fd;			/* -1 while there is no listener */
+};
+
 enum p_state {
 	READY = 0,		/**< At this stage app is looking for a SYNC word */
 	SYNC,			/**< SYNC received, copying data */
@@ -50,6 +64,8 @@ struct dma_frame_parser {
 	uint32_t total_data_to_copy;		/* Total bytes left to copy */
 	int start;				/* Start of unfilled data */
 	int len;				/* Data buffer fill level */
+	time_t update_time;			/* Last wave header update */
+	struct probe_tap tap;
 	uint8_t data[DATA_READ_LIMIT];
 	struct wave_files files[FILES_LIMIT];
 };
@@ -139,34 +155,113 @@ int init_wave(struct dma_frame_parser *p, uint32_t buffer_id, uint32_t format)
 	return i;
 }
 
+/*
+ * Fill the sizes in the header at the beginning of the file, so it can be
+ * played while the capture is still running. The sizes are written with
+ * pwrite() after flushing, the stream position is left untouched.
+ */
+static void update_wave_header(struct wave_files *file)
+{
+	uint32_t chunk_size = file->size + sizeof(struct wave) -
+			      offsetof(struct riff_chunk, format);
+	int fd = fileno(file->fd);
+
+	fflush(file->fd);
+
+	if (pwrite(fd, &chunk_size, sizeof(chunk_size),
+		   offsetof(struct wave, riff.chunk_size)) != sizeof(chunk_size) ||
+	    pwrite(fd, &file->size, sizeof(file->size),
+		   offsetof(struct wave, data.subchunk_size)) != sizeof(file->size)) {
+		fprintf(stderr, "error: unable to update header of buffer %u, error %d\n",
+			file->buffer_id, errno);
+		return;
+	}
+
+	file->header_size = file->size;
+}
+
+static void update_wave_files(struct dma_frame_parser *p)
+{
+	struct wave_files *files = p->files;
+	time_t now = time(NULL);
+	uint32_t i;
+
+	if (now - p->update_time < WAVE_UPDATE_PERIOD)
+		return;
+
+	p->update_time = now;
+
+	for (i = 0; i < FILES_LIMIT; i++) {
+		if (files[i].fd && is_audio_format(files[i].fmt) &&
+		    files[i].size != files[i].header_size)
+			update_wave_header(&files[i]);
+	}
+}
+
 void finalize_wave_files(struct dma_frame_parser *p)
 {
 	struct wave_files *files = p->files;
-	uint32_t i, chunk_size;
+	uint32_t i;
 
 	/* fill the header at the beginning of each file */
 	/* and close all opened files */
-	/* check wave struct to understand the offsets */
 	for (i = 0; i < FILES_LIMIT; i++) {
 		if (!is_audio_format(files[i].fmt))
 			continue;
 
 		if (files[i].fd) {
-			chunk_size = files[i].size + sizeof(struct wave) -
-				     offsetof(struct riff_chunk, format);
-
-			fseek(files[i].fd, sizeof(uint32_t), SEEK_SET);
-			fwrite(&chunk_size, sizeof(uint32_t), 1, files[i].fd);
-			fseek(files[i].fd, sizeof(struct wave) -
-			      offsetof(struct data_subchunk, subchunk_size),
-			      SEEK_SET);
-			fwrite(&files[i].size, sizeof(uint32_t), 1, files[i].fd);
-
+			update_wave_header(&files[i]);
 			fclose(files[i].fd);
 		}
 	}
 }
 
+/*
+ * Forward a packet to the tap pipe. The pipe is opened without blocking
+ * once a listener is there, and packets that do not fit in the pipe are
+ * dropped whole so the capture never waits for the listener and the
+ * listener never gets a partial frame.
+ */
+static void tap_write(struct probe_tap *tap, struct wave_files *file,
+		      const uint8_t *data, uint32_t size)
+{
+	struct wave header = file->header;
+	int pipe_size;
+	int queued;
+
+	if (tap->fd < 0) {
+		tap->fd = open(tap->path, O_WRONLY | O_NONBLOCK);
+		if (tap->fd < 0)
+			return;
+
+		fprintf(stderr, "%s:\t Listener connected to %s\n", APP_NAME, tap->path);
+
+		/* the stream length is not known, use the maximum */
+		if (is_audio_format(file->fmt)) {
+			header.riff.chunk_size = UINT32_MAX;
+			header.data.subchunk_size = UINT32_MAX - sizeof(struct wave);
+			if (write(tap->fd, &header, sizeof(header)) != sizeof(header))
+				goto err;
+		}
+	}
+
+	pipe_size = fcntl(tap->fd, F_GETPIPE_SZ);
+	if (pipe_size > 0 && ioctl(tap->fd, FIONREAD, &queued) == 0 &&
+	    pipe_size - queued < size)
+		return;
+
+	if (write(tap->fd, data, size) == size)
+		return;
+
+	/* EAGAIN without the pipe size check, EPIPE if the listener left */
+	if (errno == EAGAIN)
+		return;
+err:
+	fprintf(stderr, "%s:\t Listener disconnected from %s\n", APP_NAME, tap->path);
+	close(tap->fd);
+	tap->fd = -1;
+}
+
 int validate_data_packet(struct probe_data_packet *packet)
 {
 	uint64_t *checksump;
@@ -233,11 +328,14 @@ struct dma_frame_parser *parser_init(void)
 	}
 	memset(p->packet, 0, PACKET_MAX_SIZE);
 	p->packet_size = PACKET_MAX_SIZE;
+	p->tap.fd = -1;
 	return p;
 }
 
 void parser_free(struct dma_frame_parser *p)
 {
+	if (p->tap.fd >= 0)
+		close(p->tap.fd);
 	free(p->packet);
 	free(p);
 }
@@ -247,36 +345,59 @@ void parser_log_to_stdout(struct dma_frame_parser *p)
 	p->log_to_stdout = true;
 }
 
+void parser_set_tap(struct dma_frame_parser *p, uint32_t buffer_id, const char *path)
+{
+	p->tap.buffer_id = buffer_id;
+	p->tap.path = path;
+}
+
 void parser_fetch_free_buffer(struct dma_frame_parser *p, uint8_t **d, size_t *len)
 {
 	*d = &p->data[p->start];
 	*len = sizeof(p->data) - p->start;
 }
 
+/*
+ * Find the next possible SYNC word from i, memchr() scans for its first
+ * byte much faster than comparing the word at every offset.
+ */
+static uint find_sync(struct dma_frame_parser *p, uint i)
+{
+	uint8_t *sync = memchr(&p->data[i], PROBE_EXTRACT_SYNC_WORD & 0xff, p->len - i);
+
+	return sync ? sync - p->data : p->len;
+}
+
 int parser_parse_data(struct dma_frame_parser *p, size_t d_len)
 {
 	uint i = 0;
 
 	p->len = p->start + d_len;
-	/* processing all loaded bytes */
-	while (i < p->len) {
+	p->start = 0;
+	/* processing all loaded bytes, and a packet completed by the last ones */
+	while (i < p->len || (p->total_data_to_copy == 0 && p->state != READY)) {
 		if (p->total_data_to_copy == 0) {
 			switch (p->state) {
 			case READY:
 				/* check for SYNC */
+				i = find_sync(p, i);
+				if (i == p->len)
+					break;
+
 				if (p->len - i < sizeof(p->packet->sync_word)) {
 					p->start = p->len - i;
 					memmove(&p->data[0], &p->data[i], p->start);
 					i += p->start;
-				} else if (*((uint32_t *)&p->data[i]) ==
-					   PROBE_EXTRACT_SYNC_WORD) {
+					break;
+				}
+
+				if (*((uint32_t *)&p->data[i]) == PROBE_EXTRACT_SYNC_WORD) {
 					memset(p->packet, 0, p->packet_size);
 					/* request to copy full data packet */
 					p->total_data_to_copy =
 						sizeof(struct probe_data_packet);
 					p->w_ptr = (uint8_t *)p->packet;
 					p->state = SYNC;
-					p->start = 0;
 				} else {
 					i++;
 				}
@@ -311,6 +432,10 @@ int parser_parse_data(struct dma_frame_parser *p, size_t d_len)
 					       p->packet->data_size_bytes,
 					       p->files[file].fd);
 					p->files[file].size += p->packet->data_size_bytes;
+
+					if (p->tap.path && p->tap.buffer_id == p->packet->buffer_id)
+						tap_write(&p->tap, &p->files[file], p->packet->data,
+							  p->packet->data_size_bytes);
 					}
 				p->state = READY;
 				break;
@@ -334,5 +459,8 @@ int parser_parse_data(struct dma_frame_parser *p, size_t d_len)
 			i += data_to_copy;
 		}
 	}
+
+	update_wave_files(p);
+
 	return 0;
 }
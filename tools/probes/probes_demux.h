@@ -18,6 +18,8 @@ struct dma_frame_parser *parser_init(void);
 
 void parser_log_to_stdout(struct dma_frame_parser *p);
 
+void parser_set_tap(struct dma_frame_parser *p, uint32_t buffer_id, const char *path);
+
 void parser_free(struct dma_frame_parser *p);
 
 void parser_fetch_free_buffer(struct dma_frame_parser *p, uint8_t **d, size_t *len);
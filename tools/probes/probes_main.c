@@ -11,15 +11,28 @@
  *
  * Usage to parse data and create wave files: ./sof-probes -p data.bin
  *
+ * The input can also be a pipe, a UNIX socket or stdin, the wave files
+ * are kept playable while the capture is running. One buffer can be
+ * forwarded live to a named pipe:
+ *
+ *   mkfifo tap; aplay tap &
+ *   ./sof-probes -p capture_pipe -t 7:tap
+ *
  */
 
 #include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
 
 #include "probes_demux.h"
 
@@ -30,17 +43,53 @@ static void usage(void)
 	fprintf(stdout, "Usage %s <option(s)> <buffer_id/file>\n\n", APP_NAME);
 	fprintf(stdout, "%s:\t -p file\tParse extracted file\n\n", APP_NAME);
 	fprintf(stdout, "%s:\t -l \t\tLog to stdout\n\n", APP_NAME);
+	fprintf(stdout, "%s:\t -t id:fifo\tForward buffer id to named pipe fifo\n\n",
+		APP_NAME);
 	fprintf(stdout, "%s:\t -h \t\tHelp, usage info\n", APP_NAME);
 	exit(0);
 }
 
-void parse_data(const char *file_in, bool log_to_stdout)
+/* open a file or a pipe, or connect to a UNIX socket */
+static int open_input(const char *file_in)
+{
+	struct sockaddr_un addr;
+	struct stat st;
+	int fd;
+
+	if (!file_in)
+		return STDIN_FILENO;
+
+	if (stat(file_in, &st) == 0 && S_ISSOCK(st.st_mode)) {
+		memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		strncpy(addr.sun_path, file_in, sizeof(addr.sun_path) - 1);
+
+		fd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (fd >= 0 && connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+			close(fd);
+			fd = -1;
+		}
+	} else {
+		fd = open(file_in, O_RDONLY);
+	}
+
+	if (fd < 0) {
+		fprintf(stderr, "error: unable to open file %s, error %d\n",
+			file_in, errno);
+		exit(0);
+	}
+
+	return fd;
+}
+
+void parse_data(const char *file_in, bool log_to_stdout, uint32_t tap_id,
+		const char *tap_path)
 {
 	struct dma_frame_parser *p = parser_init();
-	FILE *fd_in;
 	uint8_t *data;
+	ssize_t ret;
 	size_t len;
-	int ret;
+	int fd_in;
 
 	if (!p) {
 		fprintf(stderr, "parser_init() failed\n");
@@ -50,35 +99,43 @@ void parse_data(const char *file_in, bool log_to_stdout)
 	if (log_to_stdout)
 		parser_log_to_stdout(p);
 
-	if (file_in) {
-		fd_in = fopen(file_in, "rb");
-		if (!fd_in) {
-			fprintf(stderr, "error: unable to open file %s, error %d\n",
-				file_in, errno);
-			exit(0);
-		}
-	} else {
-		fd_in = stdin;
+	if (tap_path) {
+		/* a listener leaving the pipe must not end the capture */
+		signal(SIGPIPE, SIG_IGN);
+		parser_set_tap(p, tap_id, tap_path);
 	}
 
+	fd_in = open_input(file_in);
+
+	/* read returns what is available, so pipes are parsed as they fill */
 	do {
 		parser_fetch_free_buffer(p, &data, &len);
-		len = fread(data, 1, len, fd_in);
-		ret = parser_parse_data(p, len);
-	} while (!ret && !feof(fd_in));
+		ret = read(fd_in, data, len);
+		if (ret < 0 && errno == EINTR)
+			continue;
+		if (ret <= 0)
+			break;
+		ret = parser_parse_data(p, ret);
+	} while (!ret);
 
 	if (!log_to_stdout)
 		finalize_wave_files(p);
 
+	if (fd_in != STDIN_FILENO)
+		close(fd_in);
+	parser_free(p);
 }
 
 int main(int argc, char *argv[])
 {
 	const char *fname = NULL;
+	const char *tap_path = NULL;
 	bool log_to_stdout = false;
+	uint32_t tap_id = 0;
+	char *end;
 	int opt;
 
-	while ((opt = getopt(argc, argv, "lhp:")) != -1) {
+	while ((opt = getopt(argc, argv, "lhp:t:")) != -1) {
 		switch (opt) {
 		case 'p':
 			fname = optarg;
@@ -86,13 +143,19 @@ int main(int argc, char *argv[])
 		case 'l':
 			log_to_stdout = true;
 			break;
+		case 't':
+			tap_id = strtoul(optarg, &end, 0);
+			if (end == optarg || *end != ':' || !end[1])
+				usage();
+			tap_path = end + 1;
+			break;
 		case 'h':
 		default:
 			usage();
 			return 0;
 		}
 	}
-	parse_data(fname, log_to_stdout);
+	parse_data(fname, log_to_stdout, tap_id, tap_path);
 
 	return 0;
 }
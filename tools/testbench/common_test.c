@@ -131,8 +131,72 @@ static struct comp_dev *tb_get_pipeline_host(struct pipeline *p)
 	return cd;
 }
 
+/* remember the topology DSP core of a pipeline */
+int tb_pipeline_set_core(struct testbench_prm *tp, uint32_t pipeline_id, uint32_t core)
+{
+	int i;
+
+	if (core >= TB_MAX_VCORES) {
+		fprintf(stderr, "error: pipeline %u core %u, max %d cores supported\n",
+			pipeline_id, core, TB_MAX_VCORES);
+		return -EINVAL;
+	}
+
+	for (i = 0; i < tp->pipeline_core_num; i++) {
+		if (tp->pipeline_cores[i].pipeline_id == pipeline_id) {
+			tp->pipeline_cores[i].core = core;
+			return 0;
+		}
+	}
+
+	if (tp->pipeline_core_num == TB_MAX_PIPELINES) {
+		fprintf(stderr, "error: max %d pipelines supported\n", TB_MAX_PIPELINES);
+		return -EINVAL;
+	}
+
+	tp->pipeline_cores[i].pipeline_id = pipeline_id;
+	tp->pipeline_cores[i].core = core;
+	tp->pipeline_core_num++;
+	return 0;
+}
+
+/* get the topology DSP core of a pipeline, core 0 if not known */
+uint32_t tb_pipeline_get_core(struct testbench_prm *tp, uint32_t pipeline_id)
+{
+	int i;
+
+	for (i = 0; i < tp->pipeline_core_num; i++)
+		if (tp->pipeline_cores[i].pipeline_id == pipeline_id)
+			return tp->pipeline_cores[i].core;
+
+	return 0;
+}
+
+/*
+ * The firmware library runs as a single DSP core, so all pipelines are
+ * created on core 0. In multicore mode the pipeline tasks are moved to the
+ * LL task list of their topology core before they get scheduled.
+ */
+static void tb_pipeline_map_cores(struct testbench_prm *tp, struct ipc *ipc)
+{
+	struct ipc_comp_dev *icd;
+	struct list_item *clist;
+
+	list_for_item(clist, &ipc->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->type != COMP_TYPE_PIPELINE || !icd->pipeline->pipe_task)
+			continue;
+
+		if (task_is_active(icd->pipeline->pipe_task))
+			continue;
+
+		icd->pipeline->pipe_task->core =
+			tb_pipeline_get_core(tp, icd->pipeline->pipeline_id);
+	}
+}
+
 /* set up pcm params, prepare and trigger pipeline */
-int tb_pipeline_start(struct ipc *ipc, struct pipeline *p)
+int tb_pipeline_start(struct testbench_prm *tp, struct ipc *ipc, struct pipeline *p)
 {
 	struct comp_dev *cd;
 	int ret;
@@ -148,6 +212,9 @@ int tb_pipeline_start(struct ipc *ipc, struct pipeline *p)
 		return ret;
 	}
 
+	if (tp->multicore)
+		tb_pipeline_map_cores(tp, ipc);
+
 	/* Start the pipeline */
 	ret = pipeline_trigger(cd->pipeline, cd, COMP_TRIGGER_PRE_START);
 	if (ret < 0) {
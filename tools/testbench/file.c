@@ -4,13 +4,18 @@
 
 /* file component for reading/writing pcm samples to/from a file */
 
+#define _GNU_SOURCE
+
 #include <stdio.h>
 #include <stdint.h>
 #include <stddef.h>
 #include <stdlib.h>
 #include <errno.h>
 #include <inttypes.h>
+#include <string.h>
+#include <strings.h>
 #include <rtos/sof.h>
+#include <rtos/string.h>
 #include <sof/list.h>
 #include <sof/audio/stream.h>
 #include <sof/audio/ipc-config.h>
@@ -23,6 +28,12 @@
 #include "testbench/common_test.h"
 #include "testbench/file.h"
 
+#if !defined __XCC__
+#include <pthread.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 /* bfc7488c-75aa-4ce8-9bde-d8da08a698c2 */
 DECLARE_SOF_RT_UUID("file", file_uuid, 0xbfc7488c, 0x75aa, 0x4ce8,
 		    0x9d, 0xbe, 0xd8, 0xda, 0x08, 0xa6, 0x98, 0xc2);
@@ -79,6 +90,779 @@ static void sign_extend_source_s24(const struct audio_stream *source, int sample
 	}
 }
 
+/* align s24_4le source samples to MSB of 32-bit container for WAV output */
+static void msb_align_source_s24(const struct audio_stream *source, int samples)
+{
+	uint32_t *src = (uint32_t *)source->r_ptr;
+	size_t bytes = samples * sizeof(int32_t);
+	size_t bytes_src;
+	int samples_avail;
+	int i;
+
+	while (bytes) {
+		bytes_src = audio_stream_bytes_without_wrap(source, src);
+		samples_avail = FILE_BYTES_TO_S32_SAMPLES(MIN(bytes, bytes_src));
+		for (i = 0; i < samples_avail; i++)
+			*src++ <<= 8;
+
+		bytes -= samples_avail * sizeof(int32_t);
+		src = audio_stream_wrap(source, src);
+	}
+}
+
+/*
+ * WAV files. The sample format is taken from the header of input files and
+ * checked against the stream parameters. Output files get a header for the
+ * stream format with unknown sizes, which readers take as data until end of
+ * file. The sizes are updated while writing to a mapped file and when the
+ * file is closed.
+ */
+
+#define FILE_WAV_FORMAT_PCM		0x0001
+#define FILE_WAV_FORMAT_FLOAT		0x0003
+#define FILE_WAV_FORMAT_EXTENSIBLE	0xfffe
+
+#define FILE_WAV_SIZE_UNKNOWN		0xffffffff
+
+/* samples converted at a time when reading with stdio */
+#define FILE_WAV_BUF_SAMPLES		1024
+
+struct file_wav_chunk {
+	char id[4];
+	uint32_t size;
+};
+
+/* fmt chunk, fields from ext_size on are present only with WAVE_FORMAT_EXTENSIBLE */
+struct file_wav_fmt {
+	uint16_t format;
+	uint16_t channels;
+	uint32_t rate;
+	uint32_t byte_rate;
+	uint16_t block_align;
+	uint16_t bits;
+	uint16_t ext_size;
+	uint16_t valid_bits;
+	uint32_t channel_mask;
+	uint8_t subformat[16];
+};
+
+#define FILE_WAV_FMT_PCM_SIZE	offsetof(struct file_wav_fmt, ext_size)
+
+/* RIFF chunk, WAVE id, fmt chunk and data chunk */
+#define FILE_WAV_HEADER_MAX	(2 * sizeof(struct file_wav_chunk) + 4 + \
+				 sizeof(struct file_wav_chunk) + sizeof(struct file_wav_fmt))
+
+/* KSDATAFORMAT_SUBTYPE_PCM, the first two bytes are the format tag */
+static const uint8_t file_wav_subformat_pcm[16] = {
+	0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00,
+	0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71,
+};
+
+/* parse header, leaves the file position at start of samples */
+static int file_wav_read_header(FILE *fh, struct file_wav *wav)
+{
+	struct file_wav_chunk chunk;
+	struct file_wav_fmt fmt;
+	bool have_fmt = false;
+	char id[4];
+	size_t pos;
+	size_t n;
+
+	memset(&fmt, 0, sizeof(fmt));
+	if (fread(&chunk, sizeof(chunk), 1, fh) != 1 || memcmp(chunk.id, "RIFF", 4) ||
+	    fread(id, sizeof(id), 1, fh) != 1 || memcmp(id, "WAVE", 4))
+		return -EINVAL;
+
+	pos = sizeof(chunk) + sizeof(id);
+
+	/* skip other chunks until data, chunks are padded to even size */
+	for (;;) {
+		if (fread(&chunk, sizeof(chunk), 1, fh) != 1)
+			return -EINVAL;
+
+		pos += sizeof(chunk);
+		if (!memcmp(chunk.id, "data", 4))
+			break;
+
+		n = 0;
+		if (!memcmp(chunk.id, "fmt ", 4)) {
+			if (chunk.size < FILE_WAV_FMT_PCM_SIZE)
+				return -EINVAL;
+
+			n = MIN(chunk.size, sizeof(fmt));
+			if (fread(&fmt, n, 1, fh) != 1)
+				return -EINVAL;
+
+			have_fmt = true;
+		}
+
+		if (fseek(fh, chunk.size - n + (chunk.size & 1), SEEK_CUR))
+			return -EINVAL;
+
+		pos += chunk.size + (chunk.size & 1);
+	}
+
+	if (!have_fmt || !fmt.channels || fmt.block_align % fmt.channels)
+		return -EINVAL;
+
+	wav->format = fmt.format;
+	wav->valid_bits = fmt.bits;
+	if (fmt.format == FILE_WAV_FORMAT_EXTENSIBLE) {
+		if (fmt.ext_size < sizeof(fmt) - FILE_WAV_FMT_PCM_SIZE - sizeof(fmt.ext_size))
+			return -EINVAL;
+
+		wav->format = fmt.subformat[0] | fmt.subformat[1] << 8;
+		if (fmt.valid_bits)
+			wav->valid_bits = fmt.valid_bits;
+	}
+
+	wav->rate = fmt.rate;
+	wav->channels = fmt.channels;
+	wav->sample_bytes = fmt.block_align / fmt.channels;
+	wav->header_size = pos;
+
+	/* streaming writers leave the size zero or unknown */
+	if (chunk.size && chunk.size != FILE_WAV_SIZE_UNKNOWN)
+		wav->data_left = chunk.size;
+	else
+		wav->data_left = SIZE_MAX;
+
+	return 0;
+}
+
+/* stream frame format for the WAV samples, sets if the samples need conversion */
+static int file_wav_frame_fmt(struct file_wav *wav)
+{
+	switch (wav->format) {
+	case FILE_WAV_FORMAT_PCM:
+		if (wav->sample_bytes == sizeof(int16_t) && wav->valid_bits == 16) {
+			wav->convert = false;
+			return SOF_IPC_FRAME_S16_LE;
+		}
+
+		/* packed or MSB aligned 24-bit samples */
+		if ((wav->sample_bytes == 3 || wav->sample_bytes == sizeof(int32_t)) &&
+		    wav->valid_bits == 24) {
+			wav->convert = true;
+			return SOF_IPC_FRAME_S24_4LE;
+		}
+
+		if (wav->sample_bytes == sizeof(int32_t) && wav->valid_bits == 32) {
+			wav->convert = false;
+			return SOF_IPC_FRAME_S32_LE;
+		}
+
+		break;
+	case FILE_WAV_FORMAT_FLOAT:
+		if (wav->sample_bytes == sizeof(float) && wav->valid_bits == 32) {
+			wav->convert = true;
+			return SOF_IPC_FRAME_S32_LE;
+		}
+
+		break;
+	}
+
+	return -EINVAL;
+}
+
+static inline uint32_t file_wav_get_u32(const uint8_t *in)
+{
+	return in[0] | in[1] << 8 | in[2] << 16 | (uint32_t)in[3] << 24;
+}
+
+/* convert float sample in range -1.0 .. 1.0 to Q1.31 with saturation */
+static inline int32_t file_wav_float_to_s32(const uint8_t *in)
+{
+	uint32_t bits = file_wav_get_u32(in);
+	double val;
+	float f;
+
+	memcpy_s(&f, sizeof(f), &bits, sizeof(bits));
+	val = (double)f * 2147483648.0;
+	if (val >= INT32_MAX)
+		return INT32_MAX;
+
+	if (val <= INT32_MIN)
+		return INT32_MIN;
+
+	return val < 0 ? (int32_t)(val - 0.5) : (int32_t)(val + 0.5);
+}
+
+/* convert samples in file format to stream format */
+static void file_wav_to_stream(const struct file_wav *wav, const uint8_t *in, uint8_t *out,
+			       int samples)
+{
+	int32_t *out32 = (int32_t *)out;
+	int i;
+
+	if (!wav->convert) {
+		memcpy_s(out, samples * wav->sample_bytes, in, samples * wav->sample_bytes);
+		return;
+	}
+
+	if (wav->format == FILE_WAV_FORMAT_FLOAT) {
+		for (i = 0; i < samples; i++, in += sizeof(float))
+			out32[i] = file_wav_float_to_s32(in);
+	} else if (wav->sample_bytes == 3) {
+		for (i = 0; i < samples; i++, in += 3)
+			out32[i] = (int32_t)(in[0] << 8 | in[1] << 16 | (uint32_t)in[2] << 24) >> 8;
+	} else {
+		for (i = 0; i < samples; i++, in += sizeof(int32_t))
+			out32[i] = (int32_t)file_wav_get_u32(in) >> 8;
+	}
+}
+
+static int file_wav_check_params(struct file_comp_data *cd, const struct audio_stream *stream)
+{
+	struct file_wav *wav = &cd->fs.wav;
+
+	if (file_wav_frame_fmt(wav) != audio_stream_get_frm_fmt(stream) ||
+	    wav->channels != audio_stream_get_channels(stream) ||
+	    wav->rate != audio_stream_get_rate(stream)) {
+		fprintf(stderr, "error: %s format %d channels %d rate %d, ",
+			cd->fs.fn, file_wav_frame_fmt(wav), wav->channels, wav->rate);
+		fprintf(stderr, "stream format %d channels %d rate %d\n",
+			audio_stream_get_frm_fmt(stream), audio_stream_get_channels(stream),
+			audio_stream_get_rate(stream));
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static void file_wav_put_chunk(uint8_t *hdr, size_t *pos, const char *id, uint32_t size)
+{
+	struct file_wav_chunk chunk;
+
+	memcpy_s(chunk.id, sizeof(chunk.id), id, sizeof(chunk.id));
+	chunk.size = size;
+	memcpy_s(hdr + *pos, FILE_WAV_HEADER_MAX - *pos, &chunk, sizeof(chunk));
+	*pos += sizeof(chunk);
+}
+
+/* write header for the stream format with unknown sizes */
+static int file_wav_write_header(struct file_comp_data *cd, const struct audio_stream *stream)
+{
+	struct file_wav_fmt fmt;
+	uint8_t hdr[FILE_WAV_HEADER_MAX];
+	size_t fmt_size = FILE_WAV_FMT_PCM_SIZE;
+	size_t pos = 0;
+	int sample_bytes = audio_stream_sample_bytes(stream);
+
+	/* file may be prepared again, keep the samples already written */
+	if (cd->fs.wav.header_size)
+		return 0;
+
+	memset(&fmt, 0, sizeof(fmt));
+	fmt.format = FILE_WAV_FORMAT_PCM;
+	fmt.channels = audio_stream_get_channels(stream);
+	fmt.rate = audio_stream_get_rate(stream);
+	fmt.block_align = fmt.channels * sample_bytes;
+	fmt.byte_rate = fmt.rate * fmt.block_align;
+	fmt.bits = sample_bytes * 8;
+
+	/* s24_4le is stored MSB aligned, valid bits need the extensible format */
+	if (audio_stream_get_frm_fmt(stream) == SOF_IPC_FRAME_S24_4LE) {
+		fmt.format = FILE_WAV_FORMAT_EXTENSIBLE;
+		fmt.ext_size = sizeof(fmt) - FILE_WAV_FMT_PCM_SIZE - sizeof(fmt.ext_size);
+		fmt.valid_bits = 24;
+		memcpy_s(fmt.subformat, sizeof(fmt.subformat), file_wav_subformat_pcm,
+			 sizeof(file_wav_subformat_pcm));
+		fmt_size = sizeof(fmt);
+	}
+
+	file_wav_put_chunk(hdr, &pos, "RIFF", FILE_WAV_SIZE_UNKNOWN);
+	memcpy_s(hdr + pos, sizeof(hdr) - pos, "WAVE", 4);
+	pos += 4;
+	file_wav_put_chunk(hdr, &pos, "fmt ", fmt_size);
+	memcpy_s(hdr + pos, sizeof(hdr) - pos, &fmt, fmt_size);
+	pos += fmt_size;
+	file_wav_put_chunk(hdr, &pos, "data", FILE_WAV_SIZE_UNKNOWN);
+
+	cd->fs.wav.header_size = pos;
+	if (cd->fs.map) {
+		memcpy_s(cd->fs.map, cd->fs.map_size, hdr, pos);
+		cd->fs.map_pos = pos;
+		return 0;
+	}
+
+	if (fwrite(hdr, pos, 1, cd->fs.wfh) != 1)
+		return -EIO;
+
+	return 0;
+}
+
+/* set RIFF and data chunk sizes for output file of given size */
+static void file_wav_update_sizes(struct file_comp_data *cd, size_t file_size)
+{
+	size_t data_pos = cd->fs.wav.header_size - sizeof(uint32_t);
+	uint32_t riff_size = FILE_WAV_SIZE_UNKNOWN;
+	uint32_t data_size = FILE_WAV_SIZE_UNKNOWN;
+
+	/* leave unknown sizes for files larger than 4 GB */
+	if (file_size - 8 < FILE_WAV_SIZE_UNKNOWN) {
+		riff_size = file_size - 8;
+		data_size = file_size - cd->fs.wav.header_size;
+	}
+
+	if (cd->fs.map) {
+		memcpy_s(cd->fs.map + 4, cd->fs.map_size - 4, &riff_size, sizeof(riff_size));
+		memcpy_s(cd->fs.map + data_pos, cd->fs.map_size - data_pos, &data_size,
+			 sizeof(data_size));
+		return;
+	}
+
+	if (fseek(cd->fs.wfh, 4, SEEK_SET) ||
+	    fwrite(&riff_size, sizeof(riff_size), 1, cd->fs.wfh) != 1 ||
+	    fseek(cd->fs.wfh, data_pos, SEEK_SET) ||
+	    fwrite(&data_size, sizeof(data_size), 1, cd->fs.wfh) != 1)
+		fprintf(stderr, "error: updating WAV header of %s\n", cd->fs.fn);
+}
+
+static void file_wav_close(struct file_comp_data *cd)
+{
+	if (cd->fs.mode != FILE_WRITE || cd->fs.f_format != FILE_WAV || !cd->fs.wav.header_size)
+		return;
+
+	if (cd->fs.map)
+		file_wav_update_sizes(cd, cd->fs.map_pos);
+	else
+		file_wav_update_sizes(cd, ftell(cd->fs.wfh));
+}
+
+int file_wav_get_params(const char *filename, uint32_t *rate, uint32_t *channels,
+			enum sof_ipc_frame *frame_fmt)
+{
+	struct file_wav wav;
+	FILE *fh;
+	int ret;
+
+	fh = fopen(filename, "r");
+	if (!fh)
+		return -errno;
+
+	ret = file_wav_read_header(fh, &wav);
+	fclose(fh);
+	if (ret < 0)
+		return ret;
+
+	ret = file_wav_frame_fmt(&wav);
+	if (ret < 0)
+		return ret;
+
+	*rate = wav.rate;
+	*channels = wav.channels;
+	*frame_fmt = ret;
+	return 0;
+}
+
+#if !defined __XCC__
+
+/* output mapping grows in steps of this size, truncated at file close */
+#define FILE_MAP_WRITE_CHUNK	(16 * 1024 * 1024)
+
+/* text input smaller than this is converted in a single thread */
+#define FILE_TEXT_THREAD_MIN	(1024 * 1024)
+#define FILE_TEXT_THREADS_MAX	16
+
+/* part of a text file converted by one thread */
+struct file_text_job {
+	const char *begin;
+	const char *end;
+	uint8_t *out; /* NULL when only counting samples */
+	int sample_bytes;
+	size_t count;
+	bool invalid;
+};
+
+static off_t file_size(FILE *fh)
+{
+	off_t pos = lseek(fileno(fh), 0, SEEK_CUR);
+	off_t size = lseek(fileno(fh), 0, SEEK_END);
+
+	lseek(fileno(fh), pos, SEEK_SET);
+	return size;
+}
+
+static inline bool file_text_is_space(char c)
+{
+	return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+/* parse decimal integers separated by white space, like fscanf("%d") */
+static void *file_text_parse(void *arg)
+{
+	struct file_text_job *job = arg;
+	const char *p = job->begin;
+	int64_t val;
+	bool neg;
+
+	job->count = 0;
+	while (p < job->end) {
+		if (file_text_is_space(*p)) {
+			p++;
+			continue;
+		}
+
+		neg = *p == '-';
+		if (*p == '-' || *p == '+')
+			p++;
+
+		if (p == job->end || *p < '0' || *p > '9') {
+			job->invalid = true;
+			break;
+		}
+
+		val = 0;
+		while (p < job->end && *p >= '0' && *p <= '9')
+			val = val * 10 + *p++ - '0';
+
+		if (job->out) {
+			if (neg)
+				val = -val;
+
+			if (job->sample_bytes == sizeof(int16_t))
+				((int16_t *)job->out)[job->count] = val;
+			else
+				((int32_t *)job->out)[job->count] = val;
+		}
+
+		job->count++;
+	}
+
+	return NULL;
+}
+
+static void file_text_run_jobs(struct file_text_job *jobs, int num_jobs)
+{
+	pthread_t threads[FILE_TEXT_THREADS_MAX];
+	int i;
+
+	for (i = 1; i < num_jobs; i++)
+		if (pthread_create(&threads[i], NULL, file_text_parse, &jobs[i]))
+			file_text_parse(&jobs[i]);
+
+	file_text_parse(&jobs[0]);
+
+	for (i = 1; i < num_jobs; i++)
+		pthread_join(threads[i], NULL);
+}
+
+/*
+ * Convert the whole text input to raw samples in an unlinked temporary file
+ * and map it, so file_copy() reads it like a raw input. The text is split
+ * at white space into parts that are counted and then converted in parallel.
+ */
+static int file_map_text_input(struct file_comp_data *cd, int sample_bytes)
+{
+	struct file_text_job jobs[FILE_TEXT_THREADS_MAX] = {{0}};
+	const char *text;
+	uint8_t *out;
+	size_t samples = 0;
+	size_t part;
+	FILE *tmp;
+	off_t size = file_size(cd->fs.rfh);
+	int num_jobs;
+	int ret = 0;
+	int i;
+
+	if (size <= 0)
+		return -EINVAL;
+
+	text = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fileno(cd->fs.rfh), 0);
+	if (text == MAP_FAILED)
+		return -errno;
+
+	num_jobs = 1;
+	if (size >= FILE_TEXT_THREAD_MIN)
+		num_jobs = MIN(sysconf(_SC_NPROCESSORS_ONLN), FILE_TEXT_THREADS_MAX);
+
+	/* split at white space */
+	part = size / num_jobs;
+	for (i = 0; i < num_jobs; i++) {
+		jobs[i].begin = i ? jobs[i - 1].end : text;
+		jobs[i].end = i == num_jobs - 1 ? text + size :
+			MAX(jobs[i].begin, text + part * (i + 1));
+		while (jobs[i].end < text + size && !file_text_is_space(*jobs[i].end))
+			jobs[i].end++;
+		jobs[i].sample_bytes = sample_bytes;
+	}
+
+	/* first pass counts the samples of each part */
+	file_text_run_jobs(jobs, num_jobs);
+	for (i = 0; i < num_jobs; i++) {
+		samples += jobs[i].count;
+		if (jobs[i].invalid) {
+			/* keep the valid samples before the first invalid one */
+			num_jobs = i + 1;
+			fprintf(stderr, "warning: %s: invalid text, input stops at sample %zu\n",
+				cd->fs.fn, samples);
+			break;
+		}
+	}
+
+	if (!samples) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	tmp = tmpfile();
+	if (!tmp) {
+		ret = -errno;
+		goto out;
+	}
+
+	if (ftruncate(fileno(tmp), samples * sample_bytes) < 0) {
+		ret = -errno;
+		fclose(tmp);
+		goto out;
+	}
+
+	out = mmap(NULL, samples * sample_bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+		   fileno(tmp), 0);
+	fclose(tmp);
+	if (out == MAP_FAILED) {
+		ret = -errno;
+		goto out;
+	}
+
+	/* second pass converts each part to its place in the output */
+	for (i = 0; i < num_jobs; i++) {
+		jobs[i].out = i ? jobs[i - 1].out + jobs[i - 1].count * sample_bytes : out;
+		jobs[i].invalid = false;
+	}
+
+	file_text_run_jobs(jobs, num_jobs);
+
+	cd->fs.map = out;
+	cd->fs.map_size = samples * sample_bytes;
+	cd->fs.map_pos = 0;
+	cd->fs.map_end = cd->fs.map_size;
+
+out:
+	munmap((void *)text, size);
+	return ret;
+}
+
+static int file_map_raw_input(struct file_comp_data *cd)
+{
+	off_t size = file_size(cd->fs.rfh);
+	void *map;
+
+	if (size <= 0)
+		return -EINVAL;
+
+	map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fileno(cd->fs.rfh), 0);
+	if (map == MAP_FAILED)
+		return -errno;
+
+	madvise(map, size, MADV_SEQUENTIAL);
+	cd->fs.map = map;
+	cd->fs.map_size = size;
+	cd->fs.map_pos = 0;
+	cd->fs.map_end = size;
+
+	/* read only the WAV data chunk */
+	if (cd->fs.f_format == FILE_WAV) {
+		cd->fs.map_pos = MIN(cd->fs.wav.header_size, (size_t)size);
+		cd->fs.map_end = cd->fs.map_pos + MIN(cd->fs.wav.data_left, size - cd->fs.map_pos);
+	}
+
+	return 0;
+}
+
+static int file_map_grow_output(struct file_comp_data *cd)
+{
+	size_t size = cd->fs.map_size + FILE_MAP_WRITE_CHUNK;
+	void *map;
+
+	if (ftruncate(fileno(cd->fs.wfh), size) < 0)
+		return -errno;
+
+	if (cd->fs.map)
+		map = mremap(cd->fs.map, cd->fs.map_size, size, MREMAP_MAYMOVE);
+	else
+		map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+			   fileno(cd->fs.wfh), 0);
+	if (map == MAP_FAILED)
+		return -errno;
+
+	cd->fs.map = map;
+	cd->fs.map_size = size;
+	return 0;
+}
+
+/* map the file for file_copy(), stdio is used if this fails */
+static void file_map(struct file_comp_data *cd, int sample_bytes)
+{
+	int ret;
+
+	if (cd->fs.map)
+		return;
+
+	switch (cd->fs.mode) {
+	case FILE_READ:
+		if (cd->fs.f_format == FILE_TEXT)
+			ret = file_map_text_input(cd, sample_bytes);
+		else
+			ret = file_map_raw_input(cd);
+		break;
+	case FILE_WRITE:
+		/* text output is written with stdio */
+		if (cd->fs.f_format == FILE_TEXT)
+			return;
+
+		cd->fs.map_pos = 0;
+		ret = file_map_grow_output(cd);
+		break;
+	default:
+		return;
+	}
+
+	if (ret < 0)
+		debug_print("file_map(): using stdio for file\n");
+}
+
+static void file_unmap(struct file_comp_data *cd)
+{
+	if (!cd->fs.map)
+		return;
+
+	munmap(cd->fs.map, cd->fs.map_size);
+	cd->fs.map = NULL;
+
+	/* drop the unused part of the last output chunk */
+	if (cd->fs.mode == FILE_WRITE && ftruncate(fileno(cd->fs.wfh), cd->fs.map_pos) < 0)
+		fprintf(stderr, "error: truncating file %s - %s\n", cd->fs.fn, strerror(errno));
+}
+
+#else
+
+/* no mmap() in xt-run, always use stdio */
+static void file_map(struct file_comp_data *cd, int sample_bytes)
+{
+}
+
+static void file_unmap(struct file_comp_data *cd)
+{
+}
+
+static int file_map_grow_output(struct file_comp_data *cd)
+{
+	return -EINVAL;
+}
+
+#endif
+
+/*
+ * Copy samples from mapped input file to sink
+ */
+static int read_mapped(struct file_comp_data *cd, const struct audio_stream *sink,
+		       int samples, int sample_bytes)
+{
+	uint8_t *snk = sink->w_ptr;
+	size_t bytes_snk;
+	size_t bytes;
+	size_t n;
+	int samples_copied;
+
+	samples_copied = MIN((size_t)samples,
+			     (cd->fs.map_end - cd->fs.map_pos) / sample_bytes);
+	if (samples_copied < samples)
+		cd->fs.reached_eof = true;
+
+	bytes = samples_copied * sample_bytes;
+	while (bytes) {
+		bytes_snk = audio_stream_bytes_without_wrap(sink, snk);
+		n = MIN(bytes, bytes_snk);
+		memcpy_s(snk, bytes_snk, cd->fs.map + cd->fs.map_pos, n);
+		cd->fs.map_pos += n;
+		bytes -= n;
+		snk = audio_stream_wrap(sink, snk + n);
+	}
+
+	return samples_copied;
+}
+
+/*
+ * Copy samples from source to mapped output file
+ */
+static int write_mapped(struct file_comp_data *cd, const struct audio_stream *source,
+			int samples, int sample_bytes)
+{
+	uint8_t *src = source->r_ptr;
+	size_t bytes = samples * sample_bytes;
+	size_t bytes_src;
+	size_t n;
+
+	while (cd->fs.map_pos + bytes > cd->fs.map_size) {
+		if (file_map_grow_output(cd) < 0) {
+			cd->fs.write_failed = true;
+			return 0;
+		}
+	}
+
+	while (bytes) {
+		bytes_src = audio_stream_bytes_without_wrap(source, src);
+		n = MIN(bytes, bytes_src);
+		memcpy_s(cd->fs.map + cd->fs.map_pos, cd->fs.map_size - cd->fs.map_pos, src, n);
+		cd->fs.map_pos += n;
+		bytes -= n;
+		src = audio_stream_wrap(source, src + n);
+	}
+
+	/* keep the header valid for readers of the file while it is written */
+	if (cd->fs.f_format == FILE_WAV)
+		file_wav_update_sizes(cd, cd->fs.map_pos);
+
+	return samples;
+}
+
+/*
+ * Read samples from WAV data chunk, converting packed and MSB aligned 24-bit
+ * and float samples to the stream format
+ */
+static int read_wav(struct file_comp_data *cd, const struct audio_stream *sink, int samples)
+{
+	struct file_wav *wav = &cd->fs.wav;
+	uint8_t buf[FILE_WAV_BUF_SAMPLES * sizeof(int32_t)];
+	uint8_t *snk = sink->w_ptr;
+	const uint8_t *in;
+	int out_bytes = cd->sample_container_bytes;
+	int in_bytes = wav->sample_bytes;
+	int samples_copied = 0;
+	size_t n;
+
+	if (cd->fs.map && !wav->convert)
+		return read_mapped(cd, sink, samples, in_bytes);
+
+	while (samples_copied < samples) {
+		n = MIN(samples - samples_copied,
+			audio_stream_bytes_without_wrap(sink, snk) / out_bytes);
+		if (cd->fs.map) {
+			n = MIN(n, (cd->fs.map_end - cd->fs.map_pos) / in_bytes);
+			in = cd->fs.map + cd->fs.map_pos;
+			cd->fs.map_pos += n * in_bytes;
+		} else {
+			n = MIN(n, MIN(sizeof(buf) / in_bytes, wav->data_left / in_bytes));
+			n = fread(buf, in_bytes, n, cd->fs.rfh);
+			wav->data_left -= n * in_bytes;
+			in = buf;
+		}
+
+		if (!n) {
+			cd->fs.reached_eof = true;
+			break;
+		}
+
+		file_wav_to_stream(wav, in, snk, n);
+		samples_copied += n;
+		snk = audio_stream_wrap(sink, snk + n * out_bytes);
+	}
+
+	return samples_copied;
+}
+
 /*
  * Read 32-bit samples from binary file
  */
@@ -202,7 +986,18 @@ static int read_samples_s32(struct file_comp_data *cd, const struct audio_stream
 {
 	int n_samples = 0;
 
+	if (cd->fs.map && cd->fs.f_format != FILE_WAV) {
+		n_samples = read_mapped(cd, sink, samples, sizeof(int32_t));
+		if (fmt == SOF_IPC_FRAME_S24_4LE)
+			mask_sink_s24(sink, samples);
+
+		return n_samples;
+	}
+
 	switch (cd->fs.f_format) {
+	case FILE_WAV:
+		n_samples = read_wav(cd, sink, samples);
+		break;
 	case FILE_RAW:
 		/* raw input file */
 		n_samples = read_binary_s32(cd, sink, samples);
@@ -229,10 +1024,18 @@ static int write_samples_s32(struct file_comp_data *cd, struct audio_stream *sou
 {
 	int samples_written;
 
-	if (fmt == SOF_IPC_FRAME_S24_4LE)
-		sign_extend_source_s24(source, samples);
+	if (fmt == SOF_IPC_FRAME_S24_4LE) {
+		if (cd->fs.f_format == FILE_WAV)
+			msb_align_source_s24(source, samples);
+		else
+			sign_extend_source_s24(source, samples);
+	}
+
+	if (cd->fs.map)
+		return write_mapped(cd, source, samples, sizeof(int32_t));
 
 	switch (cd->fs.f_format) {
+	case FILE_WAV:
 	case FILE_RAW:
 		/* raw input file */
 		samples_written = write_binary_s32(cd, source, samples);
@@ -371,7 +1174,13 @@ static int read_samples_s16(struct file_comp_data *cd, const struct audio_stream
 {
 	int n_samples = 0;
 
+	if (cd->fs.map && cd->fs.f_format != FILE_WAV)
+		return read_mapped(cd, sink, samples, sizeof(int16_t));
+
 	switch (cd->fs.f_format) {
+	case FILE_WAV:
+		n_samples = read_wav(cd, sink, samples);
+		break;
 	case FILE_RAW:
 		/* raw input file */
 		n_samples = read_binary_s16(cd, sink, samples);
@@ -394,7 +1203,11 @@ static int write_samples_s16(struct file_comp_data *cd, struct audio_stream *sou
 {
 	int samples_written;
 
+	if (cd->fs.map)
+		return write_mapped(cd, source, samples, sizeof(int16_t));
+
 	switch (cd->fs.f_format) {
+	case FILE_WAV:
 	case FILE_RAW:
 		/* raw input file */
 		samples_written = write_binary_s16(cd, source, samples);
@@ -519,9 +1332,9 @@ static int file_s24(struct comp_dev *dev, struct audio_stream *sink,
 	return n_samples;
 }
 
-static enum file_format get_file_format(char *filename)
+enum file_format file_get_format(const char *filename)
 {
-	char *ext = strrchr(filename, '.');
+	const char *ext = strrchr(filename, '.');
 
 	if (!ext)
 		return FILE_RAW;
@@ -529,6 +1342,9 @@ static enum file_format get_file_format(char *filename)
 	if (!strcmp(ext, ".txt"))
 		return FILE_TEXT;
 
+	if (!strcasecmp(ext, ".wav"))
+		return FILE_WAV;
+
 	return FILE_RAW;
 }
 
@@ -579,7 +1395,7 @@ static struct comp_dev *file_new(const struct comp_driver *drv,
 	cd->fs.fn = strdup(ipc_file->fn);
 
 	/* set file format */
-	cd->fs.f_format = get_file_format(cd->fs.fn);
+	cd->fs.f_format = file_get_format(cd->fs.fn);
 
 	/* set file comp mode */
 	cd->fs.mode = ipc_file->mode;
@@ -598,6 +1414,13 @@ static struct comp_dev *file_new(const struct comp_driver *drv,
 				cd->fs.fn, strerror(errno));
 			goto error;
 		}
+
+		if (cd->fs.f_format == FILE_WAV &&
+		    file_wav_read_header(cd->fs.rfh, &cd->fs.wav) < 0) {
+			fprintf(stderr, "error: %s is not a valid WAV file\n", cd->fs.fn);
+			fclose(cd->fs.rfh);
+			goto error;
+		}
 		break;
 	case FILE_WRITE:
 		cd->fs.wfh = fopen(cd->fs.fn, "w+");
@@ -645,6 +1468,9 @@ static void file_free(struct comp_dev *dev)
 
 	comp_dbg(dev, "file_free()");
 
+	file_wav_close(cd);
+	file_unmap(cd);
+
 	if (cd->fs.mode == FILE_READ)
 		fclose(cd->fs.rfh);
 	else
@@ -760,6 +1586,23 @@ static int file_params(struct comp_dev *dev,
 	cd->sample_container_bytes = audio_stream_sample_bytes(stream);
 	buffer_reset_pos(buffer, NULL);
 
+	if (cd->fs.f_format == FILE_WAV && cd->fs.mode == FILE_READ) {
+		ret = file_wav_check_params(cd, stream);
+		if (ret < 0)
+			return ret;
+	}
+
+	/* memory map the file if possible */
+	file_map(cd, cd->sample_container_bytes);
+
+	if (cd->fs.f_format == FILE_WAV && cd->fs.mode == FILE_WRITE) {
+		ret = file_wav_write_header(cd, stream);
+		if (ret < 0) {
+			fprintf(stderr, "error: writing WAV header to %s\n", cd->fs.fn);
+			return ret;
+		}
+	}
+
 	return 0;
 }
 
@@ -27,7 +27,18 @@
 /* number of widgets types supported in testbench */
 #define NUM_WIDGETS_SUPPORTED	16
 
+/* max pipelines and DSP cores tracked for host thread mapping */
+#define TB_MAX_PIPELINES	64
+#define TB_MAX_VCORES		8
+
 struct tplg_context;
+struct tb_vcores;
+
+/* topology DSP core of a pipeline */
+struct tb_pipeline_core {
+	uint32_t pipeline_id;
+	uint32_t core;
+};
 
 /*
  * Global testbench data.
@@ -56,6 +67,11 @@ struct testbench_prm {
 	bool quiet;
 	int dynamic_pipeline_iterations;
 	int num_vcores;
+	bool multicore; /* run each topology DSP core on its own host thread */
+	bool profile; /* print per component copy() profile */
+	struct tb_vcores *vcores;
+	struct tb_pipeline_core pipeline_cores[TB_MAX_PIPELINES];
+	int pipeline_core_num;
 	int tick_period_us;
 	int pipeline_duration_ms;
 	int real_time;
@@ -94,7 +110,7 @@ void sys_comp_filewrite_init(void);
 int tb_setup(struct sof *sof, struct testbench_prm *tp);
 void tb_free(struct sof *sof);
 
-int tb_pipeline_start(struct ipc *ipc, struct pipeline *p);
+int tb_pipeline_start(struct testbench_prm *tp, struct ipc *ipc, struct pipeline *p);
 
 int tb_pipeline_params(struct testbench_prm *tp, struct ipc *ipc, struct pipeline *p,
 		       struct tplg_context *ctx);
@@ -103,6 +119,26 @@ int tb_pipeline_stop(struct ipc *ipc, struct pipeline *p);
 
 int tb_pipeline_reset(struct ipc *ipc, struct pipeline *p);
 
+int tb_pipeline_set_core(struct testbench_prm *tp, uint32_t pipeline_id, uint32_t core);
+
+uint32_t tb_pipeline_get_core(struct testbench_prm *tp, uint32_t pipeline_id);
+
+int tb_vcores_start(struct testbench_prm *tp);
+
+void tb_vcores_run_tick(struct testbench_prm *tp);
+
+void tb_vcores_stop(struct testbench_prm *tp);
+
+int tb_profile_init(void);
+
+void tb_profile_free(void);
+
+void tb_profile_print(void);
+
+/* comp_copy() is wrapped by the linker for profiling */
+int __real_comp_copy(struct comp_dev *dev);
+int __wrap_comp_copy(struct comp_dev *dev);
+
 void debug_print(char *message);
 
 void tb_gettime(struct timespec *td);
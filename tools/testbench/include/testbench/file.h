@@ -27,6 +27,19 @@ enum file_mode {
 enum file_format {
 	FILE_TEXT = 0,
 	FILE_RAW,
+	FILE_WAV,
+};
+
+/* WAV file sample format and data chunk position */
+struct file_wav {
+	uint32_t rate;
+	uint16_t channels;
+	uint16_t format;	/* PCM or IEEE float, also for WAVE_FORMAT_EXTENSIBLE */
+	uint16_t sample_bytes;	/* sample container size in file */
+	uint16_t valid_bits;
+	size_t header_size;	/* file offset of the samples */
+	size_t data_left;	/* sample bytes left to read */
+	bool convert;		/* file and stream sample layouts differ */
 };
 
 /* file component state */
@@ -40,6 +53,14 @@ struct file_state {
 	enum file_format f_format;
 	bool reached_eof;
 	bool write_failed;
+
+	/* memory mapped raw file or text input converted to raw */
+	uint8_t *map;
+	size_t map_size; /* mapped bytes */
+	size_t map_pos; /* read or write position in map */
+	size_t map_end; /* end of input samples in map */
+
+	struct file_wav wav;
 };
 
 /* file comp data */
@@ -57,4 +78,8 @@ struct file_comp_data {
 	int max_copies;
 };
 
+enum file_format file_get_format(const char *filename);
+int file_wav_get_params(const char *filename, uint32_t *rate, uint32_t *channels,
+			enum sof_ipc_frame *frame_fmt);
+
 #endif
@@ -0,0 +1,224 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+/*
+ * Per component profiling for the testbench. The testbench is linked with
+ * --wrap=comp_copy so every copy() done by the pipelines passes through
+ * __wrap_comp_copy(). The execution time and the bytes consumed from source
+ * buffers and produced to sink buffers are accumulated per component and
+ * printed as a table when the pipelines are stopped.
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/component.h>
+#include <sof/audio/component_ext.h>
+#include <sof/ipc/topology.h>
+#include <sof/list.h>
+#include "testbench/common_test.h"
+
+/* max component id profiled, ids are assigned sequentially from topology */
+#define TB_PROF_MAX_COMPS	256
+
+/*
+ * Log-linear histogram for percentiles: 8 linear bins for values 0..7, then
+ * 8 sub-bins per power of two. Reported percentiles are bin upper limits,
+ * so they are accurate to 1/8 of the value.
+ */
+#define TB_PROF_SUB_BITS	3
+#define TB_PROF_SUB_BINS	(1 << TB_PROF_SUB_BITS)
+#define TB_PROF_HIST_BINS	((64 - TB_PROF_SUB_BITS + 1) * TB_PROF_SUB_BINS)
+
+struct tb_prof_comp {
+	struct comp_dev *dev;
+	uint64_t calls;
+	uint64_t total;
+	uint64_t min;
+	uint64_t max;
+	uint64_t bytes_in;
+	uint64_t bytes_out;
+	uint32_t hist[TB_PROF_HIST_BINS];
+};
+
+static struct tb_prof_comp *tb_prof;
+
+/* timestamp in cycles on xt-run and nanoseconds on host */
+static inline uint64_t tb_prof_time(void)
+{
+#if defined __XCC__
+	uint64_t cycles;
+
+	tb_getcycles(&cycles);
+	return cycles;
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+static int tb_prof_bin(uint64_t value)
+{
+	int msb;
+
+	if (value < TB_PROF_SUB_BINS)
+		return value;
+
+	msb = 63 - __builtin_clzll(value);
+	return (msb - TB_PROF_SUB_BITS + 1) * TB_PROF_SUB_BINS +
+		((value >> (msb - TB_PROF_SUB_BITS)) & (TB_PROF_SUB_BINS - 1));
+}
+
+static uint64_t tb_prof_bin_max(int bin)
+{
+	int shift;
+
+	if (bin < TB_PROF_SUB_BINS)
+		return bin;
+
+	shift = bin / TB_PROF_SUB_BINS - 1;
+	return (((uint64_t)TB_PROF_SUB_BINS + bin % TB_PROF_SUB_BINS + 1) << shift) - 1;
+}
+
+static uint64_t tb_prof_percentile(struct tb_prof_comp *pc, int percent)
+{
+	uint64_t limit = (pc->calls * percent + 99) / 100;
+	uint64_t count = 0;
+	int i;
+
+	for (i = 0; i < TB_PROF_HIST_BINS; i++) {
+		count += pc->hist[i];
+		if (count >= limit)
+			return MIN(tb_prof_bin_max(i), pc->max);
+	}
+
+	return pc->max;
+}
+
+/* bytes that can be read from source buffers and written to sink buffers */
+static void tb_prof_buffer_levels(struct comp_dev *dev, uint64_t *avail, uint64_t *free)
+{
+	struct comp_buffer *buffer;
+	struct list_item *blist;
+
+	*avail = 0;
+	*free = 0;
+
+	list_for_item(blist, &dev->bsource_list) {
+		buffer = container_of(blist, struct comp_buffer, sink_list);
+		*avail += audio_stream_get_avail_bytes(&buffer->stream);
+	}
+
+	list_for_item(blist, &dev->bsink_list) {
+		buffer = container_of(blist, struct comp_buffer, source_list);
+		*free += audio_stream_get_free_bytes(&buffer->stream);
+	}
+}
+
+int __wrap_comp_copy(struct comp_dev *dev)
+{
+	struct tb_prof_comp *pc;
+	uint64_t avail0, free0, avail1, free1;
+	uint64_t t0, delta;
+	uint32_t id = dev_comp_id(dev);
+	int ret;
+
+	if (!tb_prof || id >= TB_PROF_MAX_COMPS)
+		return __real_comp_copy(dev);
+
+	pc = &tb_prof[id];
+	tb_prof_buffer_levels(dev, &avail0, &free0);
+	t0 = tb_prof_time();
+
+	ret = __real_comp_copy(dev);
+
+	delta = tb_prof_time() - t0;
+	tb_prof_buffer_levels(dev, &avail1, &free1);
+
+	if (pc->dev != dev) {
+		/* first copy of this component */
+		memset(pc, 0, sizeof(*pc));
+		pc->dev = dev;
+		pc->min = UINT64_MAX;
+	}
+
+	pc->calls++;
+	pc->total += delta;
+	pc->min = MIN(pc->min, delta);
+	pc->max = MAX(pc->max, delta);
+	pc->hist[tb_prof_bin(delta)]++;
+	if (avail0 > avail1)
+		pc->bytes_in += avail0 - avail1;
+	if (free0 > free1)
+		pc->bytes_out += free0 - free1;
+
+	return ret;
+}
+
+int tb_profile_init(void)
+{
+	tb_prof = calloc(TB_PROF_MAX_COMPS, sizeof(*tb_prof));
+	if (!tb_prof)
+		return -ENOMEM;
+
+	return 0;
+}
+
+void tb_profile_free(void)
+{
+	free(tb_prof);
+	tb_prof = NULL;
+}
+
+/* print the table and clear the data for the next pipelines run */
+void tb_profile_print(void)
+{
+	struct tb_prof_comp *pc;
+	const char *name;
+	uint64_t sum = 0;
+	int i;
+
+	if (!tb_prof)
+		return;
+
+	for (i = 0; i < TB_PROF_MAX_COMPS; i++)
+		sum += tb_prof[i].total;
+
+#if defined __XCC__
+	printf("Component copy() profile, time in cycles:\n");
+#else
+	printf("Component copy() profile, time in ns:\n");
+#endif
+	printf("%4s %-24s %9s %12s %9s %9s %9s %9s %6s %10s %10s\n",
+	       "id", "component", "calls", "total", "avg", "min", "max", "p99",
+	       "load%", "in B/call", "out B/call");
+
+	for (i = 0; i < TB_PROF_MAX_COMPS; i++) {
+		pc = &tb_prof[i];
+		if (!pc->dev || !pc->calls)
+			continue;
+
+		name = pc->dev->drv->tctx ? pc->dev->drv->tctx->uuid_p->name : "unknown";
+		printf("%4d %-24.24s %9llu %12llu %9llu %9llu %9llu %9llu %6.2f %10.1f %10.1f\n",
+		       i, name, (unsigned long long)pc->calls,
+		       (unsigned long long)pc->total,
+		       (unsigned long long)(pc->total / pc->calls),
+		       (unsigned long long)pc->min,
+		       (unsigned long long)pc->max,
+		       (unsigned long long)tb_prof_percentile(pc, 99),
+		       sum ? 100.0 * pc->total / sum : 0.0,
+		       (double)pc->bytes_in / pc->calls,
+		       (double)pc->bytes_out / pc->calls);
+	}
+
+	printf("\n");
+	memset(tb_prof, 0, TB_PROF_MAX_COMPS * sizeof(*tb_prof));
+}
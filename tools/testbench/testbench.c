@@ -108,6 +108,47 @@ static int parse_pipelines(char *pipelines, struct testbench_prm *tp)
 	return 0;
 }
 
+/* take input format from WAV header for the options not given */
+static int get_input_wav_params(struct testbench_prm *tp)
+{
+	enum sof_ipc_frame frame_fmt;
+	uint32_t channels;
+	uint32_t rate;
+	int ret;
+
+	if (!tp->input_file_num || file_get_format(tp->input_file[0]) != FILE_WAV)
+		return 0;
+
+	ret = file_wav_get_params(tp->input_file[0], &rate, &channels, &frame_fmt);
+	if (ret < 0) {
+		fprintf(stderr, "error: unsupported WAV file %s\n", tp->input_file[0]);
+		return ret;
+	}
+
+	if (!tp->bits_in) {
+		switch (frame_fmt) {
+		case SOF_IPC_FRAME_S16_LE:
+			tp->bits_in = strdup("S16_LE");
+			break;
+		case SOF_IPC_FRAME_S24_4LE:
+			tp->bits_in = strdup("S24_LE");
+			break;
+		default:
+			tp->bits_in = strdup("S32_LE");
+			break;
+		}
+		tp->frame_fmt = frame_fmt;
+	}
+
+	if (!tp->fs_in)
+		tp->fs_in = rate;
+
+	if (!tp->channels_in)
+		tp->channels_in = channels;
+
+	return 0;
+}
+
 /* print usage for testbench */
 static void print_usage(char *executable)
 {
@@ -125,7 +166,10 @@ static void print_usage(char *executable)
 	printf("  -D <pipeline duration in ms>\n");
 	printf("  -P <number of dynamic pipeline iterations>\n");
 	printf("  -T <microseconds for tick, 0 for batch mode>\n");
-	printf("Options for input and output format override:\n");
+	printf("  -M Run pipelines of each topology DSP core in own host thread\n");
+	printf("  -x Profile copy() of each component and print a report\n");
+	printf("Options for input and output format override, with WAV input\n");
+	printf("the input format defaults to the file header:\n");
 	printf("  -b <input_format>, S16_LE, S24_LE, or S32_LE\n");
 	printf("  -c <input channels>\n");
 	printf("  -n <output channels>\n");
@@ -144,36 +188,30 @@ static void print_usage(char *executable)
 /* free components */
 static void test_pipeline_free_comps(int pipeline_id)
 {
-	struct list_item *clist;
-	struct list_item *temp;
-	struct ipc_comp_dev *icd = NULL;
+	struct ipc *ipc = sof_get()->ipc;
+	struct ipc_comp_dev *icd;
+	struct ipc_comp_dev *next;
 	int err;
 
 	/* remove the components for this pipeline */
-	list_for_item_safe(clist, temp, &sof_get()->ipc->comp_list) {
-		icd = container_of(clist, struct ipc_comp_dev, list);
+	for (icd = ipc_ppl_comp_first(ipc, pipeline_id); icd; icd = next) {
+		next = ipc_ppl_comp_next(icd);
 
 		switch (icd->type) {
 		case COMP_TYPE_COMPONENT:
-			if (icd->cd->pipeline->pipeline_id != pipeline_id)
-				break;
-			err = ipc_comp_free(sof_get()->ipc, icd->id);
+			err = ipc_comp_free(ipc, icd->id);
 			if (err)
 				fprintf(stderr, "failed to free comp %d\n",
 					icd->id);
 			break;
 		case COMP_TYPE_BUFFER:
-			if (icd->cb->pipeline_id != pipeline_id)
-				break;
-			err = ipc_buffer_free(sof_get()->ipc, icd->id);
+			err = ipc_buffer_free(ipc, icd->id);
 			if (err)
 				fprintf(stderr, "failed to free buffer %d\n",
 					icd->id);
 			break;
 		default:
-			if (icd->pipeline->pipeline_id != pipeline_id)
-				break;
-			err = ipc_pipeline_free(sof_get()->ipc, icd->id);
+			err = ipc_pipeline_free(ipc, icd->id);
 			if (err)
 				fprintf(stderr, "failed to free pipeline %d\n",
 					icd->id);
@@ -185,23 +223,17 @@ static void test_pipeline_free_comps(int pipeline_id)
 static void test_pipeline_set_test_limits(int pipeline_id, int max_copies,
 					  int max_samples)
 {
-	struct list_item *clist;
-	struct list_item *temp;
 	struct ipc_comp_dev *icd = NULL;
 	struct comp_dev *cd;
 	struct dai_data *dd;
 	struct file_comp_data *fcd;
 
 	/* set the test limits for this pipeline */
-	list_for_item_safe(clist, temp, &sof_get()->ipc->comp_list) {
-		icd = container_of(clist, struct ipc_comp_dev, list);
-
+	for (icd = ipc_ppl_comp_first(sof_get()->ipc, pipeline_id); icd;
+	     icd = ipc_ppl_comp_next(icd)) {
 		switch (icd->type) {
 		case COMP_TYPE_COMPONENT:
 			cd = icd->cd;
-			if (cd->pipeline->pipeline_id != pipeline_id)
-				break;
-
 			switch (cd->drv->type) {
 			case SOF_COMP_HOST:
 			case SOF_COMP_DAI:
@@ -226,8 +258,6 @@ static void test_pipeline_set_test_limits(int pipeline_id, int max_copies,
 
 static void test_pipeline_get_file_stats(int pipeline_id)
 {
-	struct list_item *clist;
-	struct list_item *temp;
 	struct ipc_comp_dev *icd;
 	struct comp_dev *cd;
 	struct dai_data *dd;
@@ -235,14 +265,11 @@ static void test_pipeline_get_file_stats(int pipeline_id)
 	unsigned long time;
 
 	/* get the file IO status for each file in pipeline */
-	list_for_item_safe(clist, temp, &sof_get()->ipc->comp_list) {
-		icd = container_of(clist, struct ipc_comp_dev, list);
-
+	for (icd = ipc_ppl_comp_first(sof_get()->ipc, pipeline_id); icd;
+	     icd = ipc_ppl_comp_next(icd)) {
 		switch (icd->type) {
 		case COMP_TYPE_COMPONENT:
 			cd = icd->cd;
-			if (cd->pipeline->pipeline_id != pipeline_id)
-				break;
 			switch (cd->drv->type) {
 			case SOF_COMP_HOST:
 			case SOF_COMP_DAI:
@@ -274,7 +301,7 @@ static int parse_input_args(int argc, char **argv, struct testbench_prm *tp)
 	int option = 0;
 	int ret = 0;
 
-	while ((option = getopt(argc, argv, "hdqi:o:t:b:a:r:R:c:n:C:P:Vp:T:D:")) != -1) {
+	while ((option = getopt(argc, argv, "hdqi:o:t:b:a:r:R:c:n:C:P:Vp:T:D:Mx")) != -1) {
 		switch (option) {
 		/* input sample file */
 		case 'i':
@@ -352,6 +379,16 @@ static int parse_input_args(int argc, char **argv, struct testbench_prm *tp)
 			tp->pipeline_duration_ms = atoi(optarg);
 			break;
 
+		/* run each DSP core in own thread */
+		case 'M':
+			tp->multicore = true;
+			break;
+
+		/* profile components */
+		case 'x':
+			tp->profile = true;
+			break;
+
 		/* print usage */
 		case 'h':
 			print_usage(argv[0]);
@@ -476,7 +513,7 @@ static int test_pipeline_start(struct testbench_prm *tp)
 			test_pipeline_set_test_limits(tp->pipelines[i], tp->copy_iterations, 0);
 
 		/* set pipeline params and trigger start */
-		if (tb_pipeline_start(ipc, p) < 0) {
+		if (tb_pipeline_start(tp, ipc, p) < 0) {
 			fprintf(stderr, "error: pipeline params\n");
 			return -EINVAL;
 		}
@@ -493,7 +530,10 @@ static bool test_pipeline_check_state(struct testbench_prm *tp, int state)
 
 	tb_getcycles(&cycles0);
 
-	schedule_ll_run_tasks();
+	if (tp->multicore)
+		tb_vcores_run_tick(tp);
+	else
+		schedule_ll_run_tasks();
 
 	tb_getcycles(&cycles1);
 	tp->total_cycles += cycles1 - cycles0;
@@ -615,6 +655,12 @@ static void test_pipeline_stats(struct testbench_prm *tp,
 		       delta_t, (float)frames_out / tp->fs_out * 1000000 / delta_t);
 
 	printf("\n");
+
+	if (tp->profile)
+		tb_profile_print();
+
+	if (tp->profile || tp->tick_period_us)
+		schedule_ll_report();
 }
 
 /*
@@ -625,7 +671,6 @@ static int pipline_test(struct testbench_prm *tp)
 {
 	int dp_count = 0;
 	struct tplg_context ctx;
-	struct timespec ts;
 	struct timespec td0, td1;
 	long long delta_t;
 	int err;
@@ -663,14 +708,21 @@ static int pipline_test(struct testbench_prm *tp)
 			break;
 		}
 
+		if (tp->multicore) {
+			err = tb_vcores_start(tp);
+			if (err < 0) {
+				fprintf(stderr, "error: core threads %d failed %d\n",
+					dp_count, err);
+				break;
+			}
+		}
+
 		tb_gettime(&td0);
 
 		/* sleep to let the pipeline work - we exit at timeout OR
 		 * if copy iterations OR max_samples is reached (whatever first)
 		 */
 		nsleep_time = 0;
-		ts.tv_sec = tp->tick_period_us / 1000000;
-		ts.tv_nsec = (tp->tick_period_us % 1000000) * 1000;
 		if (!tp->copy_check)
 			nsleep_limit = INT_MAX;
 		else
@@ -678,30 +730,24 @@ static int pipline_test(struct testbench_prm *tp)
 				       tp->pipeline_duration_ms;
 
 		while (nsleep_time < nsleep_limit) {
-#if defined __XCC__
-			err = 0;
-#else
 			/* wait for next tick */
-			err = nanosleep(&ts, &ts);
-#endif
-			if (err == 0) {
-				nsleep_time += tp->tick_period_us; /* sleep fully completed */
-				if (test_pipeline_check_state(tp, SOF_TASK_STATE_CANCEL)) {
-					fprintf(stdout, "pipeline cancelled !\n");
-					break;
-				}
-			} else {
-				if (err == EINTR) {
-					continue; /* interrupted - keep going */
-				} else {
-					printf("error: sleep failed: %s\n", strerror(err));
-					break;
-				}
+			err = schedule_ll_wait_tick();
+			if (err < 0) {
+				printf("error: sleep failed: %s\n", strerror(-err));
+				break;
+			}
+
+			nsleep_time += tp->tick_period_us;
+			if (test_pipeline_check_state(tp, SOF_TASK_STATE_CANCEL)) {
+				fprintf(stdout, "pipeline cancelled !\n");
+				break;
 			}
 		}
 
 		tb_gettime(&td1);
 
+		tb_vcores_stop(tp);
+
 		err = test_pipeline_stop(tp);
 		if (err < 0) {
 			fprintf(stderr, "error: pipeline stop %d failed %d\n",
@@ -748,10 +794,14 @@ int main(int argc, char **argv)
 	for (i = 0; i < MAX_INPUT_FILE_NUM; i++)
 		tp.input_file[i] = NULL;
 
-	tp.channels_in = TESTBENCH_NCH;
+	tp.channels_in = 0;
 	tp.channels_out = 0;
 	tp.max_pipeline_id = 0;
 	tp.copy_check = false;
+	tp.multicore = false;
+	tp.profile = false;
+	tp.vcores = NULL;
+	tp.pipeline_core_num = 0;
 	tp.quiet = 0;
 	tp.dynamic_pipeline_iterations = 1;
 	tp.pipeline_string = calloc(1, DEBUG_MSG_LEN);
@@ -766,6 +816,13 @@ int main(int argc, char **argv)
 	if (err < 0)
 		goto out;
 
+	err = get_input_wav_params(&tp);
+	if (err < 0)
+		goto out;
+
+	if (!tp.channels_in)
+		tp.channels_in = TESTBENCH_NCH;
+
 	if (!tp.channels_out)
 		tp.channels_out = tp.channels_in;
 
@@ -800,6 +857,11 @@ int main(int argc, char **argv)
 		tb_enable_trace(1);
 
 
+	if (tp.profile && tb_profile_init() < 0) {
+		fprintf(stderr, "error: profile init\n");
+		exit(EXIT_FAILURE);
+	}
+
 	/* initialize ipc and scheduler */
 	if (tb_setup(sof_get(), &tp) < 0) {
 		fprintf(stderr, "error: pipeline init\n");
@@ -812,6 +874,8 @@ int main(int argc, char **argv)
 	/* free other core FW services */
 	tb_free(sof_get());
 
+	tb_profile_free();
+
 out:
 	/* free all other data */
 	free(tp.bits_in);
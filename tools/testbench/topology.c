@@ -169,6 +169,16 @@ static int tb_register_pipeline(struct testbench_prm *tp, struct tplg_context *c
 
 	pipeline.sched_id = ctx->sched_id;
 
+	/*
+	 * The library firmware has a single DSP core. Keep the topology core
+	 * for mapping the pipeline to a host thread and create it on core 0.
+	 */
+	ret = tb_pipeline_set_core(tp, pipeline.pipeline_id, pipeline.core);
+	if (ret < 0)
+		return ret;
+
+	pipeline.core = 0;
+
 	/* Create pipeline */
 	if (ipc_pipeline_new(sof->ipc, (ipc_pipe_new *)&pipeline) < 0) {
 		fprintf(stderr, "error: pipeline new\n");
@@ -0,0 +1,292 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+/*
+ * Virtual DSP cores for the testbench. Every topology core that has
+ * pipelines gets a host thread that runs the LL task list of that core.
+ * All threads run one tick in parallel and are synchronized with the
+ * testbench main thread at tick start and end, so pipeline trigger and
+ * state checks in the main thread never race with the pipeline tasks.
+ *
+ * Buffers that connect pipelines on different cores are not locked by
+ * the firmware. Within a tick a core therefore waits until all cores
+ * feeding it through such buffers have completed their tasks.
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <rtos/bit.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/component.h>
+#include <sof/audio/pipeline.h>
+#include <sof/ipc/topology.h>
+#include <sof/list.h>
+#include <platform/lib/ll_schedule.h>
+#include "testbench/common_test.h"
+
+#if !defined __XCC__
+
+#include <pthread.h>
+#include <sched.h>
+
+struct tb_vcore {
+	pthread_t thread;
+	struct tb_vcores *vcores;
+	int core;
+	uint32_t upstream_mask;	/* cores producing to this core's buffers */
+};
+
+struct tb_vcores {
+	struct tb_vcore vcore[TB_MAX_VCORES];
+	uint32_t core_mask;	/* cores with pipelines */
+	int num_threads;
+	pthread_barrier_t tick_start;
+	pthread_barrier_t tick_done;
+	pthread_mutex_t lock;
+	pthread_cond_t done_cond;
+	uint32_t done_mask;	/* cores that completed the current tick */
+	bool exit;
+};
+
+static void *tb_vcore_thread(void *arg)
+{
+	struct tb_vcore *vc = arg;
+	struct tb_vcores *vcs = vc->vcores;
+
+	/* wait until all core threads are created */
+	pthread_mutex_lock(&vcs->lock);
+	pthread_mutex_unlock(&vcs->lock);
+	if (vcs->exit)
+		return NULL;
+
+	for (;;) {
+		pthread_barrier_wait(&vcs->tick_start);
+		if (vcs->exit)
+			break;
+
+		/* wait for the cross-core buffers of this core to be filled */
+		pthread_mutex_lock(&vcs->lock);
+		while ((vcs->done_mask & vc->upstream_mask) != vc->upstream_mask)
+			pthread_cond_wait(&vcs->done_cond, &vcs->lock);
+		pthread_mutex_unlock(&vcs->lock);
+
+		schedule_ll_run_core_tasks(vc->core);
+
+		pthread_mutex_lock(&vcs->lock);
+		vcs->done_mask |= BIT(vc->core);
+		pthread_cond_broadcast(&vcs->done_cond);
+		pthread_mutex_unlock(&vcs->lock);
+
+		pthread_barrier_wait(&vcs->tick_done);
+	}
+
+	return NULL;
+}
+
+/* find buffers connecting pipelines that run on different cores */
+static void tb_vcores_get_upstream(struct testbench_prm *tp, struct tb_vcores *vcs)
+{
+	struct ipc_comp_dev *icd;
+	struct comp_buffer *cb;
+	struct list_item *clist;
+	uint32_t source_core;
+	uint32_t sink_core;
+
+	list_for_item(clist, &sof_get()->ipc->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->type != COMP_TYPE_BUFFER)
+			continue;
+
+		cb = icd->cb;
+		if (!cb->source || !cb->sink ||
+		    !cb->source->pipeline || !cb->sink->pipeline)
+			continue;
+
+		source_core = tb_pipeline_get_core(tp, cb->source->pipeline->pipeline_id);
+		sink_core = tb_pipeline_get_core(tp, cb->sink->pipeline->pipeline_id);
+		if (source_core != sink_core)
+			vcs->vcore[sink_core].upstream_mask |= BIT(source_core);
+	}
+}
+
+/* cores feeding each other in a loop would wait for each other forever */
+static bool tb_vcores_have_loop(struct tb_vcores *vcs)
+{
+	uint32_t resolved = 0;
+	uint32_t progress;
+	int core;
+
+	do {
+		progress = 0;
+		for (core = 0; core < TB_MAX_VCORES; core++) {
+			if (!(vcs->core_mask & BIT(core)) || (resolved & BIT(core)))
+				continue;
+
+			if ((vcs->vcore[core].upstream_mask & resolved) ==
+			    vcs->vcore[core].upstream_mask)
+				progress |= BIT(core);
+		}
+		resolved |= progress;
+	} while (progress);
+
+	return resolved != vcs->core_mask;
+}
+
+static void tb_vcore_set_affinity(struct tb_vcore *vc)
+{
+	const char *core0 = getenv("SOF_HOST_CORE0");
+	cpu_set_t cpuset;
+	int host_core;
+	int ret;
+
+	if (!core0)
+		return;
+
+	host_core = atoi(core0) + vc->core;
+	CPU_ZERO(&cpuset);
+	CPU_SET(host_core, &cpuset);
+	ret = pthread_setaffinity_np(vc->thread, sizeof(cpuset), &cpuset);
+	if (ret)
+		fprintf(stderr, "warning: can't map core %d to host core %d: %s\n",
+			vc->core, host_core, strerror(ret));
+}
+
+static void tb_vcores_free(struct tb_vcores *vcs)
+{
+	pthread_barrier_destroy(&vcs->tick_start);
+	pthread_barrier_destroy(&vcs->tick_done);
+	pthread_mutex_destroy(&vcs->lock);
+	pthread_cond_destroy(&vcs->done_cond);
+	free(vcs);
+}
+
+int tb_vcores_start(struct testbench_prm *tp)
+{
+	char message[DEBUG_MSG_LEN];
+	struct tb_vcores *vcs;
+	struct tb_vcore *vc;
+	int created;
+	int core;
+	int ret = 0;
+	int i;
+
+	vcs = calloc(1, sizeof(*vcs));
+	if (!vcs)
+		return -ENOMEM;
+
+	for (i = 0; i < tp->pipeline_core_num; i++)
+		vcs->core_mask |= BIT(tp->pipeline_cores[i].core);
+
+	/* pipelines without topology core info run on core 0 */
+	vcs->core_mask |= BIT(0);
+
+	tb_vcores_get_upstream(tp, vcs);
+	if (tb_vcores_have_loop(vcs)) {
+		fprintf(stderr, "error: cross-core buffers form a loop, use serial mode\n");
+		free(vcs);
+		return -EINVAL;
+	}
+
+	for (core = 0; core < TB_MAX_VCORES; core++)
+		if (vcs->core_mask & BIT(core))
+			vcs->num_threads++;
+
+	/* all core threads plus the testbench main thread */
+	pthread_barrier_init(&vcs->tick_start, NULL, vcs->num_threads + 1);
+	pthread_barrier_init(&vcs->tick_done, NULL, vcs->num_threads + 1);
+	pthread_mutex_init(&vcs->lock, NULL);
+	pthread_cond_init(&vcs->done_cond, NULL);
+
+	pthread_mutex_lock(&vcs->lock);
+	for (created = 0; created < TB_MAX_VCORES; created++) {
+		if (!(vcs->core_mask & BIT(created)))
+			continue;
+
+		vc = &vcs->vcore[created];
+		vc->vcores = vcs;
+		vc->core = created;
+		ret = pthread_create(&vc->thread, NULL, tb_vcore_thread, vc);
+		if (ret) {
+			fprintf(stderr, "error: can't create core %d thread: %s\n",
+				created, strerror(ret));
+			/* the created threads exit before the first tick */
+			vcs->exit = true;
+			break;
+		}
+
+		tb_vcore_set_affinity(vc);
+		sprintf(message, "core %d: upstream cores mask 0x%x\n", created,
+			vc->upstream_mask);
+		debug_print(message);
+	}
+	pthread_mutex_unlock(&vcs->lock);
+
+	if (ret) {
+		for (core = 0; core < created; core++)
+			if (vcs->core_mask & BIT(core))
+				pthread_join(vcs->vcore[core].thread, NULL);
+
+		tb_vcores_free(vcs);
+		return -ret;
+	}
+
+	tp->vcores = vcs;
+	return 0;
+}
+
+/* run one LL tick on all cores, returns when every core has completed it */
+void tb_vcores_run_tick(struct testbench_prm *tp)
+{
+	struct tb_vcores *vcs = tp->vcores;
+
+	vcs->done_mask = 0;
+	schedule_ll_update_time();
+	pthread_barrier_wait(&vcs->tick_start);
+	pthread_barrier_wait(&vcs->tick_done);
+	schedule_ll_post_run();
+}
+
+void tb_vcores_stop(struct testbench_prm *tp)
+{
+	struct tb_vcores *vcs = tp->vcores;
+	int core;
+
+	if (!vcs)
+		return;
+
+	vcs->exit = true;
+	pthread_barrier_wait(&vcs->tick_start);
+
+	for (core = 0; core < TB_MAX_VCORES; core++)
+		if (vcs->core_mask & BIT(core))
+			pthread_join(vcs->vcore[core].thread, NULL);
+
+	tb_vcores_free(vcs);
+	tp->vcores = NULL;
+}
+
+#else
+
+/* xt-run simulation has a single thread */
+int tb_vcores_start(struct testbench_prm *tp)
+{
+	fprintf(stderr, "error: multicore mode is not supported\n");
+	return -EINVAL;
+}
+
+void tb_vcores_run_tick(struct testbench_prm *tp)
+{
+	schedule_ll_run_tasks();
+}
+
+void tb_vcores_stop(struct testbench_prm *tp)
+{
+}
+
+#endif
@@ -3,7 +3,10 @@
 % Input
 %   bits - Number of bits for data, 16 or 32
 %   fn - File name, defaults to twiddle.h
-%   fft_size_max - Number of twiddle factors, defaults to 1024 if omitted
+%   fft_size_max - Max FFT size, defaults to 8192 if omitted
+%
+% The cosine is exported for the first quarter of the unit circle. The FFT
+% library gets the other twiddle factors with symmetry.
 
 % SPDX-License-Identifier: BSD-3-Clause
 %
@@ -16,7 +19,7 @@ if nargin < 2
 end
 
 if nargin < 3
-	fft_size_max = 1024;
+	fft_size_max = 8192;
 end
 
 switch bits
@@ -33,9 +36,8 @@ end
 [~, hname, ~] =  fileparts(fn);
 hcaps = upper(hname);
 
-i = 0:(fft_size_max  - 1);
-twiddle_real = cos(i * 2 * pi / fft_size_max);
-twiddle_imag = -sin(i * 2 * pi / fft_size_max);
+i = 0:(fft_size_max / 4);
+twiddle_cos = cos(i * 2 * pi / fft_size_max);
 
 year = datestr(now(), 'yyyy');
 fh = fopen(fn, 'w');
@@ -49,11 +51,8 @@ fprintf(fh, '#ifndef __INCLUDE_%s_H__\n', hcaps);
 fprintf(fh, '#define __INCLUDE_%s_H__\n\n', hcaps);
 fprintf(fh, '#include <stdint.h>\n\n');
 fprintf(fh, '#define FFT_SIZE_MAX	%d\n\n', fft_size_max);
-fprintf(fh, '/* in Q1.%d, generated from cos(i * 2 * pi / FFT_SIZE_MAX) */\n', qy);
-c_export_int(fh, 'twiddle_real', 'FFT_SIZE_MAX', twiddle_real, qx, qy);
-
-fprintf(fh, '/* in Q1.%d, generated from sin(i * 2 * pi / FFT_SIZE_MAX) */\n', qy);
-c_export_int(fh, 'twiddle_imag', 'FFT_SIZE_MAX', twiddle_imag, qx, qy);
+fprintf(fh, '/* in Q1.%d, generated from cos(i * 2 * pi / FFT_SIZE_MAX) for the first quarter */\n', qy);
+c_export_int(fh, 'twiddle_cos', 'FFT_SIZE_MAX / 4 + 1', twiddle_cos, qx, qy);
 
 fprintf(fh, '#endif\n');
 fclose(fh);